@@ -26,6 +26,10 @@ extern "C"
 #include <rclc/action_goal_handle.h>
 #include "rclc/visibility_control.h"
 
+/// Maximum number of goal responses, which arrived before the goal handle of
+/// their request was visible to the executor
+#define RCLC_ACTION_CLIENT_MAX_PENDING_GOAL_RESPONSES 4
+
 typedef void (* rclc_action_client_goal_callback_t)(
   rclc_action_goal_handle_t * goal_handle,
   bool accepted,
@@ -50,6 +54,19 @@ typedef struct rclc_action_client_t
   rcl_action_client_t rcl_handle;
   const rcl_allocator_t * allocator;
 
+  // Goal ids: random seed of the client and atomic counter of sent goals
+  uint64_t goal_id_seed[2];
+  uintptr_t goal_id_counter;
+  // Goal responses taken by the executor before rclc_action_send_goal_request
+  // inserted the goal handle, matched again on the next spin
+  struct
+  {
+    int64_t sequence_number;
+    bool accepted;
+    int64_t received_ns;
+  } pending_goal_responses[RCLC_ACTION_CLIENT_MAX_PENDING_GOAL_RESPONSES];
+  size_t number_of_pending_goal_responses;
+
   // Callbacks
   rclc_action_client_goal_callback_t goal_callback;
   rclc_action_client_feedback_callback_t feedback_callback;
@@ -98,13 +115,22 @@ rclc_action_client_init_default(
 /**
  *  Send a goal to an action server.
  *
+ *  This function may be called concurrently by multiple threads and concurrently
+ *  to the executor, which handles the action client: goal handles are taken from
+ *  a lock-free pool, only growing an elastic pool locks a mutex, and the goal ids
+ *  are generated from a random seed of the action client and an atomic counter.
+ *  The goal handle is inserted into the list of the executor after the request has
+ *  been sent. If the executor takes the goal response before, it keeps the response
+ *  and matches it again on the next spin. The underlying RMW layer must support
+ *  concurrent requests of a client.
+ *
  *  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
  * Allocates Memory   | Yes
- * Thread-Safe        | No
- * Uses Atomics       | No
- * Lock-Free          | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
  *
  * \param[in] action_client the action client for this action request
  * \param[in] ros_request untyped ros action request
@@ -139,6 +165,36 @@ rcl_ret_t
 rclc_action_send_cancel_request(
   rclc_action_goal_handle_t * goal_handle);
 
+/**
+ *  Makes the goal handle pool of the action client elastic. When all goal handles are
+ *  in use, the pool allocates a chunk of \p options->chunk_size goal handles
+ *  from the allocator of the executor, up to \p options->max_handles goal handles in total.
+ *  Existing goal handles are never moved. The executor deallocates the last chunk, when it
+ *  has not been needed for \p options->shrink_delay_ns. Must be called after
+ *  rclc_executor_add_action_client().
+ *
+ *  * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[inout] action_client the action client added to an executor
+ * \param[in] options chunk size, maximum number of goal handles and shrink delay
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or the options are invalid
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ * \return `RCL_RET_ERROR` if the action client was not added to an executor or the pool is
+ *   already elastic
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_action_client_set_elastic_goal_handles(
+  rclc_action_client_t * action_client,
+  const rclc_action_goal_handle_pool_options_t * options);
+
 /**
  *  Fini a action client and free all resources.
  *
@@ -29,6 +29,9 @@ typedef struct rclc_action_goal_handle_t
 {
   struct rclc_action_goal_handle_t * next;
 
+  // Index + 1 of the goal handle in the goal handle pool
+  size_t pool_index;
+
   union {
     struct rclc_action_server_t * action_server;
     struct rclc_action_client_t * action_client;
@@ -39,6 +42,15 @@ typedef struct rclc_action_goal_handle_t
   unique_identifier_msgs__msg__UUID goal_id;
   struct Generic_SendGoal_Request * ros_goal_request;
 
+  // Slot of an action server for the result response, which is stored until the
+  // result is requested, NULL without result storage
+  void * ros_result_response;
+  // Progress of the result of an action server goal, accessed with atomic operations
+  unsigned int result_state;
+
+  // System time of the goal acceptance by the action server
+  rcl_time_point_value_t goal_accepted_time;
+
   bool available_goal_response;
   bool goal_accepted;
   bool available_feedback;
@@ -63,11 +75,37 @@ typedef struct rclc_action_goal_handle_t
   };
 } rclc_action_goal_handle_t;
 
+/// Maximum number of goal handles of an action client or an action server
+#define RCLC_ACTION_GOAL_HANDLE_POOL_MAX_SIZE \
+  ((((uintptr_t) 1) << (sizeof(uintptr_t) * 4)) - 1)
+
+/// Options of an elastic goal handle pool, see rclc_action_server_set_elastic_goal_handles()
+/// and rclc_action_client_set_elastic_goal_handles()
+typedef struct
+{
+  /// Number of goal handles, which are allocated at once, when the pool is exhausted
+  size_t chunk_size;
+  /// Maximum number of goal handles, including the handles_number initial ones
+  size_t max_handles;
+  /// Time, which the last chunk must not have been needed, before it is deallocated
+  int64_t shrink_delay_ns;
+} rclc_action_goal_handle_pool_options_t;
+
+struct rclc_action_goal_handle_pool_t;
+
+// The list heads are accessed with atomic operations by the rclc library.
+// free_goal_handles is a lock-free stack, which stores the index + 1 of its first
+// goal handle in the lower half of the word and a modification counter against
+// the ABA problem in the upper half. Goal handles can be taken from the pool and
+// inserted into the used list by multiple threads, but only the executor removes
+// goal handles from the used list. goal_handle_pool holds the chunks of an elastic
+// pool, it is NULL for a pool of fixed size.
 #define DECLARE_GOAL_HANDLE_POOL \
   rclc_action_goal_handle_t * goal_handles_memory; \
   size_t goal_handles_memory_size; \
-  rclc_action_goal_handle_t * free_goal_handles; \
-  rclc_action_goal_handle_t * used_goal_handles;
+  uintptr_t free_goal_handles; \
+  rclc_action_goal_handle_t * used_goal_handles; \
+  struct rclc_action_goal_handle_pool_t * goal_handle_pool;
 
 #if __cplusplus
 }
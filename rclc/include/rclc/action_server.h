@@ -39,6 +39,17 @@ typedef bool (* rclc_action_server_handle_cancel_callback_t)(
   rclc_action_goal_handle_t * ros_cancel_request,
   void * args);
 
+/// Copies a result response message into an initialized or zeroed message,
+/// e.g. the generated example_interfaces__action__Fibonacci_GetResult_Response__copy
+typedef bool (* rclc_action_server_result_copy_t)(
+  const void * ros_response,
+  void * ros_result_response);
+
+/// Finalizes a copied result response message,
+/// e.g. the generated example_interfaces__action__Fibonacci_GetResult_Response__fini
+typedef void (* rclc_action_server_result_fini_t)(
+  void * ros_result_response);
+
 typedef struct rclc_action_server_t
 {
   DECLARE_GOAL_HANDLE_POOL
@@ -46,6 +57,22 @@ typedef struct rclc_action_server_t
   rcl_action_server_t rcl_handle;
   const rcl_allocator_t * allocator;
 
+  // Pending cancel request and the goal infos of its response,
+  // one per goal handle
+  action_msgs__srv__CancelGoal_Request cancel_request;
+  rmw_request_id_t cancel_request_header;
+  action_msgs__msg__GoalInfo * cancel_goals_memory;
+
+  // Size of a goal request message, for the goal requests of an elastic pool
+  size_t ros_goal_request_size;
+
+  // Result storage: one result response slot per goal handle, see
+  // rclc_action_server_set_result_storage()
+  void * result_responses_memory;
+  size_t ros_result_response_size;
+  rclc_action_server_result_copy_t result_copy;
+  rclc_action_server_result_fini_t result_fini;
+
   // Callbacks
   rclc_action_server_handle_goal_callback_t goal_callback;
   rclc_action_server_handle_cancel_callback_t cancel_callback;
@@ -89,21 +116,28 @@ rclc_action_server_init_default(
 /**
  *  Finish a goal with a given status and result.
  *  If successful, the goal_handle will be released on the next executor spin.
+ *  If the client has not requested the result yet and the action server has a result
+ *  storage (see rclc_action_server_set_result_storage()), the result is copied into
+ *  the slot of the goal handle and the executor sends it as soon as it takes the
+ *  result request. Then \p ros_response may be reused right after the call.
  *
  *  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
  * Allocates Memory   | Yes
  * Thread-Safe        | Yes
- * Uses Atomics       | No
+ * Uses Atomics       | Yes
  * Lock-Free          | No
  *
  * \param[inout] goal_handle goal handle to be finished
  * \param[in] status goal terminal state
  * \param[in] ros_response action result message
  * \return `RCL_RET_OK` if successful
- * \return `RCLC_RET_ACTION_WAIT_RESULT_REQUEST` if the result has not been requested yet.
- * \return `RCL_ERROR` (or other error code) if an error has occurred
+ * \return `RCLC_RET_ACTION_WAIT_RESULT_REQUEST` if the result has not been requested yet
+ *   and the action server has no result storage.
+ * \return `RCL_RET_BAD_ALLOC` if copying the result failed
+ * \return `RCL_ERROR` (or other error code) if an error has occurred or the result
+ *   of the goal has already been sent or stored
  */
 RCLC_PUBLIC
 rcl_ret_t
@@ -134,6 +168,76 @@ rclc_action_publish_feedback(
   rclc_action_goal_handle_t * goal_handle,
   void * ros_feedback);
 
+/**
+ *  Stores the results of goals, which are finished before the client has requested
+ *  the result, instead of returning `RCLC_RET_ACTION_WAIT_RESULT_REQUEST` from
+ *  rclc_action_send_result(). Each goal handle gets a slot for one result response
+ *  message of \p ros_result_response_size bytes, the executor sends the stored result
+ *  when it takes the result request of the goal. A result with sequences or strings
+ *  must be deep copied with \p copy and finalized with \p fini, e.g. the generated
+ *  functions example_interfaces__action__Fibonacci_GetResult_Response__copy and
+ *  example_interfaces__action__Fibonacci_GetResult_Response__fini. Must be called after
+ *  rclc_executor_add_action_server() and before rclc_action_server_set_elastic_goal_handles(),
+ *  the slots of an elastic pool are allocated with its chunks.
+ *
+ *  * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] action_server the action server added to an executor
+ * \param[in] ros_result_response_size size of the result response message type,
+ *   e.g. sizeof(example_interfaces__action__Fibonacci_GetResult_Response)
+ * \param[in] copy copy function of the result response, NULL for a flat copy
+ * \param[in] fini fini function of the result response, NULL if nothing is to be finalized
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p action_server is a null pointer or
+ *   \p ros_result_response_size is 0
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ * \return `RCL_RET_ERROR` if the action server was not added to an executor, the pool is
+ *   already elastic or the result storage is already set
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_action_server_set_result_storage(
+  rclc_action_server_t * action_server,
+  size_t ros_result_response_size,
+  rclc_action_server_result_copy_t copy,
+  rclc_action_server_result_fini_t fini);
+
+/**
+ *  Makes the goal handle pool of the action server elastic. When all goal handles are
+ *  in use, the pool allocates a chunk of \p options->chunk_size goal handles and their goal requests
+ *  from the allocator of the executor, up to \p options->max_handles goal handles in total.
+ *  Existing goal handles are never moved. The executor deallocates the last chunk, when it
+ *  has not been needed for \p options->shrink_delay_ns. Must be called after
+ *  rclc_executor_add_action_server() and rclc_action_server_set_result_storage().
+ *
+ *  * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[inout] action_server the action server added to an executor
+ * \param[in] options chunk size, maximum number of goal handles and shrink delay
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or the options are invalid
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ * \return `RCL_RET_ERROR` if the action server was not added to an executor or the pool is
+ *   already elastic
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_action_server_set_elastic_goal_handles(
+  rclc_action_server_t * action_server,
+  const rclc_action_goal_handle_pool_options_t * options);
+
 /**
  *  Fini a action server and free all resources.
  *
@@ -0,0 +1,251 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__ASYNC_PUBLISHER_H_
+#define RCLC__ASYNC_PUBLISHER_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <rcl/rcl.h>
+#include <rclc/visibility_control.h>
+
+/*! \file async_publisher.h
+    \brief Publisher with a background thread: messages are put into a bounded
+    queue of preallocated messages and the publisher thread serializes and
+    sends them, so that publishing large messages does not block the executor.
+*/
+
+/// Minimum number of messages of a rclc_async_publisher_t: one queue slot and
+/// the message, which is sent by the publisher thread.
+#define RCLC_ASYNC_PUBLISHER_MIN_MSGS 2
+
+/// Behavior of rclc_async_publisher_publish() if the queue is full
+typedef enum
+{
+  /// The oldest queued message is replaced by the new message
+  RCLC_ASYNC_PUBLISHER_DROP_OLDEST,
+  /// The new message is dropped
+  RCLC_ASYNC_PUBLISHER_DROP_NEWEST,
+  /// The caller waits until the publisher thread has taken a message from the queue
+  RCLC_ASYNC_PUBLISHER_BLOCK
+} rclc_async_publisher_overflow_policy_t;
+
+/// Deep copy of a message, e.g. the generated function <pkg>__msg__<Type>__copy().
+/// Returns false if the message could not be copied.
+typedef bool (* rclc_async_publisher_copy_t)(const void * input, void * output);
+
+/// Counters of a rclc_async_publisher_t
+typedef struct
+{
+  /// Number of messages sent by the publisher thread
+  uint64_t published;
+  /// Number of messages dropped because the queue was full
+  uint64_t dropped;
+  /// Number of messages, which could not be sent
+  uint64_t errors;
+  /// Number of messages currently in the queue
+  size_t queued;
+} rclc_async_publisher_statistics_t;
+
+struct rclc_async_publisher_worker_t;
+
+/// Publisher, which sends messages from a background thread
+typedef struct
+{
+  /// Publisher, which is only used by the publisher thread
+  rcl_publisher_t * publisher;
+  /// Preallocated messages, owned by the async publisher until it is finalized
+  void ** msgs;
+  /// Number of messages
+  size_t number_of_msgs;
+  /// Deep copy function of the message type, NULL if only
+  /// rclc_async_publisher_publish_move() is used
+  rclc_async_publisher_copy_t copy;
+  /// Behavior if the queue is full
+  rclc_async_publisher_overflow_policy_t policy;
+  /// Queue and publisher thread
+  struct rclc_async_publisher_worker_t * worker;
+  /// Allocator of the worker
+  rcl_allocator_t allocator;
+} rclc_async_publisher_t;
+
+/**
+ *  Return a rclc_async_publisher_t struct with pointer members initialized to `NULL`
+ *  and member variables to 0.
+ */
+RCLC_PUBLIC
+rclc_async_publisher_t
+rclc_async_publisher_get_zero_initialized(void);
+
+/**
+ *  Initializes an async publisher for an initialized \p publisher and starts
+ *  its publisher thread. The preallocated messages \p msgs must be initialized
+ *  for the message type of \p publisher. They are the storage of the queue,
+ *  which holds `number_of_msgs - 1` messages, while the publisher thread sends
+ *  the last one. The array \p msgs must stay valid until rclc_async_publisher_fini().
+ *  While the async publisher is used, \p publisher must not be used otherwise.
+ *
+ *  The publisher thread needs POSIX threads.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] async_publisher pointer to a zero initialized rclc_async_publisher_t
+ * \param[in] publisher an initialized rcl publisher
+ * \param[in] msgs array of pointers to preallocated messages
+ * \param[in] number_of_msgs number of messages, at least RCLC_ASYNC_PUBLISHER_MIN_MSGS
+ * \param[in] copy deep copy function of the message type, can be NULL
+ * \param[in] policy behavior if the queue is full
+ * \param[in] allocator allocator for the queue
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ *   or \p number_of_msgs is too small
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ * \return `RCL_RET_UNSUPPORTED` if threads are not supported on this platform
+ * \return `RCL_RET_ERROR` if the publisher thread could not be started
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_async_publisher_init(
+  rclc_async_publisher_t * async_publisher,
+  rcl_publisher_t * publisher,
+  void ** msgs,
+  size_t number_of_msgs,
+  rclc_async_publisher_copy_t copy,
+  rclc_async_publisher_overflow_policy_t policy,
+  const rcl_allocator_t * allocator);
+
+/**
+ *  Sends all queued messages, stops the publisher thread and deallocates the
+ *  queue. Afterwards `msgs` contains the pointers to the messages owned by the
+ *  async publisher, which can differ from those passed to rclc_async_publisher_init()
+ *  if rclc_async_publisher_publish_move() was used. The messages and the rcl
+ *  publisher are not finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] async_publisher pointer to an initialized rclc_async_publisher_t
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p async_publisher is a null pointer
+ * \return `RCL_RET_ERROR` if the publisher thread could not be joined
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_async_publisher_fini(rclc_async_publisher_t * async_publisher);
+
+/**
+ *  Copies \p ros_message with the copy function into a free queue slot and returns.
+ *  The message is serialized and sent later by the publisher thread.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Depends on the copy function
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] async_publisher pointer to an initialized rclc_async_publisher_t
+ * \param[in] ros_message the message to publish
+ * \param[out] queued true if the message was queued, false if it was dropped
+ *   because of RCLC_ASYNC_PUBLISHER_DROP_NEWEST (can be NULL)
+ * \return `RCL_RET_OK` if the message was queued or dropped
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if the async publisher has no copy function or
+ *   the message could not be copied
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_async_publisher_publish(
+  rclc_async_publisher_t * async_publisher,
+  const void * ros_message,
+  bool * queued);
+
+/**
+ *  Moves the message \p *ros_message into the queue without copying it: the
+ *  message is exchanged with the message of a free queue slot, which is returned
+ *  in \p *ros_message and can be reused for the next message. Therefore
+ *  \p *ros_message must be initialized for the message type and, like the
+ *  messages passed to rclc_async_publisher_init(), allocated with the same allocator.
+ *  If the message is dropped, \p *ros_message is not changed.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[inout] async_publisher pointer to an initialized rclc_async_publisher_t
+ * \param[inout] ros_message pointer to the message to publish, on return
+ *   pointer to a message, which is owned by the caller
+ * \param[out] queued true if the message was queued, false if it was dropped
+ *   because of RCLC_ASYNC_PUBLISHER_DROP_NEWEST (can be NULL)
+ * \return `RCL_RET_OK` if the message was queued or dropped
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if the async publisher is being finalized
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_async_publisher_publish_move(
+  rclc_async_publisher_t * async_publisher,
+  void ** ros_message,
+  bool * queued);
+
+/**
+ *  Returns the counters of the async publisher.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[in] async_publisher pointer to an initialized rclc_async_publisher_t
+ * \param[out] statistics the counters
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ *   or \p async_publisher is not initialized
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_async_publisher_get_statistics(
+  rclc_async_publisher_t * async_publisher,
+  rclc_async_publisher_statistics_t * statistics);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__ASYNC_PUBLISHER_H_
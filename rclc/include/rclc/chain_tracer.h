@@ -0,0 +1,276 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__CHAIN_TRACER_H_
+#define RCLC__CHAIN_TRACER_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#include <rcl/rcl.h>
+#include <rclc/visibility_control.h>
+
+/*! \file chain_tracer.h
+    \brief Tracer for the end-to-end latency of cause-effect chains, e.g. from a
+    sensor subscription to an actuator publisher, across the callbacks of the
+    executors of one process.
+
+    The executor records every message it takes with the source timestamp and
+    the publisher gid of the message info, and every callback invocation. The
+    callbacks publish with rclc_chain_tracer_publish(), which records the publisher
+    gid and the time window of rcl_publish. A taken message is linked to the
+    publish of the same publisher, during which its source timestamp was set.
+    rclc_chain_tracer_analyze() follows these links back from each publish of the
+    output publisher to the input of the chain.
+*/
+
+/// Number of buckets of rclc_chain_tracer_histogram_t. Bucket 0 counts latencies
+/// shorter than 1ns, bucket k > 0 latencies in [2^(k-1), 2^k) ns. The last bucket
+/// also counts all longer latencies.
+#define RCLC_CHAIN_TRACER_HISTOGRAM_SIZE 40
+
+/// Type of a rclc_chain_tracer_event_t
+typedef enum
+{
+  /// The executor took a message of a subscription
+  RCLC_CHAIN_TRACER_TAKE,
+  /// The executor invoked the callback of a handle
+  RCLC_CHAIN_TRACER_CALLBACK,
+  /// A message was published with rclc_chain_tracer_publish()
+  RCLC_CHAIN_TRACER_PUBLISH
+} rclc_chain_tracer_event_type_t;
+
+/// Event recorded by a rclc_chain_tracer_t
+typedef struct
+{
+  /// Type of the event
+  rclc_chain_tracer_event_type_t type;
+  /// Subscription of a take, rcl object of the handle of a callback (e.g. the
+  /// subscription or timer), publisher of a publish
+  const void * source;
+  /// Number of the callback invocation (starting with 1) of a callback, number of
+  /// the invocation in which the message was published of a publish (0 if it was
+  /// published outside of a callback)
+  uint64_t invocation;
+  /// Source timestamp of the message of a take, start time of a callback,
+  /// system time before rcl_publish of a publish
+  rcutils_time_point_value_t timestamp;
+  /// System time after rcl_publish of a publish
+  rcutils_time_point_value_t timestamp_end;
+  /// Gid of the publisher of the message of a take or publish
+  rmw_gid_t gid;
+} rclc_chain_tracer_event_t;
+
+/// Tracer of the callbacks and publishes of the executors it is set to with
+/// rclc_executor_set_chain_tracer(). The events are stored in a ring buffer,
+/// the oldest events are overwritten.
+typedef struct
+{
+  /// Ring buffer of events
+  rclc_chain_tracer_event_t * events;
+  /// Size of the ring buffer
+  size_t capacity;
+  /// Number of recorded events, including overwritten ones
+  uint64_t number_of_events;
+  /// Number of callback invocations
+  uint64_t invocations;
+  /// Callback invocation, which is currently executed, 0 outside of callbacks
+  uint64_t current_invocation;
+  /// Allocator of the ring buffer
+  rcl_allocator_t allocator;
+} rclc_chain_tracer_t;
+
+/// Histogram of chain latencies
+typedef struct
+{
+  /// Number of chains
+  uint64_t count;
+  /// Shortest latency in nanoseconds
+  uint64_t min_ns;
+  /// Longest latency in nanoseconds
+  uint64_t max_ns;
+  /// Sum of all latencies in nanoseconds
+  uint64_t sum_ns;
+  /// Number of latencies per bucket
+  uint64_t buckets[RCLC_CHAIN_TRACER_HISTOGRAM_SIZE];
+} rclc_chain_tracer_histogram_t;
+
+/**
+ *  Return a rclc_chain_tracer_t struct with pointer members initialized to `NULL`
+ *  and member variables to 0.
+ */
+RCLC_PUBLIC
+rclc_chain_tracer_t
+rclc_chain_tracer_get_zero_initialized(void);
+
+/**
+ *  Initializes a chain tracer with a ring buffer of \p capacity events.
+ *  Each callback invocation records one event, plus one per taken message and
+ *  one per publish.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] tracer pointer to a zero initialized rclc_chain_tracer_t
+ * \param[in] capacity number of events in the ring buffer, at least 1
+ * \param[in] allocator allocator for the ring buffer
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or \p capacity is 0
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_chain_tracer_init(
+  rclc_chain_tracer_t * tracer,
+  size_t capacity,
+  const rcl_allocator_t * allocator);
+
+/**
+ *  Deallocates the ring buffer of a chain tracer. The tracer must have been
+ *  removed from all executors.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] tracer pointer to an initialized rclc_chain_tracer_t
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p tracer is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_chain_tracer_fini(rclc_chain_tracer_t * tracer);
+
+/**
+ *  Discards all recorded events.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] tracer pointer to an initialized rclc_chain_tracer_t
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p tracer is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_chain_tracer_clear(rclc_chain_tracer_t * tracer);
+
+/**
+ *  Publishes \p ros_message with rcl_publish() and records the publish, so that
+ *  the messages taken by the receiving callbacks are linked to the callback
+ *  invocation, which published it. Must be called from the thread of the
+ *  executors of the tracer. If \p tracer is NULL, the message is only published.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] tracer pointer to an initialized rclc_chain_tracer_t or NULL
+ * \param[in] publisher handle to the publisher
+ * \param[in] ros_message type-erased pointer to the ROS message
+ * \param[in] allocation structure pointer, used for memory preallocation (may be NULL)
+ * \return the return codes of rcl_publish()
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_chain_tracer_publish(
+  rclc_chain_tracer_t * tracer,
+  const rcl_publisher_t * publisher,
+  const void * ros_message,
+  rmw_publisher_allocation_t * allocation);
+
+/**
+ *  Computes the histogram of the latencies of the cause-effect chain from the
+ *  callback of \p input to \p output over the recorded events. The latency of a
+ *  chain is the time from the source timestamp of the message taken by \p input
+ *  (or the start of its callback, if \p input is a timer) to the publish on
+ *  \p output, which was caused by it through any number of callbacks. Call it
+ *  when the executors are not spinning, e.g. after the measurement.
+ *
+ *  The middleware must provide the source timestamp and publisher gid in the
+ *  message info (e.g. rmw_fastrtps_cpp, rmw_cyclonedds_cpp).
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] tracer pointer to an initialized rclc_chain_tracer_t
+ * \param[in] input rcl subscription or timer of the first callback of the chain
+ * \param[in] output publisher of the last callback of the chain
+ * \param[out] histogram latencies of all complete chains
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_chain_tracer_analyze(
+  const rclc_chain_tracer_t * tracer,
+  const void * input,
+  const rcl_publisher_t * output,
+  rclc_chain_tracer_histogram_t * histogram);
+
+/**
+ *  Returns an upper bound of the \p percentile (0.0 - 1.0) of the latencies in
+ *  \p histogram in nanoseconds. The resolution is a power of two.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] histogram histogram computed by rclc_chain_tracer_analyze()
+ * \param[in] percentile percentile between 0.0 and 1.0
+ * \return percentile in nanoseconds, 0 if \p histogram is NULL or empty
+ */
+RCLC_PUBLIC
+uint64_t
+rclc_chain_tracer_percentile(
+  const rclc_chain_tracer_histogram_t * histogram,
+  double percentile);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__CHAIN_TRACER_H_
@@ -0,0 +1,327 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__COMPONENT_H_
+#define RCLC__COMPONENT_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <rcl/rcl.h>
+#include <rclc/executor.h>
+#include <rclc/init.h>
+#include <rclc/visibility_control.h>
+
+/*! \file component.h
+    \brief Logical sub-nodes: components share one rcl node, so they have no
+    graph presence of their own, but namespace their topics and services and
+    own the publishers, subscriptions, services, clients and timers created
+    through them.
+
+    The names of a component `camera` are expanded as follows and then resolved
+    by rcl relative to the namespace of the node:
+    - `image` becomes `camera/image`
+    - `~/image` becomes `~/camera/image`
+    - `/image` is not changed
+*/
+
+/// Type of an entity of a rclc_component_t
+typedef enum
+{
+  RCLC_COMPONENT_PUBLISHER,
+  RCLC_COMPONENT_SUBSCRIPTION,
+  RCLC_COMPONENT_SERVICE,
+  RCLC_COMPONENT_CLIENT,
+  RCLC_COMPONENT_TIMER
+} rclc_component_entity_type_t;
+
+/// Entity owned by a rclc_component_t
+typedef struct
+{
+  /// Type of the entity
+  rclc_component_entity_type_t type;
+  /// Pointer to the rcl object
+  union {
+    rcl_publisher_t * publisher;
+    rcl_subscription_t * subscription;
+    rcl_service_t * service;
+    rcl_client_t * client;
+    rcl_timer_t * timer;
+  };
+} rclc_component_entity_t;
+
+/// Logical sub-node of a rcl node
+typedef struct
+{
+  /// Node shared by all components
+  rcl_node_t * node;
+  /// Name of the component, prefix of its relative topic and service names
+  char * name;
+  /// Entities created through the component
+  rclc_component_entity_t * entities;
+  /// Maximum number of entities
+  size_t max_entities;
+  /// Number of entities
+  size_t number_of_entities;
+  /// Allocator of the name and the entities array
+  rcl_allocator_t allocator;
+} rclc_component_t;
+
+/**
+ *  Return a rclc_component_t struct with pointer members initialized to `NULL`
+ *  and member variables to 0.
+ */
+RCLC_PUBLIC
+rclc_component_t
+rclc_component_get_zero_initialized(void);
+
+/**
+ *  Initializes a component of \p node. The memory for \p max_entities entities
+ *  is allocated only here. The component does not create any middleware entity.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] component pointer to a zero initialized rclc_component_t
+ * \param[in] name name of the component: letters, digits, '_' and '/' as separator,
+ *   not starting with a digit or '/'
+ * \param[in] node the rcl node shared by the components
+ * \param[in] max_entities maximum number of entities of the component
+ * \param[in] allocator allocator for the name and the entities
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or \p name is invalid
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_component_init(
+  rclc_component_t * component,
+  const char * name,
+  rcl_node_t * node,
+  size_t max_entities,
+  const rcl_allocator_t * allocator);
+
+/**
+ *  Finalizes all entities of the component in the reverse order of their creation
+ *  and deallocates its memory. The entities must have been removed from the
+ *  executors before, e.g. with rclc_component_remove_from_executor().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] component pointer to an initialized rclc_component_t
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p component is a null pointer
+ * \return `RCL_RET_ERROR` if an entity could not be finalized
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_component_fini(rclc_component_t * component);
+
+/**
+ *  Creates a publisher of the component on the node.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes (in RCL)
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] publisher a zero_initialized rcl_publisher_t
+ * \param[inout] component pointer to an initialized rclc_component_t
+ * \param[in] type_support the message data type
+ * \param[in] topic_name the name of the topic, relative to the component
+ * \param[in] qos_profile the qos of the topic, NULL for the default profile
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ * \return `RCL_RET_ERROR` if the component has already max_entities entities
+ *   (or other error code of rcl)
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_component_publisher_init(
+  rcl_publisher_t * publisher,
+  rclc_component_t * component,
+  const rosidl_message_type_support_t * type_support,
+  const char * topic_name,
+  const rmw_qos_profile_t * qos_profile);
+
+/**
+ *  Creates a subscription of the component on the node.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes (in RCL)
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] subscription a zero_initialized rcl_subscription_t
+ * \param[inout] component pointer to an initialized rclc_component_t
+ * \param[in] type_support the message data type
+ * \param[in] topic_name the name of the topic, relative to the component
+ * \param[in] qos_profile the qos of the topic, NULL for the default profile
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ * \return `RCL_RET_ERROR` if the component has already max_entities entities
+ *   (or other error code of rcl)
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_component_subscription_init(
+  rcl_subscription_t * subscription,
+  rclc_component_t * component,
+  const rosidl_message_type_support_t * type_support,
+  const char * topic_name,
+  const rmw_qos_profile_t * qos_profile);
+
+/**
+ *  Creates a service of the component on the node.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes (in RCL)
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] service a zero_initialized rcl_service_t
+ * \param[inout] component pointer to an initialized rclc_component_t
+ * \param[in] type_support the service data type
+ * \param[in] service_name the name of the service, relative to the component
+ * \param[in] qos_profile the qos of the service, NULL for the default profile
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ * \return `RCL_RET_ERROR` if the component has already max_entities entities
+ *   (or other error code of rcl)
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_component_service_init(
+  rcl_service_t * service,
+  rclc_component_t * component,
+  const rosidl_service_type_support_t * type_support,
+  const char * service_name,
+  const rmw_qos_profile_t * qos_profile);
+
+/**
+ *  Creates a client of the component on the node.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes (in RCL)
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] client a zero_initialized rcl_client_t
+ * \param[inout] component pointer to an initialized rclc_component_t
+ * \param[in] type_support the service data type
+ * \param[in] service_name the name of the service, relative to the component
+ * \param[in] qos_profile the qos of the service, NULL for the default profile
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ * \return `RCL_RET_ERROR` if the component has already max_entities entities
+ *   (or other error code of rcl)
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_component_client_init(
+  rcl_client_t * client,
+  rclc_component_t * component,
+  const rosidl_service_type_support_t * type_support,
+  const char * service_name,
+  const rmw_qos_profile_t * qos_profile);
+
+/**
+ *  Creates a timer of the component.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes (in RCL)
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] timer a zero_initialized rcl_timer_t
+ * \param[inout] component pointer to an initialized rclc_component_t
+ * \param[in] support the rclc_support_t object of the node
+ * \param[in] timeout_ns the time out in nanoseconds of the timer
+ * \param[in] callback the callback of the timer
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if the component has already max_entities entities
+ *   (or other error code of rcl)
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_component_timer_init(
+  rcl_timer_t * timer,
+  rclc_component_t * component,
+  rclc_support_t * support,
+  const uint64_t timeout_ns,
+  const rcl_timer_callback_t callback);
+
+/**
+ *  Removes all subscriptions, services, clients and timers of the component,
+ *  which were added to \p executor, from it. Entities, which were not added,
+ *  are skipped.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] component pointer to an initialized rclc_component_t
+ * \param[inout] executor pointer to an initialized executor
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if a handle could not be removed
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_component_remove_from_executor(
+  const rclc_component_t * component,
+  rclc_executor_t * executor);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__COMPONENT_H_
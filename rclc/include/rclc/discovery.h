@@ -0,0 +1,211 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__DISCOVERY_H_
+#define RCLC__DISCOVERY_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <rcl/rcl.h>
+#include <rcl/graph.h>
+#include <rcl_action/rcl_action.h>
+#include <rclc/types.h>
+#include <rclc/visibility_control.h>
+
+/// Type definition for the callback, which is called once the peer has been discovered
+typedef void (* rclc_discovery_callback_t)(void *);
+
+/// Kind of peer to wait for
+typedef enum
+{
+  RCLC_DISCOVERY_SERVICE_SERVER,
+  RCLC_DISCOVERY_ACTION_SERVER,
+  RCLC_DISCOVERY_SUBSCRIPTIONS
+} rclc_discovery_target_t;
+
+/// Condition on the ROS graph, which is evaluated whenever the graph
+/// guard condition of the node is triggered.
+typedef struct
+{
+  /// Kind of peer
+  rclc_discovery_target_t target;
+  /// Node, whose graph guard condition is used
+  const rcl_node_t * node;
+  /// Entity, whose peers are discovered
+  union {
+    const rcl_client_t * client;
+    const rcl_action_client_t * action_client;
+    const rcl_publisher_t * publisher;
+  };
+  /// Minimum number of matched subscriptions (RCLC_DISCOVERY_SUBSCRIPTIONS only)
+  size_t min_subscriptions;
+  /// Flag, which is true once the condition was fulfilled
+  bool matched;
+  /// Internal variable. Flag, which is true after the first evaluation of the condition
+  bool checked;
+  /// Callback called once when the condition becomes true
+  rclc_discovery_callback_t callback;
+  /// Argument of the callback
+  void * callback_context;
+} rclc_discovery_t;
+
+/**
+ *  Return a rclc_discovery_t struct with pointer members initialized to `NULL`
+ *  and member variables to 0.
+ */
+RCLC_PUBLIC
+rclc_discovery_t
+rclc_discovery_get_zero_initialized(void);
+
+/**
+ *  Initializes a discovery condition, which is fulfilled when a service server
+ *  for the \p client is available.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] discovery pointer to a rclc_discovery_t
+ * \param[in] node pointer to the initialized node of the \p client
+ * \param[in] client pointer to an initialized client
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_discovery_init_service_server(
+  rclc_discovery_t * discovery,
+  const rcl_node_t * node,
+  const rcl_client_t * client);
+
+/**
+ *  Initializes a discovery condition, which is fulfilled when an action server
+ *  for the \p action_client is available.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] discovery pointer to a rclc_discovery_t
+ * \param[in] node pointer to the initialized node of the \p action_client
+ * \param[in] action_client pointer to an initialized rcl action client
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_discovery_init_action_server(
+  rclc_discovery_t * discovery,
+  const rcl_node_t * node,
+  const rcl_action_client_t * action_client);
+
+/**
+ *  Initializes a discovery condition, which is fulfilled when at least
+ *  \p min_subscriptions subscriptions are matched with the \p publisher.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] discovery pointer to a rclc_discovery_t
+ * \param[in] node pointer to the initialized node of the \p publisher
+ * \param[in] publisher pointer to an initialized publisher
+ * \param[in] min_subscriptions number of subscriptions to wait for, must be larger than 0
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or
+ *   \p min_subscriptions is 0
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_discovery_init_subscriptions(
+  rclc_discovery_t * discovery,
+  const rcl_node_t * node,
+  const rcl_publisher_t * publisher,
+  size_t min_subscriptions);
+
+/**
+ *  Evaluates the discovery condition with the current state of the ROS graph.
+ *  Sets {@link rclc_discovery_t.matched}, but does not call the callback.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] discovery pointer to an initialized rclc_discovery_t
+ * \param[out] matched true if the condition is fulfilled
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` (or other error code) if the graph query failed
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_discovery_check(
+  rclc_discovery_t * discovery,
+  bool * matched);
+
+/**
+ *  Blocks until the discovery condition is fulfilled or the timeout expired.
+ *  Instead of polling, the function waits on the graph guard condition of the node
+ *  and evaluates the condition only after a change of the ROS graph.
+ *  Use this function instead of a fixed sleep before sending the first request.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes (wait_set in RCL)
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] discovery pointer to an initialized rclc_discovery_t
+ * \param[in] context the context of the node
+ * \param[in] timeout_ns maximum time to wait in nanoseconds, negative values wait forever
+ * \param[in] allocator allocator for the wait_set
+ * \return `RCL_RET_OK` if the condition is fulfilled
+ * \return `RCL_RET_TIMEOUT` if the condition was not fulfilled within \p timeout_ns
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` (or other error code) if an error has occurred
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_discovery_wait(
+  rclc_discovery_t * discovery,
+  rcl_context_t * context,
+  int64_t timeout_ns,
+  const rcl_allocator_t * allocator);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__DISCOVERY_H_
@@ -34,6 +34,7 @@ extern "C"
 
 #include "rclc/action_client.h"
 #include "rclc/action_server.h"
+#include "rclc/chain_tracer.h"
 
 /*! \file executor.h
     \brief The RCLC-Executor provides an Executor based on RCL in which all callbacks are
@@ -56,6 +57,27 @@ typedef enum
 /// - application specific struct used in the trigger function
 typedef bool (* rclc_executor_trigger_t)(rclc_executor_handle_t *, unsigned int, void *);
 
+/// Type definition for the callback of a scheduled task, called with the context
+/// passed to rclc_executor_schedule_at() or rclc_executor_schedule_after()
+typedef void (* rclc_executor_task_callback_t)(void * context);
+
+/// Id of a scheduled task to cancel it with rclc_executor_cancel_task()
+typedef uint64_t rclc_executor_task_id_t;
+
+/// Id, which no scheduled task has
+#define RCLC_EXECUTOR_TASK_INVALID_ID 0
+
+/// Opaque state of the events mode (see {@link rclc_executor_set_events_mode()})
+struct rclc_executor_events_t;
+/// Opaque state of the statistics export (see {@link rclc_executor_set_stats_export()})
+struct rclc_executor_stats_t;
+/// Opaque request queue (see {@link rclc_executor_enable_staging()})
+struct rclc_executor_staging_t;
+/// Opaque dependency graph and worker threads (see {@link rclc_executor_add_dependency()})
+struct rclc_executor_dag_t;
+/// Opaque scheduled tasks (see {@link rclc_executor_enable_scheduled_tasks()})
+struct rclc_executor_tasks_t;
+
 /// Container for RCLC-Executor
 typedef struct
 {
@@ -83,6 +105,22 @@ typedef struct
   void * trigger_object;
   /// data communication semantics
   rclc_executor_semantics_t data_comm_semantics;
+  /// event queue, NULL if events mode is disabled
+  struct rclc_executor_events_t * events;
+  /// statistics segment, NULL if the statistics are not exported
+  struct rclc_executor_stats_t * stats;
+  /// chain tracer, NULL if the callbacks are not traced
+  rclc_chain_tracer_t * chain_tracer;
+  /// queue of add and remove requests of other threads, NULL if staging is disabled
+  struct rclc_executor_staging_t * staging;
+  /// dependencies between the handles and worker threads, NULL if none were declared
+  struct rclc_executor_dag_t * dag;
+  /// timers are re-checked between the callbacks of a spin
+  bool timer_interleaving;
+  /// steady time of the next timer expiration, when timers are re-checked
+  rcutils_time_point_value_t timer_deadline;
+  /// one-shot tasks, NULL if scheduled tasks are disabled
+  struct rclc_executor_tasks_t * tasks;
 } rclc_executor_t;
 
 /**
@@ -93,6 +131,434 @@ RCLC_PUBLIC
 rclc_executor_t
 rclc_executor_get_zero_initialized_executor(void);
 
+/**
+ *  Export the statistics of the executor to a POSIX shared-memory segment.
+ *
+ *  The segment `/rclc_stats.<pid>.<name>` contains the handle list and, per handle,
+ *  the number of callback invocations, the number of failed takes and a histogram of
+ *  the callback times, as well as the time spent in the wait, take and execute phases
+ *  of the spin-functions. The layout is defined in rclc/executor_stats.h. Other
+ *  processes, e.g. the `rclc_top` tool, map the segment read-only. The records are
+ *  protected by sequence locks, so the executor never waits for a reader.
+ *
+ *  The segment is removed when the export is disabled or the executor is finalized.
+ *  Without an export, the spin-functions do not read the clock.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an initialized executor
+ * \param [in] name name of the executor (at most 63 characters, without '/'),
+ *             NULL to disable the export
+ * \return `RCL_RET_OK` if the export was set successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer or \p name is invalid
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ * \return `RCL_RET_UNSUPPORTED` if the platform has no POSIX shared memory
+ * \return `RCL_RET_ERROR` in an error occured
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_stats_export(
+  rclc_executor_t * executor,
+  const char * name);
+
+/**
+ *  Samples hardware and software performance counters around each callback and adds
+ *  the CPU cycles, instructions, cache misses and context switches to the statistics
+ *  of the handle (see rclc_executor_set_stats_export()).
+ *
+ *  The counters are opened with `perf_event_open` for the calling thread, so this
+ *  function must be called from the thread, which spins the executor. Counters, which
+ *  are not available, e.g. without a PMU in a virtual machine or due to
+ *  `perf_event_paranoid`, are skipped; if none is available, only the callback times
+ *  are measured. The available counters are also set in the header of the segment.
+ *  Sampling costs two system calls per callback invocation. The counters are closed
+ *  when the export is disabled or the executor is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an initialized executor with statistics export
+ * \param [out] counters RCLC_EXECUTOR_STATS_COUNTER_* bits of the sampled counters,
+ *             0 on platforms other than Linux, can be NULL
+ * \return `RCL_RET_OK` if successful, also if no counter is available
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer
+ * \return `RCL_RET_ERROR` if the executor does not export statistics
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_enable_stats_counters(
+  rclc_executor_t * executor,
+  uint32_t * counters);
+
+/**
+ *  Traces the callbacks of the executor with \p tracer (see rclc/chain_tracer.h).
+ *  The executor records the source timestamp and publisher gid of each taken message
+ *  and each callback invocation, so that rclc_chain_tracer_analyze() can link the
+ *  messages published with rclc_chain_tracer_publish() in a callback to the inputs
+ *  of the callback. Several executors spinning in the same thread can share a tracer.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an initialized executor
+ * \param [in] tracer pointer to an initialized rclc_chain_tracer_t, NULL to disable tracing
+ * \return `RCL_RET_OK` if the tracer was set successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer or \p tracer
+ *   is not initialized
+ * \return `RCL_RET_ERROR` if \p executor is not initialized
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_chain_tracer(
+  rclc_executor_t * executor,
+  rclc_chain_tracer_t * tracer);
+
+/**
+ *  Enables the staging of handle additions and removals from other threads.
+ *  The functions rclc_executor_stage_add_*() and rclc_executor_stage_remove() enqueue
+ *  a request into a lock-free queue and wake up the executor with a guard condition.
+ *  The executor applies all queued requests in their order at the beginning of the next
+ *  call of rclc_executor_spin_some(), before it waits, so neither the callbacks nor the
+ *  other threads are ever blocked. The guard condition occupies one handle of the executor,
+ *  i.e. \p max_handles of rclc_executor_init() must include it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an initialized executor
+ * \param [in] queue_size maximum number of requests not yet applied
+ * \return `RCL_RET_OK` if staging was enabled successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer or \p queue_size is 0
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ * \return `RCL_RET_ERROR` if staging is already enabled or no handle is left
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_enable_staging(
+  rclc_executor_t * executor,
+  size_t queue_size);
+
+/**
+ *  Stages the addition of a subscription, see rclc_executor_add_subscription().
+ *  The subscription and the message must stay valid until the request was applied.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an executor with staging enabled
+ * \param [in] subscription pointer to an allocated subscription
+ * \param [in] msg pointer to an allocated message
+ * \param [in] callback    function pointer to a callback
+ * \param [in] invocation  invocation type for the callback (ALWAYS or only ON_NEW_DATA)
+ * \return `RCL_RET_OK` if the request was queued
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if staging is not enabled or the queue is full
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_stage_add_subscription(
+  rclc_executor_t * executor,
+  rcl_subscription_t * subscription,
+  void * msg,
+  rclc_subscription_callback_t callback,
+  rclc_executor_handle_invocation_t invocation);
+
+/**
+ *  Stages the addition of a subscription with context,
+ *  see rclc_executor_add_subscription_with_context().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an executor with staging enabled
+ * \param [in] subscription pointer to an allocated subscription
+ * \param [in] msg pointer to an allocated message
+ * \param [in] callback    function pointer to a callback
+ * \param [in] context     type-erased ptr to additional callback context
+ * \param [in] invocation  invocation type for the callback (ALWAYS or only ON_NEW_DATA)
+ * \return `RCL_RET_OK` if the request was queued
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer (NULL context is ignored)
+ * \return `RCL_RET_ERROR` if staging is not enabled or the queue is full
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_stage_add_subscription_with_context(
+  rclc_executor_t * executor,
+  rcl_subscription_t * subscription,
+  void * msg,
+  rclc_subscription_callback_with_context_t callback,
+  void * context,
+  rclc_executor_handle_invocation_t invocation);
+
+/**
+ *  Stages the addition of a timer, see rclc_executor_add_timer().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an executor with staging enabled
+ * \param [in] timer pointer to an allocated timer
+ * \return `RCL_RET_OK` if the request was queued
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if staging is not enabled or the queue is full
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_stage_add_timer(
+  rclc_executor_t * executor,
+  rcl_timer_t * timer);
+
+/**
+ *  Stages the addition of a client, see rclc_executor_add_client().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an executor with staging enabled
+ * \param [in] client pointer to an allocated and initialized client
+ * \param [in] response_msg type-erased ptr to an allocated response message
+ * \param [in] callback    function pointer to a callback function
+ * \return `RCL_RET_OK` if the request was queued
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if staging is not enabled or the queue is full
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_stage_add_client(
+  rclc_executor_t * executor,
+  rcl_client_t * client,
+  void * response_msg,
+  rclc_client_callback_t callback);
+
+/**
+ *  Stages the addition of a service, see rclc_executor_add_service().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an executor with staging enabled
+ * \param [in] service pointer to an allocated and initialized service
+ * \param [in] request_msg type-erased ptr to an allocated request message
+ * \param [in] response_msg type-erased ptr to an allocated response message
+ * \param [in] callback    function pointer to a callback function
+ * \return `RCL_RET_OK` if the request was queued
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if staging is not enabled or the queue is full
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_stage_add_service(
+  rclc_executor_t * executor,
+  rcl_service_t * service,
+  void * request_msg,
+  void * response_msg,
+  rclc_service_callback_t callback);
+
+/**
+ *  Stages the addition of a guard condition, see rclc_executor_add_guard_condition().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an executor with staging enabled
+ * \param [in] gc pointer to an allocated and initialized guard condition
+ * \param [in] callback    function pointer to a callback function
+ * \return `RCL_RET_OK` if the request was queued
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if staging is not enabled or the queue is full
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_stage_add_guard_condition(
+  rclc_executor_t * executor,
+  rcl_guard_condition_t * gc,
+  rclc_gc_callback_t callback);
+
+/**
+ *  Stages the removal of a subscription, timer, client, service or guard condition.
+ *  The rcl object may only be finalized after the request was applied,
+ *  see rclc_executor_staging_is_idle().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an executor with staging enabled
+ * \param [in] rcl_handle pointer to the rcl object added to the executor
+ * \return `RCL_RET_OK` if the request was queued
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if staging is not enabled or the queue is full
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_stage_remove(
+  rclc_executor_t * executor,
+  const void * rcl_handle);
+
+/**
+ *  Returns true if all requests staged so far have been applied by the executor.
+ *  A thread, which staged a request and observes true afterwards, knows that its
+ *  request was applied.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param [in] executor pointer to an executor with staging enabled
+ * \return true if no staged request is pending, or staging is not enabled
+ */
+RCLC_PUBLIC
+bool
+rclc_executor_staging_is_idle(const rclc_executor_t * executor);
+
+/**
+ *  Returns the number of staged requests, which the executor could not apply, e.g.
+ *  an add request, when no handle was left, or the removal of an unknown handle.
+ *  A failed request is counted before it is reported as applied. A thread, which
+ *  reads the counter before staging a request and again after
+ *  rclc_executor_staging_is_idle() returned true, knows whether its request failed,
+ *  if no other thread stages requests at the same time.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param [in] executor pointer to an executor with staging enabled
+ * \return number of failed staged requests, 0 if staging is not enabled
+ */
+RCLC_PUBLIC
+size_t
+rclc_executor_staging_get_failed_count(const rclc_executor_t * executor);
+
+/**
+ *  Declares that the callback of the handle \p after depends on the results of the
+ *  callback of the handle \p before. With LET semantics, the executor then runs the
+ *  callbacks of one cycle in a topological order of the declared dependencies instead
+ *  of the order of the handle list: \p after is executed after \p before, if both are
+ *  in the executor. Handles without dependencies keep the order of the handle list.
+ *  The handles need not have been added yet; dependencies on removed handles are ignored.
+ *  The dependencies are not used with the semantics RCLCPP_EXECUTOR or in events mode.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param [inout] executor pointer to an initialized executor
+ * \param [in] before pointer to the rcl object (subscription, timer, etc.) of the first handle
+ * \param [in] after pointer to the rcl object of the dependent handle
+ * \return `RCL_RET_OK` if the dependency was added successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ * \return `RCL_RET_ERROR` if the dependency would create a cycle
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_add_dependency(
+  rclc_executor_t * executor,
+  const void * before,
+  const void * after);
+
+/**
+ *  Starts \p number_of_threads worker threads, which execute independent callbacks
+ *  of one LET cycle in parallel, together with the thread calling
+ *  rclc_executor_spin_some(). A callback is started once all callbacks, on which it
+ *  depends (see rclc_executor_add_dependency()), have finished. All inputs are taken
+ *  before the first callback is started, so the results do not depend on the
+ *  interleaving of independent callbacks, as long as they do not share data, which
+ *  is not declared as a dependency. While the statistics are exported or a chain
+ *  tracer is set, the callbacks are executed one after another.
+ *  The worker threads need POSIX threads.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param [inout] executor pointer to an initialized executor
+ * \param [in] number_of_threads number of worker threads
+ * \return `RCL_RET_OK` if the worker threads were started successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer or
+ *   \p number_of_threads is 0
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ * \return `RCL_RET_UNSUPPORTED` if threads are not supported on this platform
+ * \return `RCL_RET_ERROR` if the worker threads have already been started
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_enable_parallel_execution(
+  rclc_executor_t * executor,
+  size_t number_of_threads);
+
 /**
  *  Initializes an executor.
  *  It creates a dynamic array with size \p number_of_handles using the
@@ -192,6 +658,207 @@ rclc_executor_set_semantics(
   rclc_executor_t * executor,
   rclc_executor_semantics_t semantics);
 
+/**
+ *  Enable or disable the interleaved servicing of timers.
+ *
+ *  By default, the readiness of the timers is determined once per spin by rcl_wait,
+ *  so a long callback delays all timers, which come later in the order of the
+ *  handles or expire while it runs, to the next spin. With interleaving, the
+ *  executor compares the steady clock with the earliest expiration time of its
+ *  timers after each callback and executes the expired timers right away, i.e. at
+ *  the next callback boundary instead of one cycle later. A timer executed this way
+ *  is not executed again in its own turn of the same spin.
+ *
+ *  In events mode, the expired timers are popped from the timer heap after each
+ *  callback. The callbacks of the LET semantics are interleaved only if they are
+ *  executed sequentially, not with rclc_executor_enable_parallel_execution().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an initialized executor
+ * \param [in] enable true to re-check the timers between the callbacks, false to disable it
+ * \return `RCL_RET_OK` if the timer interleaving was set successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer
+ * \return `RCL_RET_ERROR` if the executor is not initialized
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_timer_interleaving(
+  rclc_executor_t * executor,
+  bool enable);
+
+/**
+ *  Enable one-shot scheduled tasks for the executor.
+ *
+ *  A scheduled task is a callback, which the executor calls once at a given time
+ *  of the steady clock, e.g. a deferred action or a timeout, without the
+ *  overhead of a rcl_timer_t in the wait_set. The tasks are kept in a min-heap
+ *  ordered by their time and the timeout of rcl_wait is shortened to the next
+ *  task, so the executor wakes up for it. Due tasks are executed at the end of
+ *  each spin, after the callbacks of the handles.
+ *
+ *  The memory for \p max_tasks tasks is allocated with the allocator of the
+ *  executor when the tasks are enabled; scheduling a task does not allocate.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an initialized executor
+ * \param [in] max_tasks maximum number of tasks, which are scheduled at the same time
+ * \return `RCL_RET_OK` if the scheduled tasks were enabled successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer or \p max_tasks is 0
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory for the tasks failed
+ * \return `RCL_RET_ERROR` if the executor is not initialized or the tasks are already enabled
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_enable_scheduled_tasks(
+  rclc_executor_t * executor,
+  size_t max_tasks);
+
+/**
+ *  Schedule \p callback to be called once with \p context by the executor at
+ *  \p steady_time (see rcutils_steady_time_now()). A task, whose time has
+ *  passed, is executed in the next spin. Tasks due at the same spin are executed
+ *  in the order of their time. A callback may schedule further tasks; a task
+ *  scheduled for the current time by a callback may be executed in the next spin.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an initialized executor with scheduled tasks enabled
+ * \param [in] steady_time time of the steady clock in nanoseconds
+ * \param [in] callback function pointer to the task
+ * \param [in] context argument of \p callback
+ * \param [out] task_id id of the task, may be NULL
+ * \return `RCL_RET_OK` if the task was scheduled successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor or \p callback is a null pointer
+ * \return `RCL_RET_ERROR` if the scheduled tasks are not enabled or all task slots are in use
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_schedule_at(
+  rclc_executor_t * executor,
+  rcutils_time_point_value_t steady_time,
+  rclc_executor_task_callback_t callback,
+  void * context,
+  rclc_executor_task_id_t * task_id);
+
+/**
+ *  Schedule \p callback to be called once with \p context by the executor
+ *  \p delay_ns nanoseconds from now. See rclc_executor_schedule_at().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an initialized executor with scheduled tasks enabled
+ * \param [in] delay_ns delay in nanoseconds
+ * \param [in] callback function pointer to the task
+ * \param [in] context argument of \p callback
+ * \param [out] task_id id of the task, may be NULL
+ * \return `RCL_RET_OK` if the task was scheduled successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor or \p callback is a null pointer
+ * \return `RCL_RET_ERROR` if the scheduled tasks are not enabled or all task slots are in use
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_schedule_after(
+  rclc_executor_t * executor,
+  int64_t delay_ns,
+  rclc_executor_task_callback_t callback,
+  void * context,
+  rclc_executor_task_id_t * task_id);
+
+/**
+ *  Cancel a scheduled task, whose callback has not been called yet.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an initialized executor with scheduled tasks enabled
+ * \param [in] task_id id returned by rclc_executor_schedule_at() or
+ *             rclc_executor_schedule_after()
+ * \return `RCL_RET_OK` if the task was cancelled successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer
+ * \return `RCL_RET_ERROR` if the scheduled tasks are not enabled or the task has
+ *         already been executed or cancelled
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_cancel_task(
+  rclc_executor_t * executor,
+  rclc_executor_task_id_t task_id);
+
+/**
+ *  Enable or disable the events mode of the executor.
+ *
+ *  In events mode, subscriptions, services and clients are not added to the wait_set.
+ *  Instead a listener callback is registered at the middleware, which puts the handle
+ *  into a lock-free event queue when new data arrives. Timers are kept in a min-heap
+ *  ordered by their expiration time. The spin-functions only dispatch the queued
+ *  handles and expired timers, so the cost per spin depends on the number of
+ *  events and not on the total number of handles.
+ *
+ *  Guard conditions, action clients and action servers have no listener API in rcl
+ *  and are still checked with rcl_wait. Subscriptions, services and clients with
+ *  invocation ALWAYS are checked with rcl_wait as well, so that their callback is
+ *  called once per spin like in the default mode. A trigger function and the LET
+ *  semantics are not applied in events mode: every event is processed as soon as
+ *  possible.
+ *
+ *  The memory for the event queue is allocated with the allocator of the executor
+ *  when the events mode is enabled. The events mode requires a middleware, which
+ *  supports listener callbacks (e.g. rmw_fastrtps_cpp or rmw_cyclonedds_cpp) and
+ *  rcl of Humble or later; with older rcl versions it cannot be enabled.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an initialized executor
+ * \param [in] enable true to enable, false to disable the events mode
+ * \return `RCL_RET_OK` if events mode was set successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ * \return `RCL_RET_UNSUPPORTED` if rcl has no listener callbacks (before Humble)
+ * \return `RCL_RET_ERROR` in an error occured
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_events_mode(
+  rclc_executor_t * executor,
+  bool enable);
+
 /**
  *  Cleans up executor.
  *  Deallocates dynamic memory of {@link rclc_executor_t.handles} and
@@ -281,6 +948,43 @@ rclc_executor_add_subscription_with_context(
   void * context,
   rclc_executor_handle_invocation_t invocation);
 
+/**
+ *  Adds a subscription to an executor, which takes each message into a buffer of
+ *  the latest-value slot \p latest_value. Other threads read the newest message
+ *  with rclc_latest_value_acquire() without blocking the executor.
+ *  If all buffers are held by readers, the message stays in the queue of the
+ *  subscription until a buffer is released.
+ * * An error is returned, if {@link rclc_executor_t.handles} array is full.
+ * * The total number_of_subscriptions field of {@link rclc_executor_t.info}
+ *   is incremented by one.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] subscription pointer to an allocated subscription
+ * \param [in] latest_value pointer to an initialized rclc_latest_value_t
+ * \param [in] callback    function pointer to a callback, which is called with the
+ *   newest message on the executor thread (can be NULL)
+ * \param [in] invocation  invocation type for the callback (ALWAYS or only ON_NEW_DATA)
+ * \return `RCL_RET_OK` if add-operation was successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer (NULL callback is ignored)
+ * \return `RCL_RET_ERROR` if any other error occured
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_add_subscription_latest_value(
+  rclc_executor_t * executor,
+  rcl_subscription_t * subscription,
+  rclc_latest_value_t * latest_value,
+  rclc_subscription_callback_t callback,
+  rclc_executor_handle_invocation_t invocation);
+
 /**
  *  Adds a timer to an executor.
  * * An error is returned, if {@link rclc_executor_t.handles} array is full.
@@ -461,7 +1165,9 @@ rclc_executor_add_action_client(
  * \param [in] ros_goal_request type-erased ptr to an allocated ROS goal request message
  * \param [in] ros_goal_request_size size of the ROS goal request message type
  * \param [in] goal_callback    function pointer to a goal request callback
- * \param [in] cancel_callback    function pointer to a cancel request callback
+ * \param [in] cancel_callback    function pointer to a cancel request callback, which
+ *             is called for each goal selected by a cancel request (by goal id, by stamp or
+ *             all goals). One response lists all goals for which it returned true.
  * \param [in] context context to pass to the callback functions
  * \return `RCL_RET_OK` if add-operation was successful
  * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
@@ -511,6 +1217,72 @@ rclc_executor_add_service_with_request_id(
   void * response_msg,
   rclc_service_callback_with_request_id_t callback);
 
+/**
+ *  Sets a response cache for a service, which has been added to the executor.
+ *  A request whose serialized representation equals a cached request is answered
+ *  with the cached response without calling the callback. Only use a cache for
+ *  services whose response depends on nothing but the request, and clear it with
+ *  rclc_service_cache_clear() or rclc_service_cache_invalidate() when the data of
+ *  the service changes.
+ *
+ *  A cached response is deserialized into the response message of the service, which
+ *  reallocates its strings and sequences with the default allocator of rosidl.
+ *  Therefore the response message must be initialized with its `__init` function;
+ *  strings and sequences in static or otherwise allocated memory must not be used.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] service pointer to a service previously added to executor
+ * \param [in] cache pointer to an initialized rclc_service_cache_t, NULL to disable the cache
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor or \p service is a null pointer
+ * \return `RCL_RET_ERROR` if \p service is not found in {@link rclc_executor_t.handles}
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_service_cache(
+  rclc_executor_t * executor,
+  const rcl_service_t * service,
+  rclc_service_cache_t * cache);
+
+/**
+ *  Sets topic statistics for a subscription, which has been added to the executor.
+ *  Each time the executor takes a message of the subscription, it updates the
+ *  inter-arrival period, the age of the message and the number of lost messages
+ *  in \p stats (see rclc/topic_statistics.h). Read \p stats in the thread spinning
+ *  the executor, e.g. in a timer callback, which also publishes them with
+ *  rclc_topic_statistics_publish().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] subscription pointer to a subscription previously added to executor
+ * \param [in] stats pointer to an initialized rclc_topic_statistics_t, NULL to disable
+ *             the statistics
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor or \p subscription is a null pointer
+ * \return `RCL_RET_ERROR` if \p subscription is not found in {@link rclc_executor_t.handles}
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_topic_statistics(
+  rclc_executor_t * executor,
+  const rcl_subscription_t * subscription,
+  rclc_topic_statistics_t * stats);
+
 /**
  *  Adds a service to an executor.
  * * An error is returned if {@link rclc_executor_t.handles} array is full.
@@ -573,6 +1345,41 @@ rclc_executor_add_guard_condition(
   rcl_guard_condition_t * gc,
   rclc_gc_callback_t callback);
 
+/**
+ *  Adds a discovery condition to an executor.
+ *  The graph guard condition of the node is added to the wait_set. Whenever the ROS graph
+ *  changes, the condition is evaluated and the \p callback is called once, as soon as the
+ *  peer (service server, action server or subscriptions) has been discovered.
+ *  The condition is also evaluated in the first spin, in case the peer has been discovered
+ *  before. Use this function instead of a fixed sleep before sending the first request.
+ * * An error is returned if {@link rclc_executor_t.handles} array is full.
+ * * The total number_of_guard_conditions field of {@link rclc_executor_t.info}
+ *   is incremented by one.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] discovery pointer to an initialized discovery condition, see {@link rclc_discovery_t}
+ * \param [in] callback    function pointer to a callback function
+ * \param [in] context     argument of the callback
+ * \return `RCL_RET_OK` if add-operation was successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if any other error occured
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_add_discovery(
+  rclc_executor_t * executor,
+  rclc_discovery_t * discovery,
+  rclc_discovery_callback_t callback,
+  void * context);
+
 
 /**
  *  Removes a subscription from an executor.
@@ -712,6 +1519,33 @@ rclc_executor_remove_guard_condition(
   rclc_executor_t * executor,
   const rcl_guard_condition_t * guard_condition);
 
+/**
+ *  Removes a discovery condition from an executor.
+ * * An error is returned if {@link rclc_executor_t.handles} array is empty.
+ * * An error is returned if discovery is not found in {@link rclc_executor_t.handles}.
+ * * The total number_of_guard_conditions field of {@link rclc_executor_t.info}
+ *   is decremented by one.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] discovery pointer to a discovery condition previously added to executor
+ * \return `RCL_RET_OK` if remove-operation was successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if any other error occured
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_remove_discovery(
+  rclc_executor_t * executor,
+  const rclc_discovery_t * discovery);
+
 /**
  *  The executor prepare function prepare the waitset of the executor if
  *  it is invalid. Does nothing if a valid waitset is already prepared.
@@ -0,0 +1,693 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__EXECUTOR_HPP_
+#define RCLC__EXECUTOR_HPP_
+
+#if __cplusplus < 201703L
+#error "rclc/executor.hpp requires C++17"
+#endif
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <rosidl_runtime_c/action_type_support_struct.h>
+#include <rosidl_runtime_c/message_type_support_struct.h>
+#include <rosidl_runtime_c/service_type_support_struct.h>
+
+#include "rclc/rclc.h"
+#include "rclc/executor.h"
+
+/*! \file executor.hpp
+    \brief Header-only C++17 layer on top of the rclc executor.
+
+    Callbacks can be lambdas with captures, member functions or any other callable.
+    They are stored with type erasure in a fixed-size buffer inside the executor,
+    i.e. registering a callback never allocates memory. The C callbacks of the
+    rclc executor dispatch to them via the callback context.
+
+    Type supports are deduced at compile time from the C message types. The
+    message, service and action types have to be registered once with
+    RCLC_DECLARE_MESSAGE_TYPE_SUPPORT, RCLC_DECLARE_SERVICE_TYPE_SUPPORT and
+    RCLC_DECLARE_ACTION_TYPE_SUPPORT at global namespace.
+*/
+
+namespace rclc
+{
+
+/// Default size of the inline storage of a callback: a lambda with four captured pointers
+constexpr std::size_t default_callback_capacity = 4 * sizeof(void *);
+
+template<typename Signature, std::size_t Capacity = default_callback_capacity>
+class InplaceFunction;
+
+/**
+ *  Move-only, type-erased callable with inline storage of \p Capacity bytes.
+ *  Callables which do not fit into the storage are rejected at compile time.
+ */
+template<typename R, typename ... Args, std::size_t Capacity>
+class InplaceFunction<R(Args...), Capacity>
+{
+public:
+  InplaceFunction() noexcept = default;
+
+  template<
+    typename F,
+    typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InplaceFunction>>>
+  InplaceFunction(F && f)  // NOLINT(runtime/explicit)
+  {
+    using Functor = std::decay_t<F>;
+    static_assert(
+      std::is_invocable_r_v<R, Functor &, Args...>,
+      "callable cannot be invoked with the arguments of the callback");
+    static_assert(
+      sizeof(Functor) <= Capacity,
+      "callable does not fit into the inline storage, increase the capacity");
+    static_assert(
+      alignof(Functor) <= alignof(std::max_align_t),
+      "callable is over-aligned");
+    static_assert(
+      std::is_nothrow_move_constructible_v<Functor>,
+      "callable must be nothrow move constructible");
+    ::new (static_cast<void *>(&storage_)) Functor(std::forward<F>(f));
+    ops_ = &ops_for<Functor>;
+  }
+
+  InplaceFunction(InplaceFunction && other) noexcept
+  {
+    move_from(other);
+  }
+
+  InplaceFunction & operator=(InplaceFunction && other) noexcept
+  {
+    if (this != &other) {
+      reset();
+      move_from(other);
+    }
+    return *this;
+  }
+
+  InplaceFunction(const InplaceFunction &) = delete;
+  InplaceFunction & operator=(const InplaceFunction &) = delete;
+
+  ~InplaceFunction()
+  {
+    reset();
+  }
+
+  void reset() noexcept
+  {
+    if (nullptr != ops_) {
+      ops_->destroy(&storage_);
+      ops_ = nullptr;
+    }
+  }
+
+  explicit operator bool() const noexcept
+  {
+    return nullptr != ops_;
+  }
+
+  R operator()(Args... args)
+  {
+    return ops_->invoke(&storage_, std::forward<Args>(args)...);
+  }
+
+private:
+  struct Ops
+  {
+    R (* invoke)(void * storage, Args && ... args);
+    void (* move)(void * dst, void * src) noexcept;
+    void (* destroy)(void * storage) noexcept;
+  };
+
+  template<typename Functor>
+  static R invoke(void * storage, Args && ... args)
+  {
+    return std::invoke(*static_cast<Functor *>(storage), std::forward<Args>(args)...);
+  }
+
+  template<typename Functor>
+  static void move(void * dst, void * src) noexcept
+  {
+    ::new (dst) Functor(std::move(*static_cast<Functor *>(src)));
+    static_cast<Functor *>(src)->~Functor();
+  }
+
+  template<typename Functor>
+  static void destroy(void * storage) noexcept
+  {
+    static_cast<Functor *>(storage)->~Functor();
+  }
+
+  template<typename Functor>
+  static constexpr Ops ops_for = {&invoke<Functor>, &move<Functor>, &destroy<Functor>};
+
+  void move_from(InplaceFunction & other) noexcept
+  {
+    if (nullptr != other.ops_) {
+      other.ops_->move(&storage_, &other.storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  alignas(std::max_align_t) unsigned char storage_[Capacity];
+  const Ops * ops_ = nullptr;
+};
+
+/// Type support of a message type, see RCLC_DECLARE_MESSAGE_TYPE_SUPPORT
+template<typename MessageT>
+struct message_type_support;
+
+/// Type support of a service, keyed by its request type, see RCLC_DECLARE_SERVICE_TYPE_SUPPORT
+template<typename RequestT>
+struct service_type_support;
+
+/// Type support of an action, keyed by its SendGoal request type,
+/// see RCLC_DECLARE_ACTION_TYPE_SUPPORT
+template<typename SendGoalRequestT>
+struct action_type_support;
+
+}  // namespace rclc
+
+/// Registers the type support of a message, e.g. (std_msgs, msg, Int32)
+#define RCLC_DECLARE_MESSAGE_TYPE_SUPPORT(PKG, SUBFOLDER, NAME) \
+  namespace rclc \
+  { \
+  template<> \
+  struct message_type_support<PKG ## __ ## SUBFOLDER ## __ ## NAME> \
+  { \
+    static const rosidl_message_type_support_t * get() \
+    { \
+      return ROSIDL_GET_MSG_TYPE_SUPPORT(PKG, SUBFOLDER, NAME); \
+    } \
+  }; \
+  }
+
+/// Registers the type support of a service, e.g. (example_interfaces, AddTwoInts)
+#define RCLC_DECLARE_SERVICE_TYPE_SUPPORT(PKG, NAME) \
+  namespace rclc \
+  { \
+  template<> \
+  struct service_type_support<PKG ## __srv__ ## NAME ## _Request> \
+  { \
+    static const rosidl_service_type_support_t * get() \
+    { \
+      return ROSIDL_GET_SRV_TYPE_SUPPORT(PKG, srv, NAME); \
+    } \
+  }; \
+  }
+
+/// Registers the type support of an action, e.g. (example_interfaces, Fibonacci)
+#define RCLC_DECLARE_ACTION_TYPE_SUPPORT(PKG, NAME) \
+  namespace rclc \
+  { \
+  template<> \
+  struct action_type_support<PKG ## __action__ ## NAME ## _SendGoal_Request> \
+  { \
+    static const rosidl_action_type_support_t * get() \
+    { \
+      return ROSIDL_GET_ACTION_TYPE_SUPPORT(PKG, NAME); \
+    } \
+  }; \
+  }
+
+namespace rclc
+{
+
+template<typename MessageT>
+rcl_ret_t publisher_init_default(
+  rcl_publisher_t * publisher, const rcl_node_t * node, const char * topic_name)
+{
+  return rclc_publisher_init_default(
+    publisher, node, message_type_support<MessageT>::get(), topic_name);
+}
+
+template<typename MessageT>
+rcl_ret_t subscription_init_default(
+  rcl_subscription_t * subscription, rcl_node_t * node, const char * topic_name)
+{
+  return rclc_subscription_init_default(
+    subscription, node, message_type_support<MessageT>::get(), topic_name);
+}
+
+template<typename RequestT>
+rcl_ret_t service_init_default(
+  rcl_service_t * service, const rcl_node_t * node, const char * service_name)
+{
+  return rclc_service_init_default(
+    service, node, service_type_support<RequestT>::get(), service_name);
+}
+
+template<typename RequestT>
+rcl_ret_t client_init_default(
+  rcl_client_t * client, const rcl_node_t * node, const char * service_name)
+{
+  return rclc_client_init_default(
+    client, node, service_type_support<RequestT>::get(), service_name);
+}
+
+template<typename SendGoalRequestT>
+rcl_ret_t action_server_init_default(
+  rclc_action_server_t * action_server, rcl_node_t * node, rclc_support_t * support,
+  const char * action_name)
+{
+  return rclc_action_server_init_default(
+    action_server, node, support, action_type_support<SendGoalRequestT>::get(), action_name);
+}
+
+template<typename SendGoalRequestT>
+rcl_ret_t action_client_init_default(
+  rclc_action_client_t * action_client, rcl_node_t * node, const char * action_name)
+{
+  return rclc_action_client_init_default(
+    action_client, node, action_type_support<SendGoalRequestT>::get(), action_name);
+}
+
+/**
+ *  Timer with a capture-capable callback. The rcl timer is the first member, so
+ *  that the C callback of the timer can find its Timer object without a global lookup.
+ *  The callback is invocable either without arguments or with (rcl_timer_t *, int64_t).
+ *  A Timer must not be moved after init().
+ */
+template<std::size_t Capacity = default_callback_capacity>
+class Timer
+{
+public:
+  Timer()
+  : timer_(rcl_get_zero_initialized_timer()) {}
+
+  Timer(const Timer &) = delete;
+  Timer & operator=(const Timer &) = delete;
+
+  template<typename F>
+  rcl_ret_t init(rclc_support_t * support, uint64_t timeout_ns, F && callback)
+  {
+    if constexpr (std::is_invocable_v<std::decay_t<F> &>) {
+      callback_ = [f = std::forward<F>(callback)](rcl_timer_t *, int64_t) mutable {f();};
+    } else {
+      callback_ = std::forward<F>(callback);
+    }
+    return rclc_timer_init_default(&timer_, support, timeout_ns, &Timer::dispatch);
+  }
+
+  rcl_ret_t fini()
+  {
+    return rcl_timer_fini(&timer_);
+  }
+
+  rcl_timer_t * get()
+  {
+    return &timer_;
+  }
+
+private:
+  static void dispatch(rcl_timer_t * timer, int64_t last_call_time)
+  {
+    static_assert(std::is_standard_layout_v<Timer>, "rcl timer must be the first member");
+    Timer * self = reinterpret_cast<Timer *>(timer);
+    if (self->callback_) {
+      self->callback_(timer, last_call_time);
+    }
+  }
+
+  rcl_timer_t timer_;
+  InplaceFunction<void(rcl_timer_t *, int64_t), Capacity> callback_;
+};
+
+/**
+ *  Executor with capture-capable callbacks for at most \p MaxHandles handles.
+ *  The callbacks are stored inline, each one in at most \p Capacity bytes.
+ *  An Executor must not be moved, because the rclc executor keeps pointers to the
+ *  stored callbacks.
+ */
+template<std::size_t MaxHandles, std::size_t Capacity = default_callback_capacity>
+class Executor
+{
+public:
+  Executor()
+  : executor_(rclc_executor_get_zero_initialized_executor()) {}
+
+  Executor(const Executor &) = delete;
+  Executor & operator=(const Executor &) = delete;
+
+  ~Executor()
+  {
+    fini();
+  }
+
+  rcl_ret_t init(rcl_context_t * context, const rcl_allocator_t * allocator)
+  {
+    return rclc_executor_init(&executor_, context, MaxHandles, allocator);
+  }
+
+  rcl_ret_t fini()
+  {
+    for (auto & slot : slots_) {
+      slot = Slot();
+    }
+    if (nullptr == executor_.handles) {
+      return RCL_RET_OK;
+    }
+    return rclc_executor_fini(&executor_);
+  }
+
+  /// The underlying rclc executor, e.g. to configure the semantics or a trigger.
+  rclc_executor_t * get()
+  {
+    return &executor_;
+  }
+
+  /**
+   *  Adds a subscription. The callback is invocable with `const MessageT &`,
+   *  or with `const MessageT *`, which is nullptr if \p invocation is ALWAYS
+   *  and no new message is available.
+   */
+  template<typename MessageT, typename F>
+  rcl_ret_t add_subscription(
+    rcl_subscription_t * subscription, MessageT * msg, F && callback,
+    rclc_executor_handle_invocation_t invocation = ON_NEW_DATA)
+  {
+    Slot * slot = free_slot();
+    if (nullptr == slot) {
+      return RCL_RET_ERROR;
+    }
+    slot->entity = subscription;
+    slot->callbacks.template emplace<SubscriptionCallbacks>().callback =
+      [f = std::forward<F>(callback)](const void * msgin) mutable {
+        const MessageT * msg = static_cast<const MessageT *>(msgin);
+        if constexpr (std::is_invocable_v<std::decay_t<F> &, const MessageT &>) {
+          if (nullptr != msg) {
+            std::invoke(f, *msg);
+          }
+        } else {
+          std::invoke(f, msg);
+        }
+      };
+    return check_added(
+      slot, rclc_executor_add_subscription_with_context(
+        &executor_, subscription, msg, &Executor::dispatch_subscription, slot, invocation));
+  }
+
+  /// Adds a subscription with a member function of \p object as callback.
+  template<typename MessageT, typename T, typename Method>
+  rcl_ret_t add_subscription(
+    rcl_subscription_t * subscription, MessageT * msg, T * object, Method method,
+    rclc_executor_handle_invocation_t invocation = ON_NEW_DATA)
+  {
+    return add_subscription(
+      subscription, msg,
+      [object, method](const MessageT & m) {(object->*method)(m);}, invocation);
+  }
+
+  rcl_ret_t remove_subscription(const rcl_subscription_t * subscription)
+  {
+    return check_removed(
+      subscription, rclc_executor_remove_subscription(&executor_, subscription));
+  }
+
+  template<std::size_t TimerCapacity>
+  rcl_ret_t add_timer(Timer<TimerCapacity> & timer)
+  {
+    return rclc_executor_add_timer(&executor_, timer.get());
+  }
+
+  template<std::size_t TimerCapacity>
+  rcl_ret_t remove_timer(Timer<TimerCapacity> & timer)
+  {
+    return rclc_executor_remove_timer(&executor_, timer.get());
+  }
+
+  /// Adds a service. The callback is invocable with `(const RequestT &, ResponseT &)`.
+  template<typename RequestT, typename ResponseT, typename F>
+  rcl_ret_t add_service(
+    rcl_service_t * service, RequestT * request, ResponseT * response, F && callback)
+  {
+    Slot * slot = free_slot();
+    if (nullptr == slot) {
+      return RCL_RET_ERROR;
+    }
+    slot->entity = service;
+    slot->callbacks.template emplace<ServiceCallbacks>().callback =
+      [f = std::forward<F>(callback)](const void * req, void * res) mutable {
+        std::invoke(f, *static_cast<const RequestT *>(req), *static_cast<ResponseT *>(res));
+      };
+    return check_added(
+      slot, rclc_executor_add_service_with_context(
+        &executor_, service, request, response, &Executor::dispatch_service, slot));
+  }
+
+  /// Adds a service with a member function of \p object as callback.
+  template<typename RequestT, typename ResponseT, typename T, typename Method>
+  rcl_ret_t add_service(
+    rcl_service_t * service, RequestT * request, ResponseT * response, T * object,
+    Method method)
+  {
+    return add_service(
+      service, request, response,
+      [object, method](const RequestT & req, ResponseT & res) {(object->*method)(req, res);});
+  }
+
+  rcl_ret_t remove_service(const rcl_service_t * service)
+  {
+    return check_removed(service, rclc_executor_remove_service(&executor_, service));
+  }
+
+  /**
+   *  Adds an action server with one goal handle per element of \p goal_requests.
+   *  The goal callback is invocable with `(rclc_action_goal_handle_t *)` and returns
+   *  an rcl_ret_t (RCL_RET_ACTION_GOAL_ACCEPTED or RCL_RET_ACTION_GOAL_REJECTED),
+   *  the cancel callback returns bool.
+   */
+  template<typename SendGoalRequestT, std::size_t N, typename GoalF, typename CancelF>
+  rcl_ret_t add_action_server(
+    rclc_action_server_t * action_server, SendGoalRequestT (& goal_requests)[N],
+    GoalF && goal_callback, CancelF && cancel_callback)
+  {
+    Slot * slot = free_slot();
+    if (nullptr == slot) {
+      return RCL_RET_ERROR;
+    }
+    slot->entity = action_server;
+    auto & callbacks = slot->callbacks.template emplace<ActionServerCallbacks>();
+    callbacks.goal = std::forward<GoalF>(goal_callback);
+    callbacks.cancel = std::forward<CancelF>(cancel_callback);
+    return check_added(
+      slot, rclc_executor_add_action_server(
+        &executor_, action_server, N, goal_requests, sizeof(SendGoalRequestT),
+        &Executor::dispatch_action_server_goal, &Executor::dispatch_action_server_cancel,
+        slot));
+  }
+
+  /**
+   *  Adds an action client with \p handles_number goal handles.
+   *  The callbacks are invocable with
+   *  - goal: `(rclc_action_goal_handle_t *, bool accepted)`
+   *  - feedback: `(rclc_action_goal_handle_t *, const FeedbackMessageT &)`
+   *  - result: `(rclc_action_goal_handle_t *, const ResultResponseT &)`
+   *  - cancel: `(rclc_action_goal_handle_t *, bool cancelled)`
+   *
+   *  The feedback and the cancel callback are optional and can be nullptr.
+   */
+  template<
+    typename ResultResponseT, typename FeedbackMessageT,
+    typename GoalF, typename FeedbackF, typename ResultF, typename CancelF>
+  rcl_ret_t add_action_client(
+    rclc_action_client_t * action_client, std::size_t handles_number,
+    ResultResponseT * result_response, FeedbackMessageT * feedback,
+    GoalF && goal_callback, FeedbackF && feedback_callback,
+    ResultF && result_callback, CancelF && cancel_callback)
+  {
+    Slot * slot = free_slot();
+    if (nullptr == slot) {
+      return RCL_RET_ERROR;
+    }
+    slot->entity = action_client;
+    auto & callbacks = slot->callbacks.template emplace<ActionClientCallbacks>();
+    callbacks.goal = std::forward<GoalF>(goal_callback);
+    callbacks.result =
+      [f = std::forward<ResultF>(result_callback)](
+      rclc_action_goal_handle_t * goal_handle, void * result) mutable {
+        std::invoke(f, goal_handle, *static_cast<const ResultResponseT *>(result));
+      };
+    rclc_action_client_feedback_callback_t feedback_dispatcher = nullptr;
+    if constexpr (!std::is_null_pointer_v<std::decay_t<FeedbackF>>) {
+      callbacks.feedback =
+        [f = std::forward<FeedbackF>(feedback_callback)](
+        rclc_action_goal_handle_t * goal_handle, void * msg) mutable {
+          std::invoke(f, goal_handle, *static_cast<const FeedbackMessageT *>(msg));
+        };
+      feedback_dispatcher = &Executor::dispatch_action_client_feedback;
+    }
+    rclc_action_client_cancel_callback_t cancel_dispatcher = nullptr;
+    if constexpr (!std::is_null_pointer_v<std::decay_t<CancelF>>) {
+      callbacks.cancel = std::forward<CancelF>(cancel_callback);
+      cancel_dispatcher = &Executor::dispatch_action_client_cancel;
+    }
+    return check_added(
+      slot, rclc_executor_add_action_client(
+        &executor_, action_client, handles_number, result_response,
+        std::is_null_pointer_v<std::decay_t<FeedbackF>>? nullptr : feedback,
+        &Executor::dispatch_action_client_goal, feedback_dispatcher,
+        &Executor::dispatch_action_client_result, cancel_dispatcher, slot));
+  }
+
+  rcl_ret_t prepare()
+  {
+    return rclc_executor_prepare(&executor_);
+  }
+
+  rcl_ret_t spin_some(uint64_t timeout_ns)
+  {
+    return rclc_executor_spin_some(&executor_, timeout_ns);
+  }
+
+  rcl_ret_t spin_period(uint64_t period_ns)
+  {
+    return rclc_executor_spin_period(&executor_, period_ns);
+  }
+
+  rcl_ret_t spin()
+  {
+    return rclc_executor_spin(&executor_);
+  }
+
+private:
+  struct SubscriptionCallbacks
+  {
+    InplaceFunction<void(const void *), Capacity> callback;
+  };
+
+  struct ServiceCallbacks
+  {
+    InplaceFunction<void(const void *, void *), Capacity> callback;
+  };
+
+  struct ActionServerCallbacks
+  {
+    InplaceFunction<rcl_ret_t(rclc_action_goal_handle_t *), Capacity> goal;
+    InplaceFunction<bool(rclc_action_goal_handle_t *), Capacity> cancel;
+  };
+
+  struct ActionClientCallbacks
+  {
+    InplaceFunction<void(rclc_action_goal_handle_t *, bool), Capacity> goal;
+    InplaceFunction<void(rclc_action_goal_handle_t *, void *), Capacity> feedback;
+    InplaceFunction<void(rclc_action_goal_handle_t *, void *), Capacity> result;
+    InplaceFunction<void(rclc_action_goal_handle_t *, bool), Capacity> cancel;
+  };
+
+  struct Slot
+  {
+    const void * entity = nullptr;
+    std::variant<
+      std::monostate, SubscriptionCallbacks, ServiceCallbacks,
+      ActionServerCallbacks, ActionClientCallbacks> callbacks;
+  };
+
+  Slot * free_slot()
+  {
+    for (auto & slot : slots_) {
+      if (nullptr == slot.entity) {
+        return &slot;
+      }
+    }
+    return nullptr;
+  }
+
+  static rcl_ret_t check_added(Slot * slot, rcl_ret_t rc)
+  {
+    if (RCL_RET_OK != rc) {
+      *slot = Slot();
+    }
+    return rc;
+  }
+
+  rcl_ret_t check_removed(const void * entity, rcl_ret_t rc)
+  {
+    if (RCL_RET_OK == rc) {
+      for (auto & slot : slots_) {
+        if (entity == slot.entity) {
+          slot = Slot();
+        }
+      }
+    }
+    return rc;
+  }
+
+  template<typename Callbacks>
+  static Callbacks & callbacks_of(void * context)
+  {
+    return *std::get_if<Callbacks>(&static_cast<Slot *>(context)->callbacks);
+  }
+
+  static void dispatch_subscription(const void * msg, void * context)
+  {
+    callbacks_of<SubscriptionCallbacks>(context).callback(msg);
+  }
+
+  static void dispatch_service(const void * request, void * response, void * context)
+  {
+    callbacks_of<ServiceCallbacks>(context).callback(request, response);
+  }
+
+  static rcl_ret_t dispatch_action_server_goal(
+    rclc_action_goal_handle_t * goal_handle, void * context)
+  {
+    return callbacks_of<ActionServerCallbacks>(context).goal(goal_handle);
+  }
+
+  static bool dispatch_action_server_cancel(
+    rclc_action_goal_handle_t * goal_handle, void * context)
+  {
+    return callbacks_of<ActionServerCallbacks>(context).cancel(goal_handle);
+  }
+
+  static void dispatch_action_client_goal(
+    rclc_action_goal_handle_t * goal_handle, bool accepted, void * context)
+  {
+    callbacks_of<ActionClientCallbacks>(context).goal(goal_handle, accepted);
+  }
+
+  static void dispatch_action_client_feedback(
+    rclc_action_goal_handle_t * goal_handle, void * feedback, void * context)
+  {
+    callbacks_of<ActionClientCallbacks>(context).feedback(goal_handle, feedback);
+  }
+
+  static void dispatch_action_client_result(
+    rclc_action_goal_handle_t * goal_handle, void * result, void * context)
+  {
+    callbacks_of<ActionClientCallbacks>(context).result(goal_handle, result);
+  }
+
+  static void dispatch_action_client_cancel(
+    rclc_action_goal_handle_t * goal_handle, bool cancelled, void * context)
+  {
+    callbacks_of<ActionClientCallbacks>(context).cancel(goal_handle, cancelled);
+  }
+
+  rclc_executor_t executor_;
+  std::array<Slot, MaxHandles> slots_;
+};
+
+}  // namespace rclc
+
+#endif  // RCLC__EXECUTOR_HPP_
@@ -26,6 +26,10 @@ extern "C"
 
 #include <rclc/action_client.h>
 #include <rclc/action_server.h>
+#include <rclc/discovery.h>
+#include <rclc/latest_value.h>
+#include <rclc/service_cache.h>
+#include <rclc/topic_statistics.h>
 
 /// TODO (jst3si) Where is this defined? - in my build environment this variable is not set.
 // #define ROS_PACKAGE_NAME "rclc"
@@ -47,6 +51,8 @@ typedef enum
   RCLC_ACTION_SERVER,
   RCLC_GUARD_CONDITION,
   // RCLC_GUARD_CONDITION_WITH_CONTEXT,  //TODO
+  RCLC_DISCOVERY,
+  RCLC_SUBSCRIPTION_LATEST_VALUE,
   RCLC_NONE
 } rclc_executor_handle_type_t;
 
@@ -117,9 +123,11 @@ typedef struct
     rcl_guard_condition_t * gc;
     rclc_action_client_t * action_client;
     rclc_action_server_t * action_server;
+    rclc_discovery_t * discovery;
   };
   /// Storage of data, which holds the message of a subscription, service, etc.
   /// subscription: ptr to message
+  /// subscription with latest value: ptr to rclc_latest_value_t
   /// service: ptr to request message
   void * data;
 
@@ -132,6 +140,12 @@ typedef struct
   /// ptr to additional callback context
   void * callback_context;
 
+  /// only for service - ptr to the response cache (NULL: no cache)
+  rclc_service_cache_t * service_cache;
+
+  /// only for subscription - ptr to the topic statistics (NULL: no statistics)
+  rclc_topic_statistics_t * topic_statistics;
+
   // TODO(jst3si) new type to be stored as data for
   //              service/client objects
   //              look at memory allocation for this struct!
@@ -0,0 +1,269 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__EXECUTOR_STATS_H_
+#define RCLC__EXECUTOR_STATS_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <rcl/rcl.h>
+#include <rclc/visibility_control.h>
+
+/*! \file executor_stats.h
+    \brief Layout of the shared-memory segment, to which an executor exports its
+    statistics (see rclc_executor_set_stats_export()), and functions to read it
+    from another process.
+
+    The segment is named `/rclc_stats.<pid>.<name>`. It starts with a
+    rclc_executor_stats_segment_t, followed by `max_handles` records of type
+    rclc_executor_stats_handle_t. The executor is the single writer. Each record
+    is protected by a sequence lock: the sequence number is odd while the record
+    is written, so a reader copies the record and retries if the sequence number
+    was odd or has changed. The executor never waits for a reader. A reader gives
+    up after #RCLC_EXECUTOR_STATS_READ_ATTEMPTS attempts, e.g. if the executor
+    died while writing a record, and reports the segment as stale.
+*/
+
+/// Prefix of the names of all statistics segments
+#define RCLC_EXECUTOR_STATS_SEGMENT_PREFIX "rclc_stats."
+/// Value of rclc_executor_stats_segment_t.magic of an initialized segment
+#define RCLC_EXECUTOR_STATS_MAGIC 0x54415453434c4352ULL
+/// Version of the layout
+#define RCLC_EXECUTOR_STATS_VERSION 2
+/// Size of the names in the segment, including the terminating '\0'
+#define RCLC_EXECUTOR_STATS_NAME_SIZE 64
+/// Number of buckets of the callback time histogram. Bucket 0 counts callbacks
+/// shorter than 1ns, bucket k > 0 callbacks in [2^(k-1), 2^k) ns. The last
+/// bucket also counts all longer callbacks.
+#define RCLC_EXECUTOR_STATS_HISTOGRAM_SIZE 40
+/// Number of attempts to read a consistent snapshot, before a reader reports the
+/// segment as stale, e.g. because the executor died while updating it
+#define RCLC_EXECUTOR_STATS_READ_ATTEMPTS 1000
+
+/// Bits of rclc_executor_stats_segment_t.counters, set for each counter, which
+/// is sampled around the callbacks (see rclc_executor_enable_stats_counters())
+#define RCLC_EXECUTOR_STATS_COUNTER_CYCLES (1u << 0)
+#define RCLC_EXECUTOR_STATS_COUNTER_INSTRUCTIONS (1u << 1)
+#define RCLC_EXECUTOR_STATS_COUNTER_CACHE_MISSES (1u << 2)
+#define RCLC_EXECUTOR_STATS_COUNTER_CONTEXT_SWITCHES (1u << 3)
+
+/// Statistics of one handle of the executor
+typedef struct
+{
+  /// Sequence lock of this record
+  uint64_t sequence;
+  /// Type of the handle, see rclc_executor_handle_type_t
+  uint32_t type;
+  /// Reserved, 0
+  uint32_t reserved;
+  /// Address of the rcl object of the handle, identifies the handle across updates
+  uint64_t id;
+  /// Topic, service or action name of the handle
+  char name[RCLC_EXECUTOR_STATS_NAME_SIZE];
+  /// Number of callback invocations
+  uint64_t invocations;
+  /// Number of failed takes of new data
+  uint64_t take_failures;
+  /// Total time spent in the callback in nanoseconds
+  uint64_t callback_time_ns;
+  /// Longest callback time in nanoseconds
+  uint64_t callback_time_max_ns;
+  /// Histogram of the callback times
+  uint64_t callback_time_histogram[RCLC_EXECUTOR_STATS_HISTOGRAM_SIZE];
+  /// Total CPU cycles in the callbacks, 0 unless RCLC_EXECUTOR_STATS_COUNTER_CYCLES
+  uint64_t cycles;
+  /// Total retired instructions in the callbacks
+  uint64_t instructions;
+  /// Total last-level cache misses in the callbacks
+  uint64_t cache_misses;
+  /// Total context switches during the callbacks
+  uint64_t context_switches;
+} rclc_executor_stats_handle_t;
+
+/// Header of the statistics segment of an executor
+typedef struct
+{
+  /// RCLC_EXECUTOR_STATS_MAGIC, written last when the segment is initialized
+  uint64_t magic;
+  /// RCLC_EXECUTOR_STATS_VERSION
+  uint32_t version;
+  /// Process id of the executor
+  int32_t pid;
+  /// Name of the executor
+  char name[RCLC_EXECUTOR_STATS_NAME_SIZE];
+  /// Number of handle records following the header
+  uint64_t max_handles;
+  /// Sequence lock of the following fields
+  uint64_t sequence;
+  /// Number of handles of the executor
+  uint64_t number_of_handles;
+  /// Number of spin_some iterations
+  uint64_t spins;
+  /// Total time in rcl_wait in nanoseconds
+  uint64_t wait_time_ns;
+  /// Total time taking new data in nanoseconds
+  uint64_t take_time_ns;
+  /// Total time executing callbacks in nanoseconds
+  uint64_t execute_time_ns;
+  /// Steady time of the last update in nanoseconds
+  uint64_t timestamp_ns;
+  /// RCLC_EXECUTOR_STATS_COUNTER_* bits of the sampled counters, 0 if only the
+  /// callback times are measured
+  uint64_t counters;
+} rclc_executor_stats_segment_t;
+
+/// Read-only mapping of the statistics segment of an executor
+typedef struct
+{
+  /// Mapped segment
+  const rclc_executor_stats_segment_t * segment;
+  /// Size of the mapping in bytes
+  size_t size;
+} rclc_executor_stats_view_t;
+
+/**
+ *  Return a rclc_executor_stats_view_t struct with pointer members initialized to `NULL`
+ *  and member variables to 0.
+ */
+RCLC_PUBLIC
+rclc_executor_stats_view_t
+rclc_executor_stats_view_get_zero_initialized(void);
+
+/**
+ *  Maps the statistics segment \p segment_name read-only, e.g. `rclc_stats.1234.control`.
+ *  This does neither send ROS messages nor interfere with the executor.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] view pointer to a zero initialized rclc_executor_stats_view_t
+ * \param[in] segment_name name of the segment, with or without leading '/'
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if the segment does not exist or is not initialized
+ * \return `RCL_RET_UNSUPPORTED` if the platform has no POSIX shared memory
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_stats_attach(
+  rclc_executor_stats_view_t * view,
+  const char * segment_name);
+
+/**
+ *  Unmaps the statistics segment.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] view pointer to an attached rclc_executor_stats_view_t
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p view is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_stats_detach(rclc_executor_stats_view_t * view);
+
+/**
+ *  Copies a consistent snapshot of the header of the segment.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] view pointer to an attached rclc_executor_stats_view_t
+ * \param[out] segment snapshot of the header
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or \p view is not attached
+ * \return `RCL_RET_TIMEOUT` if no consistent snapshot was read within
+ *   #RCLC_EXECUTOR_STATS_READ_ATTEMPTS attempts, i.e. the segment is stale
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_stats_read_segment(
+  const rclc_executor_stats_view_t * view,
+  rclc_executor_stats_segment_t * segment);
+
+/**
+ *  Copies a consistent snapshot of the statistics of the handle with \p index.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] view pointer to an attached rclc_executor_stats_view_t
+ * \param[in] index index of the handle, smaller than rclc_executor_stats_segment_t.max_handles
+ * \param[out] handle snapshot of the handle statistics
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or \p index is too large
+ * \return `RCL_RET_TIMEOUT` if no consistent snapshot was read within
+ *   #RCLC_EXECUTOR_STATS_READ_ATTEMPTS attempts, i.e. the record is stale
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_stats_read_handle(
+  const rclc_executor_stats_view_t * view,
+  size_t index,
+  rclc_executor_stats_handle_t * handle);
+
+/**
+ *  Returns an upper bound of the \p percentile (0.0 - 1.0) of the callback time
+ *  of \p handle in nanoseconds. The resolution is a power of two.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] handle snapshot of the handle statistics
+ * \param[in] percentile percentile between 0.0 and 1.0
+ * \return percentile in nanoseconds, 0 if \p handle is NULL or has no invocations
+ */
+RCLC_PUBLIC
+uint64_t
+rclc_executor_stats_percentile(
+  const rclc_executor_stats_handle_t * handle,
+  double percentile);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__EXECUTOR_STATS_H_
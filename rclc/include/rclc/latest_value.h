@@ -0,0 +1,182 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__LATEST_VALUE_H_
+#define RCLC__LATEST_VALUE_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#include <rcl/rcl.h>
+#include <rclc/visibility_control.h>
+
+/// Minimum number of buffers of a rclc_latest_value_t
+#define RCLC_LATEST_VALUE_MIN_BUFFERS 3
+
+/// Message buffer of a rclc_latest_value_t
+typedef struct
+{
+  /// Pointer to the preallocated message
+  void * msg;
+  /// Sequence number of the message, the first received message has the number 1
+  uint64_t sequence_number;
+  /// Number of readers which hold the buffer, accessed with atomic operations
+  uintptr_t readers;
+} rclc_latest_value_buffer_t;
+
+/// Latest-value slot of a subscription. The executor takes each message into a
+/// buffer, which is neither the newest one nor held by a reader, and then publishes
+/// it as the newest message. Any number of threads can read the newest message
+/// concurrently without a lock and without copying it. If all buffers are in use,
+/// the executor takes the message in serialized form and drops it.
+typedef struct
+{
+  /// Message buffers
+  rclc_latest_value_buffer_t * buffers;
+  /// Number of message buffers
+  size_t number_of_buffers;
+  /// Index + 1 of the newest buffer, 0 if no message was received yet.
+  /// Accessed with atomic operations.
+  uintptr_t latest;
+  /// Number of received messages, only written by the executor
+  uint64_t sequence_number;
+  /// Number of dropped messages, only written by the executor
+  uint64_t dropped;
+  /// Serialized message into which dropped messages are taken
+  rcl_serialized_message_t dropped_msg;
+  /// Allocator of the buffers array and the serialized message
+  rcl_allocator_t allocator;
+} rclc_latest_value_t;
+
+/**
+ *  Return a rclc_latest_value_t struct with pointer members initialized to `NULL`
+ *  and member variables to 0.
+ */
+RCLC_PUBLIC
+rclc_latest_value_t
+rclc_latest_value_get_zero_initialized(void);
+
+/**
+ *  Initializes a latest-value slot with the preallocated messages \p msgs.
+ *  The messages must be initialized for the message type of the subscription.
+ *  While k readers hold a message, the executor needs k + 2 buffers to take
+ *  the next message: with three buffers one reader at a time never loses
+ *  a message. Otherwise the executor takes the message in serialized form,
+ *  drops it and counts it in {@link rclc_latest_value_t.dropped}, so that
+ *  the subscription does not stay ready and the executor does not spin on it.
+ *  The sequence number still advances, so readers can detect the gap.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] latest_value pointer to a zero initialized rclc_latest_value_t
+ * \param[in] msgs array of pointers to preallocated messages
+ * \param[in] number_of_msgs number of messages, at least RCLC_LATEST_VALUE_MIN_BUFFERS
+ * \param[in] allocator allocator for the array of buffers
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ *   or \p number_of_msgs is too small
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_latest_value_init(
+  rclc_latest_value_t * latest_value,
+  void ** msgs,
+  size_t number_of_msgs,
+  const rcl_allocator_t * allocator);
+
+/**
+ *  Deallocates the buffers and the serialized message of a latest-value slot.
+ *  The messages are not finalized. The subscription must have been removed from
+ *  the executor and all readers must have released their messages.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] latest_value pointer to an initialized rclc_latest_value_t
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p latest_value is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_latest_value_fini(rclc_latest_value_t * latest_value);
+
+/**
+ *  Returns the newest message and holds it until rclc_latest_value_release()
+ *  is called. The message is not modified by the executor while it is held.
+ *  Can be called from any thread; readers neither block each other nor the executor.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] latest_value pointer to an initialized rclc_latest_value_t
+ * \param[out] sequence_number sequence number of the message (can be NULL)
+ * \return pointer to the newest message
+ * \return `NULL` if no message was received yet or \p latest_value is a null pointer
+ */
+RCLC_PUBLIC
+const void *
+rclc_latest_value_acquire(
+  rclc_latest_value_t * latest_value,
+  uint64_t * sequence_number);
+
+/**
+ *  Releases a message returned by rclc_latest_value_acquire(), so that the
+ *  executor can take new messages into its buffer.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] latest_value pointer to an initialized rclc_latest_value_t
+ * \param[in] msg pointer returned by rclc_latest_value_acquire()
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ *   or \p msg is not a buffer of \p latest_value
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_latest_value_release(
+  rclc_latest_value_t * latest_value,
+  const void * msg);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__LATEST_VALUE_H_
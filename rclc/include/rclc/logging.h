@@ -0,0 +1,234 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__LOGGING_H_
+#define RCLC__LOGGING_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <rcl/allocator.h>
+#include <rcl/types.h>
+#include <rcutils/logging.h>
+#include <rcutils/logging_macros.h>
+#include <rclc/visibility_control.h>
+
+/*! \file logging.h
+    \brief Logging macros of rclc with a compile-time severity ceiling and an
+    optional asynchronous log sink.
+
+    Log statements below RCLC_LOG_MIN_SEVERITY are removed by the pre-processor,
+    i.e. neither the arguments nor the severity of the logger are evaluated.
+    The ceiling is configured with the CMake variable RCLC_LOG_MIN_SEVERITY
+    (DEBUG, INFO, WARN, ERROR, FATAL or NONE) of rclc. It is exported with the
+    rclc target and applies to all code, which includes this header; the default
+    DEBUG removes nothing.
+
+    If the asynchronous sink is initialized with rclc_logging_async_init(), the
+    log statements only copy the format string and the arguments into a lock-free
+    ring buffer. Formatting and output are done in rclc_logging_async_flush(),
+    which is called by another thread of the application.
+*/
+
+// same values as enum RCUTILS_LOG_SEVERITY, but usable in pre-processor conditions
+#define RCLC_LOG_SEVERITY_DEBUG 10
+#define RCLC_LOG_SEVERITY_INFO 20
+#define RCLC_LOG_SEVERITY_WARN 30
+#define RCLC_LOG_SEVERITY_ERROR 40
+#define RCLC_LOG_SEVERITY_FATAL 50
+#define RCLC_LOG_SEVERITY_NONE 60
+
+#ifndef RCLC_LOG_MIN_SEVERITY
+#define RCLC_LOG_MIN_SEVERITY RCLC_LOG_SEVERITY_DEBUG
+#endif
+
+/// Maximum number of arguments of a message in the asynchronous sink
+#define RCLC_LOGGING_ASYNC_MAX_ARGS 4
+
+// first try the asynchronous sink, fall back to the rcutils logging macro, which
+// checks the severity of the logger itself
+#define RCLC_LOG_NAMED_(severity, rcutils_macro, name, ...) \
+  do { \
+    if (!rclc_logging_async_is_initialized()) { \
+      rcutils_macro(name, __VA_ARGS__); \
+    } else if (rcutils_logging_logger_is_enabled_for(name, severity) && \
+      !rclc_logging_async_write(severity, name, __VA_ARGS__)) \
+    { \
+      rcutils_macro(name, __VA_ARGS__); \
+    } \
+  } while (0)
+
+#if RCLC_LOG_MIN_SEVERITY > RCLC_LOG_SEVERITY_DEBUG
+#define RCLC_LOG_DEBUG_NAMED(name, ...) do {} while (0)
+#else
+#define RCLC_LOG_DEBUG_NAMED(name, ...) \
+  RCLC_LOG_NAMED_(RCLC_LOG_SEVERITY_DEBUG, RCUTILS_LOG_DEBUG_NAMED, name, __VA_ARGS__)
+#endif
+
+#if RCLC_LOG_MIN_SEVERITY > RCLC_LOG_SEVERITY_INFO
+#define RCLC_LOG_INFO_NAMED(name, ...) do {} while (0)
+#else
+#define RCLC_LOG_INFO_NAMED(name, ...) \
+  RCLC_LOG_NAMED_(RCLC_LOG_SEVERITY_INFO, RCUTILS_LOG_INFO_NAMED, name, __VA_ARGS__)
+#endif
+
+#if RCLC_LOG_MIN_SEVERITY > RCLC_LOG_SEVERITY_WARN
+#define RCLC_LOG_WARN_NAMED(name, ...) do {} while (0)
+#else
+#define RCLC_LOG_WARN_NAMED(name, ...) \
+  RCLC_LOG_NAMED_(RCLC_LOG_SEVERITY_WARN, RCUTILS_LOG_WARN_NAMED, name, __VA_ARGS__)
+#endif
+
+#if RCLC_LOG_MIN_SEVERITY > RCLC_LOG_SEVERITY_ERROR
+#define RCLC_LOG_ERROR_NAMED(name, ...) do {} while (0)
+#else
+#define RCLC_LOG_ERROR_NAMED(name, ...) \
+  RCLC_LOG_NAMED_(RCLC_LOG_SEVERITY_ERROR, RCUTILS_LOG_ERROR_NAMED, name, __VA_ARGS__)
+#endif
+
+/**
+ *  Initializes the asynchronous log sink with a ring buffer of \p capacity messages.
+ *  The capacity is rounded up to the next power of two. If the ring buffer is full,
+ *  new messages are dropped and counted.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] capacity number of messages in the ring buffer, must be larger than 0
+ * \param[in] allocator allocator for the ring buffer
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is invalid
+ * \return `RCL_RET_ALREADY_INIT` if the sink is already initialized
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_logging_async_init(
+  size_t capacity,
+  const rcl_allocator_t * allocator);
+
+/**
+ *  Outputs all buffered messages and deallocates the asynchronous log sink.
+ *  Afterwards the rclc log macros log synchronously again. Must not be called
+ *  while other threads are logging.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \return `RCL_RET_OK` if successful or if the sink was not initialized
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_logging_async_fini(void);
+
+/**
+ *  Returns true if the asynchronous sink is initialized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ */
+RCLC_PUBLIC
+bool
+rclc_logging_async_is_initialized(void);
+
+/**
+ *  Copies a log message into the ring buffer of the asynchronous sink.
+ *  It does not format the message. Therefore \p name and \p format must have
+ *  static storage duration (e.g. string literals) and at most
+ *  RCLC_LOGGING_ASYNC_MAX_ARGS arguments of type long (conversions %ld, %lu, %lx)
+ *  are supported. Messages with any other conversion, including flags or a field
+ *  width, are rejected. The severity of the logger is not checked, the RCLC_LOG_*
+ *  macros call it only for enabled loggers.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] severity severity of the message
+ * \param[in] name name of the logger
+ * \param[in] format printf-like format string
+ * \return true if the message was handled by the asynchronous sink (stored or dropped)
+ * \return false if the sink is not initialized or the message is not supported
+ */
+RCLC_PUBLIC
+bool
+rclc_logging_async_write(
+  int severity,
+  const char * name,
+  const char * format,
+  ...);
+
+/**
+ *  Formats and outputs all buffered messages with the rcutils output handler.
+ *  This function is intended to be called periodically from a low-priority thread.
+ *  Only one thread may call this function at a time.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \return number of messages, which were taken from the ring buffer
+ */
+RCLC_PUBLIC
+size_t
+rclc_logging_async_flush(void);
+
+/**
+ *  Returns the number of messages which were dropped, because the ring buffer was full.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ */
+RCLC_PUBLIC
+size_t
+rclc_logging_async_get_dropped(void);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__LOGGING_H_
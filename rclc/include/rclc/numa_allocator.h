@@ -0,0 +1,163 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__NUMA_ALLOCATOR_H_
+#define RCLC__NUMA_ALLOCATOR_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <rcl/allocator.h>
+#include <rcl/types.h>
+#include <rclc/visibility_control.h>
+
+/*! \file numa_allocator.h
+    \brief rcl_allocator_t, which serves all allocations from one memory region
+    placed on a NUMA node and optionally backed by huge pages.
+
+    Pass it to rclc_support_init() and rclc_executor_init(), so that the handle
+    array of the executor, the goal handle pools of the action servers and the
+    message buffers allocated with it are local to the socket of the executor
+    thread. One 2 MB huge page covers the memory of many small objects, which
+    reduces TLB misses.
+*/
+
+/// Use the NUMA node of the CPU of the calling thread
+#define RCLC_NUMA_NODE_CURRENT -1
+
+/// Size of a huge page
+#define RCLC_NUMA_ALLOCATOR_HUGE_PAGE_SIZE (2u * 1024u * 1024u)
+
+/// Options of rclc_numa_allocator_init()
+typedef struct
+{
+  /// NUMA node of the memory region, RCLC_NUMA_NODE_CURRENT for the node of the
+  /// calling thread
+  int numa_node;
+  /// Size of the memory region in bytes, rounded up to the page size
+  size_t size;
+  /// Back the region with huge pages. If no huge pages are reserved, transparent
+  /// huge pages are requested for the region instead.
+  bool huge_pages;
+} rclc_numa_allocator_options_t;
+
+/// Usage of a NUMA allocator
+typedef struct
+{
+  /// NUMA node of the memory region, -1 if it could not be bound to a node
+  int numa_node;
+  /// Size of the memory region in bytes
+  size_t size;
+  /// Whether the region is backed by reserved huge pages
+  bool huge_pages;
+  /// Bytes currently allocated from the region, including block headers
+  size_t used;
+  /// Number of allocations, which did not fit into the region and were served
+  /// by the default allocator
+  uint64_t fallback_allocations;
+} rclc_numa_allocator_info_t;
+
+/**
+ *  Return the default options: node of the calling thread, 16 MB, huge pages.
+ */
+RCLC_PUBLIC
+rclc_numa_allocator_options_t
+rclc_numa_allocator_get_default_options(void);
+
+/**
+ *  Initializes \p allocator with a memory region placed on the NUMA node given in
+ *  \p options. The pages are touched during initialization, so that no page faults
+ *  occur when handles or messages are allocated later. Allocations, which do not
+ *  fit into the region, are served by the default allocator. The allocator is
+ *  thread-safe, a mutex serializes the allocations, and can be used by rcl as well.
+ *
+ *  Call it from the thread, which runs the executor, with the
+ *  RCLC_NUMA_NODE_CURRENT node, after the thread was pinned to its CPUs.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[out] allocator allocator to initialize
+ * \param[in] options options of the memory region
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or the size is 0
+ * \return `RCL_RET_BAD_ALLOC` if the memory region could not be mapped
+ * \return `RCL_RET_ERROR` if the mutex could not be initialized
+ * \return `RCL_RET_UNSUPPORTED` if the platform is not Linux
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_numa_allocator_init(
+  rcl_allocator_t * allocator,
+  const rclc_numa_allocator_options_t * options);
+
+/**
+ *  Unmaps the memory region of \p allocator. All entities, which were created
+ *  with the allocator, must have been finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] allocator allocator initialized with rclc_numa_allocator_init()
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p allocator is a null pointer or not a NUMA allocator
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_numa_allocator_fini(rcl_allocator_t * allocator);
+
+/**
+ *  Returns the usage of the memory region of \p allocator.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param[in] allocator allocator initialized with rclc_numa_allocator_init()
+ * \param[out] info usage of the allocator
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or
+ *   \p allocator is not a NUMA allocator
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_numa_allocator_get_info(
+  const rcl_allocator_t * allocator,
+  rclc_numa_allocator_info_t * info);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__NUMA_ALLOCATOR_H_
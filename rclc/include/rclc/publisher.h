@@ -25,6 +25,7 @@ extern "C"
 // #include<rosidl_generator_c/message_type_support_struct.h>
 // #include<rcl/node.h>
 #include <rcl/allocator.h>
+#include <rcutils/time.h>
 #include <rclc/types.h>
 #include "rclc/visibility_control.h"
 
@@ -108,6 +109,118 @@ rclc_publisher_init(
   const char * topic_name,
   const rmw_qos_profile_t * qos_profile);
 
+/// Publisher, which suppresses messages whose serialized payload is identical to
+/// the last published message. Unchanged messages are sent again after the
+/// heartbeat interval, so that late joining subscriptions receive the state.
+typedef struct
+{
+  /// Publisher
+  rcl_publisher_t * publisher;
+  /// Type support of the published messages
+  const rosidl_message_type_support_t * type_support;
+  /// Serialized messages: the last published message and the scratch buffer
+  rcl_serialized_message_t serialized_msgs[2];
+  /// Index of the last published message in serialized_msgs
+  size_t last;
+  /// Flag, which is true once a message was published
+  bool has_last;
+  /// Interval in nanoseconds after which an unchanged message is published again
+  /// 0: unchanged messages are never published again
+  int64_t heartbeat_ns;
+  /// Steady time of the last publish
+  rcutils_time_point_value_t last_publish_time;
+  /// Number of suppressed messages
+  size_t suppressed;
+} rclc_change_publisher_t;
+
+/**
+ *  Return a rclc_change_publisher_t struct with pointer members initialized to `NULL`
+ *  and member variables to 0.
+ */
+RCLC_PUBLIC
+rclc_change_publisher_t
+rclc_change_publisher_get_zero_initialized(void);
+
+/**
+ *  Initializes a change-detecting publisher for an initialized \p publisher.
+ *  The buffers for the serialized messages grow to the size of the largest
+ *  message on demand.
+ *
+ *  * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] change_publisher a zero_initialized rclc_change_publisher_t
+ * \param[in] publisher an initialized rcl publisher
+ * \param[in] type_support the message data type of \p publisher
+ * \param[in] heartbeat_ns interval in nanoseconds after which unchanged messages
+ *   are published again, 0 to suppress them always
+ * \param[in] allocator allocator for the serialized messages
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or
+ *   \p heartbeat_ns is negative
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_change_publisher_init(
+  rclc_change_publisher_t * change_publisher,
+  rcl_publisher_t * publisher,
+  const rosidl_message_type_support_t * type_support,
+  int64_t heartbeat_ns,
+  const rcl_allocator_t * allocator);
+
+/**
+ *  Serializes \p ros_message and publishes it, if it differs from the last
+ *  published message or if the heartbeat interval has elapsed since the last publish.
+ *
+ *  * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes (if the message is larger than all previous messages)
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] change_publisher an initialized rclc_change_publisher_t
+ * \param[in] ros_message the message to publish
+ * \param[out] published true if the message was published, false if it was
+ *   suppressed (can be NULL)
+ * \return `RCL_RET_OK` if the message was published or suppressed
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` (or other error code) if an error has occurred
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_change_publisher_publish(
+  rclc_change_publisher_t * change_publisher,
+  const void * ros_message,
+  bool * published);
+
+/**
+ *  Deallocates the serialized messages. The rcl publisher is not finalized.
+ *
+ *  * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] change_publisher an initialized rclc_change_publisher_t
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p change_publisher is a null pointer
+ * \return `RCL_RET_ERROR` (or other error code) if an error has occurred
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_change_publisher_fini(rclc_change_publisher_t * change_publisher);
+
 #if __cplusplus
 }
 #endif
@@ -32,8 +32,18 @@ extern "C"
 #include "rclc/timer.h"
 #include "rclc/client.h"
 #include "rclc/service.h"
+#include "rclc/service_cache.h"
+#include "rclc/topic_statistics.h"
 #include "rclc/action_client.h"
 #include "rclc/action_server.h"
+#include "rclc/async_publisher.h"
+#include "rclc/chain_tracer.h"
+#include "rclc/component.h"
+#include "rclc/discovery.h"
+#include "rclc/executor_stats.h"
+#include "rclc/latest_value.h"
+#include "rclc/logging.h"
+#include "rclc/numa_allocator.h"
 #include "rclc/types.h"
 #include "rclc/visibility_control.h"
 #if __cplusplus
@@ -0,0 +1,174 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__SERVICE_CACHE_H_
+#define RCLC__SERVICE_CACHE_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#include <rcl/rcl.h>
+#include <rclc/visibility_control.h>
+
+/// Cached response of a service
+typedef struct
+{
+  /// Hash of the serialized request
+  uint64_t hash;
+  /// Serialized request
+  rcl_serialized_message_t request;
+  /// Serialized response
+  rcl_serialized_message_t response;
+  /// Value of rclc_service_cache_t.clock at the last use, for the LRU replacement
+  uint64_t last_used;
+  /// Flag, which is true if the entry holds a response
+  bool valid;
+} rclc_service_cache_entry_t;
+
+/// Fixed-capacity LRU cache of the responses of an idempotent service.
+/// Requests are compared by their serialized representation.
+typedef struct
+{
+  /// Type support of the request message
+  const rosidl_message_type_support_t * request_type_support;
+  /// Type support of the response message
+  const rosidl_message_type_support_t * response_type_support;
+  /// Cache entries
+  rclc_service_cache_entry_t * entries;
+  /// Number of cache entries
+  size_t capacity;
+  /// Internal variable. Counter for the LRU replacement
+  uint64_t clock;
+  /// Internal variable. Serialized request of the last lookup
+  rcl_serialized_message_t request;
+  /// Internal variable. Hash of the last lookup
+  uint64_t request_hash;
+  /// Number of requests answered from the cache
+  size_t hits;
+  /// Number of requests passed to the callback
+  size_t misses;
+  /// Allocator of the entries
+  rcl_allocator_t allocator;
+} rclc_service_cache_t;
+
+/**
+ *  Return a rclc_service_cache_t struct with pointer members initialized to `NULL`
+ *  and member variables to 0.
+ */
+RCLC_PUBLIC
+rclc_service_cache_t
+rclc_service_cache_get_zero_initialized(void);
+
+/**
+ *  Initializes a response cache with \p capacity entries. The type supports of
+ *  request and response are the message type supports of the service type,
+ *  e.g. `ROSIDL_GET_MSG_TYPE_SUPPORT(example_interfaces, srv, AddTwoInts_Request)`.
+ *  The cache is used by the Executor after rclc_executor_set_service_cache().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] cache pointer to a zero initialized rclc_service_cache_t
+ * \param[in] capacity number of cached responses, must be larger than 0
+ * \param[in] request_type_support type support of the request message
+ * \param[in] response_type_support type support of the response message
+ * \param[in] allocator allocator for the entries and serialized messages
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or \p capacity is 0
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_service_cache_init(
+  rclc_service_cache_t * cache,
+  size_t capacity,
+  const rosidl_message_type_support_t * request_type_support,
+  const rosidl_message_type_support_t * response_type_support,
+  const rcl_allocator_t * allocator);
+
+/**
+ *  Deallocates the entries of the cache.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] cache pointer to an initialized rclc_service_cache_t
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p cache is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_service_cache_fini(rclc_service_cache_t * cache);
+
+/**
+ *  Removes all cached responses, e.g. after the data of the service has changed.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] cache pointer to an initialized rclc_service_cache_t
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p cache is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_service_cache_clear(rclc_service_cache_t * cache);
+
+/**
+ *  Removes the cached response of \p request.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes (if the request is larger than all previous requests)
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] cache pointer to an initialized rclc_service_cache_t
+ * \param[in] request request message
+ * \return `RCL_RET_OK` if successful, also if no response was cached for \p request
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if the request could not be serialized
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_service_cache_invalidate(
+  rclc_service_cache_t * cache,
+  const void * request);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__SERVICE_CACHE_H_
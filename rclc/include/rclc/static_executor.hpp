@@ -0,0 +1,324 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__STATIC_EXECUTOR_HPP_
+#define RCLC__STATIC_EXECUTOR_HPP_
+
+#if __cplusplus < 201703L
+#error "rclc/static_executor.hpp requires C++17"
+#endif
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include <rcl/rcl.h>
+
+/*! \file static_executor.hpp
+    \brief Executor for a fixed set of handles, which is specialized at compile time.
+
+    The types of the handles and of their callbacks as well as the processing order
+    are template parameters of rclc::static_executor. spin_some() is generated with
+    fold expressions into a sequence of rcl_take and direct callback calls in the
+    order of the handles: there is no handle array, no switch on the handle type and
+    no call through a function pointer. The wait set is allocated once in init().
+
+    Example:
+    \code
+    rclc::static_executor executor(
+      rclc::static_subscription(&sub, &msg, [](const std_msgs__msg__Int32 & m) {...}),
+      rclc::static_timer(&timer, [](rcl_timer_t *, int64_t) {...}));
+    executor.init(&support.context, allocator);
+    executor.spin_some(RCL_MS_TO_NS(100));
+    \endcode
+*/
+
+namespace rclc
+{
+
+/// Number of wait set entries of a handle type
+template<
+  std::size_t Subscriptions, std::size_t Timers, std::size_t Clients, std::size_t Services>
+struct static_handle
+{
+  static constexpr std::size_t number_of_subscriptions = Subscriptions;
+  static constexpr std::size_t number_of_timers = Timers;
+  static constexpr std::size_t number_of_clients = Clients;
+  static constexpr std::size_t number_of_services = Services;
+};
+
+/// Subscription, the callback is invoked with `const MessageT &`.
+template<typename MessageT, typename Callback>
+class static_subscription : public static_handle<1, 0, 0, 0>
+{
+public:
+  static_subscription(rcl_subscription_t * subscription, MessageT * msg, Callback callback)
+  : subscription_(subscription), msg_(msg), callback_(std::move(callback)) {}
+
+  rcl_ret_t add_to_wait_set(rcl_wait_set_t * wait_set)
+  {
+    return rcl_wait_set_add_subscription(wait_set, subscription_, &index_);
+  }
+
+  rcl_ret_t execute(const rcl_wait_set_t * wait_set)
+  {
+    if (nullptr == wait_set->subscriptions[index_]) {
+      return RCL_RET_OK;
+    }
+    rmw_message_info_t message_info;
+    rcl_ret_t rc = rcl_take(subscription_, msg_, &message_info, nullptr);
+    if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == rc) {
+      return RCL_RET_OK;
+    } else if (RCL_RET_OK != rc) {
+      return rc;
+    }
+    callback_(static_cast<const MessageT &>(*msg_));
+    return RCL_RET_OK;
+  }
+
+private:
+  rcl_subscription_t * subscription_;
+  MessageT * msg_;
+  Callback callback_;
+  std::size_t index_ = 0;
+};
+
+/// Timer, the callback is invoked with `(rcl_timer_t *, int64_t last_call_time)`.
+/// The rcl timer should be created without a callback, otherwise it is called as well.
+template<typename Callback>
+class static_timer : public static_handle<0, 1, 0, 0>
+{
+public:
+  static_timer(rcl_timer_t * timer, Callback callback)
+  : timer_(timer), callback_(std::move(callback)) {}
+
+  rcl_ret_t add_to_wait_set(rcl_wait_set_t * wait_set)
+  {
+    return rcl_wait_set_add_timer(wait_set, timer_, &index_);
+  }
+
+  rcl_ret_t execute(const rcl_wait_set_t * wait_set)
+  {
+    if (nullptr == wait_set->timers[index_]) {
+      return RCL_RET_OK;
+    }
+    int64_t last_call_time = 0;
+    rcl_ret_t rc = rcl_timer_get_time_since_last_call(timer_, &last_call_time);
+    if (RCL_RET_OK != rc) {
+      return rc;
+    }
+    rc = rcl_timer_call(timer_);
+    if (RCL_RET_TIMER_CANCELED == rc) {
+      return RCL_RET_OK;
+    } else if (RCL_RET_OK != rc) {
+      return rc;
+    }
+    callback_(timer_, last_call_time);
+    return RCL_RET_OK;
+  }
+
+private:
+  rcl_timer_t * timer_;
+  Callback callback_;
+  std::size_t index_ = 0;
+};
+
+/// Service, the callback is invoked with `(const RequestT &, ResponseT &)`
+/// and the response is sent afterwards.
+template<typename RequestT, typename ResponseT, typename Callback>
+class static_service : public static_handle<0, 0, 0, 1>
+{
+public:
+  static_service(
+    rcl_service_t * service, RequestT * request, ResponseT * response, Callback callback)
+  : service_(service), request_(request), response_(response), callback_(std::move(callback))
+  {}
+
+  rcl_ret_t add_to_wait_set(rcl_wait_set_t * wait_set)
+  {
+    return rcl_wait_set_add_service(wait_set, service_, &index_);
+  }
+
+  rcl_ret_t execute(const rcl_wait_set_t * wait_set)
+  {
+    if (nullptr == wait_set->services[index_]) {
+      return RCL_RET_OK;
+    }
+    rmw_request_id_t request_id;
+    rcl_ret_t rc = rcl_take_request(service_, &request_id, request_);
+    if (RCL_RET_SERVICE_TAKE_FAILED == rc) {
+      return RCL_RET_OK;
+    } else if (RCL_RET_OK != rc) {
+      return rc;
+    }
+    callback_(static_cast<const RequestT &>(*request_), *response_);
+    return rcl_send_response(service_, &request_id, response_);
+  }
+
+private:
+  rcl_service_t * service_;
+  RequestT * request_;
+  ResponseT * response_;
+  Callback callback_;
+  std::size_t index_ = 0;
+};
+
+/// Client, the callback is invoked with `(const ResponseT &, const rmw_request_id_t &)`.
+template<typename ResponseT, typename Callback>
+class static_client : public static_handle<0, 0, 1, 0>
+{
+public:
+  static_client(rcl_client_t * client, ResponseT * response, Callback callback)
+  : client_(client), response_(response), callback_(std::move(callback)) {}
+
+  rcl_ret_t add_to_wait_set(rcl_wait_set_t * wait_set)
+  {
+    return rcl_wait_set_add_client(wait_set, client_, &index_);
+  }
+
+  rcl_ret_t execute(const rcl_wait_set_t * wait_set)
+  {
+    if (nullptr == wait_set->clients[index_]) {
+      return RCL_RET_OK;
+    }
+    rmw_request_id_t request_id;
+    rcl_ret_t rc = rcl_take_response(client_, &request_id, response_);
+    if (RCL_RET_CLIENT_TAKE_FAILED == rc) {
+      return RCL_RET_OK;
+    } else if (RCL_RET_OK != rc) {
+      return rc;
+    }
+    callback_(static_cast<const ResponseT &>(*response_), request_id);
+    return RCL_RET_OK;
+  }
+
+private:
+  rcl_client_t * client_;
+  ResponseT * response_;
+  Callback callback_;
+  std::size_t index_ = 0;
+};
+
+/**
+ *  Executor for the handles \p Handles, which are processed in the given order
+ *  (rclcpp semantics: each ready handle takes its data and executes its callback).
+ */
+template<typename ... Handles>
+class static_executor
+{
+public:
+  static constexpr std::size_t number_of_subscriptions =
+    (std::size_t{0} + ... + Handles::number_of_subscriptions);
+  static constexpr std::size_t number_of_timers =
+    (std::size_t{0} + ... + Handles::number_of_timers);
+  static constexpr std::size_t number_of_clients =
+    (std::size_t{0} + ... + Handles::number_of_clients);
+  static constexpr std::size_t number_of_services =
+    (std::size_t{0} + ... + Handles::number_of_services);
+
+  explicit static_executor(Handles... handles)
+  : handles_(std::move(handles)...), wait_set_(rcl_get_zero_initialized_wait_set()) {}
+
+  static_executor(const static_executor &) = delete;
+  static_executor & operator=(const static_executor &) = delete;
+
+  ~static_executor()
+  {
+    fini();
+  }
+
+  rcl_ret_t init(rcl_context_t * context, rcl_allocator_t allocator)
+  {
+    context_ = context;
+    return rcl_wait_set_init(
+      &wait_set_, number_of_subscriptions, 0, number_of_timers,
+      number_of_clients, number_of_services, 0, context, allocator);
+  }
+
+  rcl_ret_t fini()
+  {
+    if (!rcl_wait_set_is_valid(&wait_set_)) {
+      return RCL_RET_OK;
+    }
+    return rcl_wait_set_fini(&wait_set_);
+  }
+
+  /**
+   *  Waits at most \p timeout_ns for new data and processes all ready handles once.
+   *  \return `RCL_RET_TIMEOUT` if no handle was ready, otherwise the first error
+   *  of the handles or `RCL_RET_OK`
+   */
+  rcl_ret_t spin_some(int64_t timeout_ns)
+  {
+    rcl_ret_t rc = rcl_wait_set_clear(&wait_set_);
+    if (RCL_RET_OK != rc) {
+      return rc;
+    }
+    rc = add_to_wait_set(std::index_sequence_for<Handles...>{});
+    if (RCL_RET_OK != rc) {
+      return rc;
+    }
+    rc = rcl_wait(&wait_set_, timeout_ns);
+    if (RCL_RET_OK != rc) {
+      return rc;
+    }
+    return execute(std::index_sequence_for<Handles...>{});
+  }
+
+  /// Spins until the context is shut down.
+  rcl_ret_t spin(int64_t timeout_ns)
+  {
+    rcl_ret_t rc = RCL_RET_OK;
+    while (rcl_context_is_valid(context_) &&
+      (RCL_RET_OK == rc || RCL_RET_TIMEOUT == rc))
+    {
+      rc = spin_some(timeout_ns);
+    }
+    return rc;
+  }
+
+private:
+  template<std::size_t ... I>
+  rcl_ret_t add_to_wait_set(std::index_sequence<I...>)
+  {
+    rcl_ret_t rc = RCL_RET_OK;
+    // stops at the first error
+    static_cast<void>(
+      ((rc = std::get<I>(handles_).add_to_wait_set(&wait_set_), RCL_RET_OK == rc) && ...));
+    return rc;
+  }
+
+  template<std::size_t ... I>
+  rcl_ret_t execute(std::index_sequence<I...>)
+  {
+    rcl_ret_t result = RCL_RET_OK;
+    // all handles are processed, the first error is returned
+    static_cast<void>(
+      ((result = first_error(result, std::get<I>(handles_).execute(&wait_set_))), ...));
+    return result;
+  }
+
+  static rcl_ret_t first_error(rcl_ret_t result, rcl_ret_t rc)
+  {
+    return (RCL_RET_OK != result) ? result : rc;
+  }
+
+  std::tuple<Handles...> handles_;
+  rcl_wait_set_t wait_set_;
+  rcl_context_t * context_ = nullptr;
+};
+
+}  // namespace rclc
+
+#endif  // RCLC__STATIC_EXECUTOR_HPP_
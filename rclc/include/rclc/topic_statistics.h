@@ -0,0 +1,273 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLC__TOPIC_STATISTICS_H_
+#define RCLC__TOPIC_STATISTICS_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#include <rcl/rcl.h>
+#include <rclc/visibility_control.h>
+#ifdef RCLC_HAVE_STATISTICS_MSGS
+#include <statistics_msgs/msg/metrics_message.h>
+#endif
+
+/*! \file topic_statistics.h
+    \brief Statistics of the messages of a subscription: the inter-arrival period,
+    the age of the messages when they are taken and the number of messages lost
+    between publisher and subscription.
+
+    The executor updates a rclc_topic_statistics_t, which is set for a subscription
+    with rclc_executor_set_topic_statistics(), each time it takes a message. All
+    statistics are computed incrementally and without allocating memory. A
+    rclc_topic_statistics_publisher_t publishes them in the format of the rclcpp
+    topic statistics (statistics_msgs/msg/MetricsMessage). The publisher is only
+    available, if rclc was built with statistics_msgs (RCLC_HAVE_STATISTICS_MSGS).
+*/
+
+/// Number of publishers of a topic, whose publication sequence numbers are tracked
+/// to count lost messages. If a topic has more publishers, gaps are only counted
+/// for the most recently seen ones.
+#define RCLC_TOPIC_STATISTICS_MAX_PUBLISHERS 8
+
+/// Default topic of rclc_topic_statistics_publisher_init(), the same as of rclcpp
+#define RCLC_TOPIC_STATISTICS_DEFAULT_TOPIC "/statistics"
+
+/// Mean, variance, minimum and maximum of a sample, updated with each value
+/// (Welford's algorithm)
+typedef struct
+{
+  /// Number of values
+  uint64_t count;
+  /// Mean of the values
+  double mean;
+  /// Internal variable. Sum of the squared differences from the mean
+  double m2;
+  /// Smallest value
+  double min;
+  /// Largest value
+  double max;
+} rclc_topic_statistics_metric_t;
+
+/// Last publication sequence number of a publisher
+typedef struct
+{
+  /// Gid of the publisher
+  rmw_gid_t gid;
+  /// Publication sequence number of the last message
+  uint64_t sequence_number;
+} rclc_topic_statistics_sequence_t;
+
+/// Statistics of the messages of a subscription since the start of the window
+typedef struct
+{
+  /// Time between the arrivals of consecutive messages in nanoseconds. The
+  /// reception timestamp of the middleware is used, if available, otherwise the
+  /// time of the take.
+  rclc_topic_statistics_metric_t period;
+  /// Time from the source timestamp of a message until it is taken in nanoseconds
+  rclc_topic_statistics_metric_t age;
+  /// Number of taken messages
+  uint64_t messages;
+  /// Number of messages missing in the publication sequence numbers
+  uint64_t dropped;
+  /// System time of the start of the window
+  rcutils_time_point_value_t window_start;
+  /// Internal variable. Arrival time of the last message, 0 before the first one
+  rcutils_time_point_value_t last_arrival;
+  /// Internal variable. Last sequence numbers of the publishers
+  rclc_topic_statistics_sequence_t sequences[RCLC_TOPIC_STATISTICS_MAX_PUBLISHERS];
+  /// Internal variable. Number of used entries of sequences
+  size_t number_of_sequences;
+  /// Internal variable. Entry of sequences, which is replaced next
+  size_t next_sequence;
+} rclc_topic_statistics_t;
+
+#ifdef RCLC_HAVE_STATISTICS_MSGS
+/// Publisher of topic statistics as statistics_msgs/msg/MetricsMessage
+typedef struct
+{
+  /// Publisher of the metrics messages
+  rcl_publisher_t publisher;
+  /// Message of the metric "message_age"
+  statistics_msgs__msg__MetricsMessage age_msg;
+  /// Message of the metric "message_period"
+  statistics_msgs__msg__MetricsMessage period_msg;
+} rclc_topic_statistics_publisher_t;
+#endif  // RCLC_HAVE_STATISTICS_MSGS
+
+/**
+ *  Return a rclc_topic_statistics_t struct with all members initialized to 0.
+ */
+RCLC_PUBLIC
+rclc_topic_statistics_t
+rclc_topic_statistics_get_zero_initialized(void);
+
+/**
+ *  Starts the first window of the statistics.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] stats pointer to a zero initialized rclc_topic_statistics_t
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p stats is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_topic_statistics_init(rclc_topic_statistics_t * stats);
+
+/**
+ *  Starts a new window: the metrics and counters are cleared. The arrival time
+ *  of the last message and the sequence numbers are kept, so the first period
+ *  and the lost messages between the windows are counted in the new window.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] stats pointer to an initialized rclc_topic_statistics_t
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p stats is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_topic_statistics_reset(rclc_topic_statistics_t * stats);
+
+/**
+ *  Returns the sample variance of the values of \p metric, 0 for less than two values.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] metric pointer to a metric of a rclc_topic_statistics_t
+ * \return variance, 0 if \p metric is a null pointer
+ */
+RCLC_PUBLIC
+double
+rclc_topic_statistics_variance(const rclc_topic_statistics_metric_t * metric);
+
+#ifdef RCLC_HAVE_STATISTICS_MSGS
+/**
+ *  Return a rclc_topic_statistics_publisher_t struct with all members
+ *  zero initialized.
+ */
+RCLC_PUBLIC
+rclc_topic_statistics_publisher_t
+rclc_topic_statistics_publisher_get_zero_initialized(void);
+
+/**
+ *  Creates the publisher of the metrics messages and initializes the messages,
+ *  whose measurement source is the name of \p node, as in rclcpp.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] publisher pointer to a zero initialized rclc_topic_statistics_publisher_t
+ * \param[in] node pointer to an initialized node
+ * \param[in] topic_name topic of the metrics messages,
+ *            NULL for RCLC_TOPIC_STATISTICS_DEFAULT_TOPIC
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p publisher or \p node is a null pointer
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory for the messages failed
+ * \return `RCL_RET_ERROR` if the publisher could not be created
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_topic_statistics_publisher_init(
+  rclc_topic_statistics_publisher_t * publisher,
+  rcl_node_t * node,
+  const char * topic_name);
+
+/**
+ *  Finalizes the publisher and the messages.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] publisher pointer to an initialized rclc_topic_statistics_publisher_t
+ * \param[in] node pointer to the node of the publisher
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if the publisher could not be finalized
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_topic_statistics_publisher_fini(
+  rclc_topic_statistics_publisher_t * publisher,
+  rcl_node_t * node);
+
+/**
+ *  Publishes the statistics of the current window of \p stats as the metrics
+ *  "message_age" and "message_period" in milliseconds, with average, minimum,
+ *  maximum, standard deviation and sample count like rclcpp, and starts a new
+ *  window. Metrics without values are published as NaN. Call it periodically,
+ *  e.g. in a timer callback.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] publisher pointer to an initialized rclc_topic_statistics_publisher_t
+ * \param[inout] stats pointer to an initialized rclc_topic_statistics_t
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if publishing failed
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_topic_statistics_publish(
+  rclc_topic_statistics_publisher_t * publisher,
+  rclc_topic_statistics_t * stats);
+#endif  // RCLC_HAVE_STATISTICS_MSGS
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__TOPIC_STATISTICS_H_
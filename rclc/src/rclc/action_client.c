@@ -13,15 +13,49 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <time.h>
+#include <stdatomic.h>
+#include <string.h>
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
 
 #include <rcl/error_handling.h>
 #include <rcutils/logging_macros.h>
+#include <rcutils/time.h>
 #include <rclc/action_client.h>
 
 #include "./action_generic_types.h"
+#include "./action_client_internal.h"
 #include "./action_goal_handle_internal.h"
 
+static uint64_t splitmix64(
+  uint64_t * state)
+{
+  uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+static void set_goal_id_seed(
+  rclc_action_client_t * action_client)
+{
+#if defined(__linux__)
+  if (getrandom(
+      action_client->goal_id_seed, sizeof(action_client->goal_id_seed),
+      0) == (ssize_t) sizeof(action_client->goal_id_seed))
+  {
+    return;
+  }
+#endif
+  // no entropy source available: mix time and address of the action client
+  rcutils_time_point_value_t now = 0;
+  rcutils_system_time_now(&now);
+  uint64_t state = (uint64_t) now ^ (uint64_t) (uintptr_t) action_client;
+  action_client->goal_id_seed[0] = splitmix64(&state);
+  action_client->goal_id_seed[1] = splitmix64(&state);
+}
+
 rcl_ret_t
 rclc_action_client_init_default(
   rclc_action_client_t * action_client,
@@ -39,6 +73,7 @@ rclc_action_client_init_default(
     action_name, "action_name is a null pointer", return RCL_RET_INVALID_ARGUMENT);
 
   *action_client = (rclc_action_client_t) {0};
+  set_goal_id_seed(action_client);
 
   action_client->rcl_handle = rcl_action_get_zero_initialized_client();
   rcl_action_client_options_t action_client_opt = rcl_action_client_get_default_options();
@@ -56,29 +91,92 @@ rclc_action_client_init_default(
 }
 
 static void set_uuid(
+  rclc_action_client_t * action_client,
   uint8_t * uuid)
 {
-  static bool uuid_gen_init = false;
-  static uint64_t uuid_lsb = 0;
-  static uint64_t uuid_msb = 0;
+  uint64_t uuid_msb = action_client->goal_id_seed[0];
+  uint64_t uuid_lsb = action_client->goal_id_seed[1] +
+    (uint64_t) atomic_fetch_add_explicit(
+    (atomic_uintptr_t *) &action_client->goal_id_counter, 1, memory_order_relaxed);
 
-  RCL_CHECK_FOR_NULL_WITH_MSG(
-    uuid, "uuid is a null pointer", return );
+  memcpy(&uuid[0], &uuid_msb, sizeof(uuid_msb));
+  memcpy(&uuid[8], &uuid_lsb, sizeof(uuid_lsb));
+}
 
-  if (!uuid_gen_init) {
-    uuid_gen_init = true;
-    srand(time(NULL));
-    uuid_lsb = (uint64_t)rand();
-    uuid_msb = (uint64_t)rand();
+// Sets the goal response of the goal handle with the sequence number of the request.
+static bool
+match_goal_response(
+  rclc_action_client_t * action_client,
+  int64_t sequence_number,
+  bool accepted)
+{
+  rclc_action_goal_handle_t * goal_handle =
+    rclc_action_find_handle_by_goal_request_sequence_number(action_client, sequence_number);
+  if (NULL == goal_handle) {
+    return false;
   }
+  goal_handle->available_goal_response = true;
+  goal_handle->goal_accepted = accepted;
+  return true;
+}
 
-  uuid_lsb++;
-  if (0 == uuid_lsb) {
-    uuid_msb++;
+void
+rclc_action_client_match_goal_response(
+  rclc_action_client_t * action_client,
+  int64_t sequence_number,
+  bool accepted)
+{
+  if (match_goal_response(action_client, sequence_number, accepted)) {
+    return;
+  }
+  // the sending thread has not inserted the goal handle yet
+  size_t n = action_client->number_of_pending_goal_responses;
+  if (n == RCLC_ACTION_CLIENT_MAX_PENDING_GOAL_RESPONSES) {
+    RCUTILS_LOG_ERROR_NAMED(
+      ROS_PACKAGE_NAME, "Too many pending goal responses, dropping sequence number %ld",
+      (long) action_client->pending_goal_responses[0].sequence_number);
+    memmove(
+      &action_client->pending_goal_responses[0], &action_client->pending_goal_responses[1],
+      (n - 1) * sizeof(action_client->pending_goal_responses[0]));
+    n--;
   }
+  rcutils_time_point_value_t now = 0;
+  rcutils_ret_t ret = rcutils_steady_time_now(&now);
+  RCLC_UNUSED(ret);
+  action_client->pending_goal_responses[n].sequence_number = sequence_number;
+  action_client->pending_goal_responses[n].accepted = accepted;
+  action_client->pending_goal_responses[n].received_ns = now;
+  action_client->number_of_pending_goal_responses = n + 1;
+}
 
-  *(uint64_t *)(&uuid[0]) = uuid_msb;
-  *(uint64_t *)(&uuid[8]) = uuid_lsb;
+void
+rclc_action_client_match_pending_goal_responses(
+  rclc_action_client_t * action_client)
+{
+  rcutils_time_point_value_t now = 0;
+  rcutils_ret_t ret = rcutils_steady_time_now(&now);
+  RCLC_UNUSED(ret);
+  size_t kept = 0;
+  for (size_t i = 0; i < action_client->number_of_pending_goal_responses; i++) {
+    if (match_goal_response(
+        action_client,
+        action_client->pending_goal_responses[i].sequence_number,
+        action_client->pending_goal_responses[i].accepted))
+    {
+      continue;
+    }
+    if (now - action_client->pending_goal_responses[i].received_ns >
+      RCLC_ACTION_CLIENT_PENDING_GOAL_RESPONSE_TIMEOUT_NS)
+    {
+      // no goal handle for this response, e.g. a response of a second action server
+      RCUTILS_LOG_WARN_NAMED(
+        ROS_PACKAGE_NAME, "Dropping unmatched goal response with sequence number %ld",
+        (long) action_client->pending_goal_responses[i].sequence_number);
+      continue;
+    }
+    action_client->pending_goal_responses[kept++] = action_client->pending_goal_responses[i];
+  }
+  action_client->number_of_pending_goal_responses = kept;
 }
 
 rcl_ret_t
@@ -93,32 +191,32 @@ rclc_action_send_goal_request(
     ros_request, "ros_request is a null pointer", return RCL_RET_INVALID_ARGUMENT);
 
   Generic_SendGoal_Request * request = (Generic_SendGoal_Request *) ros_request;
-  rclc_action_goal_handle_t * handle = rclc_action_take_goal_handle(action_client);
+  rclc_action_goal_handle_t * handle = rclc_action_take_free_goal_handle(action_client);
 
   if (NULL == handle) {
-    PRINT_RCLC_ERROR(rclc_action_send_goal_request, rclc_action_take_goal_handle);
+    PRINT_RCLC_ERROR(rclc_action_send_goal_request, rclc_action_take_free_goal_handle);
     return RCL_RET_ERROR;
   }
 
-  set_uuid(handle->goal_id.uuid);
+  set_uuid(action_client, handle->goal_id.uuid);
   request->goal_id = handle->goal_id;
+  handle->ros_goal_request = ros_request;
 
+  int64_t goal_request_sequence_number;
   rcl_ret_t rc = rcl_action_send_goal_request(
     &action_client->rcl_handle, ros_request,
-    &handle->goal_request_sequence_number);
+    &goal_request_sequence_number);
 
   if (rc != RCL_RET_OK) {
-    rclc_action_remove_used_goal_handle(action_client, handle);
+    rclc_action_put_free_goal_handle(action_client, handle);
     PRINT_RCLC_ERROR(rclc_action_send_goal_request, rcl_action_send_goal_request);
     return RCL_RET_ERROR;
   }
 
-  handle->status = GOAL_STATE_UNKNOWN;
-  handle->ros_goal_request = ros_request;
-  handle->available_goal_response = false;
-  handle->available_feedback = false;
-  handle->available_result_response = false;
-  handle->available_cancel_response = false;
+  // the handle is visible to the executor from now on, a goal response taken
+  // before is kept by the executor until then
+  handle->goal_request_sequence_number = goal_request_sequence_number;
+  rclc_action_put_goal_handle_in_list(&action_client->used_goal_handles, handle);
 
   if (NULL != goal_handle) {
     *goal_handle = handle;
@@ -174,6 +272,43 @@ rclc_action_send_cancel_request(
 }
 
 
+rcl_ret_t
+rclc_action_client_set_elastic_goal_handles(
+  rclc_action_client_t * action_client,
+  const rclc_action_goal_handle_pool_options_t * options)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    action_client, "action_client is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    options, "options is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+
+  rcl_ret_t rc = rclc_action_init_goal_handle_pool(
+    action_client, options, 0, 0, action_client->allocator);
+  if (rc != RCL_RET_OK) {
+    return rc;
+  }
+
+  // one goal info per goal handle for the cancel response
+  size_t capacity = rclc_action_get_goal_handle_capacity(action_client);
+  action_msgs__msg__GoalInfo * goals_canceling = action_client->allocator->allocate(
+    capacity * sizeof(action_msgs__msg__GoalInfo),
+    action_client->allocator->state);
+  if (NULL == goals_canceling) {
+    rclc_action_fini_goal_handle_pool(action_client);
+    RCL_SET_ERROR_MSG("Could not allocate memory for the cancel response.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  if (NULL != action_client->ros_cancel_response.goals_canceling.data) {
+    action_client->allocator->deallocate(
+      action_client->ros_cancel_response.goals_canceling.data,
+      action_client->allocator->state);
+  }
+  action_client->ros_cancel_response.goals_canceling.data = goals_canceling;
+  action_client->ros_cancel_response.goals_canceling.size = 0;
+  action_client->ros_cancel_response.goals_canceling.capacity = capacity;
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rclc_action_client_fini(
   rclc_action_client_t * action_client,
@@ -186,6 +321,8 @@ rclc_action_client_fini(
 
   rcl_ret_t rc;
 
+  rclc_action_fini_goal_handle_pool(action_client);
+
   if (NULL != action_client->goal_handles_memory) {
     action_client->allocator->deallocate(
       action_client->goal_handles_memory,
@@ -20,15 +20,35 @@ extern "C"
 {
 #endif
 
+#include <rcutils/time.h>
 #include <rclc/types.h>
 
 #include <rclc/client.h>
 #include <rclc/action_goal_handle.h>
+#include <rclc/action_client.h>
 
 rcl_ret_t
 rclc_action_send_result_request(
   rclc_action_goal_handle_t * goal_handle);
 
+// Goal responses, which have not been matched with their goal handle for this
+// time, are dropped
+#define RCLC_ACTION_CLIENT_PENDING_GOAL_RESPONSE_TIMEOUT_NS RCUTILS_MS_TO_NS(100)
+
+// A goal response can only be matched by the sequence number of its request, but
+// rclc_action_send_goal_request inserts the goal handle after the request has been
+// sent. The executor keeps goal responses without goal handle and retries matching
+// them on the next spin with rclc_action_client_match_pending_goal_responses.
+void
+rclc_action_client_match_goal_response(
+  rclc_action_client_t * action_client,
+  int64_t sequence_number,
+  bool accepted);
+
+void
+rclc_action_client_match_pending_goal_responses(
+  rclc_action_client_t * action_client);
+
 #if __cplusplus
 }
 #endif
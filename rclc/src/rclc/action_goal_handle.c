@@ -17,8 +17,13 @@
 
 #include "./action_generic_types.h"
 
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
 #include <rcl/error_handling.h>
 #include <rcutils/logging_macros.h>
+#include <rcutils/time.h>
 
 
 typedef struct rclc_generic_entity_t
@@ -27,6 +32,253 @@ typedef struct rclc_generic_entity_t
 } rclc_generic_entity_t;
 
 
+// The list heads and links are plain members of the public structs, which are also
+// used from C++. They are accessed here through atomic types of the same size.
+typedef _Atomic (rclc_action_goal_handle_t *) rclc_action_atomic_goal_handle_ptr_t;
+#define ATOMIC_GOAL_HANDLE_PTR(ptr) ((rclc_action_atomic_goal_handle_ptr_t *) (ptr))
+#define ATOMIC_FREE_LIST(entity) ((atomic_uintptr_t *) &(entity)->free_goal_handles)
+
+#define FREE_LIST_INDEX_BITS (sizeof(uintptr_t) * 4)
+#define FREE_LIST_INDEX(head) ((head) & RCLC_ACTION_GOAL_HANDLE_POOL_MAX_SIZE)
+
+// Chunks of an elastic goal handle pool. The chunk table has a fixed size, so that the
+// free list can map an index to a goal handle without locking. Chunks are only added
+// and removed at the end of the table under the mutex, a removed chunk is deallocated
+// as soon as no thread is inside rclc_action_take_free_goal_handle anymore.
+typedef struct rclc_action_goal_handle_pool_t
+{
+  size_t chunk_size;
+  size_t max_chunks;
+  size_t chunk_bytes;
+  size_t ros_goal_request_offset;
+  size_t ros_goal_request_size;
+  size_t ros_result_response_offset;
+  size_t ros_result_response_size;
+  int64_t shrink_delay_ns;
+  const rcl_allocator_t * allocator;
+
+  _Atomic (rclc_action_goal_handle_t *) * chunks;
+  atomic_size_t number_of_chunks;
+  _Atomic (rclc_action_goal_handle_t *) retired;
+
+  // goal handles taken from the pool
+  atomic_size_t used;
+  // threads inside rclc_action_take_free_goal_handle
+  atomic_size_t active_takers;
+  // last time the pool needed its last chunk
+  atomic_int_least64_t busy_time;
+  // serializes growing and shrinking, which may allocate and deallocate a chunk
+  pthread_mutex_t mutex;
+} rclc_action_goal_handle_pool_t;
+
+// new head of the free list: first goal handle and incremented modification counter
+static uintptr_t _rclc_action_free_list_head(
+  uintptr_t head,
+  rclc_action_goal_handle_t * first)
+{
+  uintptr_t index = (NULL == first) ? 0 : (uintptr_t) first->pool_index;
+  return (((head >> FREE_LIST_INDEX_BITS) + 1) << FREE_LIST_INDEX_BITS) | index;
+}
+
+// goal handle of an index of the free list, NULL for 0 or an index of a removed chunk
+static rclc_action_goal_handle_t * _rclc_action_goal_handle_at(
+  rclc_generic_entity_t * entity,
+  uintptr_t index)
+{
+  if (0 == index) {
+    return NULL;
+  }
+  size_t i = (size_t) index - 1;
+  if (i < entity->goal_handles_memory_size) {
+    return &entity->goal_handles_memory[i];
+  }
+  rclc_action_goal_handle_pool_t * pool = entity->goal_handle_pool;
+  i -= entity->goal_handles_memory_size;
+  if (NULL == pool || i / pool->chunk_size >= pool->max_chunks) {
+    return NULL;
+  }
+  rclc_action_goal_handle_t * chunk = atomic_load_explicit(
+    &pool->chunks[i / pool->chunk_size], memory_order_acquire);
+  return (NULL == chunk) ? NULL : &chunk[i % pool->chunk_size];
+}
+
+// pushes the linked goal handles first ... last onto the free list
+static void _rclc_action_push_free_goal_handles(
+  rclc_generic_entity_t * entity,
+  rclc_action_goal_handle_t * first,
+  rclc_action_goal_handle_t * last)
+{
+  uintptr_t head = atomic_load_explicit(ATOMIC_FREE_LIST(entity), memory_order_relaxed);
+  uintptr_t new_head;
+  do {
+    atomic_store_explicit(
+      ATOMIC_GOAL_HANDLE_PTR(&last->next),
+      _rclc_action_goal_handle_at(entity, FREE_LIST_INDEX(head)),
+      memory_order_release);
+    new_head = _rclc_action_free_list_head(head, first);
+  } while (!atomic_compare_exchange_weak_explicit(
+    ATOMIC_FREE_LIST(entity), &head, new_head,
+    memory_order_release, memory_order_relaxed));
+}
+
+static rclc_action_goal_handle_t * _rclc_action_pop_free_goal_handle(
+  rclc_generic_entity_t * entity)
+{
+  rclc_action_goal_handle_t * handle;
+  uintptr_t head = atomic_load(ATOMIC_FREE_LIST(entity));
+  while (true) {
+    uintptr_t index = FREE_LIST_INDEX(head);
+    if (0 == index) {
+      return NULL;
+    }
+    // next might be stale if another thread took the handle meanwhile,
+    // then the modification counter of the head has changed and the CAS fails
+    handle = _rclc_action_goal_handle_at(entity, index);
+    if (NULL == handle) {
+      // the chunk was removed after head was loaded
+      head = atomic_load(ATOMIC_FREE_LIST(entity));
+      continue;
+    }
+    // acquire: next may be a goal handle of a chunk added by another thread
+    uintptr_t new_head = _rclc_action_free_list_head(
+      head,
+      atomic_load_explicit(ATOMIC_GOAL_HANDLE_PTR(&handle->next), memory_order_acquire));
+    if (atomic_compare_exchange_weak_explicit(
+        ATOMIC_FREE_LIST(entity), &head, new_head,
+        memory_order_acquire, memory_order_acquire))
+    {
+      return handle;
+    }
+  }
+}
+
+// Adds a chunk to an exhausted pool. Returns false if the pool has reached its maximum size
+// or the allocation failed.
+static bool _rclc_action_grow_goal_handle_pool(
+  rclc_generic_entity_t * entity,
+  rclc_action_goal_handle_pool_t * pool)
+{
+  rcutils_time_point_value_t now;
+  if (RCUTILS_RET_OK == rcutils_steady_time_now(&now)) {
+    atomic_store_explicit(&pool->busy_time, now, memory_order_relaxed);
+  }
+
+  pthread_mutex_lock(&pool->mutex);
+  if (0 != FREE_LIST_INDEX(atomic_load(ATOMIC_FREE_LIST(entity)))) {
+    // another thread has added a chunk or returned a goal handle meanwhile
+    pthread_mutex_unlock(&pool->mutex);
+    return true;
+  }
+  size_t slot = atomic_load_explicit(&pool->number_of_chunks, memory_order_relaxed);
+  if (slot == pool->max_chunks) {
+    pthread_mutex_unlock(&pool->mutex);
+    return false;
+  }
+  // a removed chunk, which has not been deallocated yet, is reused in the same slot
+  rclc_action_goal_handle_t * chunk = atomic_exchange(&pool->retired, NULL);
+  if (NULL == chunk) {
+    chunk = pool->allocator->zero_allocate(1, pool->chunk_bytes, pool->allocator->state);
+    if (NULL == chunk) {
+      pthread_mutex_unlock(&pool->mutex);
+      return false;
+    }
+    uint8_t * ros_goal_requests = (uint8_t *) chunk + pool->ros_goal_request_offset;
+    uint8_t * ros_result_responses = (uint8_t *) chunk + pool->ros_result_response_offset;
+    for (size_t i = 0; i < pool->chunk_size; i++) {
+      rclc_action_goal_handle_t * handle = &chunk[i];
+      handle->pool_index = entity->goal_handles_memory_size + slot * pool->chunk_size + i + 1;
+      if (pool->ros_goal_request_size > 0) {
+        handle->action_server = (struct rclc_action_server_t *) entity;
+        handle->ros_goal_request =
+          (void *) &ros_goal_requests[i * pool->ros_goal_request_size];
+        if (pool->ros_result_response_size > 0) {
+          handle->ros_result_response =
+            (void *) &ros_result_responses[i * pool->ros_result_response_size];
+        }
+      } else {
+        handle->action_client = (struct rclc_action_client_t *) entity;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < pool->chunk_size; i++) {
+    rclc_action_goal_handle_t * handle = &chunk[i];
+    atomic_store_explicit(
+      ATOMIC_GOAL_HANDLE_PTR(&handle->next),
+      (i + 1 < pool->chunk_size) ? &chunk[i + 1] : NULL,
+      memory_order_relaxed);
+  }
+  atomic_store_explicit(&pool->chunks[slot], chunk, memory_order_release);
+  atomic_store_explicit(&pool->number_of_chunks, slot + 1, memory_order_relaxed);
+  _rclc_action_push_free_goal_handles(entity, &chunk[0], &chunk[pool->chunk_size - 1]);
+  pthread_mutex_unlock(&pool->mutex);
+  return true;
+}
+
+// Removes the last chunk, if all its goal handles are free. Otherwise its goal handles
+// are moved to the bottom of the free list, so that they are taken last. Called with the mutex locked.
+static void _rclc_action_shrink_goal_handle_pool(
+  rclc_generic_entity_t * entity,
+  rclc_action_goal_handle_pool_t * pool)
+{
+  size_t slot = atomic_load_explicit(&pool->number_of_chunks, memory_order_relaxed) - 1;
+  uintptr_t first_index = entity->goal_handles_memory_size + slot * pool->chunk_size + 1;
+
+  // detach the whole free list
+  uintptr_t head = atomic_load(ATOMIC_FREE_LIST(entity));
+  while (!atomic_compare_exchange_weak(
+    ATOMIC_FREE_LIST(entity), &head, _rclc_action_free_list_head(head, NULL)))
+  {
+  }
+
+  rclc_action_goal_handle_t * keep_first = NULL, * keep_last = NULL;
+  rclc_action_goal_handle_t * chunk_first = NULL, * chunk_last = NULL;
+  size_t free_in_chunk = 0;
+  rclc_action_goal_handle_t * handle = _rclc_action_goal_handle_at(entity, FREE_LIST_INDEX(head));
+  while (NULL != handle) {
+    rclc_action_goal_handle_t * next = atomic_load_explicit(
+      ATOMIC_GOAL_HANDLE_PTR(&handle->next), memory_order_relaxed);
+    if (handle->pool_index >= first_index) {
+      if (NULL == chunk_first) {
+        chunk_first = handle;
+      } else {
+        atomic_store_explicit(
+          ATOMIC_GOAL_HANDLE_PTR(&chunk_last->next), handle, memory_order_release);
+      }
+      chunk_last = handle;
+      free_in_chunk++;
+    } else {
+      if (NULL == keep_first) {
+        keep_first = handle;
+      } else {
+        atomic_store_explicit(
+          ATOMIC_GOAL_HANDLE_PTR(&keep_last->next), handle, memory_order_release);
+      }
+      keep_last = handle;
+    }
+    handle = next;
+  }
+
+  if (free_in_chunk == pool->chunk_size) {
+    rclc_action_goal_handle_t * chunk = atomic_load_explicit(
+      &pool->chunks[slot], memory_order_relaxed);
+    atomic_store(&pool->chunks[slot], NULL);
+    atomic_store_explicit(&pool->number_of_chunks, slot, memory_order_relaxed);
+    atomic_store(&pool->retired, chunk);
+  } else if (NULL != chunk_first) {
+    if (NULL == keep_first) {
+      keep_first = chunk_first;
+    } else {
+      atomic_store_explicit(
+        ATOMIC_GOAL_HANDLE_PTR(&keep_last->next), chunk_first, memory_order_release);
+    }
+    keep_last = chunk_last;
+  }
+  if (NULL != keep_first) {
+    _rclc_action_push_free_goal_handles(entity, keep_first, keep_last);
+  }
+}
+
 void rclc_action_put_goal_handle_in_list(
   rclc_action_goal_handle_t ** list,
   rclc_action_goal_handle_t * goal_handle)
@@ -36,8 +288,14 @@ void rclc_action_put_goal_handle_in_list(
   RCL_CHECK_FOR_NULL_WITH_MSG(
     goal_handle, "goal_handle is a null pointer", return );
 
-  goal_handle->next = *list;
-  *list = goal_handle;
+  rclc_action_goal_handle_t * first = atomic_load_explicit(
+    ATOMIC_GOAL_HANDLE_PTR(list), memory_order_relaxed);
+  do {
+    atomic_store_explicit(
+      ATOMIC_GOAL_HANDLE_PTR(&goal_handle->next), first, memory_order_relaxed);
+  } while (!atomic_compare_exchange_weak_explicit(
+    ATOMIC_GOAL_HANDLE_PTR(list), &first, goal_handle,
+    memory_order_release, memory_order_relaxed));
 }
 
 bool rclc_action_check_handle_in_list(
@@ -49,7 +307,8 @@ bool rclc_action_check_handle_in_list(
   RCL_CHECK_FOR_NULL_WITH_MSG(
     goal_handle, "goal_handle is a null pointer", return false);
 
-  rclc_action_goal_handle_t * handle = *list;
+  rclc_action_goal_handle_t * handle = atomic_load_explicit(
+    ATOMIC_GOAL_HANDLE_PTR(list), memory_order_acquire);
   while (NULL != handle) {
     if (handle == goal_handle) {
       return true;
@@ -65,8 +324,15 @@ rclc_action_goal_handle_t * rclc_action_pop_first_goal_handle_from_list(
   RCL_CHECK_FOR_NULL_WITH_MSG(
     list, "list is a null pointer", return NULL);
 
-  rclc_action_goal_handle_t * handle = *list;
-  *list = (*list == NULL ) ? NULL : (*list)->next;
+  // only one thread may remove goal handles from a list
+  rclc_action_goal_handle_t * handle = atomic_load_explicit(
+    ATOMIC_GOAL_HANDLE_PTR(list), memory_order_acquire);
+  while (NULL != handle &&
+    !atomic_compare_exchange_weak_explicit(
+      ATOMIC_GOAL_HANDLE_PTR(list), &handle, handle->next,
+      memory_order_acquire, memory_order_acquire))
+  {
+  }
   return handle;
 }
 
@@ -79,9 +345,15 @@ bool rclc_action_pop_goal_handle_from_list(
   RCL_CHECK_FOR_NULL_WITH_MSG(
     goal_handle, "goal_handle is a null pointer", return false);
 
-  rclc_action_goal_handle_t * handle = *list;
-  if (goal_handle == handle) {
-    *list = handle->next;
+  // only one thread may remove goal handles from a list, other threads may insert
+  // goal handles at the front concurrently
+  rclc_action_goal_handle_t * handle = atomic_load_explicit(
+    ATOMIC_GOAL_HANDLE_PTR(list), memory_order_acquire);
+  if (goal_handle == handle &&
+    atomic_compare_exchange_strong_explicit(
+      ATOMIC_GOAL_HANDLE_PTR(list), &handle, goal_handle->next,
+      memory_order_acq_rel, memory_order_acquire))
+  {
     return true;
   }
 
@@ -95,6 +367,71 @@ bool rclc_action_pop_goal_handle_from_list(
   return false;
 }
 
+rclc_action_goal_handle_t * rclc_action_get_first_used_goal_handle(
+  void * untyped_entity)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    untyped_entity, "untyped_entity is a null pointer", return NULL);
+
+  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
+  return atomic_load_explicit(
+    ATOMIC_GOAL_HANDLE_PTR(&entity->used_goal_handles), memory_order_acquire);
+}
+
+rclc_action_goal_handle_t * rclc_action_take_free_goal_handle(
+  void * untyped_entity)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    untyped_entity, "untyped_entity is a null pointer", return NULL);
+
+  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
+  rclc_action_goal_handle_pool_t * pool = entity->goal_handle_pool;
+  rclc_action_goal_handle_t * handle;
+  if (NULL == pool) {
+    handle = _rclc_action_pop_free_goal_handle(entity);
+  } else {
+    do {
+      atomic_fetch_add(&pool->active_takers, 1);
+      handle = _rclc_action_pop_free_goal_handle(entity);
+      atomic_fetch_sub(&pool->active_takers, 1);
+    } while (NULL == handle && _rclc_action_grow_goal_handle_pool(entity, pool));
+    if (NULL != handle) {
+      atomic_fetch_add_explicit(&pool->used, 1, memory_order_relaxed);
+    }
+  }
+  if (NULL == handle) {
+    return NULL;
+  }
+
+  // Initialize handle
+  handle->available_goal_response = false;
+  handle->goal_accepted = false;
+  handle->available_feedback = false;
+  handle->available_result_response = false;
+  handle->available_cancel_response = false;
+  handle->goal_cancelled = false;
+  handle->goal_accepted_time = 0;
+  handle->status = GOAL_STATE_UNKNOWN;
+
+  return handle;
+}
+
+void rclc_action_put_free_goal_handle(
+  void * untyped_entity,
+  rclc_action_goal_handle_t * goal_handle)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    untyped_entity, "untyped_entity is a null pointer", return );
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    goal_handle, "goal_handle is a null pointer", return );
+
+  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
+  _rclc_action_push_free_goal_handles(entity, goal_handle, goal_handle);
+  if (NULL != entity->goal_handle_pool) {
+    atomic_fetch_sub_explicit(&entity->goal_handle_pool->used, 1, memory_order_relaxed);
+  }
+}
+
 rclc_action_goal_handle_t * rclc_action_take_goal_handle(
   void * untyped_entity)
 {
@@ -102,18 +439,9 @@ rclc_action_goal_handle_t * rclc_action_take_goal_handle(
     untyped_entity, "untyped_entity is a null pointer", return NULL);
 
   rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
-  rclc_action_goal_handle_t * handle = rclc_action_pop_first_goal_handle_from_list(
-    &entity->free_goal_handles);
+  rclc_action_goal_handle_t * handle = rclc_action_take_free_goal_handle(entity);
 
   if (NULL != handle) {
-    // Initialize handle
-    handle->available_goal_response = false;
-    handle->goal_accepted = false;
-    handle->available_feedback = false;
-    handle->available_result_response = false;
-    handle->available_cancel_response = false;
-    handle->goal_cancelled = false;
-    handle->status = GOAL_STATE_UNKNOWN;
     rclc_action_put_goal_handle_in_list(&entity->used_goal_handles, handle);
   }
 
@@ -127,12 +455,14 @@ void rclc_action_init_goal_handle_memory(
     untyped_entity, "untyped_entity is a null pointer", return );
 
   rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
-  entity->free_goal_handles = entity->goal_handles_memory;
+  rclc_action_goal_handle_t * memory = entity->goal_handles_memory;
   size_t size = entity->goal_handles_memory_size;
-  for (size_t i = 0; i < size - 1; i++) {
-    entity->free_goal_handles[i].next = &entity->free_goal_handles[i + 1];
+  for (size_t i = 0; i < size; i++) {
+    memory[i].next = (i + 1 < size) ? &memory[i + 1] : NULL;
+    memory[i].pool_index = i + 1;
   }
-  entity->free_goal_handles[size - 1].next = NULL;
+  entity->used_goal_handles = NULL;
+  atomic_store_explicit(ATOMIC_FREE_LIST(entity), 1, memory_order_release);
 }
 
 void rclc_action_remove_used_goal_handle(
@@ -146,10 +476,187 @@ void rclc_action_remove_used_goal_handle(
 
   rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
   if (rclc_action_pop_goal_handle_from_list(&entity->used_goal_handles, goal_handle)) {
-    rclc_action_put_goal_handle_in_list(&entity->free_goal_handles, goal_handle);
+    rclc_action_put_free_goal_handle(entity, goal_handle);
   }
 }
 
+rcl_ret_t rclc_action_init_goal_handle_pool(
+  void * untyped_entity,
+  const rclc_action_goal_handle_pool_options_t * options,
+  size_t ros_goal_request_size,
+  size_t ros_result_response_size,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    untyped_entity, "untyped_entity is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    options, "options is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+
+  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
+  if (NULL == entity->goal_handles_memory) {
+    RCL_SET_ERROR_MSG("goal handles not initialized, add the entity to an executor first");
+    return RCL_RET_ERROR;
+  }
+  if (NULL != entity->goal_handle_pool) {
+    RCL_SET_ERROR_MSG("elastic goal handle pool already initialized");
+    return RCL_RET_ERROR;
+  }
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  if (0 == options->chunk_size || options->shrink_delay_ns < 0 ||
+    options->max_handles > RCLC_ACTION_GOAL_HANDLE_POOL_MAX_SIZE ||
+    options->max_handles < entity->goal_handles_memory_size + options->chunk_size)
+  {
+    RCL_SET_ERROR_MSG(
+      "chunk_size is 0, shrink_delay_ns is negative or max_handles is not in "
+      "[handles_number + chunk_size, RCLC_ACTION_GOAL_HANDLE_POOL_MAX_SIZE]");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  rclc_action_goal_handle_pool_t * pool = allocator->zero_allocate(
+    1, sizeof(rclc_action_goal_handle_pool_t), allocator->state);
+  if (NULL == pool) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for the goal handle pool.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  pool->chunk_size = options->chunk_size;
+  pool->max_chunks = (options->max_handles - entity->goal_handles_memory_size) /
+    options->chunk_size;
+  pool->chunks = allocator->allocate(
+    pool->max_chunks * sizeof(*pool->chunks), allocator->state);
+  if (NULL == pool->chunks) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for the goal handle pool.");
+    allocator->deallocate(pool, allocator->state);
+    return RCL_RET_BAD_ALLOC;
+  }
+  for (size_t i = 0; i < pool->max_chunks; i++) {
+    atomic_init(&pool->chunks[i], NULL);
+  }
+
+  // goal handles and, for an action server, the goal requests and the result slots of one chunk
+  size_t alignment = _Alignof(max_align_t);
+  pool->ros_goal_request_offset =
+    (pool->chunk_size * sizeof(rclc_action_goal_handle_t) + alignment - 1) & ~(alignment - 1);
+  pool->ros_goal_request_size = ros_goal_request_size;
+  pool->ros_result_response_offset =
+    (pool->ros_goal_request_offset + pool->chunk_size * ros_goal_request_size + alignment - 1) &
+    ~(alignment - 1);
+  pool->ros_result_response_size = ros_result_response_size;
+  pool->chunk_bytes = pool->ros_result_response_offset +
+    pool->chunk_size * ros_result_response_size;
+  pool->shrink_delay_ns = options->shrink_delay_ns;
+  pool->allocator = allocator;
+
+  rcutils_time_point_value_t now = 0;
+  rcutils_ret_t rc = rcutils_steady_time_now(&now);
+  RCLC_UNUSED(rc);
+  atomic_init(&pool->number_of_chunks, 0);
+  atomic_init(&pool->retired, NULL);
+  atomic_init(&pool->used, 0);
+  atomic_init(&pool->active_takers, 0);
+  atomic_init(&pool->busy_time, now);
+  if (0 != pthread_mutex_init(&pool->mutex, NULL)) {
+    RCL_SET_ERROR_MSG("Could not initialize the mutex of the goal handle pool.");
+    allocator->deallocate(pool->chunks, allocator->state);
+    allocator->deallocate(pool, allocator->state);
+    return RCL_RET_ERROR;
+  }
+
+  // goal handles in use before are not counted, they are returned to the pool later
+  for (rclc_action_goal_handle_t * handle = rclc_action_get_first_used_goal_handle(entity);
+    NULL != handle; handle = handle->next)
+  {
+    atomic_fetch_add(&pool->used, 1);
+  }
+  entity->goal_handle_pool = pool;
+  return RCL_RET_OK;
+}
+
+void rclc_action_fini_goal_handle_pool(
+  void * untyped_entity)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    untyped_entity, "untyped_entity is a null pointer", return );
+
+  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
+  rclc_action_goal_handle_pool_t * pool = entity->goal_handle_pool;
+  if (NULL == pool) {
+    return;
+  }
+  const rcl_allocator_t * allocator = pool->allocator;
+  for (size_t i = 0; i < pool->max_chunks; i++) {
+    rclc_action_goal_handle_t * chunk = atomic_load(&pool->chunks[i]);
+    if (NULL != chunk) {
+      allocator->deallocate(chunk, allocator->state);
+    }
+  }
+  rclc_action_goal_handle_t * retired = atomic_load(&pool->retired);
+  if (NULL != retired) {
+    allocator->deallocate(retired, allocator->state);
+  }
+  pthread_mutex_destroy(&pool->mutex);
+  allocator->deallocate(pool->chunks, allocator->state);
+  allocator->deallocate(pool, allocator->state);
+  entity->goal_handle_pool = NULL;
+}
+
+void rclc_action_trim_goal_handle_pool(
+  void * untyped_entity)
+{
+  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
+  rclc_action_goal_handle_pool_t * pool = entity->goal_handle_pool;
+  if (NULL == pool ||
+    (0 == atomic_load_explicit(&pool->number_of_chunks, memory_order_relaxed) &&
+    NULL == atomic_load_explicit(&pool->retired, memory_order_relaxed)))
+  {
+    return;
+  }
+  rcutils_time_point_value_t now;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    return;
+  }
+
+  pthread_mutex_lock(&pool->mutex);
+  size_t number_of_chunks = atomic_load_explicit(&pool->number_of_chunks, memory_order_relaxed);
+  size_t capacity = entity->goal_handles_memory_size + number_of_chunks * pool->chunk_size;
+  size_t used = atomic_load_explicit(&pool->used, memory_order_relaxed);
+  if (number_of_chunks > 0 && NULL == atomic_load(&pool->retired)) {
+    if (used + pool->chunk_size > capacity) {
+      // the goal handles in use do not fit into the pool without its last chunk
+      atomic_store_explicit(&pool->busy_time, now, memory_order_relaxed);
+    } else if (now - atomic_load_explicit(&pool->busy_time, memory_order_relaxed) >=
+      pool->shrink_delay_ns)
+    {
+      _rclc_action_shrink_goal_handle_pool(entity, pool);
+      atomic_store_explicit(&pool->busy_time, now, memory_order_relaxed);
+    }
+  }
+  // a removed chunk is deallocated once no thread can hold a stale pointer into it
+  rclc_action_goal_handle_t * retired = atomic_load(&pool->retired);
+  if (NULL != retired && 0 == atomic_load(&pool->active_takers)) {
+    atomic_store(&pool->retired, NULL);
+    pool->allocator->deallocate(retired, pool->allocator->state);
+  }
+  pthread_mutex_unlock(&pool->mutex);
+}
+
+size_t rclc_action_get_goal_handle_capacity(
+  void * untyped_entity)
+{
+  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
+  rclc_action_goal_handle_pool_t * pool = entity->goal_handle_pool;
+  return entity->goal_handles_memory_size +
+         ((NULL == pool) ? 0 : pool->max_chunks * pool->chunk_size);
+}
+
+size_t rclc_action_get_goal_handle_pool_size(
+  void * untyped_entity)
+{
+  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
+  rclc_action_goal_handle_pool_t * pool = entity->goal_handle_pool;
+  return entity->goal_handles_memory_size +
+         ((NULL == pool) ? 0 : atomic_load(&pool->number_of_chunks) * pool->chunk_size);
+}
+
 rclc_action_goal_handle_t * rclc_action_find_goal_handle_by_uuid(
   void * untyped_entity,
   const unique_identifier_msgs__msg__UUID * uuid_msg)
@@ -159,8 +666,7 @@ rclc_action_goal_handle_t * rclc_action_find_goal_handle_by_uuid(
   RCL_CHECK_FOR_NULL_WITH_MSG(
     uuid_msg, "uuid_msg is a null pointer", return NULL);
 
-  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
-  rclc_action_goal_handle_t * handle = entity->used_goal_handles;
+  rclc_action_goal_handle_t * handle = rclc_action_get_first_used_goal_handle(untyped_entity);
   while (NULL != handle) {
     if (uuidcmp(handle->goal_id.uuid, uuid_msg->uuid)) {
       return handle;
@@ -177,8 +683,7 @@ rclc_action_goal_handle_t * rclc_action_find_first_handle_by_status(
   RCL_CHECK_FOR_NULL_WITH_MSG(
     untyped_entity, "untyped_entity is a null pointer", return NULL);
 
-  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
-  rclc_action_goal_handle_t * handle = entity->used_goal_handles;
+  rclc_action_goal_handle_t * handle = rclc_action_get_first_used_goal_handle(untyped_entity);
   while (NULL != handle) {
     if (handle->status == status) {
       return handle;
@@ -207,8 +712,7 @@ rclc_action_goal_handle_t * rclc_action_find_first_terminated_handle(
   RCL_CHECK_FOR_NULL_WITH_MSG(
     untyped_entity, "untyped_entity is a null pointer", return NULL);
 
-  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
-  rclc_action_goal_handle_t * handle = entity->used_goal_handles;
+  rclc_action_goal_handle_t * handle = rclc_action_get_first_used_goal_handle(untyped_entity);
   while (NULL != handle) {
     if (handle->status > GOAL_STATE_CANCELING) {
       return handle;
@@ -225,8 +729,7 @@ rclc_action_goal_handle_t * rclc_action_find_handle_by_goal_request_sequence_num
   RCL_CHECK_FOR_NULL_WITH_MSG(
     untyped_entity, "untyped_entity is a null pointer", return NULL);
 
-  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
-  rclc_action_goal_handle_t * handle = entity->used_goal_handles;
+  rclc_action_goal_handle_t * handle = rclc_action_get_first_used_goal_handle(untyped_entity);
   while (NULL != handle) {
     if (handle->goal_request_sequence_number == goal_request_sequence_number) {
       return handle;
@@ -243,8 +746,7 @@ rclc_action_goal_handle_t * rclc_action_find_handle_by_result_request_sequence_n
   RCL_CHECK_FOR_NULL_WITH_MSG(
     untyped_entity, "untyped_entity is a null pointer", return NULL);
 
-  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
-  rclc_action_goal_handle_t * handle = entity->used_goal_handles;
+  rclc_action_goal_handle_t * handle = rclc_action_get_first_used_goal_handle(untyped_entity);
   while (NULL != handle) {
     if (handle->result_request_sequence_number == result_request_sequence_number) {
       return handle;
@@ -261,8 +763,7 @@ rclc_action_goal_handle_t * rclc_action_find_handle_by_cancel_request_sequence_n
   RCL_CHECK_FOR_NULL_WITH_MSG(
     untyped_entity, "untyped_entity is a null pointer", return NULL);
 
-  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
-  rclc_action_goal_handle_t * handle = entity->used_goal_handles;
+  rclc_action_goal_handle_t * handle = rclc_action_get_first_used_goal_handle(untyped_entity);
   while (NULL != handle) {
     if (handle->cancel_request_sequence_number == cancel_request_sequence_number) {
       return handle;
@@ -278,8 +779,7 @@ rclc_action_goal_handle_t * rclc_action_find_first_handle_with_goal_response(
   RCL_CHECK_FOR_NULL_WITH_MSG(
     untyped_entity, "untyped_entity is a null pointer", return NULL);
 
-  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
-  rclc_action_goal_handle_t * handle = entity->used_goal_handles;
+  rclc_action_goal_handle_t * handle = rclc_action_get_first_used_goal_handle(untyped_entity);
   while (NULL != handle) {
     if (handle->available_goal_response) {
       return handle;
@@ -295,8 +795,7 @@ rclc_action_goal_handle_t * rclc_action_find_first_handle_with_feedback(
   RCL_CHECK_FOR_NULL_WITH_MSG(
     untyped_entity, "untyped_entity is a null pointer", return NULL);
 
-  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
-  rclc_action_goal_handle_t * handle = entity->used_goal_handles;
+  rclc_action_goal_handle_t * handle = rclc_action_get_first_used_goal_handle(untyped_entity);
   while (NULL != handle) {
     if (handle->available_feedback) {
       return handle;
@@ -312,8 +811,7 @@ rclc_action_goal_handle_t * rclc_action_find_first_handle_with_result_response(
   RCL_CHECK_FOR_NULL_WITH_MSG(
     untyped_entity, "untyped_entity is a null pointer", return NULL);
 
-  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
-  rclc_action_goal_handle_t * handle = entity->used_goal_handles;
+  rclc_action_goal_handle_t * handle = rclc_action_get_first_used_goal_handle(untyped_entity);
   while (NULL != handle) {
     if (handle->available_result_response) {
       return handle;
@@ -329,8 +827,7 @@ rclc_action_goal_handle_t * rclc_action_find_first_handle_with_cancel_response(
   RCL_CHECK_FOR_NULL_WITH_MSG(
     untyped_entity, "untyped_entity is a null pointer", return NULL);
 
-  rclc_generic_entity_t * entity = (rclc_generic_entity_t *) untyped_entity;
-  rclc_action_goal_handle_t * handle = entity->used_goal_handles;
+  rclc_action_goal_handle_t * handle = rclc_action_get_first_used_goal_handle(untyped_entity);
   while (NULL != handle) {
     if (handle->available_cancel_response) {
       return handle;
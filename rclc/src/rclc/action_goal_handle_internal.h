@@ -43,6 +43,16 @@ bool rclc_action_pop_goal_handle_from_list(
   rclc_action_goal_handle_t ** list,
   rclc_action_goal_handle_t * goal_handle);
 
+rclc_action_goal_handle_t * rclc_action_get_first_used_goal_handle(
+  void * untyped_entity);
+
+rclc_action_goal_handle_t * rclc_action_take_free_goal_handle(
+  void * untyped_entity);
+
+void rclc_action_put_free_goal_handle(
+  void * untyped_entity,
+  rclc_action_goal_handle_t * goal_handle);
+
 rclc_action_goal_handle_t * rclc_action_take_goal_handle(
   void * untyped_entity);
 
@@ -53,6 +63,32 @@ void rclc_action_remove_used_goal_handle(
   void * untyped_entity,
   rclc_action_goal_handle_t * goal_handle);
 
+/// Makes the goal handle pool of an action server or client elastic, see
+/// rclc_action_server_set_elastic_goal_handles(). ros_goal_request_size is 0 for a client,
+/// ros_result_response_size is 0 for a client and an action server without result storage.
+rcl_ret_t rclc_action_init_goal_handle_pool(
+  void * untyped_entity,
+  const rclc_action_goal_handle_pool_options_t * options,
+  size_t ros_goal_request_size,
+  size_t ros_result_response_size,
+  const rcl_allocator_t * allocator);
+
+void rclc_action_fini_goal_handle_pool(
+  void * untyped_entity);
+
+/// Releases the last chunk of an elastic pool, if it has not been needed for
+/// shrink_delay_ns. Only called by the executor.
+void rclc_action_trim_goal_handle_pool(
+  void * untyped_entity);
+
+/// Maximum number of goal handles
+size_t rclc_action_get_goal_handle_capacity(
+  void * untyped_entity);
+
+/// Number of goal handles currently allocated
+size_t rclc_action_get_goal_handle_pool_size(
+  void * untyped_entity);
+
 rclc_action_goal_handle_t * rclc_action_find_goal_handle_by_uuid(
   void * untyped_entity,
   const unique_identifier_msgs__msg__UUID * uuid_msg);
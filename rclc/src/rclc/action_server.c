@@ -15,11 +15,19 @@
 
 #include <rclc/action_server.h>
 
+#include <stdatomic.h>
+#include <string.h>
+
 #include <rcl/error_handling.h>
 #include <rcutils/logging_macros.h>
+#include <rcutils/time.h>
 
 #include "./action_generic_types.h"
 #include "./action_goal_handle_internal.h"
+#include "./action_server_internal.h"
+
+// result_state is written by the executor and the threads finishing goals
+#define ATOMIC_RESULT_STATE(goal_handle) ((atomic_uint *) &(goal_handle)->result_state)
 
 rcl_ret_t
 rclc_action_server_init_default(
@@ -82,6 +90,14 @@ rclc_action_server_response_goal_request(
   Generic_SendGoal_Response res = {0};
   res.accepted = accepted;
 
+  // System time, as the stamps of cancel requests
+  if (accepted) {
+    if (RCUTILS_RET_OK != rcutils_system_time_now(&goal_handle->goal_accepted_time)) {
+      PRINT_RCLC_ERROR(rclc_action_server_response_goal_request, rcutils_system_time_now);
+      return RCL_RET_ERROR;
+    }
+  }
+
   rcl_ret_t rc = rcl_action_send_goal_response(
     &action_server->rcl_handle,
     &goal_handle->goal_request_header, &res);
@@ -93,45 +109,99 @@ rclc_action_server_response_goal_request(
   return RCL_RET_OK;
 }
 
-rcl_ret_t
-rclc_action_server_goal_cancel_accept(
-  rclc_action_goal_handle_t * goal_handle)
+// Returns true if the goal is selected by the cancel request. As defined by
+// action_msgs/srv/CancelGoal, a zero goal id and a zero stamp select all goals,
+// a stamp selects all goals accepted at or before it and a goal id selects
+// this goal. Goals, which have not been accepted yet, are never selected.
+static bool rclc_action_server_cancel_request_selects(
+  const action_msgs__srv__CancelGoal_Request * request,
+  rcl_time_point_value_t stamp,
+  const rclc_action_goal_handle_t * goal_handle)
 {
-  RCL_CHECK_FOR_NULL_WITH_MSG(
-    goal_handle, "goal_handle is a null pointer", return RCL_RET_INVALID_ARGUMENT);
-
-  rcl_action_cancel_response_t cancel_response =
-    rcl_action_get_zero_initialized_cancel_response();
-  cancel_response.msg.return_code = CANCEL_STATE_OK;
-
-  action_msgs__msg__GoalInfo goal_info;
-  goal_info.goal_id = goal_handle->goal_id;
-
-  cancel_response.msg.goals_canceling.data = &goal_info;
-  cancel_response.msg.goals_canceling.size = 1;
-  cancel_response.msg.goals_canceling.capacity = 1;
-
-  return rcl_action_send_cancel_response(
-    &goal_handle->action_server->rcl_handle,
-    &goal_handle->cancel_request_header, &cancel_response.msg);
+  if (GOAL_STATE_UNKNOWN == goal_handle->status) {
+    return false;
+  }
+  bool zero_goal_id = uuidcmpzero(request->goal_info.goal_id.uuid);
+  if (zero_goal_id && 0 == stamp) {
+    return true;
+  }
+  if (!zero_goal_id && uuidcmp(goal_handle->goal_id.uuid, request->goal_info.goal_id.uuid)) {
+    return true;
+  }
+  return 0 != stamp && goal_handle->goal_accepted_time <= stamp;
 }
 
 rcl_ret_t
-rclc_action_server_goal_cancel_reject(
+rclc_action_server_process_cancel_request(
   rclc_action_server_t * action_server,
-  rcl_action_cancel_state_t state,
-  rmw_request_id_t cancel_request_header)
+  void * context)
 {
   RCL_CHECK_FOR_NULL_WITH_MSG(
     action_server, "action_server is a null pointer", return RCL_RET_INVALID_ARGUMENT);
 
+  const action_msgs__srv__CancelGoal_Request * request = &action_server->cancel_request;
+  rcl_time_point_value_t stamp =
+    RCL_S_TO_NS((int64_t) request->goal_info.stamp.sec) + request->goal_info.stamp.nanosec;
+
   rcl_action_cancel_response_t cancel_response =
     rcl_action_get_zero_initialized_cancel_response();
-  cancel_response.msg.return_code = state;
+  cancel_response.msg.goals_canceling.data = action_server->cancel_goals_memory;
+  cancel_response.msg.goals_canceling.size = 0;
+  cancel_response.msg.goals_canceling.capacity =
+    rclc_action_get_goal_handle_capacity(action_server);
+
+  size_t selected = 0, cancelable = 0;
+  rclc_action_goal_handle_t * goal_handle;
+  for (goal_handle = rclc_action_get_first_used_goal_handle(action_server);
+    NULL != goal_handle;
+    goal_handle = goal_handle->next)
+  {
+    if (!rclc_action_server_cancel_request_selects(request, stamp, goal_handle)) {
+      continue;
+    }
+    selected++;
+    // a goal with a stored result has already terminated
+    if (RCLC_ACTION_RESULT_STORED == atomic_load_explicit(
+        ATOMIC_RESULT_STATE(goal_handle), memory_order_acquire))
+    {
+      continue;
+    }
+    if (GOAL_STATE_CANCELING != rcl_action_transition_goal_state(
+        goal_handle->status, GOAL_EVENT_CANCEL_GOAL))
+    {
+      continue;
+    }
+    cancelable++;
+    goal_handle->cancel_request_header = action_server->cancel_request_header;
+    goal_handle->goal_cancelled = action_server->cancel_callback(goal_handle, context);
+    if (goal_handle->goal_cancelled) {
+      goal_handle->status = GOAL_STATE_CANCELING;
+      action_msgs__msg__GoalInfo * goal_info =
+        &cancel_response.msg.goals_canceling.data[cancel_response.msg.goals_canceling.size++];
+      goal_info->goal_id = goal_handle->goal_id;
+      goal_info->stamp.sec = (int32_t) RCL_NS_TO_S(goal_handle->goal_accepted_time);
+      goal_info->stamp.nanosec =
+        (uint32_t) (goal_handle->goal_accepted_time % RCL_S_TO_NS(1));
+    }
+  }
 
-  return rcl_action_send_cancel_response(
+  if (cancel_response.msg.goals_canceling.size > 0) {
+    cancel_response.msg.return_code = CANCEL_STATE_OK;
+  } else if (0 == selected && !uuidcmpzero(request->goal_info.goal_id.uuid)) {
+    cancel_response.msg.return_code = CANCEL_STATE_UNKNOWN_GOAL;
+  } else if (selected > 0 && 0 == cancelable) {
+    cancel_response.msg.return_code = CANCEL_STATE_TERMINATED;
+  } else {
+    cancel_response.msg.return_code = CANCEL_STATE_REJECTED;
+  }
+
+  rcl_ret_t rc = rcl_action_send_cancel_response(
     &action_server->rcl_handle,
-    &cancel_request_header, &cancel_response.msg);
+    &action_server->cancel_request_header, &cancel_response.msg);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_action_server_process_cancel_request, rcl_action_send_cancel_response);
+  }
+  return rc;
 }
 
 rcl_ret_t rclc_action_publish_feedback(
@@ -155,6 +225,34 @@ rcl_ret_t rclc_action_publish_feedback(
   return rcl_action_publish_feedback(&goal_handle->action_server->rcl_handle, feedback);
 }
 
+// Sends the result response stored in the slot of the goal handle and releases the slot
+static rcl_ret_t
+_rclc_action_server_send_stored_result(
+  rclc_action_goal_handle_t * goal_handle)
+{
+  rclc_action_server_t * action_server = goal_handle->action_server;
+  Generic_GetResult_Response * response =
+    (Generic_GetResult_Response *) goal_handle->ros_result_response;
+
+  rcl_ret_t rc = rcl_action_send_result_response(
+    &action_server->rcl_handle,
+    &goal_handle->result_request_header, response);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_action_send_result, rcl_action_send_result_response);
+  }
+
+  goal_handle->status = response->status;
+  if (NULL != action_server->result_fini) {
+    action_server->result_fini(response);
+  }
+  memset(response, 0, action_server->ros_result_response_size);
+  atomic_store_explicit(
+    ATOMIC_RESULT_STATE(goal_handle), RCLC_ACTION_RESULT_SENT, memory_order_relaxed);
+  action_server->goal_ended = true;
+
+  return rc;
+}
+
 rcl_ret_t rclc_action_send_result(
   rclc_action_goal_handle_t * goal_handle,
   rcl_action_goal_state_t status,
@@ -171,25 +269,180 @@ rcl_ret_t rclc_action_send_result(
 
   if (status <= GOAL_STATE_CANCELING) {
     return RCL_RET_INVALID_ARGUMENT;
-  } else if (goal_handle->status != GOAL_STATE_EXECUTING && // NOLINT
-    goal_handle->status != GOAL_STATE_CANCELING)
-  {
-    return RCLC_RET_ACTION_WAIT_RESULT_REQUEST;
   }
 
+  rclc_action_server_t * action_server = goal_handle->action_server;
   Generic_GetResult_Response * response = (Generic_GetResult_Response *)ros_response;
   response->status = status;
 
+  unsigned int state = atomic_load_explicit(
+    ATOMIC_RESULT_STATE(goal_handle), memory_order_acquire);
+  if (RCLC_ACTION_RESULT_STORED == state || RCLC_ACTION_RESULT_SENT == state) {
+    RCL_SET_ERROR_MSG("result of the goal has already been sent or stored");
+    return RCL_RET_ERROR;
+  } else if (RCLC_ACTION_RESULT_NONE == state) {
+    if (NULL == goal_handle->ros_result_response) {
+      return RCLC_RET_ACTION_WAIT_RESULT_REQUEST;
+    }
+
+    // store the result until the executor takes the result request
+    if (NULL != action_server->result_copy) {
+      if (!action_server->result_copy(response, goal_handle->ros_result_response)) {
+        RCL_SET_ERROR_MSG("Could not copy the result response.");
+        return RCL_RET_BAD_ALLOC;
+      }
+    } else {
+      memcpy(goal_handle->ros_result_response, response, action_server->ros_result_response_size);
+    }
+    if (atomic_compare_exchange_strong_explicit(
+        ATOMIC_RESULT_STATE(goal_handle), &state, RCLC_ACTION_RESULT_STORED,
+        memory_order_acq_rel, memory_order_acquire))
+    {
+      return RCL_RET_OK;
+    }
+    // the result has been requested meanwhile
+    return _rclc_action_server_send_stored_result(goal_handle);
+  }
+
   rcl_ret_t rc = rcl_action_send_result_response(
-    &goal_handle->action_server->rcl_handle,
+    &action_server->rcl_handle,
     &goal_handle->result_request_header, response);
 
   goal_handle->status = status;
-  goal_handle->action_server->goal_ended = true;
+  atomic_store_explicit(
+    ATOMIC_RESULT_STATE(goal_handle), RCLC_ACTION_RESULT_SENT, memory_order_relaxed);
+  action_server->goal_ended = true;
 
   return rc;
 }
 
+rcl_ret_t
+rclc_action_server_process_result_request(
+  rclc_action_goal_handle_t * goal_handle,
+  const rmw_request_id_t * result_request_header)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    goal_handle, "goal_handle is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    result_request_header, "result_request_header is a null pointer",
+    return RCL_RET_INVALID_ARGUMENT);
+
+  // the header and the status are set before the request is published to
+  // rclc_action_send_result, which may send the result from another thread
+  rcl_action_goal_state_t status = goal_handle->status;
+  goal_handle->result_request_header = *result_request_header;
+  goal_handle->status = GOAL_STATE_EXECUTING;
+
+  unsigned int state = RCLC_ACTION_RESULT_NONE;
+  if (atomic_compare_exchange_strong_explicit(
+      ATOMIC_RESULT_STATE(goal_handle), &state, RCLC_ACTION_RESULT_REQUESTED,
+      memory_order_acq_rel, memory_order_acquire))
+  {
+    return RCL_RET_OK;
+  }
+  if (RCLC_ACTION_RESULT_STORED == state) {
+    return _rclc_action_server_send_stored_result(goal_handle);
+  }
+  if (RCLC_ACTION_RESULT_SENT == state) {
+    // the result has already been sent, the goal stays terminated
+    goal_handle->status = status;
+  }
+  return RCL_RET_OK;
+}
+
+void
+rclc_action_server_reset_result(
+  rclc_action_goal_handle_t * goal_handle)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    goal_handle, "goal_handle is a null pointer", return );
+
+  rclc_action_server_t * action_server = goal_handle->action_server;
+  if (RCLC_ACTION_RESULT_STORED == atomic_load_explicit(
+      ATOMIC_RESULT_STATE(goal_handle), memory_order_acquire))
+  {
+    if (NULL != action_server->result_fini) {
+      action_server->result_fini(goal_handle->ros_result_response);
+    }
+    memset(goal_handle->ros_result_response, 0, action_server->ros_result_response_size);
+  }
+  atomic_store_explicit(
+    ATOMIC_RESULT_STATE(goal_handle), RCLC_ACTION_RESULT_NONE, memory_order_relaxed);
+}
+
+rcl_ret_t
+rclc_action_server_set_result_storage(
+  rclc_action_server_t * action_server,
+  size_t ros_result_response_size,
+  rclc_action_server_result_copy_t copy,
+  rclc_action_server_result_fini_t fini)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    action_server, "action_server is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (0 == ros_result_response_size) {
+    RCL_SET_ERROR_MSG("ros_result_response_size is 0");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (NULL == action_server->goal_handles_memory) {
+    RCL_SET_ERROR_MSG("goal handles not initialized, add the action server to an executor first");
+    return RCL_RET_ERROR;
+  }
+  if (NULL != action_server->goal_handle_pool || NULL != action_server->result_responses_memory) {
+    RCL_SET_ERROR_MSG("goal handle pool already elastic or result storage already set");
+    return RCL_RET_ERROR;
+  }
+
+  // zeroed slots, which the generated copy functions accept as initialized messages
+  uint8_t * result_responses_memory = action_server->allocator->zero_allocate(
+    action_server->goal_handles_memory_size, ros_result_response_size,
+    action_server->allocator->state);
+  if (NULL == result_responses_memory) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for the result responses.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  for (size_t i = 0; i < action_server->goal_handles_memory_size; i++) {
+    action_server->goal_handles_memory[i].ros_result_response =
+      (void *) &result_responses_memory[i * ros_result_response_size];
+  }
+  action_server->result_responses_memory = result_responses_memory;
+  action_server->ros_result_response_size = ros_result_response_size;
+  action_server->result_copy = copy;
+  action_server->result_fini = fini;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_action_server_set_elastic_goal_handles(
+  rclc_action_server_t * action_server,
+  const rclc_action_goal_handle_pool_options_t * options)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    action_server, "action_server is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    options, "options is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+
+  rcl_ret_t rc = rclc_action_init_goal_handle_pool(
+    action_server, options, action_server->ros_goal_request_size,
+    action_server->ros_result_response_size, action_server->allocator);
+  if (rc != RCL_RET_OK) {
+    return rc;
+  }
+
+  // one goal info per goal handle for the cancel response
+  action_msgs__msg__GoalInfo * cancel_goals_memory = action_server->allocator->allocate(
+    rclc_action_get_goal_handle_capacity(action_server) * sizeof(action_msgs__msg__GoalInfo),
+    action_server->allocator->state);
+  if (NULL == cancel_goals_memory) {
+    rclc_action_fini_goal_handle_pool(action_server);
+    RCL_SET_ERROR_MSG("Could not allocate memory for the cancel response.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  action_server->allocator->deallocate(
+    action_server->cancel_goals_memory,
+    action_server->allocator->state);
+  action_server->cancel_goals_memory = cancel_goals_memory;
+  return RCL_RET_OK;
+}
 
 rcl_ret_t
 rclc_action_server_fini(
@@ -203,6 +456,18 @@ rclc_action_server_fini(
 
   rcl_ret_t rc;
 
+  // results, which have been stored but never requested
+  if (NULL != action_server->goal_handles_memory) {
+    for (rclc_action_goal_handle_t * goal_handle =
+      rclc_action_get_first_used_goal_handle(action_server);
+      NULL != goal_handle; goal_handle = goal_handle->next)
+    {
+      rclc_action_server_reset_result(goal_handle);
+    }
+  }
+
+  rclc_action_fini_goal_handle_pool(action_server);
+
   if (NULL != action_server->goal_handles_memory) {
     action_server->allocator->deallocate(
       action_server->goal_handles_memory,
@@ -210,6 +475,20 @@ rclc_action_server_fini(
     action_server->goal_handles_memory = NULL;
   }
 
+  if (NULL != action_server->cancel_goals_memory) {
+    action_server->allocator->deallocate(
+      action_server->cancel_goals_memory,
+      action_server->allocator->state);
+    action_server->cancel_goals_memory = NULL;
+  }
+
+  if (NULL != action_server->result_responses_memory) {
+    action_server->allocator->deallocate(
+      action_server->result_responses_memory,
+      action_server->allocator->state);
+    action_server->result_responses_memory = NULL;
+  }
+
   rc = rcl_action_server_fini(&action_server->rcl_handle, node);
 
   return rc;
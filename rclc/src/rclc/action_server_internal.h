@@ -31,15 +31,32 @@ rclc_action_server_response_goal_request(
   rclc_action_goal_handle_t * goal_handle,
   const bool accepted);
 
+// Handles the pending cancel request of the action server: calls the cancel
+// callback of all goals selected by the request and sends one response
+// listing the goals which are canceling.
 rcl_ret_t
-rclc_action_server_goal_cancel_accept(
-  rclc_action_goal_handle_t * goal_handle);
+rclc_action_server_process_cancel_request(
+  rclc_action_server_t * action_server,
+  void * context);
 
+// result_state of a goal handle of an action server
+#define RCLC_ACTION_RESULT_NONE 0u       // neither requested nor stored
+#define RCLC_ACTION_RESULT_REQUESTED 1u  // requested by the client, sent by rclc_action_send_result
+#define RCLC_ACTION_RESULT_STORED 2u     // stored in the slot, sent when it is requested
+#define RCLC_ACTION_RESULT_SENT 3u       // response sent
+
+// Handles a result request for the goal: sends a stored result right away,
+// otherwise the result is sent by rclc_action_send_result.
 rcl_ret_t
-rclc_action_server_goal_cancel_reject(
-  rclc_action_server_t * action_server,
-  rcl_action_cancel_state_t state,
-  rmw_request_id_t cancel_request_header);
+rclc_action_server_process_result_request(
+  rclc_action_goal_handle_t * goal_handle,
+  const rmw_request_id_t * result_request_header);
+
+// Prepares the result of a goal handle taken from the pool for a new goal,
+// a result which has been stored but never requested is released.
+void
+rclc_action_server_reset_result(
+  rclc_action_goal_handle_t * goal_handle);
 
 #if __cplusplus
 }
@@ -0,0 +1,367 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(__unix__) || defined(__APPLE__)
+#define RCLC_ASYNC_PUBLISHER_PTHREAD
+#if !defined(_POSIX_C_SOURCE) && !defined(_GNU_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#endif
+
+#include "rclc/async_publisher.h"
+
+#ifdef RCLC_ASYNC_PUBLISHER_PTHREAD
+#include <pthread.h>
+#endif
+
+#include <rcl/error_handling.h>
+#include <rcutils/logging_macros.h>
+
+#include "rclc/types.h"
+
+#ifdef RCLC_ASYNC_PUBLISHER_PTHREAD
+// The queue is a ring buffer of message pointers stored in the msgs array of
+// the user: msgs[0 .. capacity - 1] are the slots and msgs[capacity] is the
+// message, which the publisher thread sends. The publisher thread exchanges
+// the oldest queued message with the sent one, so that it publishes without
+// holding the mutex and never reads a message, which a producer writes.
+struct rclc_async_publisher_worker_t
+{
+  pthread_mutex_t mutex;
+  pthread_cond_t not_empty;
+  pthread_cond_t not_full;
+  pthread_t thread;
+  rcl_publisher_t * publisher;
+  void ** slots;
+  size_t capacity;
+  size_t head;
+  size_t count;
+  bool stop;
+  uint64_t published;
+  uint64_t dropped;
+  uint64_t errors;
+};
+
+static
+void *
+_rclc_async_publisher_run(void * arg)
+{
+  struct rclc_async_publisher_worker_t * worker = arg;
+  pthread_mutex_lock(&worker->mutex);
+  for (;;) {
+    while (0 == worker->count && !worker->stop) {
+      pthread_cond_wait(&worker->not_empty, &worker->mutex);
+    }
+    // queued messages are still sent after fini was requested
+    if (0 == worker->count) {
+      break;
+    }
+    void * msg = worker->slots[worker->head];
+    worker->slots[worker->head] = worker->slots[worker->capacity];
+    worker->slots[worker->capacity] = msg;
+    worker->head = (worker->head + 1) % worker->capacity;
+    worker->count--;
+    pthread_cond_signal(&worker->not_full);
+    pthread_mutex_unlock(&worker->mutex);
+
+    rcl_ret_t rc = rcl_publish(worker->publisher, msg, NULL);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_async_publisher, rcl_publish);
+    }
+
+    pthread_mutex_lock(&worker->mutex);
+    if (rc == RCL_RET_OK) {
+      worker->published++;
+    } else {
+      worker->errors++;
+    }
+  }
+  pthread_mutex_unlock(&worker->mutex);
+  return NULL;
+}
+
+// Reserves a free slot according to the overflow policy. Returns the index of
+// the slot in slot, or capacity if the message is dropped. The mutex must be held.
+static
+rcl_ret_t
+_rclc_async_publisher_reserve(
+  struct rclc_async_publisher_worker_t * worker,
+  rclc_async_publisher_overflow_policy_t policy,
+  size_t * slot)
+{
+  if (worker->stop) {
+    RCL_SET_ERROR_MSG("async publisher is being finalized");
+    return RCL_RET_ERROR;
+  }
+  if (worker->count == worker->capacity) {
+    switch (policy) {
+      case RCLC_ASYNC_PUBLISHER_DROP_OLDEST:
+        worker->head = (worker->head + 1) % worker->capacity;
+        worker->count--;
+        worker->dropped++;
+        break;
+      case RCLC_ASYNC_PUBLISHER_DROP_NEWEST:
+        worker->dropped++;
+        *slot = worker->capacity;
+        return RCL_RET_OK;
+      case RCLC_ASYNC_PUBLISHER_BLOCK:
+      default:
+        while (worker->count == worker->capacity && !worker->stop) {
+          pthread_cond_wait(&worker->not_full, &worker->mutex);
+        }
+        if (worker->stop) {
+          RCL_SET_ERROR_MSG("async publisher is being finalized");
+          return RCL_RET_ERROR;
+        }
+        break;
+    }
+  }
+  *slot = (worker->head + worker->count) % worker->capacity;
+  return RCL_RET_OK;
+}
+#endif
+
+rclc_async_publisher_t
+rclc_async_publisher_get_zero_initialized(void)
+{
+  static rclc_async_publisher_t null_async_publisher = {
+    .publisher = NULL,
+    .msgs = NULL,
+    .number_of_msgs = 0,
+    .copy = NULL,
+    .policy = RCLC_ASYNC_PUBLISHER_DROP_OLDEST,
+    .worker = NULL
+  };
+  return null_async_publisher;
+}
+
+rcl_ret_t
+rclc_async_publisher_init(
+  rclc_async_publisher_t * async_publisher,
+  rcl_publisher_t * publisher,
+  void ** msgs,
+  size_t number_of_msgs,
+  rclc_async_publisher_copy_t copy,
+  rclc_async_publisher_overflow_policy_t policy,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    async_publisher, "async_publisher is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    publisher, "publisher is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    msgs, "msgs is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "allocator is invalid", return RCL_RET_INVALID_ARGUMENT);
+  if (number_of_msgs < RCLC_ASYNC_PUBLISHER_MIN_MSGS) {
+    RCL_SET_ERROR_MSG("number_of_msgs must be at least RCLC_ASYNC_PUBLISHER_MIN_MSGS");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  for (size_t i = 0; i < number_of_msgs; i++) {
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      msgs[i], "msgs contains a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  }
+
+#ifdef RCLC_ASYNC_PUBLISHER_PTHREAD
+  (*async_publisher) = rclc_async_publisher_get_zero_initialized();
+  struct rclc_async_publisher_worker_t * worker = allocator->zero_allocate(
+    1, sizeof(struct rclc_async_publisher_worker_t), allocator->state);
+  if (NULL == worker) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for 'worker'.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  worker->publisher = publisher;
+  worker->slots = msgs;
+  worker->capacity = number_of_msgs - 1;
+  if (0 != pthread_mutex_init(&worker->mutex, NULL)) {
+    allocator->deallocate(worker, allocator->state);
+    RCL_SET_ERROR_MSG("Could not initialize the mutex of the async publisher.");
+    return RCL_RET_ERROR;
+  }
+  if (0 != pthread_cond_init(&worker->not_empty, NULL)) {
+    pthread_mutex_destroy(&worker->mutex);
+    allocator->deallocate(worker, allocator->state);
+    RCL_SET_ERROR_MSG("Could not initialize the condition variables of the async publisher.");
+    return RCL_RET_ERROR;
+  }
+  if (0 != pthread_cond_init(&worker->not_full, NULL)) {
+    pthread_cond_destroy(&worker->not_empty);
+    pthread_mutex_destroy(&worker->mutex);
+    allocator->deallocate(worker, allocator->state);
+    RCL_SET_ERROR_MSG("Could not initialize the condition variables of the async publisher.");
+    return RCL_RET_ERROR;
+  }
+  if (0 != pthread_create(&worker->thread, NULL, _rclc_async_publisher_run, worker)) {
+    pthread_cond_destroy(&worker->not_full);
+    pthread_cond_destroy(&worker->not_empty);
+    pthread_mutex_destroy(&worker->mutex);
+    allocator->deallocate(worker, allocator->state);
+    RCL_SET_ERROR_MSG("Could not start the publisher thread.");
+    return RCL_RET_ERROR;
+  }
+
+  async_publisher->publisher = publisher;
+  async_publisher->msgs = msgs;
+  async_publisher->number_of_msgs = number_of_msgs;
+  async_publisher->copy = copy;
+  async_publisher->policy = policy;
+  async_publisher->worker = worker;
+  async_publisher->allocator = *allocator;
+  return RCL_RET_OK;
+#else
+  RCLC_UNUSED(copy);
+  RCLC_UNUSED(policy);
+  RCL_SET_ERROR_MSG("Threads are not supported on this platform.");
+  return RCL_RET_UNSUPPORTED;
+#endif
+}
+
+rcl_ret_t
+rclc_async_publisher_fini(rclc_async_publisher_t * async_publisher)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    async_publisher, "async_publisher is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+#ifdef RCLC_ASYNC_PUBLISHER_PTHREAD
+  struct rclc_async_publisher_worker_t * worker = async_publisher->worker;
+  if (NULL != worker) {
+    pthread_mutex_lock(&worker->mutex);
+    worker->stop = true;
+    pthread_cond_broadcast(&worker->not_empty);
+    pthread_cond_broadcast(&worker->not_full);
+    pthread_mutex_unlock(&worker->mutex);
+    if (0 != pthread_join(worker->thread, NULL)) {
+      RCL_SET_ERROR_MSG("Could not join the publisher thread.");
+      return RCL_RET_ERROR;
+    }
+    pthread_cond_destroy(&worker->not_full);
+    pthread_cond_destroy(&worker->not_empty);
+    pthread_mutex_destroy(&worker->mutex);
+    async_publisher->allocator.deallocate(worker, async_publisher->allocator.state);
+  }
+#endif
+  (*async_publisher) = rclc_async_publisher_get_zero_initialized();
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_async_publisher_publish(
+  rclc_async_publisher_t * async_publisher,
+  const void * ros_message,
+  bool * queued)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    async_publisher, "async_publisher is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    async_publisher->worker, "async_publisher is not initialized",
+    return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    ros_message, "ros_message is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (NULL != queued) {
+    *queued = false;
+  }
+  if (NULL == async_publisher->copy) {
+    RCL_SET_ERROR_MSG("async_publisher has no copy function, use publish_move");
+    return RCL_RET_ERROR;
+  }
+#ifdef RCLC_ASYNC_PUBLISHER_PTHREAD
+  struct rclc_async_publisher_worker_t * worker = async_publisher->worker;
+  size_t slot = 0;
+  pthread_mutex_lock(&worker->mutex);
+  rcl_ret_t rc = _rclc_async_publisher_reserve(worker, async_publisher->policy, &slot);
+  if (rc == RCL_RET_OK && slot < worker->capacity) {
+    // copied with the mutex held: the slot must not be dropped meanwhile
+    if (async_publisher->copy(ros_message, worker->slots[slot])) {
+      worker->count++;
+      pthread_cond_signal(&worker->not_empty);
+      if (NULL != queued) {
+        *queued = true;
+      }
+    } else {
+      RCL_SET_ERROR_MSG("Could not copy the message.");
+      rc = RCL_RET_ERROR;
+    }
+  }
+  pthread_mutex_unlock(&worker->mutex);
+  return rc;
+#else
+  return RCL_RET_UNSUPPORTED;
+#endif
+}
+
+rcl_ret_t
+rclc_async_publisher_publish_move(
+  rclc_async_publisher_t * async_publisher,
+  void ** ros_message,
+  bool * queued)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    async_publisher, "async_publisher is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    async_publisher->worker, "async_publisher is not initialized",
+    return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    ros_message, "ros_message is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    *ros_message, "ros_message is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (NULL != queued) {
+    *queued = false;
+  }
+#ifdef RCLC_ASYNC_PUBLISHER_PTHREAD
+  struct rclc_async_publisher_worker_t * worker = async_publisher->worker;
+  size_t slot = 0;
+  pthread_mutex_lock(&worker->mutex);
+  rcl_ret_t rc = _rclc_async_publisher_reserve(worker, async_publisher->policy, &slot);
+  if (rc == RCL_RET_OK && slot < worker->capacity) {
+    void * free_msg = worker->slots[slot];
+    worker->slots[slot] = *ros_message;
+    *ros_message = free_msg;
+    worker->count++;
+    pthread_cond_signal(&worker->not_empty);
+    if (NULL != queued) {
+      *queued = true;
+    }
+  }
+  pthread_mutex_unlock(&worker->mutex);
+  return rc;
+#else
+  return RCL_RET_UNSUPPORTED;
+#endif
+}
+
+rcl_ret_t
+rclc_async_publisher_get_statistics(
+  rclc_async_publisher_t * async_publisher,
+  rclc_async_publisher_statistics_t * statistics)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    async_publisher, "async_publisher is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    async_publisher->worker, "async_publisher is not initialized",
+    return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    statistics, "statistics is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+#ifdef RCLC_ASYNC_PUBLISHER_PTHREAD
+  struct rclc_async_publisher_worker_t * worker = async_publisher->worker;
+  pthread_mutex_lock(&worker->mutex);
+  statistics->published = worker->published;
+  statistics->dropped = worker->dropped;
+  statistics->errors = worker->errors;
+  statistics->queued = worker->count;
+  pthread_mutex_unlock(&worker->mutex);
+  return RCL_RET_OK;
+#else
+  return RCL_RET_UNSUPPORTED;
+#endif
+}
@@ -0,0 +1,354 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclc/chain_tracer.h"
+#include "./chain_tracer_internal.h"
+#include "./histogram_internal.h"
+
+#include <string.h>
+
+#include <rcl/error_handling.h>
+#include <rcutils/time.h>
+#include <rmw/rmw.h>
+
+// no origin of a callback invocation found in the recorded events
+#define RCLC_CHAIN_TRACER_NO_ORIGIN -1
+
+rclc_chain_tracer_t
+rclc_chain_tracer_get_zero_initialized(void)
+{
+  static rclc_chain_tracer_t null_tracer = {
+    .events = NULL,
+    .capacity = 0,
+    .number_of_events = 0,
+    .invocations = 0,
+    .current_invocation = 0
+  };
+  return null_tracer;
+}
+
+rcl_ret_t
+rclc_chain_tracer_init(
+  rclc_chain_tracer_t * tracer,
+  size_t capacity,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    tracer, "tracer is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "allocator is invalid", return RCL_RET_INVALID_ARGUMENT);
+  if (0 == capacity) {
+    RCL_SET_ERROR_MSG("capacity must be at least 1");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  (*tracer) = rclc_chain_tracer_get_zero_initialized();
+  tracer->events = allocator->allocate(
+    capacity * sizeof(rclc_chain_tracer_event_t), allocator->state);
+  if (NULL == tracer->events) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for 'events'.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  tracer->capacity = capacity;
+  tracer->allocator = *allocator;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_chain_tracer_fini(rclc_chain_tracer_t * tracer)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    tracer, "tracer is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (NULL != tracer->events) {
+    tracer->allocator.deallocate(tracer->events, tracer->allocator.state);
+  }
+  (*tracer) = rclc_chain_tracer_get_zero_initialized();
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_chain_tracer_clear(rclc_chain_tracer_t * tracer)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    tracer, "tracer is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  tracer->number_of_events = 0;
+  return RCL_RET_OK;
+}
+
+// returns the next event of the ring buffer, overwriting the oldest one if it is full
+static
+rclc_chain_tracer_event_t *
+_rclc_chain_tracer_next_event(
+  rclc_chain_tracer_t * tracer,
+  rclc_chain_tracer_event_type_t type,
+  const void * source)
+{
+  rclc_chain_tracer_event_t * event =
+    &tracer->events[tracer->number_of_events % tracer->capacity];
+  tracer->number_of_events++;
+  memset(event, 0, sizeof(rclc_chain_tracer_event_t));
+  event->type = type;
+  event->source = source;
+  return event;
+}
+
+void
+rclc_chain_tracer_record_take(
+  rclc_chain_tracer_t * tracer,
+  const rcl_subscription_t * subscription,
+  const rmw_message_info_t * message_info)
+{
+  rclc_chain_tracer_event_t * event =
+    _rclc_chain_tracer_next_event(tracer, RCLC_CHAIN_TRACER_TAKE, subscription);
+  event->timestamp = message_info->source_timestamp;
+  event->gid = message_info->publisher_gid;
+}
+
+void
+rclc_chain_tracer_begin_callback(
+  rclc_chain_tracer_t * tracer,
+  const void * source)
+{
+  rclc_chain_tracer_event_t * event =
+    _rclc_chain_tracer_next_event(tracer, RCLC_CHAIN_TRACER_CALLBACK, source);
+  event->invocation = ++tracer->invocations;
+  rcutils_ret_t ret = rcutils_system_time_now(&event->timestamp);
+  (void) ret;
+  tracer->current_invocation = event->invocation;
+}
+
+void
+rclc_chain_tracer_end_callback(rclc_chain_tracer_t * tracer)
+{
+  tracer->current_invocation = 0;
+}
+
+rcl_ret_t
+rclc_chain_tracer_publish(
+  rclc_chain_tracer_t * tracer,
+  const rcl_publisher_t * publisher,
+  const void * ros_message,
+  rmw_publisher_allocation_t * allocation)
+{
+  if (NULL == tracer || NULL == tracer->events) {
+    return rcl_publish(publisher, ros_message, allocation);
+  }
+  rcutils_time_point_value_t start = 0;
+  rcutils_ret_t ret = rcutils_system_time_now(&start);
+  rcl_ret_t rc = rcl_publish(publisher, ros_message, allocation);
+  if (RCL_RET_OK != rc) {
+    return rc;
+  }
+
+  rcutils_time_point_value_t end = 0;
+  ret = rcutils_system_time_now(&end);
+  (void) ret;
+  rmw_gid_t gid;
+  if (RMW_RET_OK != rmw_get_gid_for_publisher(rcl_publisher_get_rmw_handle(publisher), &gid)) {
+    // the publish cannot be linked to the takes of its message
+    return RCL_RET_OK;
+  }
+
+  rclc_chain_tracer_event_t * event =
+    _rclc_chain_tracer_next_event(tracer, RCLC_CHAIN_TRACER_PUBLISH, publisher);
+  event->invocation = tracer->current_invocation;
+  event->timestamp = start;
+  event->timestamp_end = end;
+  event->gid = gid;
+  return RCL_RET_OK;
+}
+
+// recorded events from the oldest to the newest one
+static
+const rclc_chain_tracer_event_t *
+_rclc_chain_tracer_event(
+  const rclc_chain_tracer_t * tracer,
+  uint64_t first,
+  size_t i)
+{
+  return &tracer->events[(first + i) % tracer->capacity];
+}
+
+// index of the callback event with the given invocation before index i
+static
+bool
+_rclc_chain_tracer_find_callback(
+  const rclc_chain_tracer_t * tracer,
+  uint64_t first,
+  size_t i,
+  uint64_t invocation,
+  size_t * index)
+{
+  while (i-- > 0) {
+    const rclc_chain_tracer_event_t * event = _rclc_chain_tracer_event(tracer, first, i);
+    if (RCLC_CHAIN_TRACER_CALLBACK == event->type && event->invocation == invocation) {
+      *index = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+// index of the take of the message, which the callback at index i processes. The
+// search stops at the previous callback of the same handle, which consumed older takes.
+static
+bool
+_rclc_chain_tracer_find_take(
+  const rclc_chain_tracer_t * tracer,
+  uint64_t first,
+  size_t i,
+  size_t * index)
+{
+  const void * source = _rclc_chain_tracer_event(tracer, first, i)->source;
+  while (i-- > 0) {
+    const rclc_chain_tracer_event_t * event = _rclc_chain_tracer_event(tracer, first, i);
+    if (event->source != source) {
+      continue;
+    }
+    if (RCLC_CHAIN_TRACER_CALLBACK == event->type) {
+      return false;
+    }
+    if (RCLC_CHAIN_TRACER_TAKE == event->type) {
+      *index = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+// index of the publish of the message taken at index i: the source timestamp of the
+// message is set during rcl_publish by the publisher with the same gid
+static
+bool
+_rclc_chain_tracer_find_publish(
+  const rclc_chain_tracer_t * tracer,
+  uint64_t first,
+  size_t i,
+  size_t * index)
+{
+  const rclc_chain_tracer_event_t * take = _rclc_chain_tracer_event(tracer, first, i);
+  while (i-- > 0) {
+    const rclc_chain_tracer_event_t * event = _rclc_chain_tracer_event(tracer, first, i);
+    if (RCLC_CHAIN_TRACER_PUBLISH == event->type &&
+      event->timestamp <= take->timestamp && take->timestamp <= event->timestamp_end &&
+      0 == memcmp(event->gid.data, take->gid.data, RMW_GID_STORAGE_SIZE))
+    {
+      *index = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+static
+void
+_rclc_chain_tracer_histogram_add(
+  rclc_chain_tracer_histogram_t * histogram,
+  uint64_t latency_ns)
+{
+  if (0 == histogram->count || latency_ns < histogram->min_ns) {
+    histogram->min_ns = latency_ns;
+  }
+  if (latency_ns > histogram->max_ns) {
+    histogram->max_ns = latency_ns;
+  }
+  histogram->count++;
+  histogram->sum_ns += latency_ns;
+  histogram->buckets[rclc_histogram_bucket(latency_ns, RCLC_CHAIN_TRACER_HISTOGRAM_SIZE)]++;
+}
+
+rcl_ret_t
+rclc_chain_tracer_analyze(
+  const rclc_chain_tracer_t * tracer,
+  const void * input,
+  const rcl_publisher_t * output,
+  rclc_chain_tracer_histogram_t * histogram)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    tracer, "tracer is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    input, "input is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    output, "output is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    histogram, "histogram is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  memset(histogram, 0, sizeof(rclc_chain_tracer_histogram_t));
+
+  size_t n = (tracer->number_of_events < tracer->capacity) ?
+    (size_t) tracer->number_of_events : tracer->capacity;
+  if (0 == n) {
+    return RCL_RET_OK;
+  }
+  uint64_t first = tracer->number_of_events - n;
+
+  // origin (time of the input of the chain) of each callback event, the events are
+  // processed in the recorded order, so the origins of all causing callbacks are known
+  rcutils_time_point_value_t * origins = tracer->allocator.allocate(
+    n * sizeof(rcutils_time_point_value_t), tracer->allocator.state);
+  if (NULL == origins) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for 'origins'.");
+    return RCL_RET_BAD_ALLOC;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    const rclc_chain_tracer_event_t * event = _rclc_chain_tracer_event(tracer, first, i);
+    origins[i] = RCLC_CHAIN_TRACER_NO_ORIGIN;
+    size_t take = 0;
+    size_t publish = 0;
+    size_t callback = 0;
+
+    if (RCLC_CHAIN_TRACER_CALLBACK == event->type && NULL != event->source) {
+      bool has_take = _rclc_chain_tracer_find_take(tracer, first, i, &take);
+      if (event->source == input) {
+        // start of a chain
+        origins[i] = has_take ?
+          _rclc_chain_tracer_event(tracer, first, take)->timestamp : event->timestamp;
+      } else if (has_take &&
+        _rclc_chain_tracer_find_publish(tracer, first, take, &publish))
+      {
+        uint64_t invocation = _rclc_chain_tracer_event(tracer, first, publish)->invocation;
+        if (0 != invocation &&
+          _rclc_chain_tracer_find_callback(tracer, first, publish, invocation, &callback))
+        {
+          origins[i] = origins[callback];
+        }
+      }
+    } else if (RCLC_CHAIN_TRACER_PUBLISH == event->type && event->source == output) {
+      if (0 != event->invocation &&
+        _rclc_chain_tracer_find_callback(tracer, first, i, event->invocation, &callback) &&
+        RCLC_CHAIN_TRACER_NO_ORIGIN != origins[callback])
+      {
+        rcutils_time_point_value_t latency = event->timestamp - origins[callback];
+        _rclc_chain_tracer_histogram_add(histogram, (latency > 0) ? (uint64_t) latency : 0);
+      }
+    }
+  }
+
+  tracer->allocator.deallocate(origins, tracer->allocator.state);
+  return RCL_RET_OK;
+}
+
+uint64_t
+rclc_chain_tracer_percentile(
+  const rclc_chain_tracer_histogram_t * histogram,
+  double percentile)
+{
+  if (NULL == histogram) {
+    return 0;
+  }
+  return rclc_histogram_percentile(
+    histogram->buckets, RCLC_CHAIN_TRACER_HISTOGRAM_SIZE,
+    histogram->count, histogram->max_ns, percentile);
+}
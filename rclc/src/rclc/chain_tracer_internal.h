@@ -0,0 +1,47 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__CHAIN_TRACER_INTERNAL_H_
+#define RCLC__CHAIN_TRACER_INTERNAL_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include "rclc/chain_tracer.h"
+
+/// Records that the executor took a message of \p subscription.
+void
+rclc_chain_tracer_record_take(
+  rclc_chain_tracer_t * tracer,
+  const rcl_subscription_t * subscription,
+  const rmw_message_info_t * message_info);
+
+/// Records the start of a callback invocation of the handle with the rcl object
+/// \p source. Publishes until rclc_chain_tracer_end_callback() belong to it.
+void
+rclc_chain_tracer_begin_callback(
+  rclc_chain_tracer_t * tracer,
+  const void * source);
+
+/// Records the end of the current callback invocation.
+void
+rclc_chain_tracer_end_callback(rclc_chain_tracer_t * tracer);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__CHAIN_TRACER_INTERNAL_H_
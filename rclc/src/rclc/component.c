@@ -0,0 +1,411 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclc/component.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rcl/error_handling.h>
+#include <rcutils/logging_macros.h>
+#include <rmw/qos_profiles.h>
+
+#include "rclc/client.h"
+#include "rclc/publisher.h"
+#include "rclc/service.h"
+#include "rclc/subscription.h"
+#include "rclc/timer.h"
+
+rclc_component_t
+rclc_component_get_zero_initialized(void)
+{
+  static rclc_component_t null_component = {
+    .node = NULL,
+    .name = NULL,
+    .entities = NULL,
+    .max_entities = 0,
+    .number_of_entities = 0
+  };
+  return null_component;
+}
+
+// letters, digits and '_', separated by single '/', not starting with a digit
+static
+bool
+_rclc_component_is_valid_name(const char * name)
+{
+  bool token_start = true;
+  if ('\0' == name[0]) {
+    return false;
+  }
+  for (const char * c = name; '\0' != *c; c++) {
+    if ('/' == *c) {
+      if (token_start) {
+        return false;
+      }
+      token_start = true;
+    } else if (isalpha((unsigned char) *c) || '_' == *c ||
+      (!token_start && isdigit((unsigned char) *c)))
+    {
+      token_start = false;
+    } else {
+      return false;
+    }
+  }
+  return !token_start;
+}
+
+rcl_ret_t
+rclc_component_init(
+  rclc_component_t * component,
+  const char * name,
+  rcl_node_t * node,
+  size_t max_entities,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    component, "component is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    name, "name is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    node, "node is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "allocator is invalid", return RCL_RET_INVALID_ARGUMENT);
+  if (!_rclc_component_is_valid_name(name)) {
+    RCL_SET_ERROR_MSG("invalid component name");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  (*component) = rclc_component_get_zero_initialized();
+  size_t name_size = strlen(name) + 1;
+  component->name = allocator->allocate(name_size, allocator->state);
+  if (NULL == component->name) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for 'name'.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  memcpy(component->name, name, name_size);
+  if (max_entities > 0) {
+    component->entities = allocator->allocate(
+      max_entities * sizeof(rclc_component_entity_t), allocator->state);
+    if (NULL == component->entities) {
+      allocator->deallocate(component->name, allocator->state);
+      component->name = NULL;
+      RCL_SET_ERROR_MSG("Could not allocate memory for 'entities'.");
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+  component->node = node;
+  component->max_entities = max_entities;
+  component->allocator = *allocator;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_component_fini(rclc_component_t * component)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    component, "component is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = RCL_RET_OK;
+  while (component->number_of_entities > 0) {
+    rclc_component_entity_t * entity = &component->entities[--component->number_of_entities];
+    rcl_ret_t rc = RCL_RET_OK;
+    switch (entity->type) {
+      case RCLC_COMPONENT_PUBLISHER:
+        rc = rcl_publisher_fini(entity->publisher, component->node);
+        break;
+      case RCLC_COMPONENT_SUBSCRIPTION:
+        rc = rcl_subscription_fini(entity->subscription, component->node);
+        break;
+      case RCLC_COMPONENT_SERVICE:
+        rc = rcl_service_fini(entity->service, component->node);
+        break;
+      case RCLC_COMPONENT_CLIENT:
+        rc = rcl_client_fini(entity->client, component->node);
+        break;
+      case RCLC_COMPONENT_TIMER:
+        rc = rcl_timer_fini(entity->timer);
+        break;
+      default:
+        rc = RCL_RET_ERROR;
+        break;
+    }
+    if (RCL_RET_OK != rc) {
+      PRINT_RCLC_ERROR(rclc_component_fini, rcl_fini);
+      ret = RCL_RET_ERROR;
+    }
+  }
+  if (NULL != component->entities) {
+    component->allocator.deallocate(component->entities, component->allocator.state);
+  }
+  if (NULL != component->name) {
+    component->allocator.deallocate(component->name, component->allocator.state);
+  }
+  (*component) = rclc_component_get_zero_initialized();
+  return ret;
+}
+
+// Checks that the component has space for another entity.
+static
+rcl_ret_t
+_rclc_component_check_capacity(const rclc_component_t * component)
+{
+  if (NULL == component->name) {
+    RCL_SET_ERROR_MSG("component not initialized");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (component->number_of_entities >= component->max_entities) {
+    RCL_SET_ERROR_MSG("component has already max_entities entities");
+    return RCL_RET_ERROR;
+  }
+  return RCL_RET_OK;
+}
+
+// Prefixes a relative topic or service name with the component name. The result
+// must be deallocated with the allocator of the component.
+static
+char *
+_rclc_component_expand_name(const rclc_component_t * component, const char * name)
+{
+  const char * private_prefix = "";
+  const char * suffix = name;
+  if ('/' == name[0]) {
+    private_prefix = NULL;
+  } else if ('~' == name[0]) {
+    private_prefix = "~/";
+    suffix = ('/' == name[1]) ? name + 2 : name + 1;
+  }
+
+  size_t size = (NULL == private_prefix) ? strlen(name) + 1 :
+    strlen(private_prefix) + strlen(component->name) + 1 + strlen(suffix) + 1;
+  char * expanded = component->allocator.allocate(size, component->allocator.state);
+  if (NULL == expanded) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for the expanded name.");
+    return NULL;
+  }
+  if (NULL == private_prefix) {
+    memcpy(expanded, name, size);
+  } else {
+    snprintf(
+      expanded, size, "%s%s%s%s", private_prefix, component->name,
+      ('\0' != suffix[0]) ? "/" : "", suffix);
+  }
+  return expanded;
+}
+
+rcl_ret_t
+rclc_component_publisher_init(
+  rcl_publisher_t * publisher,
+  rclc_component_t * component,
+  const rosidl_message_type_support_t * type_support,
+  const char * topic_name,
+  const rmw_qos_profile_t * qos_profile)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    component, "component is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    topic_name, "topic_name is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t rc = _rclc_component_check_capacity(component);
+  if (RCL_RET_OK != rc) {
+    return rc;
+  }
+  char * expanded_name = _rclc_component_expand_name(component, topic_name);
+  if (NULL == expanded_name) {
+    return RCL_RET_BAD_ALLOC;
+  }
+  rc = rclc_publisher_init(
+    publisher, component->node, type_support, expanded_name,
+    (NULL != qos_profile) ? qos_profile : &rmw_qos_profile_default);
+  component->allocator.deallocate(expanded_name, component->allocator.state);
+  if (RCL_RET_OK == rc) {
+    rclc_component_entity_t * entity = &component->entities[component->number_of_entities++];
+    entity->type = RCLC_COMPONENT_PUBLISHER;
+    entity->publisher = publisher;
+  }
+  return rc;
+}
+
+rcl_ret_t
+rclc_component_subscription_init(
+  rcl_subscription_t * subscription,
+  rclc_component_t * component,
+  const rosidl_message_type_support_t * type_support,
+  const char * topic_name,
+  const rmw_qos_profile_t * qos_profile)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    component, "component is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    topic_name, "topic_name is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t rc = _rclc_component_check_capacity(component);
+  if (RCL_RET_OK != rc) {
+    return rc;
+  }
+  char * expanded_name = _rclc_component_expand_name(component, topic_name);
+  if (NULL == expanded_name) {
+    return RCL_RET_BAD_ALLOC;
+  }
+  rc = rclc_subscription_init(
+    subscription, component->node, type_support, expanded_name,
+    (NULL != qos_profile) ? qos_profile : &rmw_qos_profile_default);
+  component->allocator.deallocate(expanded_name, component->allocator.state);
+  if (RCL_RET_OK == rc) {
+    rclc_component_entity_t * entity = &component->entities[component->number_of_entities++];
+    entity->type = RCLC_COMPONENT_SUBSCRIPTION;
+    entity->subscription = subscription;
+  }
+  return rc;
+}
+
+rcl_ret_t
+rclc_component_service_init(
+  rcl_service_t * service,
+  rclc_component_t * component,
+  const rosidl_service_type_support_t * type_support,
+  const char * service_name,
+  const rmw_qos_profile_t * qos_profile)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    component, "component is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    service_name, "service_name is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t rc = _rclc_component_check_capacity(component);
+  if (RCL_RET_OK != rc) {
+    return rc;
+  }
+  char * expanded_name = _rclc_component_expand_name(component, service_name);
+  if (NULL == expanded_name) {
+    return RCL_RET_BAD_ALLOC;
+  }
+  rc = rclc_service_init(
+    service, component->node, type_support, expanded_name,
+    (NULL != qos_profile) ? qos_profile : &rmw_qos_profile_services_default);
+  component->allocator.deallocate(expanded_name, component->allocator.state);
+  if (RCL_RET_OK == rc) {
+    rclc_component_entity_t * entity = &component->entities[component->number_of_entities++];
+    entity->type = RCLC_COMPONENT_SERVICE;
+    entity->service = service;
+  }
+  return rc;
+}
+
+rcl_ret_t
+rclc_component_client_init(
+  rcl_client_t * client,
+  rclc_component_t * component,
+  const rosidl_service_type_support_t * type_support,
+  const char * service_name,
+  const rmw_qos_profile_t * qos_profile)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    component, "component is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    service_name, "service_name is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t rc = _rclc_component_check_capacity(component);
+  if (RCL_RET_OK != rc) {
+    return rc;
+  }
+  char * expanded_name = _rclc_component_expand_name(component, service_name);
+  if (NULL == expanded_name) {
+    return RCL_RET_BAD_ALLOC;
+  }
+  rc = rclc_client_init(
+    client, component->node, type_support, expanded_name,
+    (NULL != qos_profile) ? qos_profile : &rmw_qos_profile_services_default);
+  component->allocator.deallocate(expanded_name, component->allocator.state);
+  if (RCL_RET_OK == rc) {
+    rclc_component_entity_t * entity = &component->entities[component->number_of_entities++];
+    entity->type = RCLC_COMPONENT_CLIENT;
+    entity->client = client;
+  }
+  return rc;
+}
+
+rcl_ret_t
+rclc_component_timer_init(
+  rcl_timer_t * timer,
+  rclc_component_t * component,
+  rclc_support_t * support,
+  const uint64_t timeout_ns,
+  const rcl_timer_callback_t callback)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    component, "component is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t rc = _rclc_component_check_capacity(component);
+  if (RCL_RET_OK != rc) {
+    return rc;
+  }
+  rc = rclc_timer_init_default(timer, support, timeout_ns, callback);
+  if (RCL_RET_OK == rc) {
+    rclc_component_entity_t * entity = &component->entities[component->number_of_entities++];
+    entity->type = RCLC_COMPONENT_TIMER;
+    entity->timer = timer;
+  }
+  return rc;
+}
+
+// Returns whether the rcl object was added to the executor.
+static
+bool
+_rclc_component_is_in_executor(const rclc_executor_t * executor, const void * rcl_handle)
+{
+  for (size_t i = 0; i < executor->index; i++) {
+    if (executor->handles[i].subscription == rcl_handle) {
+      return true;
+    }
+  }
+  return false;
+}
+
+rcl_ret_t
+rclc_component_remove_from_executor(
+  const rclc_component_t * component,
+  rclc_executor_t * executor)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    component, "component is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    executor, "executor is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t rc = RCL_RET_OK;
+  for (size_t i = 0; i < component->number_of_entities; i++) {
+    const rclc_component_entity_t * entity = &component->entities[i];
+    if (RCLC_COMPONENT_PUBLISHER == entity->type ||
+      !_rclc_component_is_in_executor(executor, entity->subscription))
+    {
+      continue;
+    }
+    switch (entity->type) {
+      case RCLC_COMPONENT_SUBSCRIPTION:
+        rc = rclc_executor_remove_subscription(executor, entity->subscription);
+        break;
+      case RCLC_COMPONENT_SERVICE:
+        rc = rclc_executor_remove_service(executor, entity->service);
+        break;
+      case RCLC_COMPONENT_CLIENT:
+        rc = rclc_executor_remove_client(executor, entity->client);
+        break;
+      case RCLC_COMPONENT_TIMER:
+        rc = rclc_executor_remove_timer(executor, entity->timer);
+        break;
+      default:
+        break;
+    }
+    if (RCL_RET_OK != rc) {
+      PRINT_RCLC_ERROR(rclc_component_remove_from_executor, rclc_executor_remove);
+      return rc;
+    }
+  }
+  return RCL_RET_OK;
+}
@@ -0,0 +1,218 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclc/discovery.h"
+
+#include <rcl/error_handling.h>
+#include <rcutils/logging_macros.h>
+#include <rcutils/time.h>
+
+rclc_discovery_t
+rclc_discovery_get_zero_initialized(void)
+{
+  static rclc_discovery_t null_discovery = {
+    .target = RCLC_DISCOVERY_SERVICE_SERVER,
+    .node = NULL,
+    .client = NULL,
+    .min_subscriptions = 0,
+    .matched = false,
+    .checked = false,
+    .callback = NULL,
+    .callback_context = NULL
+  };
+  return null_discovery;
+}
+
+rcl_ret_t
+rclc_discovery_init_service_server(
+  rclc_discovery_t * discovery,
+  const rcl_node_t * node,
+  const rcl_client_t * client)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    discovery, "discovery is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    node, "node is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    client, "client is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+
+  (*discovery) = rclc_discovery_get_zero_initialized();
+  discovery->target = RCLC_DISCOVERY_SERVICE_SERVER;
+  discovery->node = node;
+  discovery->client = client;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_discovery_init_action_server(
+  rclc_discovery_t * discovery,
+  const rcl_node_t * node,
+  const rcl_action_client_t * action_client)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    discovery, "discovery is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    node, "node is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    action_client, "action_client is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+
+  (*discovery) = rclc_discovery_get_zero_initialized();
+  discovery->target = RCLC_DISCOVERY_ACTION_SERVER;
+  discovery->node = node;
+  discovery->action_client = action_client;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_discovery_init_subscriptions(
+  rclc_discovery_t * discovery,
+  const rcl_node_t * node,
+  const rcl_publisher_t * publisher,
+  size_t min_subscriptions)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    discovery, "discovery is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    node, "node is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    publisher, "publisher is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (0 == min_subscriptions) {
+    RCL_SET_ERROR_MSG("min_subscriptions is 0. Must be larger or equal to 1");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  (*discovery) = rclc_discovery_get_zero_initialized();
+  discovery->target = RCLC_DISCOVERY_SUBSCRIPTIONS;
+  discovery->node = node;
+  discovery->publisher = publisher;
+  discovery->min_subscriptions = min_subscriptions;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_discovery_check(
+  rclc_discovery_t * discovery,
+  bool * matched)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    discovery, "discovery is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    matched, "matched is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+
+  rcl_ret_t rc = RCL_RET_OK;
+  size_t subscription_count = 0;
+  *matched = false;
+  switch (discovery->target) {
+    case RCLC_DISCOVERY_SERVICE_SERVER:
+      rc = rcl_service_server_is_available(discovery->node, discovery->client, matched);
+      break;
+    case RCLC_DISCOVERY_ACTION_SERVER:
+      rc = rcl_action_server_is_available(discovery->node, discovery->action_client, matched);
+      break;
+    case RCLC_DISCOVERY_SUBSCRIPTIONS:
+      rc = rcl_publisher_get_subscription_count(discovery->publisher, &subscription_count);
+      *matched = (subscription_count >= discovery->min_subscriptions);
+      break;
+    default:
+      RCL_SET_ERROR_MSG("unknown discovery target");
+      return RCL_RET_ERROR;
+  }
+  if (rc != RCL_RET_OK) {
+    *matched = false;
+    PRINT_RCLC_ERROR(rclc_discovery_check, graph_query);
+    return rc;
+  }
+  discovery->checked = true;
+  discovery->matched = *matched;
+  return rc;
+}
+
+rcl_ret_t
+rclc_discovery_wait(
+  rclc_discovery_t * discovery,
+  rcl_context_t * context,
+  int64_t timeout_ns,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    discovery, "discovery is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context, "context is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+
+  bool matched = false;
+  rcl_ret_t rc = rclc_discovery_check(discovery, &matched);
+  if (rc != RCL_RET_OK || matched) {
+    return rc;
+  }
+
+  const rcl_guard_condition_t * graph_gc = rcl_node_get_graph_guard_condition(discovery->node);
+  if (NULL == graph_gc) {
+    PRINT_RCLC_ERROR(rclc_discovery_wait, rcl_node_get_graph_guard_condition);
+    return RCL_RET_ERROR;
+  }
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rc = rcl_wait_set_init(&wait_set, 0, 1, 0, 0, 0, 0, context, *allocator);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_discovery_wait, rcl_wait_set_init);
+    return rc;
+  }
+
+  rcutils_time_point_value_t start;
+  rcutils_time_point_value_t now;
+  rc = rcutils_steady_time_now(&start);
+  int64_t remaining = timeout_ns;
+  while (rc == RCL_RET_OK && !matched) {
+    if (timeout_ns >= 0) {
+      rc = rcutils_steady_time_now(&now);
+      remaining = timeout_ns - (now - start);
+      if (remaining <= 0) {
+        rc = RCL_RET_TIMEOUT;
+        break;
+      }
+    }
+    rc = rcl_wait_set_clear(&wait_set);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_discovery_wait, rcl_wait_set_clear);
+      break;
+    }
+    rc = rcl_wait_set_add_guard_condition(&wait_set, graph_gc, NULL);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_discovery_wait, rcl_wait_set_add_guard_condition);
+      break;
+    }
+    // the graph guard condition is triggered on every change of the ROS graph
+    rc = rcl_wait(&wait_set, remaining);
+    if (rc == RCL_RET_TIMEOUT) {
+      // last evaluation, the condition might have become true without a trigger
+      rc = rclc_discovery_check(discovery, &matched);
+      if (rc == RCL_RET_OK && !matched) {
+        rc = RCL_RET_TIMEOUT;
+      }
+      break;
+    }
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_discovery_wait, rcl_wait);
+      break;
+    }
+    rc = rclc_discovery_check(discovery, &matched);
+  }
+
+  rcl_ret_t fini_rc = rcl_wait_set_fini(&wait_set);
+  if (fini_rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_discovery_wait, rcl_wait_set_fini);
+  }
+  return rc;
+}
@@ -15,12 +15,23 @@
 // limitations under the License.
 
 #include "rclc/executor.h"
+#include "rclc/logging.h"
+#include <limits.h>
 #include <rcutils/time.h>
 
 #include "./action_generic_types.h"
 #include "./action_goal_handle_internal.h"
 #include "./action_client_internal.h"
 #include "./action_server_internal.h"
+#include "./executor_events_internal.h"
+#include "./executor_stats_internal.h"
+#include "./chain_tracer_internal.h"
+#include "./executor_staging_internal.h"
+#include "./executor_dag_internal.h"
+#include "./executor_tasks_internal.h"
+#include "./latest_value_internal.h"
+#include "./service_cache_internal.h"
+#include "./topic_statistics_internal.h"
 
 // Include backport of function 'rcl_wait_set_is_valid' introduced in Foxy
 // in case of building for Dashing and Eloquent. This pre-processor macro
@@ -32,6 +43,8 @@
 
 // default timeout for rcl_wait() is 1000ms
 #define DEFAULT_WAIT_TIMEOUT_NS 1000000000
+// wait timeout while an action client keeps goal responses without goal handle
+#define RCLC_EXECUTOR_PENDING_GOAL_RESPONSE_WAIT_NS 1000000
 
 // declarations of helper functions
 /*
@@ -89,7 +102,15 @@ rclc_executor_get_zero_initialized_executor()
     .timeout_ns = 0,
     .invocation_time = 0,
     .trigger_function = NULL,
-    .trigger_object = NULL
+    .trigger_object = NULL,
+    .events = NULL,
+    .stats = NULL,
+    .chain_tracer = NULL,
+    .staging = NULL,
+    .dag = NULL,
+    .timer_interleaving = false,
+    .timer_deadline = 0,
+    .tasks = NULL
   };
   return null_executor;
 }
@@ -176,11 +197,281 @@ rclc_executor_set_semantics(rclc_executor_t * executor, rclc_executor_semantics_
   return ret;
 }
 
+rcl_ret_t
+rclc_executor_set_timer_interleaving(rclc_executor_t * executor, bool enable)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    executor, "executor is null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (!_rclc_executor_is_valid(executor)) {
+    RCL_SET_ERROR_MSG("executor not initialized.");
+    return RCL_RET_ERROR;
+  }
+  executor->timer_interleaving = enable;
+  executor->timer_deadline = 0;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_enable_scheduled_tasks(rclc_executor_t * executor, size_t max_tasks)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    executor, "executor is null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (!_rclc_executor_is_valid(executor)) {
+    RCL_SET_ERROR_MSG("executor not initialized.");
+    return RCL_RET_ERROR;
+  }
+  if (NULL != executor->tasks) {
+    RCL_SET_ERROR_MSG("scheduled tasks are already enabled.");
+    return RCL_RET_ERROR;
+  }
+  rcl_ret_t ret = rclc_executor_tasks_init(&executor->tasks, max_tasks, executor->allocator);
+  if (RCL_RET_OK != ret) {
+    PRINT_RCLC_ERROR(rclc_executor_enable_scheduled_tasks, rclc_executor_tasks_init);
+  }
+  return ret;
+}
+
+rcl_ret_t
+rclc_executor_schedule_at(
+  rclc_executor_t * executor,
+  rcutils_time_point_value_t steady_time,
+  rclc_executor_task_callback_t callback,
+  void * context,
+  rclc_executor_task_id_t * task_id)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    executor, "executor is null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    callback, "callback is null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (NULL == executor->tasks) {
+    RCL_SET_ERROR_MSG("scheduled tasks are not enabled.");
+    return RCL_RET_ERROR;
+  }
+  return rclc_executor_tasks_schedule(
+    executor->tasks, steady_time, callback, context, task_id);
+}
+
+rcl_ret_t
+rclc_executor_schedule_after(
+  rclc_executor_t * executor,
+  int64_t delay_ns,
+  rclc_executor_task_callback_t callback,
+  void * context,
+  rclc_executor_task_id_t * task_id)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    executor, "executor is null pointer", return RCL_RET_INVALID_ARGUMENT);
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    RCL_SET_ERROR_MSG("could not read the steady clock.");
+    return RCL_RET_ERROR;
+  }
+  return rclc_executor_schedule_at(executor, now + delay_ns, callback, context, task_id);
+}
+
+rcl_ret_t
+rclc_executor_cancel_task(rclc_executor_t * executor, rclc_executor_task_id_t task_id)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    executor, "executor is null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (NULL == executor->tasks) {
+    RCL_SET_ERROR_MSG("scheduled tasks are not enabled.");
+    return RCL_RET_ERROR;
+  }
+  return rclc_executor_tasks_cancel(executor->tasks, task_id);
+}
+
+// shortens the timeout of rcl_wait to the next scheduled task and, while goal
+// responses are pending, to RCLC_EXECUTOR_PENDING_GOAL_RESPONSE_WAIT_NS
+static
+int64_t
+_rclc_executor_wait_timeout(rclc_executor_t * executor, int64_t timeout_ns)
+{
+  // wake up soon to match goal responses, which arrived before their goal handle
+  for (size_t i = 0; i < executor->index; i++) {
+    if ((executor->handles[i].type == RCLC_ACTION_CLIENT) &&
+      (0 < executor->handles[i].action_client->number_of_pending_goal_responses) &&
+      (timeout_ns < 0 || RCLC_EXECUTOR_PENDING_GOAL_RESPONSE_WAIT_NS < timeout_ns))
+    {
+      timeout_ns = RCLC_EXECUTOR_PENDING_GOAL_RESPONSE_WAIT_NS;
+    }
+  }
+  int64_t task_timeout = 0;
+  if (rclc_executor_tasks_pending(executor->tasks) > 0 &&
+    rclc_executor_tasks_get_timeout(executor->tasks, &task_timeout) &&
+    (timeout_ns < 0 || task_timeout < timeout_ns))
+  {
+    return task_timeout;
+  }
+  return timeout_ns;
+}
+
+// sleeps for the timeout of rcl_wait, rounded up to milliseconds so that a task
+// is due when the executor wakes up
+static
+void
+_rclc_executor_sleep(int64_t timeout_ns)
+{
+  if (timeout_ns <= 0) {
+    return;
+  }
+  int64_t timeout_ms = (timeout_ns + RCUTILS_MS_TO_NS(1) - 1) / RCUTILS_MS_TO_NS(1);
+  rclc_sleep_ms((timeout_ms > UINT_MAX) ? UINT_MAX : (unsigned int) timeout_ms);
+}
+
+rcl_ret_t
+rclc_executor_set_events_mode(rclc_executor_t * executor, bool enable)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    executor, "executor is null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (!_rclc_executor_is_valid(executor)) {
+    RCL_SET_ERROR_MSG("executor not initialized.");
+    return RCL_RET_ERROR;
+  }
+  if (enable == (NULL != executor->events)) {
+    return RCL_RET_OK;
+  }
+#ifndef RCLC_HAVE_LISTENER_API
+  if (enable) {
+    RCL_SET_ERROR_MSG("events mode requires the listener API of rcl (Humble or later).");
+    return RCL_RET_UNSUPPORTED;
+  }
+#endif
+
+  rcl_ret_t ret = RCL_RET_OK;
+  if (enable) {
+    ret = rclc_executor_events_init(
+      &executor->events, executor->context, executor->max_handles,
+      executor->allocator);
+    if (RCL_RET_OK != ret) {
+      PRINT_RCLC_ERROR(rclc_executor_set_events_mode, rclc_executor_events_init);
+      return ret;
+    }
+  } else {
+    ret = rclc_executor_events_fini(
+      &executor->events, executor->handles, executor->index,
+      executor->allocator);
+    if (RCL_RET_OK != ret) {
+      PRINT_RCLC_ERROR(rclc_executor_set_events_mode, rclc_executor_events_fini);
+    }
+  }
+
+  // force a refresh of the wait set
+  if (rcl_wait_set_is_valid(&executor->wait_set)) {
+    rcl_ret_t rc = rcl_wait_set_fini(&executor->wait_set);
+    if (RCL_RET_OK != rc) {
+      PRINT_RCLC_ERROR(rclc_executor_set_events_mode, rcl_wait_set_fini);
+      return rc;
+    }
+  }
+  return ret;
+}
+
+rcl_ret_t
+rclc_executor_set_stats_export(rclc_executor_t * executor, const char * name)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    executor, "executor is null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (!_rclc_executor_is_valid(executor)) {
+    RCL_SET_ERROR_MSG("executor not initialized.");
+    return RCL_RET_ERROR;
+  }
+
+  rcl_ret_t ret = RCL_RET_OK;
+  if (NULL != executor->stats) {
+    ret = rclc_executor_stats_fini(&executor->stats, executor->allocator);
+    if (RCL_RET_OK != ret) {
+      PRINT_RCLC_ERROR(rclc_executor_set_stats_export, rclc_executor_stats_fini);
+      return ret;
+    }
+  }
+  if (NULL != name) {
+    ret = rclc_executor_stats_init(
+      &executor->stats, name, executor->max_handles, executor->allocator);
+    if (RCL_RET_OK != ret) {
+      PRINT_RCLC_ERROR(rclc_executor_set_stats_export, rclc_executor_stats_init);
+      return ret;
+    }
+    rclc_executor_stats_update_handles(executor->stats, executor->handles, executor->index);
+  }
+  return ret;
+}
+
+rcl_ret_t
+rclc_executor_enable_stats_counters(rclc_executor_t * executor, uint32_t * counters)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    executor, "executor is null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (NULL == executor->stats) {
+    RCL_SET_ERROR_MSG("executor does not export statistics.");
+    return RCL_RET_ERROR;
+  }
+  uint32_t available = 0;
+  rcl_ret_t ret = rclc_executor_stats_enable_counters(executor->stats, &available);
+  if (RCL_RET_OK != ret) {
+    PRINT_RCLC_ERROR(rclc_executor_enable_stats_counters, rclc_executor_stats_enable_counters);
+    return ret;
+  }
+  if (NULL != counters) {
+    *counters = available;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_set_chain_tracer(rclc_executor_t * executor, rclc_chain_tracer_t * tracer)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    executor, "executor is null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (!_rclc_executor_is_valid(executor)) {
+    RCL_SET_ERROR_MSG("executor not initialized.");
+    return RCL_RET_ERROR;
+  }
+  if (NULL != tracer && NULL == tracer->events) {
+    RCL_SET_ERROR_MSG("tracer not initialized.");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  executor->chain_tracer = tracer;
+  return RCL_RET_OK;
+}
+
 
 rcl_ret_t
 rclc_executor_fini(rclc_executor_t * executor)
 {
   if (_rclc_executor_is_valid(executor)) {
+    if (NULL != executor->events) {
+      rcl_ret_t rc = rclc_executor_events_fini(
+        &executor->events, executor->handles, executor->index,
+        executor->allocator);
+      if (rc != RCL_RET_OK) {
+        PRINT_RCLC_ERROR(rclc_executor_fini, rclc_executor_events_fini);
+      }
+    }
+    if (NULL != executor->stats) {
+      rcl_ret_t rc = rclc_executor_stats_fini(&executor->stats, executor->allocator);
+      if (rc != RCL_RET_OK) {
+        PRINT_RCLC_ERROR(rclc_executor_fini, rclc_executor_stats_fini);
+      }
+    }
+    if (NULL != executor->staging) {
+      rcl_ret_t rc = rclc_executor_staging_fini(&executor->staging, executor->allocator);
+      if (rc != RCL_RET_OK) {
+        PRINT_RCLC_ERROR(rclc_executor_fini, rclc_executor_staging_fini);
+      }
+    }
+    if (NULL != executor->dag) {
+      rcl_ret_t rc = rclc_executor_dag_fini(&executor->dag, executor->allocator);
+      if (rc != RCL_RET_OK) {
+        PRINT_RCLC_ERROR(rclc_executor_fini, rclc_executor_dag_fini);
+      }
+    }
+    if (NULL != executor->tasks) {
+      rcl_ret_t rc = rclc_executor_tasks_fini(&executor->tasks, executor->allocator);
+      if (rc != RCL_RET_OK) {
+        PRINT_RCLC_ERROR(rclc_executor_fini, rclc_executor_tasks_fini);
+      }
+    }
     executor->allocator->deallocate(executor->handles, executor->allocator->state);
     executor->handles = NULL;
     executor->max_handles = 0;
@@ -231,6 +522,7 @@ rclc_executor_add_subscription(
   executor->handles[executor->index].initialized = true;
   executor->handles[executor->index].callback_context = NULL;
   executor->handles[executor->index].data_available = false;
+  executor->handles[executor->index].topic_statistics = NULL;
 
   // increase index of handle array
   executor->index++;
@@ -247,7 +539,7 @@ rclc_executor_add_subscription(
 
   executor->info.number_of_subscriptions++;
 
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a subscription.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a subscription.");
   return ret;
 }
 
@@ -280,6 +572,7 @@ rclc_executor_add_subscription_with_context(
   executor->handles[executor->index].invocation = invocation;
   executor->handles[executor->index].initialized = true;
   executor->handles[executor->index].callback_context = context;
+  executor->handles[executor->index].topic_statistics = NULL;
 
   // increase index of handle array
   executor->index++;
@@ -296,7 +589,55 @@ rclc_executor_add_subscription_with_context(
 
   executor->info.number_of_subscriptions++;
 
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a subscription.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a subscription.");
+  return ret;
+}
+
+rcl_ret_t
+rclc_executor_add_subscription_latest_value(
+  rclc_executor_t * executor,
+  rcl_subscription_t * subscription,
+  rclc_latest_value_t * latest_value,
+  rclc_subscription_callback_t callback,
+  rclc_executor_handle_invocation_t invocation)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(latest_value, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = RCL_RET_OK;
+  // array bound check
+  if (executor->index >= executor->max_handles) {
+    RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
+    return RCL_RET_ERROR;
+  }
+
+  // assign data fields
+  executor->handles[executor->index].type = RCLC_SUBSCRIPTION_LATEST_VALUE;
+  executor->handles[executor->index].subscription = subscription;
+  executor->handles[executor->index].data = latest_value;
+  executor->handles[executor->index].subscription_callback = callback;
+  executor->handles[executor->index].invocation = invocation;
+  executor->handles[executor->index].initialized = true;
+  executor->handles[executor->index].callback_context = NULL;
+  executor->handles[executor->index].data_available = false;
+  executor->handles[executor->index].topic_statistics = NULL;
+
+  // increase index of handle array
+  executor->index++;
+
+  // invalidate wait_set so that in next spin_some() call the
+  // 'executor->wait_set' is updated accordingly
+  if (rcl_wait_set_is_valid(&executor->wait_set)) {
+    ret = rcl_wait_set_fini(&executor->wait_set);
+    if (RCL_RET_OK != ret) {
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_subscription_latest_value.");
+      return ret;
+    }
+  }
+
+  executor->info.number_of_subscriptions++;
+
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a subscription with latest value.");
   return ret;
 }
 
@@ -338,7 +679,7 @@ rclc_executor_add_timer(
     }
   }
   executor->info.number_of_timers++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a timer.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a timer.");
   return ret;
 }
 
@@ -384,7 +725,7 @@ rclc_executor_add_client(
   }
 
   executor->info.number_of_clients++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a client.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a client.");
   return ret;
 }
 
@@ -430,7 +771,7 @@ rclc_executor_add_client_with_request_id(
   }
 
   executor->info.number_of_clients++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a client.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a client.");
   return ret;
 }
 
@@ -457,6 +798,7 @@ rclc_executor_add_service(
 
   // assign data fields
   executor->handles[executor->index].type = RCLC_SERVICE;
+  executor->handles[executor->index].service_cache = NULL;
   executor->handles[executor->index].service = service;
   executor->handles[executor->index].data = request_msg;
   // TODO(jst3si) new type with req and resp message in data field.
@@ -480,7 +822,7 @@ rclc_executor_add_service(
   }
 
   executor->info.number_of_services++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a service.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a service.");
   return ret;
 }
 
@@ -508,6 +850,7 @@ rclc_executor_add_service_with_context(
 
   // assign data fields
   executor->handles[executor->index].type = RCLC_SERVICE_WITH_CONTEXT;
+  executor->handles[executor->index].service_cache = NULL;
   executor->handles[executor->index].service = service;
   executor->handles[executor->index].data = request_msg;
   // TODO(jst3si) new type with req and resp message in data field.
@@ -531,7 +874,7 @@ rclc_executor_add_service_with_context(
   }
 
   executor->info.number_of_services++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a service.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a service.");
   return ret;
 }
 
@@ -558,6 +901,7 @@ rclc_executor_add_service_with_request_id(
 
   // assign data fields
   executor->handles[executor->index].type = RCLC_SERVICE_WITH_REQUEST_ID;
+  executor->handles[executor->index].service_cache = NULL;
   executor->handles[executor->index].service = service;
   executor->handles[executor->index].data = request_msg;
   // TODO(jst3si) new type with req and resp message in data field.
@@ -581,7 +925,7 @@ rclc_executor_add_service_with_request_id(
   }
 
   executor->info.number_of_services++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a service.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a service.");
   return ret;
 }
 
@@ -624,7 +968,7 @@ rclc_executor_add_guard_condition(
   }
 
   executor->info.number_of_guard_conditions++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a guard_condition.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a guard_condition.");
   return ret;
 }
 
@@ -653,6 +997,15 @@ _rclc_executor_remove_handle(rclc_executor_t * executor, rclc_executor_handle_t
     return RCL_RET_ERROR;
   }
 
+  // the listeners refer to the position of the handles, which is changed below
+  if (NULL != executor->events) {
+    ret = rclc_executor_events_detach(executor->events, executor->handles, executor->index);
+    if (RCL_RET_OK != ret) {
+      RCL_SET_ERROR_MSG("Could not detach events in _rclc_executor_remove_handle.");
+      return ret;
+    }
+  }
+
   // shorten the list of handles without changing the order of remaining handles
   executor->index--;
   for (rclc_executor_handle_t * handle_dest = handle;
@@ -672,7 +1025,7 @@ _rclc_executor_remove_handle(rclc_executor_t * executor, rclc_executor_handle_t
     }
   }
 
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a handle.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a handle.");
   return ret;
 }
 
@@ -693,6 +1046,42 @@ _rclc_executor_find_handle(
   return NULL;
 }
 
+rcl_ret_t
+rclc_executor_set_service_cache(
+  rclc_executor_t * executor,
+  const rcl_service_t * service,
+  rclc_service_cache_t * cache)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(service, RCL_RET_INVALID_ARGUMENT);
+
+  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, service);
+  if (NULL == handle) {
+    RCL_SET_ERROR_MSG("service not found in rclc_executor_set_service_cache");
+    return RCL_RET_ERROR;
+  }
+  handle->service_cache = cache;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_set_topic_statistics(
+  rclc_executor_t * executor,
+  const rcl_subscription_t * subscription,
+  rclc_topic_statistics_t * stats)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
+
+  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, subscription);
+  if (NULL == handle) {
+    RCL_SET_ERROR_MSG("subscription not found in rclc_executor_set_topic_statistics");
+    return RCL_RET_ERROR;
+  }
+  handle->topic_statistics = stats;
+  return RCL_RET_OK;
+}
+
 
 rcl_ret_t
 rclc_executor_remove_subscription(
@@ -710,7 +1099,7 @@ rclc_executor_remove_subscription(
     return ret;
   }
   executor->info.number_of_subscriptions--;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a subscription.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a subscription.");
   return ret;
 }
 
@@ -730,7 +1119,7 @@ rclc_executor_remove_timer(
     return ret;
   }
   executor->info.number_of_timers--;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a timer.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a timer.");
   return ret;
 }
 
@@ -750,7 +1139,7 @@ rclc_executor_remove_client(
     return ret;
   }
   executor->info.number_of_clients--;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a client.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a client.");
   return ret;
 }
 
@@ -770,7 +1159,7 @@ rclc_executor_remove_service(
     return ret;
   }
   executor->info.number_of_services--;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a service.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a service.");
   return ret;
 }
 
@@ -791,51 +1180,486 @@ rclc_executor_remove_guard_condition(
     return ret;
   }
   executor->info.number_of_guard_conditions--;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a guard condition.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a guard condition.");
   return ret;
 }
 
 rcl_ret_t
-rclc_executor_add_action_client(
+rclc_executor_add_discovery(
   rclc_executor_t * executor,
-  rclc_action_client_t * action_client,
-  size_t handles_number,
-  void * ros_result_response,
-  void * ros_feedback,
-  rclc_action_client_goal_callback_t goal_callback,
-  rclc_action_client_feedback_callback_t feedback_callback,
-  rclc_action_client_result_callback_t result_callback,
-  rclc_action_client_cancel_callback_t cancel_callback,
+  rclc_discovery_t * discovery,
+  rclc_discovery_callback_t callback,
   void * context)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(action_client, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(ros_result_response, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(goal_callback, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(result_callback, RCL_RET_INVALID_ARGUMENT);
-
-  if (NULL != feedback_callback) {
-    RCL_CHECK_ARGUMENT_FOR_NULL(ros_feedback, RCL_RET_INVALID_ARGUMENT);
-  }
-
+  RCL_CHECK_ARGUMENT_FOR_NULL(discovery, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(discovery->node, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
   rcl_ret_t ret = RCL_RET_OK;
-
   // array bound check
   if (executor->index >= executor->max_handles) {
-    rcl_ret_t ret = RCL_RET_ERROR;
+    ret = RCL_RET_ERROR;
     RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
     return ret;
   }
 
-  action_client->allocator = executor->allocator;
+  discovery->callback = callback;
+  discovery->callback_context = context;
+  discovery->matched = false;
+  discovery->checked = false;
 
-  // Init goal handles
-  action_client->goal_handles_memory =
-    executor->allocator->allocate(
-    handles_number * sizeof(rclc_action_goal_handle_t),
-    executor->allocator->state);
-  if (NULL == action_client->goal_handles_memory) {
-    return RCL_RET_ERROR;
+  // assign data fields
+  executor->handles[executor->index].type = RCLC_DISCOVERY;
+  executor->handles[executor->index].discovery = discovery;
+  executor->handles[executor->index].invocation = ON_NEW_DATA;  // invoke on graph changes
+  executor->handles[executor->index].initialized = true;
+  executor->handles[executor->index].callback_context = context;
+
+  // increase index of handle array
+  executor->index++;
+
+  // invalidate wait_set so that in next spin_some() call the
+  // 'executor->wait_set' is updated accordingly
+  if (rcl_wait_set_is_valid(&executor->wait_set)) {
+    ret = rcl_wait_set_fini(&executor->wait_set);
+    if (RCL_RET_OK != ret) {
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_discovery function.");
+      return ret;
+    }
+  }
+
+  executor->info.number_of_guard_conditions++;
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a discovery condition.");
+  return ret;
+}
+
+rcl_ret_t
+rclc_executor_remove_discovery(
+  rclc_executor_t * executor,
+  const rclc_discovery_t * discovery)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(discovery, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = RCL_RET_OK;
+
+  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, discovery);
+  ret = _rclc_executor_remove_handle(executor, handle);
+  if (RCL_RET_OK != ret) {
+    RCL_SET_ERROR_MSG("Failed to remove handle in rclc_executor_remove_discovery.");
+    return ret;
+  }
+  executor->info.number_of_guard_conditions--;
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a discovery condition.");
+  return ret;
+}
+
+// callback of the staging guard condition, the requests are applied before the wait
+static
+void
+_rclc_executor_staging_wakeup(void)
+{
+}
+
+rcl_ret_t
+rclc_executor_enable_staging(rclc_executor_t * executor, size_t queue_size)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    executor, "executor is null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (!_rclc_executor_is_valid(executor)) {
+    RCL_SET_ERROR_MSG("executor not initialized.");
+    return RCL_RET_ERROR;
+  }
+  if (NULL != executor->staging) {
+    RCL_SET_ERROR_MSG("staging is already enabled.");
+    return RCL_RET_ERROR;
+  }
+
+  rcl_ret_t ret = rclc_executor_staging_init(
+    &executor->staging, executor->context, queue_size, executor->allocator);
+  if (RCL_RET_OK != ret) {
+    PRINT_RCLC_ERROR(rclc_executor_enable_staging, rclc_executor_staging_init);
+    return ret;
+  }
+  ret = rclc_executor_add_guard_condition(
+    executor, rclc_executor_staging_get_guard_condition(executor->staging),
+    _rclc_executor_staging_wakeup);
+  if (RCL_RET_OK != ret) {
+    PRINT_RCLC_ERROR(rclc_executor_enable_staging, rclc_executor_add_guard_condition);
+    rcl_ret_t rc = rclc_executor_staging_fini(&executor->staging, executor->allocator);
+    RCLC_UNUSED(rc);
+    return ret;
+  }
+  return ret;
+}
+
+static
+rcl_ret_t
+_rclc_executor_stage(rclc_executor_t * executor, const rclc_executor_staged_request_t * request)
+{
+  if (NULL == executor->staging) {
+    RCL_SET_ERROR_MSG("staging is not enabled.");
+    return RCL_RET_ERROR;
+  }
+  return rclc_executor_staging_push(executor->staging, request);
+}
+
+rcl_ret_t
+rclc_executor_stage_add_subscription(
+  rclc_executor_t * executor,
+  rcl_subscription_t * subscription,
+  void * msg,
+  rclc_subscription_callback_t callback,
+  rclc_executor_handle_invocation_t invocation)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  rclc_executor_staged_request_t request = {
+    .operation = RCLC_STAGED_ADD,
+    .type = RCLC_SUBSCRIPTION,
+    .invocation = invocation,
+    .rcl_handle = subscription,
+    .data = msg,
+    .subscription_callback = callback
+  };
+  return _rclc_executor_stage(executor, &request);
+}
+
+rcl_ret_t
+rclc_executor_stage_add_subscription_with_context(
+  rclc_executor_t * executor,
+  rcl_subscription_t * subscription,
+  void * msg,
+  rclc_subscription_callback_with_context_t callback,
+  void * context,
+  rclc_executor_handle_invocation_t invocation)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  rclc_executor_staged_request_t request = {
+    .operation = RCLC_STAGED_ADD,
+    .type = RCLC_SUBSCRIPTION_WITH_CONTEXT,
+    .invocation = invocation,
+    .rcl_handle = subscription,
+    .data = msg,
+    .callback_context = context,
+    .subscription_callback_with_context = callback
+  };
+  return _rclc_executor_stage(executor, &request);
+}
+
+rcl_ret_t
+rclc_executor_stage_add_timer(
+  rclc_executor_t * executor,
+  rcl_timer_t * timer)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  rclc_executor_staged_request_t request = {
+    .operation = RCLC_STAGED_ADD,
+    .type = RCLC_TIMER,
+    .invocation = ON_NEW_DATA,
+    .rcl_handle = timer
+  };
+  return _rclc_executor_stage(executor, &request);
+}
+
+rcl_ret_t
+rclc_executor_stage_add_client(
+  rclc_executor_t * executor,
+  rcl_client_t * client,
+  void * response_msg,
+  rclc_client_callback_t callback)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(client, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(response_msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  rclc_executor_staged_request_t request = {
+    .operation = RCLC_STAGED_ADD,
+    .type = RCLC_CLIENT,
+    .invocation = ON_NEW_DATA,
+    .rcl_handle = client,
+    .data = response_msg,
+    .client_callback = callback
+  };
+  return _rclc_executor_stage(executor, &request);
+}
+
+rcl_ret_t
+rclc_executor_stage_add_service(
+  rclc_executor_t * executor,
+  rcl_service_t * service,
+  void * request_msg,
+  void * response_msg,
+  rclc_service_callback_t callback)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(service, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(request_msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(response_msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  rclc_executor_staged_request_t request = {
+    .operation = RCLC_STAGED_ADD,
+    .type = RCLC_SERVICE,
+    .invocation = ON_NEW_DATA,
+    .rcl_handle = service,
+    .data = request_msg,
+    .data_response_msg = response_msg,
+    .service_callback = callback
+  };
+  return _rclc_executor_stage(executor, &request);
+}
+
+rcl_ret_t
+rclc_executor_stage_add_guard_condition(
+  rclc_executor_t * executor,
+  rcl_guard_condition_t * gc,
+  rclc_gc_callback_t callback)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(gc, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  rclc_executor_staged_request_t request = {
+    .operation = RCLC_STAGED_ADD,
+    .type = RCLC_GUARD_CONDITION,
+    .invocation = ON_NEW_DATA,
+    .rcl_handle = gc,
+    .gc_callback = callback
+  };
+  return _rclc_executor_stage(executor, &request);
+}
+
+rcl_ret_t
+rclc_executor_stage_remove(
+  rclc_executor_t * executor,
+  const void * rcl_handle)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(rcl_handle, RCL_RET_INVALID_ARGUMENT);
+  rclc_executor_staged_request_t request = {
+    .operation = RCLC_STAGED_REMOVE,
+    .type = RCLC_NONE,
+    .rcl_handle = (void *) rcl_handle
+  };
+  return _rclc_executor_stage(executor, &request);
+}
+
+bool
+rclc_executor_staging_is_idle(const rclc_executor_t * executor)
+{
+  if (NULL == executor || NULL == executor->staging) {
+    return true;
+  }
+  return rclc_executor_staging_all_applied(executor->staging);
+}
+
+size_t
+rclc_executor_staging_get_failed_count(const rclc_executor_t * executor)
+{
+  if (NULL == executor || NULL == executor->staging) {
+    return 0;
+  }
+  return rclc_executor_staging_failed(executor->staging);
+}
+
+static
+rcl_ret_t
+_rclc_executor_apply_staged_add(
+  rclc_executor_t * executor,
+  const rclc_executor_staged_request_t * request)
+{
+  switch (request->type) {
+    case RCLC_SUBSCRIPTION:
+      return rclc_executor_add_subscription(
+        executor, request->rcl_handle, request->data,
+        request->subscription_callback, request->invocation);
+    case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+      return rclc_executor_add_subscription_with_context(
+        executor, request->rcl_handle, request->data,
+        request->subscription_callback_with_context, request->callback_context,
+        request->invocation);
+    case RCLC_TIMER:
+      return rclc_executor_add_timer(executor, request->rcl_handle);
+    case RCLC_CLIENT:
+      return rclc_executor_add_client(
+        executor, request->rcl_handle, request->data, request->client_callback);
+    case RCLC_SERVICE:
+      return rclc_executor_add_service(
+        executor, request->rcl_handle, request->data, request->data_response_msg,
+        request->service_callback);
+    case RCLC_GUARD_CONDITION:
+      return rclc_executor_add_guard_condition(
+        executor, request->rcl_handle, request->gc_callback);
+    default:
+      RCL_SET_ERROR_MSG("staged handle type not supported");
+      return RCL_RET_ERROR;
+  }
+}
+
+static
+rcl_ret_t
+_rclc_executor_apply_staged_remove(
+  rclc_executor_t * executor,
+  const rclc_executor_staged_request_t * request)
+{
+  if (request->rcl_handle == rclc_executor_staging_get_guard_condition(executor->staging)) {
+    RCL_SET_ERROR_MSG("the staging guard condition cannot be removed");
+    return RCL_RET_ERROR;
+  }
+  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, request->rcl_handle);
+  if (NULL == handle) {
+    RCL_SET_ERROR_MSG("staged handle not found in executor");
+    return RCL_RET_ERROR;
+  }
+  switch (handle->type) {
+    case RCLC_SUBSCRIPTION:
+    case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+    case RCLC_SUBSCRIPTION_LATEST_VALUE:
+      return rclc_executor_remove_subscription(executor, handle->subscription);
+    case RCLC_TIMER:
+      return rclc_executor_remove_timer(executor, handle->timer);
+    case RCLC_CLIENT:
+    case RCLC_CLIENT_WITH_REQUEST_ID:
+      return rclc_executor_remove_client(executor, handle->client);
+    case RCLC_SERVICE:
+    case RCLC_SERVICE_WITH_REQUEST_ID:
+    case RCLC_SERVICE_WITH_CONTEXT:
+      return rclc_executor_remove_service(executor, handle->service);
+    case RCLC_GUARD_CONDITION:
+      return rclc_executor_remove_guard_condition(executor, handle->gc);
+    case RCLC_DISCOVERY:
+      return rclc_executor_remove_discovery(executor, handle->discovery);
+    default:
+      RCL_SET_ERROR_MSG("staged handle type cannot be removed");
+      return RCL_RET_ERROR;
+  }
+}
+
+// applies the staged requests in their order, called by the executor thread
+// at the beginning of rclc_executor_spin_some
+static
+void
+_rclc_executor_apply_staged(rclc_executor_t * executor)
+{
+  rclc_executor_staged_request_t request;
+  while (rclc_executor_staging_pop(executor->staging, &request)) {
+    rcl_ret_t rc;
+    if (RCLC_STAGED_ADD == request.operation) {
+      rc = _rclc_executor_apply_staged_add(executor, &request);
+      if (RCL_RET_OK != rc) {
+        PRINT_RCLC_ERROR(rclc_executor_spin_some, rclc_executor_stage_add);
+      }
+    } else {
+      rc = _rclc_executor_apply_staged_remove(executor, &request);
+      if (RCL_RET_OK != rc) {
+        PRINT_RCLC_ERROR(rclc_executor_spin_some, rclc_executor_stage_remove);
+      }
+    }
+    rclc_executor_staging_mark_applied(executor->staging, RCL_RET_OK == rc);
+  }
+}
+
+rcl_ret_t
+rclc_executor_add_dependency(
+  rclc_executor_t * executor,
+  const void * before,
+  const void * after)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(before, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(after, RCL_RET_INVALID_ARGUMENT);
+  if (!_rclc_executor_is_valid(executor)) {
+    RCL_SET_ERROR_MSG("executor is not initialized.");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (NULL == executor->dag) {
+    rcl_ret_t rc = rclc_executor_dag_init(
+      &executor->dag, executor->max_handles, executor->allocator);
+    if (RCL_RET_OK != rc) {
+      PRINT_RCLC_ERROR(rclc_executor_add_dependency, rclc_executor_dag_init);
+      return rc;
+    }
+  }
+  return rclc_executor_dag_add_dependency(
+    executor->dag, before, after, executor->handles, executor->index);
+}
+
+rcl_ret_t
+rclc_executor_enable_parallel_execution(
+  rclc_executor_t * executor,
+  size_t number_of_threads)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  if (!_rclc_executor_is_valid(executor)) {
+    RCL_SET_ERROR_MSG("executor is not initialized.");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (0 == number_of_threads) {
+    RCL_SET_ERROR_MSG("number_of_threads is 0. Must be larger or equal to 1");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (NULL == executor->dag) {
+    rcl_ret_t rc = rclc_executor_dag_init(
+      &executor->dag, executor->max_handles, executor->allocator);
+    if (RCL_RET_OK != rc) {
+      PRINT_RCLC_ERROR(rclc_executor_enable_parallel_execution, rclc_executor_dag_init);
+      return rc;
+    }
+    rclc_executor_dag_update_handles(executor->dag, executor->handles, executor->index);
+  }
+  return rclc_executor_dag_start_workers(executor->dag, number_of_threads);
+}
+
+rcl_ret_t
+rclc_executor_add_action_client(
+  rclc_executor_t * executor,
+  rclc_action_client_t * action_client,
+  size_t handles_number,
+  void * ros_result_response,
+  void * ros_feedback,
+  rclc_action_client_goal_callback_t goal_callback,
+  rclc_action_client_feedback_callback_t feedback_callback,
+  rclc_action_client_result_callback_t result_callback,
+  rclc_action_client_cancel_callback_t cancel_callback,
+  void * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(action_client, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_result_response, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(goal_callback, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(result_callback, RCL_RET_INVALID_ARGUMENT);
+
+  if (NULL != feedback_callback) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(ros_feedback, RCL_RET_INVALID_ARGUMENT);
+  }
+
+  rcl_ret_t ret = RCL_RET_OK;
+
+  // array bound check
+  if (executor->index >= executor->max_handles) {
+    rcl_ret_t ret = RCL_RET_ERROR;
+    RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
+    return ret;
+  }
+
+  if (0 == handles_number || handles_number > RCLC_ACTION_GOAL_HANDLE_POOL_MAX_SIZE) {
+    RCL_SET_ERROR_MSG("handles_number is 0 or exceeds RCLC_ACTION_GOAL_HANDLE_POOL_MAX_SIZE");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  action_client->allocator = executor->allocator;
+
+  // Init goal handles
+  action_client->goal_handles_memory =
+    executor->allocator->allocate(
+    handles_number * sizeof(rclc_action_goal_handle_t),
+    executor->allocator->state);
+  if (NULL == action_client->goal_handles_memory) {
+    return RCL_RET_ERROR;
   }
   action_client->goal_handles_memory_size = handles_number;
   rclc_action_init_goal_handle_memory(action_client);
@@ -850,10 +1674,8 @@ rclc_executor_add_action_client(
   action_client->ros_cancel_response.goals_canceling.size = 0;
   action_client->ros_cancel_response.goals_canceling.capacity = handles_number;
 
-  rclc_action_goal_handle_t * goal_handle = action_client->free_goal_handles;
-  while (NULL != goal_handle) {
-    goal_handle->action_client = action_client;
-    goal_handle = goal_handle->next;
+  for (size_t i = 0; i < handles_number; i++) {
+    action_client->goal_handles_memory[i].action_client = action_client;
   }
 
   // assign data fields
@@ -904,7 +1726,7 @@ rclc_executor_add_action_client(
   executor->info.number_of_services += num_services;
 
   executor->info.number_of_action_clients++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added an action client.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added an action client.");
   return ret;
 }
 
@@ -932,6 +1754,11 @@ rclc_executor_add_action_server(
 
   rcl_ret_t ret = RCL_RET_OK;
 
+  if (0 == handles_number || handles_number > RCLC_ACTION_GOAL_HANDLE_POOL_MAX_SIZE) {
+    RCL_SET_ERROR_MSG("handles_number is 0 or exceeds RCLC_ACTION_GOAL_HANDLE_POOL_MAX_SIZE");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
   action_server->allocator = executor->allocator;
 
   // array bound check
@@ -951,15 +1778,28 @@ rclc_executor_add_action_server(
   }
   action_server->goal_handles_memory_size = handles_number;
   rclc_action_init_goal_handle_memory(action_server);
+  action_server->ros_goal_request_size = ros_goal_request_size;
 
-  rclc_action_goal_handle_t * goal_handle = action_server->free_goal_handles;
-  size_t ros_goal_request_index = 0;
-  while (NULL != goal_handle) {
+  // Init goal infos of the cancel response
+  action_server->cancel_goals_memory =
+    executor->allocator->allocate(
+    handles_number * sizeof(action_msgs__msg__GoalInfo),
+    executor->allocator->state);
+  if (NULL == action_server->cancel_goals_memory) {
+    executor->allocator->deallocate(
+      action_server->goal_handles_memory,
+      executor->allocator->state);
+    action_server->goal_handles_memory = NULL;
+    return RCL_RET_ERROR;
+  }
+
+  for (size_t i = 0; i < handles_number; i++) {
+    rclc_action_goal_handle_t * goal_handle = &action_server->goal_handles_memory[i];
     goal_handle->ros_goal_request =
-      (void *) &((uint8_t *)ros_goal_request)[ros_goal_request_index * ros_goal_request_size]; // NOLINT()
+      (void *) &((uint8_t *)ros_goal_request)[i * ros_goal_request_size]; // NOLINT()
     goal_handle->action_server = action_server;
-    ros_goal_request_index++;
-    goal_handle = goal_handle->next;
+    goal_handle->ros_result_response = NULL;
+    goal_handle->result_state = RCLC_ACTION_RESULT_NONE;
   }
 
   // assign data fields
@@ -1008,7 +1848,7 @@ rclc_executor_add_action_server(
   executor->info.number_of_services += num_services;
 
   executor->info.number_of_action_servers++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a action client.");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a action client.");
   return ret;
 }
 
@@ -1031,6 +1871,7 @@ _rclc_check_for_new_data(rclc_executor_handle_t * handle, rcl_wait_set_t * wait_
   switch (handle->type) {
     case RCLC_SUBSCRIPTION:
     case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+    case RCLC_SUBSCRIPTION_LATEST_VALUE:
       handle->data_available = (NULL != wait_set->subscriptions[handle->index]);
       break;
 
@@ -1056,7 +1897,14 @@ _rclc_check_for_new_data(rclc_executor_handle_t * handle, rcl_wait_set_t * wait_
       handle->data_available = (NULL != wait_set->guard_conditions[handle->index]);
       break;
 
+    case RCLC_DISCOVERY:
+      // evaluate the condition only on graph changes (and once initially)
+      handle->data_available = !handle->discovery->matched &&
+        ((NULL != wait_set->guard_conditions[handle->index]) || !handle->discovery->checked);
+      break;
+
     case RCLC_ACTION_CLIENT:
+      rclc_action_trim_goal_handle_pool(handle->action_client);
       rc = rcl_action_client_wait_set_get_entities_ready(
         wait_set,
         &handle->action_client->rcl_handle,
@@ -1066,9 +1914,13 @@ _rclc_check_for_new_data(rclc_executor_handle_t * handle, rcl_wait_set_t * wait_
         &handle->action_client->cancel_response_available,
         &handle->action_client->result_response_available
       );
+      if (0 < handle->action_client->number_of_pending_goal_responses) {
+        handle->action_client->goal_response_available = true;
+      }
       break;
 
     case RCLC_ACTION_SERVER:
+      rclc_action_trim_goal_handle_pool(handle->action_server);
       rc = rcl_action_server_wait_set_get_entities_ready(
         wait_set,
         &handle->action_server->rcl_handle,
@@ -1080,20 +1932,57 @@ _rclc_check_for_new_data(rclc_executor_handle_t * handle, rcl_wait_set_t * wait_
       break;
 
     default:
-      RCUTILS_LOG_DEBUG_NAMED(
-        ROS_PACKAGE_NAME, "Error in _rclc_check_for_new_data:wait_set unknwon handle type: %d",
-        handle->type);
+      RCLC_LOG_DEBUG_NAMED(
+        ROS_PACKAGE_NAME, "Error in _rclc_check_for_new_data:wait_set unknwon handle type: %ld",
+        (long) handle->type);
       return RCL_RET_ERROR;
   }    // switch-case
   return rc;
 }
 
+// take a message into a free buffer of the latest-value slot and publish it
+static
+rcl_ret_t
+_rclc_take_latest_value(rclc_executor_handle_t * handle, rclc_chain_tracer_t * tracer)
+{
+  rclc_latest_value_t * latest_value = (rclc_latest_value_t *) handle->data;
+  rclc_latest_value_buffer_t * buffer = rclc_latest_value_get_free_buffer(latest_value);
+  rmw_message_info_t messageInfo;
+  rcl_ret_t rc;
+  if (NULL == buffer) {
+    // all buffers are held by readers: drop the message, otherwise the subscription
+    // stays ready and rcl_wait returns immediately until a reader releases its buffer
+    rc = rclc_latest_value_drop(latest_value, handle->subscription, &messageInfo);
+    if (rc == RCL_RET_OK) {
+      if (NULL != handle->topic_statistics) {
+        rclc_topic_statistics_record(handle->topic_statistics, &messageInfo);
+      }
+      // no new value is published, so the callback is not invoked
+      rc = RCL_RET_SUBSCRIPTION_TAKE_FAILED;
+    }
+    return rc;
+  }
+  rc = rcl_take(handle->subscription, buffer->msg, &messageInfo, NULL);
+  if (rc == RCL_RET_OK) {
+    rclc_latest_value_publish(latest_value, buffer);
+    if (NULL != tracer) {
+      rclc_chain_tracer_record_take(tracer, handle->subscription, &messageInfo);
+    }
+    if (NULL != handle->topic_statistics) {
+      rclc_topic_statistics_record(handle->topic_statistics, &messageInfo);
+    }
+  }
+  return rc;
+}
+
 // call rcl_take for subscription
 // todo change function signature (rclc_executor_handle_t * handle, rcl_wait_set_t * wait_set)
 
 static
 rcl_ret_t
-_rclc_take_new_data(rclc_executor_handle_t * handle, rcl_wait_set_t * wait_set)
+_rclc_take_new_data(
+  rclc_executor_handle_t * handle, rcl_wait_set_t * wait_set,
+  rclc_chain_tracer_t * tracer)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(handle, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
@@ -1119,6 +2008,27 @@ _rclc_take_new_data(rclc_executor_handle_t * handle, rcl_wait_set_t * wait_set)
           }
           return rc;
         }
+        if (NULL != tracer) {
+          rclc_chain_tracer_record_take(tracer, handle->subscription, &messageInfo);
+        }
+        if (NULL != handle->topic_statistics) {
+          rclc_topic_statistics_record(handle->topic_statistics, &messageInfo);
+        }
+      }
+      break;
+
+    case RCLC_SUBSCRIPTION_LATEST_VALUE:
+      if (wait_set->subscriptions[handle->index]) {
+        rc = _rclc_take_latest_value(handle, tracer);
+        if (rc != RCL_RET_OK) {
+          if (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED) {
+            PRINT_RCLC_ERROR(rclc_take_new_data, rcl_take);
+            RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
+          } else {
+            handle->data_available = false;
+          }
+          return rc;
+        }
       }
       break;
 
@@ -1130,24 +2040,26 @@ _rclc_take_new_data(rclc_executor_handle_t * handle, rcl_wait_set_t * wait_set)
 
     case RCLC_ACTION_CLIENT:
       if (handle->action_client->goal_response_available) {
+        // responses taken before their goal handle was in the used list
+        rclc_action_client_match_pending_goal_responses(handle->action_client);
         Generic_SendGoal_Response aux_goal_response;
         rmw_request_id_t aux_goal_response_header;
         rc = rcl_action_take_goal_response(
           &handle->action_client->rcl_handle,
           &aux_goal_response_header,
           &aux_goal_response);
-        if (rc != RCL_RET_OK) {
+        if (rc == RCL_RET_OK) {
+          rclc_action_client_match_goal_response(
+            handle->action_client, aux_goal_response_header.sequence_number,
+            aux_goal_response.accepted);
+        } else if (rc == RCL_RET_ACTION_CLIENT_TAKE_FAILED) {
+          // only pending responses were available
+          rc = RCL_RET_OK;
+        } else {
           PRINT_RCLC_ERROR(rclc_take_new_data, rcl_action_take_goal_response);
           RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
           return rc;
         }
-        rclc_action_goal_handle_t * goal_handle =
-          rclc_action_find_handle_by_goal_request_sequence_number(
-          handle->action_client, aux_goal_response_header.sequence_number);
-        if (NULL != goal_handle) {
-          goal_handle->available_goal_response = true;
-          goal_handle->goal_accepted = aux_goal_response.accepted;
-        }
       }
       if (handle->action_client->feedback_callback != NULL &&
         handle->action_client->feedback_available)
@@ -1236,6 +2148,7 @@ _rclc_take_new_data(rclc_executor_handle_t * handle, rcl_wait_set_t * wait_set)
           }
           goal_handle->goal_id = goal_handle->ros_goal_request->goal_id;
           goal_handle->status = GOAL_STATE_UNKNOWN;
+          rclc_action_server_reset_result(goal_handle);
         }
       }
       if (handle->action_server->result_request_available) {
@@ -1253,42 +2166,25 @@ _rclc_take_new_data(rclc_executor_handle_t * handle, rcl_wait_set_t * wait_set)
         rclc_action_goal_handle_t * goal_handle = rclc_action_find_goal_handle_by_uuid(
           handle->action_server, &aux_result_request.goal_id);
         if (NULL != goal_handle) {
-          goal_handle->result_request_header = aux_result_request_header;
-          goal_handle->status = GOAL_STATE_EXECUTING;
+          // a stored result is sent right away
+          if (RCL_RET_OK != rclc_action_server_process_result_request(
+              goal_handle, &aux_result_request_header))
+          {
+            PRINT_RCLC_ERROR(rclc_take_new_data, rclc_action_server_process_result_request);
+          }
         }
         handle->action_server->result_request_available = false;
       }
       if (handle->action_server->cancel_request_available) {
-        action_msgs__srv__CancelGoal_Request aux_cancel_request;
-        rmw_request_id_t aux_cancel_request_header;
-
         rc = rcl_action_take_cancel_request(
           &handle->action_server->rcl_handle,
-          &aux_cancel_request_header,
-          &aux_cancel_request);
+          &handle->action_server->cancel_request_header,
+          &handle->action_server->cancel_request);
         if (rc != RCL_RET_OK) {
           PRINT_RCLC_ERROR(rclc_take_new_data, rcl_action_take_cancel_request);
           RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
           return rc;
         }
-        rclc_action_goal_handle_t * goal_handle = rclc_action_find_goal_handle_by_uuid(
-          handle->action_server, &aux_cancel_request.goal_info.goal_id);
-        if (NULL != goal_handle) {
-          if (GOAL_STATE_CANCELING == rcl_action_transition_goal_state(
-              goal_handle->status, GOAL_EVENT_CANCEL_GOAL))
-          {
-            goal_handle->cancel_request_header = aux_cancel_request_header;
-            goal_handle->status = GOAL_STATE_CANCELING;
-          } else {
-            rclc_action_server_goal_cancel_reject(
-              handle->action_server, CANCEL_STATE_TERMINATED,
-              aux_cancel_request_header);
-          }
-        } else {
-          rclc_action_server_goal_cancel_reject(
-            handle->action_server, CANCEL_STATE_UNKNOWN_GOAL,
-            aux_cancel_request_header);
-        }
       }
       break;
 
@@ -1331,14 +2227,15 @@ _rclc_take_new_data(rclc_executor_handle_t * handle, rcl_wait_set_t * wait_set)
       break;
 
     case RCLC_GUARD_CONDITION:
+    case RCLC_DISCOVERY:
       // case RCLC_GUARD_CONDITION_WITH_CONTEXT:
       // nothing to do
       break;
 
     default:
-      RCUTILS_LOG_DEBUG_NAMED(
-        ROS_PACKAGE_NAME, "Error in _rclc_take_new_data:wait_set unknwon handle type: %d",
-        handle->type);
+      RCLC_LOG_DEBUG_NAMED(
+        ROS_PACKAGE_NAME, "Error in _rclc_take_new_data:wait_set unknwon handle type: %ld",
+        (long) handle->type);
       return RCL_RET_ERROR;
   }    // switch-case
   return rc;
@@ -1430,6 +2327,17 @@ _rclc_execute(rclc_executor_handle_t * handle)
         }
         break;
 
+      case RCLC_SUBSCRIPTION_LATEST_VALUE:
+        if (NULL == handle->subscription_callback) {
+          break;
+        }
+        if (handle->data_available) {
+          handle->subscription_callback(rclc_latest_value_get_newest_msg(handle->data));
+        } else {
+          handle->subscription_callback(NULL);
+        }
+        break;
+
       case RCLC_TIMER:
         // case RCLC_TIMER_WITH_CONTEXT:
         rc = rcl_timer_call(handle->timer);
@@ -1449,6 +2357,23 @@ _rclc_execute(rclc_executor_handle_t * handle)
       case RCLC_SERVICE:
       case RCLC_SERVICE_WITH_REQUEST_ID:
       case RCLC_SERVICE_WITH_CONTEXT:
+        // answer a repeated request from the response cache
+        if (NULL != handle->service_cache && handle->data_available) {
+          bool hit = false;
+          rc = rclc_service_cache_lookup(
+            handle->service_cache, handle->data, handle->data_response_msg, &hit);
+          if (rc != RCL_RET_OK) {
+            PRINT_RCLC_ERROR(rclc_execute, rclc_service_cache_lookup);
+          }
+          if (hit) {
+            rc = rcl_send_response(handle->service, &handle->req_id, handle->data_response_msg);
+            if (rc != RCL_RET_OK) {
+              PRINT_RCLC_ERROR(rclc_execute, rcl_send_response);
+              return rc;
+            }
+            break;
+          }
+        }
         // differentiate user-side service types
         switch (handle->type) {
           case RCLC_SERVICE:
@@ -1477,6 +2402,14 @@ _rclc_execute(rclc_executor_handle_t * handle)
           PRINT_RCLC_ERROR(rclc_execute, rcl_send_response);
           return rc;
         }
+        // a failed lookup or store only disables caching of this request
+        if (NULL != handle->service_cache && handle->data_available) {
+          if (RCL_RET_OK != rclc_service_cache_store(
+              handle->service_cache, handle->data_response_msg))
+          {
+            PRINT_RCLC_ERROR(rclc_execute, rclc_service_cache_store);
+          }
+        }
         break;
 
       case RCLC_CLIENT:
@@ -1494,6 +2427,20 @@ _rclc_execute(rclc_executor_handle_t * handle)
         handle->gc_callback();
         break;
 
+      case RCLC_DISCOVERY:
+        {
+          bool matched = false;
+          rc = rclc_discovery_check(handle->discovery, &matched);
+          if (rc != RCL_RET_OK) {
+            PRINT_RCLC_ERROR(rclc_execute, rclc_discovery_check);
+            return rc;
+          }
+          if (matched) {
+            handle->discovery->callback(handle->discovery->callback_context);
+          }
+        }
+        break;
+
       // case RCLC_GUARD_CONDITION_WITH_CONTEXT:  //TODO
       //   break;
 
@@ -1529,7 +2476,8 @@ _rclc_execute(rclc_executor_handle_t * handle)
         }
         if (handle->action_client->feedback_available) {
           rclc_action_goal_handle_t * goal_handle;
-          for (goal_handle = handle->action_client->used_goal_handles; NULL != goal_handle;
+          for (goal_handle = rclc_action_get_first_used_goal_handle(handle->action_client);
+            NULL != goal_handle;
             goal_handle = goal_handle->next)
           {
             if (goal_handle->available_feedback) {
@@ -1546,7 +2494,8 @@ _rclc_execute(rclc_executor_handle_t * handle)
         }
         if (handle->action_client->cancel_response_available) {
           rclc_action_goal_handle_t * goal_handle;
-          for (goal_handle = handle->action_client->used_goal_handles; NULL != goal_handle;
+          for (goal_handle = rclc_action_get_first_used_goal_handle(handle->action_client);
+            NULL != goal_handle;
             goal_handle = goal_handle->next)
           {
             if (goal_handle->available_cancel_response) {
@@ -1638,6 +2587,7 @@ _rclc_execute(rclc_executor_handle_t * handle)
               default:
                 rclc_action_server_response_goal_request(goal_handle, false);
                 // Set rejected/error post-condition
+                rclc_action_server_reset_result(goal_handle);
                 rclc_action_remove_used_goal_handle(handle->action_server, goal_handle);
                 break;
             }
@@ -1645,120 +2595,727 @@ _rclc_execute(rclc_executor_handle_t * handle)
           handle->action_server->goal_request_available = false;
         }
         if (handle->action_server->cancel_request_available) {
-          rclc_action_goal_handle_t * goal_handle;
-          for (goal_handle = handle->action_server->used_goal_handles; NULL != goal_handle;
-            goal_handle = goal_handle->next)
-          {
-            if (GOAL_STATE_CANCELING == goal_handle->status) {
-              goal_handle->goal_cancelled =
-                handle->action_server->cancel_callback(goal_handle, handle->callback_context);
-              if (goal_handle->goal_cancelled) {
-                rclc_action_server_goal_cancel_accept(goal_handle);
-              } else {
-                rclc_action_server_goal_cancel_reject(
-                  handle->action_server, CANCEL_STATE_REJECTED,
-                  goal_handle->cancel_request_header);
-                goal_handle->status = GOAL_STATE_EXECUTING;
-              }
-            }
-          }
+          // Handle action server cancel request
+          //
+          // Pre-condition:
+          // - cancel request taken into action_server->cancel_request
+          //
+          // Post-condition:
+          // - selected goals accepted by the cancel callback:
+          //   goal->status = GOAL_STATE_CANCELING
+          // - one cancel response listing these goals has been sent
+          rclc_action_server_process_cancel_request(
+            handle->action_server,
+            handle->callback_context);
           handle->action_server->cancel_request_available = false;
         }
         break;
 
       default:
-        RCUTILS_LOG_DEBUG_NAMED(
-          ROS_PACKAGE_NAME, "Error in _rclc_execute: unknwon handle type: %d",
-          handle->type);
+        RCLC_LOG_DEBUG_NAMED(
+          ROS_PACKAGE_NAME, "Error in _rclc_execute: unknwon handle type: %ld",
+          (long) handle->type);
         return RCL_RET_ERROR;
     }   // switch-case
   }
-
+
+  return rc;
+}
+
+
+// Takes new data of the handle and, if the executor exports statistics,
+// records the take time and take failures.
+static
+rcl_ret_t
+_rclc_executor_take(rclc_executor_t * executor, rclc_executor_handle_t * handle)
+{
+  if (NULL == executor->stats) {
+    return _rclc_take_new_data(handle, &executor->wait_set, executor->chain_tracer);
+  }
+  rcutils_time_point_value_t start = 0;
+  rcutils_ret_t ret = rcutils_steady_time_now(&start);
+  RCLC_UNUSED(ret);
+  rcl_ret_t rc = _rclc_take_new_data(handle, &executor->wait_set, executor->chain_tracer);
+  rclc_executor_stats_record_take(
+    executor->stats, (size_t) (handle - executor->handles), start, rc);
+  return rc;
+}
+
+// True if the callback of the handle is called by _rclc_execute. Must be checked
+// before the execution, which resets the flags of the action handles.
+static
+bool
+_rclc_executor_is_invoked(rclc_executor_handle_t * handle)
+{
+  return (handle->invocation == ALWAYS) || _rclc_check_handle_data_available(handle);
+}
+
+// Executes the handle and, if the executor exports statistics, records the
+// callback time. If the executor has a chain tracer, the invocation is traced.
+static
+rcl_ret_t
+_rclc_executor_execute(rclc_executor_t * executor, rclc_executor_handle_t * handle)
+{
+  if (NULL == executor->stats && NULL == executor->chain_tracer) {
+    return _rclc_execute(handle);
+  }
+  bool invoked = _rclc_executor_is_invoked(handle);
+  if (invoked && NULL != executor->chain_tracer) {
+    rclc_chain_tracer_begin_callback(executor->chain_tracer, handle->subscription);
+  }
+  rcutils_time_point_value_t start = 0;
+  if (NULL != executor->stats) {
+    if (invoked) {
+      rclc_executor_stats_begin_execute(executor->stats);
+    }
+    rcutils_ret_t ret = rcutils_steady_time_now(&start);
+    RCLC_UNUSED(ret);
+  }
+  rcl_ret_t rc = _rclc_execute(handle);
+  if (NULL != executor->stats) {
+    rclc_executor_stats_record_execute(
+      executor->stats, (size_t) (handle - executor->handles), start, invoked);
+  }
+  if (invoked && NULL != executor->chain_tracer) {
+    rclc_chain_tracer_end_callback(executor->chain_tracer);
+  }
+  return rc;
+}
+
+// Executes the timers, which have expired while the callbacks of the current spin
+// were running. Only the clock is read, until the earliest expiration time of the
+// timers has passed, then all timers are checked and the expiration time is updated.
+static
+rcl_ret_t
+_rclc_executor_interleave_timers(rclc_executor_t * executor)
+{
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now) || now < executor->timer_deadline) {
+    return RCL_RET_OK;
+  }
+
+  rcutils_time_point_value_t deadline = INT64_MAX;
+  for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
+    rclc_executor_handle_t * handle = &executor->handles[i];
+    if (RCLC_TIMER != handle->type) {
+      continue;
+    }
+    bool ready = false;
+    rcl_ret_t rc = rcl_timer_is_ready(handle->timer, &ready);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(_rclc_executor_interleave_timers, rcl_timer_is_ready);
+      return rc;
+    }
+    if (ready) {
+      // the timer is not executed again in its own turn of this spin
+      handle->data_available = true;
+      rc = _rclc_executor_execute(executor, handle);
+      handle->data_available = false;
+      if (rc != RCL_RET_OK) {
+        return rc;
+      }
+    }
+    // cancelled timers are skipped, they are checked again after a reset by rcl_wait
+    int64_t time_until_next_call = 0;
+    if (RCL_RET_OK == rcl_timer_get_time_until_next_call(handle->timer, &time_until_next_call) &&
+      now + time_until_next_call < deadline)
+    {
+      deadline = now + time_until_next_call;
+    }
+  }
+  executor->timer_deadline = deadline;
+  return RCL_RET_OK;
+}
+
+// Re-checks the timers after the callback of a handle, if it has been invoked
+// (see _rclc_executor_is_invoked)
+static
+rcl_ret_t
+_rclc_executor_after_execute(rclc_executor_t * executor, bool invoked)
+{
+  if (!executor->timer_interleaving || !invoked) {
+    return RCL_RET_OK;
+  }
+  return _rclc_executor_interleave_timers(executor);
+}
+
+// Executes the handle with the given index, called by the dependency graph
+static
+rcl_ret_t
+_rclc_executor_execute_index(void * context, size_t index)
+{
+  rclc_executor_t * executor = (rclc_executor_t *) context;
+  return _rclc_executor_execute(executor, &executor->handles[index]);
+}
+
+// Executes the handle with the given index and re-checks the timers afterwards,
+// called by the dependency graph, if all handles are executed by the executor thread
+static
+rcl_ret_t
+_rclc_executor_execute_index_sequential(void * context, size_t index)
+{
+  rclc_executor_t * executor = (rclc_executor_t *) context;
+  bool invoked = _rclc_executor_is_invoked(&executor->handles[index]);
+  rcl_ret_t rc = _rclc_executor_execute(executor, &executor->handles[index]);
+  if (rc != RCL_RET_OK) {
+    return rc;
+  }
+  return _rclc_executor_after_execute(executor, invoked);
+}
+
+static
+rcl_ret_t
+_rclc_default_scheduling(rclc_executor_t * executor)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t rc = RCL_RET_OK;
+
+  for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
+    rc = _rclc_check_for_new_data(&executor->handles[i], &executor->wait_set);
+    if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED)) {
+      return rc;
+    }
+  }
+  // if the trigger condition is fullfilled, fetch data and execute
+  if (executor->trigger_function(
+      executor->handles, executor->max_handles,
+      executor->trigger_object))
+  {
+    // take new input data from DDS-queue and execute the corresponding callback of the handle
+    for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
+      rc = _rclc_executor_take(executor, &executor->handles[i]);
+      if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED) &&
+        (rc != RCL_RET_SERVICE_TAKE_FAILED))
+      {
+        return rc;
+      }
+      bool invoked = _rclc_executor_is_invoked(&executor->handles[i]);
+      rc = _rclc_executor_execute(executor, &executor->handles[i]);
+      if (rc != RCL_RET_OK) {
+        return rc;
+      }
+      rc = _rclc_executor_after_execute(executor, invoked);
+      if (rc != RCL_RET_OK) {
+        return rc;
+      }
+    }
+  }
+  return rc;
+}
+
+static
+rcl_ret_t
+_rclc_let_scheduling(rclc_executor_t * executor)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t rc = RCL_RET_OK;
+
+  // logical execution time
+  // 1. read all input
+  // 2. process
+  // 3. write data (*) data is written not at the end of all callbacks, but it will not be
+  //    processed by the callbacks 'in this round' because all input data is read in the
+  //    beginning and the incoming messages were copied.
+
+  // step 0: check for available input data from DDS queue
+  // complexity: O(n) where n denotes the number of handles
+  for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
+    rc = _rclc_check_for_new_data(&executor->handles[i], &executor->wait_set);
+    if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED)) {
+      return rc;
+    }
+  }
+
+  // if the trigger condition is fullfilled, fetch data and execute
+  // complexity: O(n) where n denotes the number of handles
+  if (executor->trigger_function(
+      executor->handles, executor->max_handles,
+      executor->trigger_object))
+  {
+    // step 1: read input data
+    for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
+      rc = _rclc_executor_take(executor, &executor->handles[i]);
+      if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED)) {
+        return rc;
+      }
+    }
+
+    // step 2:  process (execute)
+    if (NULL != executor->dag) {
+      // in the order of the dependencies, independent handles in parallel
+      // if statistics or tracing do not require a single thread
+      bool parallel = (NULL == executor->stats && NULL == executor->chain_tracer);
+      if (parallel && rclc_executor_dag_has_workers(executor->dag)) {
+        return rclc_executor_dag_execute(
+          executor->dag, _rclc_executor_execute_index, executor, true);
+      }
+      // timers are only interleaved, while the callbacks run in the executor thread
+      return rclc_executor_dag_execute(
+        executor->dag, _rclc_executor_execute_index_sequential, executor, false);
+    }
+    for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
+      bool invoked = _rclc_executor_is_invoked(&executor->handles[i]);
+      rc = _rclc_executor_execute(executor, &executor->handles[i]);
+      if (rc != RCL_RET_OK) {
+        return rc;
+      }
+      rc = _rclc_executor_after_execute(executor, invoked);
+      if (rc != RCL_RET_OK) {
+        return rc;
+      }
+    }
+  }
+  return rc;
+}
+
+static
+rcl_ret_t
+_rclc_executor_add_handle_to_wait_set(rclc_executor_t * executor, rclc_executor_handle_t * handle)
+{
+  rcl_ret_t rc = RCL_RET_OK;
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "wait_set_add_* %ld", (long) handle->type);
+  switch (handle->type) {
+    case RCLC_SUBSCRIPTION:
+    case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+    case RCLC_SUBSCRIPTION_LATEST_VALUE:
+      // add subscription to wait_set and save index
+      rc = rcl_wait_set_add_subscription(
+        &executor->wait_set, handle->subscription,
+        &handle->index);
+      if (rc == RCL_RET_OK) {
+        RCLC_LOG_DEBUG_NAMED(
+          ROS_PACKAGE_NAME,
+          "Subscription added to wait_set_subscription[%ld]",
+          handle->index);
+      } else {
+        PRINT_RCLC_ERROR(rclc_executor_add_handle_to_wait_set, rcl_wait_set_add_subscription);
+        return rc;
+      }
+      break;
+
+    case RCLC_TIMER:
+      // case RCLC_TIMER_WITH_CONTEXT:
+      // add timer to wait_set and save index
+      rc = rcl_wait_set_add_timer(
+        &executor->wait_set, handle->timer,
+        &handle->index);
+      if (rc == RCL_RET_OK) {
+        RCLC_LOG_DEBUG_NAMED(
+          ROS_PACKAGE_NAME, "Timer added to wait_set_timers[%ld]",
+          handle->index);
+      } else {
+        PRINT_RCLC_ERROR(rclc_executor_add_handle_to_wait_set, rcl_wait_set_add_timer);
+        return rc;
+      }
+      break;
+
+    case RCLC_SERVICE:
+    case RCLC_SERVICE_WITH_REQUEST_ID:
+    case RCLC_SERVICE_WITH_CONTEXT:
+      // add service to wait_set and save index
+      rc = rcl_wait_set_add_service(
+        &executor->wait_set, handle->service,
+        &handle->index);
+      if (rc == RCL_RET_OK) {
+        RCLC_LOG_DEBUG_NAMED(
+          ROS_PACKAGE_NAME, "Service added to wait_set_service[%ld]",
+          handle->index);
+      } else {
+        PRINT_RCLC_ERROR(rclc_executor_add_handle_to_wait_set, rcl_wait_set_add_service);
+        return rc;
+      }
+      break;
+
+
+    case RCLC_CLIENT:
+    case RCLC_CLIENT_WITH_REQUEST_ID:
+      // case RCLC_CLIENT_WITH_CONTEXT:
+      // add client to wait_set and save index
+      rc = rcl_wait_set_add_client(
+        &executor->wait_set, handle->client,
+        &handle->index);
+      if (rc == RCL_RET_OK) {
+        RCLC_LOG_DEBUG_NAMED(
+          ROS_PACKAGE_NAME, "Client added to wait_set_client[%ld]",
+          handle->index);
+      } else {
+        PRINT_RCLC_ERROR(rclc_executor_add_handle_to_wait_set, rcl_wait_set_add_client);
+        return rc;
+      }
+      break;
+
+    case RCLC_GUARD_CONDITION:
+      // case RCLC_GUARD_CONDITION_WITH_CONTEXT:
+      // add guard_condition to wait_set and save index
+      rc = rcl_wait_set_add_guard_condition(
+        &executor->wait_set, handle->gc,
+        &handle->index);
+      if (rc == RCL_RET_OK) {
+        RCLC_LOG_DEBUG_NAMED(
+          ROS_PACKAGE_NAME, "Guard_condition added to wait_set_client[%ld]",
+          handle->index);
+      } else {
+        PRINT_RCLC_ERROR(rclc_executor_add_handle_to_wait_set, rcl_wait_set_add_guard_condition);
+        return rc;
+      }
+      break;
+
+    case RCLC_DISCOVERY:
+      // add graph guard condition of the node to wait_set and save index
+      rc = rcl_wait_set_add_guard_condition(
+        &executor->wait_set, rcl_node_get_graph_guard_condition(handle->discovery->node),
+        &handle->index);
+      if (rc == RCL_RET_OK) {
+        RCLC_LOG_DEBUG_NAMED(
+          ROS_PACKAGE_NAME, "Graph guard_condition added to wait_set_guard_conditions[%ld]",
+          handle->index);
+      } else {
+        PRINT_RCLC_ERROR(rclc_executor_add_handle_to_wait_set, rcl_wait_set_add_guard_condition);
+        return rc;
+      }
+      break;
+
+    case RCLC_ACTION_CLIENT:
+      // add action client to wait_set and save index
+      rc = rcl_action_wait_set_add_action_client(
+        &executor->wait_set, &handle->action_client->rcl_handle,
+        &handle->index, NULL);
+      if (rc == RCL_RET_OK) {
+        RCLC_LOG_DEBUG_NAMED(
+          ROS_PACKAGE_NAME,
+          "Action client added to wait_set_action_clients[%ld]",
+          handle->index);
+      } else {
+        PRINT_RCLC_ERROR(rclc_executor_add_handle_to_wait_set, rcl_wait_set_add_action_client);
+        return rc;
+      }
+      break;
+
+    case RCLC_ACTION_SERVER:
+      // add action server to wait_set and save index
+      rc = rcl_action_wait_set_add_action_server(
+        &executor->wait_set, &handle->action_server->rcl_handle,
+        &handle->index);
+      if (rc == RCL_RET_OK) {
+        RCLC_LOG_DEBUG_NAMED(
+          ROS_PACKAGE_NAME,
+          "Action server added to wait_set_action_servers[%ld]",
+          handle->index);
+      } else {
+        PRINT_RCLC_ERROR(rclc_executor_add_handle_to_wait_set, rcl_wait_set_add_action_server);
+        return rc;
+      }
+      break;
+
+    default:
+      RCLC_LOG_DEBUG_NAMED(
+        ROS_PACKAGE_NAME, "Error: unknown handle type: %ld",
+        (long) handle->type);
+      PRINT_RCLC_ERROR(rclc_executor_add_handle_to_wait_set, rcl_wait_set_add_unknown_handle);
+      return RCL_RET_ERROR;
+  }
   return rc;
 }
 
+// in events mode the wait_set contains only the guard condition of the event queue,
+// the handles without listener API in rcl: guard conditions and actions, and the
+// subscriptions, services and clients with invocation ALWAYS, whose callback is
+// called once per spin like in the default mode
+static
+bool
+_rclc_executor_events_use_wait_set(rclc_executor_handle_t * handle)
+{
+  return (handle->type == RCLC_GUARD_CONDITION) ||
+         (handle->type == RCLC_DISCOVERY) ||
+         (handle->type == RCLC_ACTION_CLIENT) ||
+         (handle->type == RCLC_ACTION_SERVER) ||
+         ((handle->invocation == ALWAYS) && (handle->type != RCLC_TIMER));
+}
 
 static
 rcl_ret_t
-_rclc_default_scheduling(rclc_executor_t * executor)
+_rclc_executor_events_prepare(rclc_executor_t * executor)
 {
-  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  rcl_ret_t rc = RCL_RET_OK;
+  rcl_ret_t rc = rcl_wait_set_fini(&executor->wait_set);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_executor_prepare, rcl_wait_set_fini);
+  }
 
+  // guard condition of the event queue
+  size_t number_of_guard_conditions = 1;
+  size_t number_of_subscriptions = 0, number_of_timers = 0;
+  size_t number_of_clients = 0, number_of_services = 0;
   for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
-    rc = _rclc_check_for_new_data(&executor->handles[i], &executor->wait_set);
-    if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED)) {
+    size_t num_subscriptions = 0, num_guard_conditions = 0, num_timers = 0;
+    size_t num_clients = 0, num_services = 0;
+    switch (executor->handles[i].type) {
+      case RCLC_GUARD_CONDITION:
+      case RCLC_DISCOVERY:
+        num_guard_conditions = 1;
+        break;
+      case RCLC_ACTION_CLIENT:
+        rc = rcl_action_client_wait_set_get_num_entities(
+          &executor->handles[i].action_client->rcl_handle,
+          &num_subscriptions, &num_guard_conditions, &num_timers,
+          &num_clients, &num_services);
+        break;
+      case RCLC_ACTION_SERVER:
+        rc = rcl_action_server_wait_set_get_num_entities(
+          &executor->handles[i].action_server->rcl_handle,
+          &num_subscriptions, &num_guard_conditions, &num_timers,
+          &num_clients, &num_services);
+        break;
+      case RCLC_SUBSCRIPTION:
+      case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+      case RCLC_SUBSCRIPTION_LATEST_VALUE:
+        num_subscriptions = _rclc_executor_events_use_wait_set(&executor->handles[i]) ? 1 : 0;
+        break;
+      case RCLC_SERVICE:
+      case RCLC_SERVICE_WITH_REQUEST_ID:
+      case RCLC_SERVICE_WITH_CONTEXT:
+        num_services = _rclc_executor_events_use_wait_set(&executor->handles[i]) ? 1 : 0;
+        break;
+      case RCLC_CLIENT:
+      case RCLC_CLIENT_WITH_REQUEST_ID:
+        num_clients = _rclc_executor_events_use_wait_set(&executor->handles[i]) ? 1 : 0;
+        break;
+      default:
+        break;
+    }
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_executor_prepare, rcl_action_wait_set_get_num_entities);
       return rc;
     }
+    number_of_subscriptions += num_subscriptions;
+    number_of_guard_conditions += num_guard_conditions;
+    number_of_timers += num_timers;
+    number_of_clients += num_clients;
+    number_of_services += num_services;
   }
-  // if the trigger condition is fullfilled, fetch data and execute
-  if (executor->trigger_function(
-      executor->handles, executor->max_handles,
-      executor->trigger_object))
-  {
-    // take new input data from DDS-queue and execute the corresponding callback of the handle
-    for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
-      rc = _rclc_take_new_data(&executor->handles[i], &executor->wait_set);
-      if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED) &&
-        (rc != RCL_RET_SERVICE_TAKE_FAILED))
-      {
-        return rc;
-      }
-      rc = _rclc_execute(&executor->handles[i]);
-      if (rc != RCL_RET_OK) {
-        return rc;
-      }
-    }
+
+  executor->wait_set = rcl_get_zero_initialized_wait_set();
+  rc = rcl_wait_set_init(
+    &executor->wait_set, number_of_subscriptions,
+    number_of_guard_conditions, number_of_timers,
+    number_of_clients, number_of_services,
+    0,
+    executor->context,
+    *executor->allocator);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_executor_prepare, rcl_wait_set_init);
+    return rc;
+  }
+
+  // (re-)register listeners, because the list of handles has changed
+  rc = rclc_executor_events_detach(executor->events, executor->handles, executor->index);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_executor_prepare, rclc_executor_events_detach);
+    return rc;
+  }
+  rc = rclc_executor_events_attach(executor->events, executor->handles, executor->index);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_executor_prepare, rclc_executor_events_attach);
   }
   return rc;
 }
 
+// take one message, request or response without consulting the wait_set
 static
 rcl_ret_t
-_rclc_let_scheduling(rclc_executor_t * executor)
+_rclc_executor_events_take(rclc_executor_handle_t * handle, rclc_chain_tracer_t * tracer)
 {
-  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
   rcl_ret_t rc = RCL_RET_OK;
+  rmw_message_info_t messageInfo;
 
-  // logical execution time
-  // 1. read all input
-  // 2. process
-  // 3. write data (*) data is written not at the end of all callbacks, but it will not be
-  //    processed by the callbacks 'in this round' because all input data is read in the
-  //    beginning and the incoming messages were copied.
+  switch (handle->type) {
+    case RCLC_SUBSCRIPTION:
+    case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+      rc = rcl_take(handle->subscription, handle->data, &messageInfo, NULL);
+      if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED)) {
+        PRINT_RCLC_ERROR(rclc_executor_events_take, rcl_take);
+      }
+      if ((rc == RCL_RET_OK) && (NULL != tracer)) {
+        rclc_chain_tracer_record_take(tracer, handle->subscription, &messageInfo);
+      }
+      if ((rc == RCL_RET_OK) && (NULL != handle->topic_statistics)) {
+        rclc_topic_statistics_record(handle->topic_statistics, &messageInfo);
+      }
+      break;
 
-  // step 0: check for available input data from DDS queue
-  // complexity: O(n) where n denotes the number of handles
-  for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
-    rc = _rclc_check_for_new_data(&executor->handles[i], &executor->wait_set);
-    if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED)) {
+    case RCLC_SUBSCRIPTION_LATEST_VALUE:
+      rc = _rclc_take_latest_value(handle, tracer);
+      if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED)) {
+        PRINT_RCLC_ERROR(rclc_executor_events_take, rcl_take);
+      }
+      break;
+
+    case RCLC_SERVICE:
+    case RCLC_SERVICE_WITH_REQUEST_ID:
+    case RCLC_SERVICE_WITH_CONTEXT:
+      rc = rcl_take_request(handle->service, &handle->req_id, handle->data);
+      if ((rc != RCL_RET_OK) && (rc != RCL_RET_SERVICE_TAKE_FAILED)) {
+        PRINT_RCLC_ERROR(rclc_executor_events_take, rcl_take_request);
+      }
+      break;
+
+    case RCLC_CLIENT:
+    case RCLC_CLIENT_WITH_REQUEST_ID:
+      rc = rcl_take_response(handle->client, &handle->req_id, handle->data);
+      if ((rc != RCL_RET_OK) && (rc != RCL_RET_CLIENT_TAKE_FAILED)) {
+        PRINT_RCLC_ERROR(rclc_executor_events_take, rcl_take_response);
+      }
+      break;
+
+    default:
+      RCLC_LOG_DEBUG_NAMED(
+        ROS_PACKAGE_NAME, "Error in _rclc_executor_events_take: unexpected handle type: %ld",
+        (long) handle->type);
+      return RCL_RET_ERROR;
+  }
+  handle->data_available = (rc == RCL_RET_OK);
+  return rc;
+}
+
+// Executes the timers, whose expiration time in the timer heap has passed
+static
+rcl_ret_t
+_rclc_executor_events_execute_timers(rclc_executor_t * executor)
+{
+  size_t index = 0;
+  for (size_t n = 0; n < executor->index &&
+    rclc_executor_events_pop_expired_timer(executor->events, &index); n++)
+  {
+    if (index >= executor->index) {
+      continue;
+    }
+    rclc_executor_handle_t * handle = &executor->handles[index];
+    rcl_ret_t rc = rcl_timer_is_ready(handle->timer, &handle->data_available);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_timer_is_ready);
+      return rc;
+    }
+    rc = _rclc_executor_execute(executor, handle);
+    if (rc != RCL_RET_OK) {
+      return rc;
+    }
+    rc = rclc_executor_events_schedule_timer(executor->events, executor->handles, index);
+    if (rc != RCL_RET_OK) {
       return rc;
     }
   }
+  return RCL_RET_OK;
+}
 
-  // if the trigger condition is fullfilled, fetch data and execute
-  // complexity: O(n) where n denotes the number of handles
-  if (executor->trigger_function(
-      executor->handles, executor->max_handles,
-      executor->trigger_object))
-  {
-    // step 1: read input data
-    for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
-      rc = _rclc_take_new_data(&executor->handles[i], &executor->wait_set);
-      if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED)) {
+static
+rcl_ret_t
+_rclc_executor_spin_some_events(rclc_executor_t * executor, const uint64_t timeout_ns)
+{
+  rcl_ret_t rc = rcl_wait_set_clear(&executor->wait_set);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_clear);
+    return rc;
+  }
+  rc = rcl_wait_set_add_guard_condition(
+    &executor->wait_set, rclc_executor_events_get_guard_condition(executor->events), NULL);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_guard_condition);
+    return rc;
+  }
+  for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
+    if (_rclc_executor_events_use_wait_set(&executor->handles[i])) {
+      rc = _rclc_executor_add_handle_to_wait_set(executor, &executor->handles[i]);
+      if (rc != RCL_RET_OK) {
         return rc;
       }
     }
+  }
 
-    // step 2:  process (execute)
-    for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
-      rc = _rclc_execute(&executor->handles[i]);
+  // do not block, if events are queued already, and wake up for the next timer
+  int64_t wait_timeout = (timeout_ns > INT64_MAX) ? INT64_MAX : (int64_t) timeout_ns;
+  int64_t timer_timeout = 0;
+  if (rclc_executor_events_pending(executor->events)) {
+    wait_timeout = 0;
+  } else if (rclc_executor_events_get_timer_timeout(executor->events, &timer_timeout) &&
+    timer_timeout < wait_timeout)
+  {
+    wait_timeout = timer_timeout;
+  }
+  wait_timeout = _rclc_executor_wait_timeout(executor, wait_timeout);
+  rcutils_time_point_value_t wait_start = 0;
+  if (NULL != executor->stats) {
+    rcutils_ret_t ret = rcutils_steady_time_now(&wait_start);
+    RCLC_UNUSED(ret);
+  }
+  rc = rcl_wait(&executor->wait_set, wait_timeout);
+  RCLC_UNUSED(rc);
+  if (NULL != executor->stats) {
+    rclc_executor_stats_record_wait(executor->stats, wait_start);
+  }
+
+  // process the queued events. The number of iterations is bounded, because
+  // events arriving meanwhile put the handle into the queue again.
+  size_t index = 0;
+  size_t count = 0;
+  for (size_t n = 0; n < executor->index &&
+    rclc_executor_events_pop(executor->events, &index, &count); n++)
+  {
+    if (index >= executor->index) {
+      continue;
+    }
+    rclc_executor_handle_t * handle = &executor->handles[index];
+    for (size_t k = 0; k < count; k++) {
+      rc = _rclc_executor_events_take(handle, executor->chain_tracer);
+      if ((rc == RCL_RET_SUBSCRIPTION_TAKE_FAILED) || (rc == RCL_RET_SERVICE_TAKE_FAILED) ||
+        (rc == RCL_RET_CLIENT_TAKE_FAILED))
+      {
+        break;
+      }
       if (rc != RCL_RET_OK) {
         return rc;
       }
+      rc = _rclc_executor_execute(executor, handle);
+      if (rc != RCL_RET_OK) {
+        return rc;
+      }
+      if (executor->timer_interleaving) {
+        rc = _rclc_executor_events_execute_timers(executor);
+        if (rc != RCL_RET_OK) {
+          return rc;
+        }
+      }
     }
   }
-  return rc;
+
+  // process expired timers
+  rc = _rclc_executor_events_execute_timers(executor);
+  if (rc != RCL_RET_OK) {
+    return rc;
+  }
+
+  // process guard conditions, actions and the handles with invocation ALWAYS
+  for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
+    rclc_executor_handle_t * handle = &executor->handles[i];
+    if (!_rclc_executor_events_use_wait_set(handle)) {
+      continue;
+    }
+    rc = _rclc_check_for_new_data(handle, &executor->wait_set);
+    if (rc != RCL_RET_OK) {
+      return rc;
+    }
+    // a failed take only means, that no data is available (anymore)
+    rc = _rclc_executor_take(executor, handle);
+    if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED) &&
+      (rc != RCL_RET_SERVICE_TAKE_FAILED) && (rc != RCL_RET_CLIENT_TAKE_FAILED) &&
+      (rc != RCL_RET_ACTION_CLIENT_TAKE_FAILED) && (rc != RCL_RET_ACTION_SERVER_TAKE_FAILED))
+    {
+      return rc;
+    }
+    rc = _rclc_executor_execute(executor, handle);
+    if (rc != RCL_RET_OK) {
+      return rc;
+    }
+  }
+  return RCL_RET_OK;
 }
 
 rcl_ret_t
@@ -1766,13 +3323,19 @@ rclc_executor_prepare(rclc_executor_t * executor)
 {
   rcl_ret_t rc = RCL_RET_OK;
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "executor_prepare");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "executor_prepare");
 
   // initialize wait_set if
   // (1) this is the first invocation of executor_spin_some()
   // (2) executor_add_timer() or executor_add_subscription() has been called.
   //     i.e. a new timer or subscription has been added to the Executor.
   if (!rcl_wait_set_is_valid(&executor->wait_set)) {
+    // the handle list has changed
+    rclc_executor_stats_update_handles(executor->stats, executor->handles, executor->index);
+    rclc_executor_dag_update_handles(executor->dag, executor->handles, executor->index);
+    if (NULL != executor->events) {
+      return _rclc_executor_events_prepare(executor);
+    }
     // calling wait_set on zero_initialized wait_set multiple times is ok.
     rcl_ret_t rc = rcl_wait_set_fini(&executor->wait_set);
     if (rc != RCL_RET_OK) {
@@ -1803,15 +3366,30 @@ rclc_executor_spin_some(rclc_executor_t * executor, const uint64_t timeout_ns)
 {
   rcl_ret_t rc = RCL_RET_OK;
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "spin_some");
+  RCLC_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "spin_some");
 
   if (!rcl_context_is_valid(executor->context)) {
     PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_context_not_valid);
     return RCL_RET_ERROR;
   }
 
+  if (NULL != executor->staging) {
+    _rclc_executor_apply_staged(executor);
+  }
+
   rclc_executor_prepare(executor);
 
+  if (NULL != executor->events) {
+    rc = _rclc_executor_spin_some_events(executor, timeout_ns);
+    if (rc == RCL_RET_OK && NULL != executor->tasks) {
+      rclc_executor_tasks_execute(executor->tasks);
+    }
+    if (NULL != executor->stats) {
+      rclc_executor_stats_record_spin(executor->stats);
+    }
+    return rc;
+  }
+
   // set rmw fields to NULL
   rc = rcl_wait_set_clear(&executor->wait_set);
   if (rc != RCL_RET_OK) {
@@ -1819,140 +3397,36 @@ rclc_executor_spin_some(rclc_executor_t * executor, const uint64_t timeout_ns)
     return rc;
   }
 
-  // (jst3si) put in a sub-function - for improved readability
   // add handles to wait_set
   for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
-    RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "wait_set_add_* %d", executor->handles[i].type);
-    switch (executor->handles[i].type) {
-      case RCLC_SUBSCRIPTION:
-      case RCLC_SUBSCRIPTION_WITH_CONTEXT:
-        // add subscription to wait_set and save index
-        rc = rcl_wait_set_add_subscription(
-          &executor->wait_set, executor->handles[i].subscription,
-          &executor->handles[i].index);
-        if (rc == RCL_RET_OK) {
-          RCUTILS_LOG_DEBUG_NAMED(
-            ROS_PACKAGE_NAME,
-            "Subscription added to wait_set_subscription[%ld]",
-            executor->handles[i].index);
-        } else {
-          PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_subscription);
-          return rc;
-        }
-        break;
-
-      case RCLC_TIMER:
-        // case RCLC_TIMER_WITH_CONTEXT:
-        // add timer to wait_set and save index
-        rc = rcl_wait_set_add_timer(
-          &executor->wait_set, executor->handles[i].timer,
-          &executor->handles[i].index);
-        if (rc == RCL_RET_OK) {
-          RCUTILS_LOG_DEBUG_NAMED(
-            ROS_PACKAGE_NAME, "Timer added to wait_set_timers[%ld]",
-            executor->handles[i].index);
-        } else {
-          PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_timer);
-          return rc;
-        }
-        break;
-
-      case RCLC_SERVICE:
-      case RCLC_SERVICE_WITH_REQUEST_ID:
-      case RCLC_SERVICE_WITH_CONTEXT:
-        // add service to wait_set and save index
-        rc = rcl_wait_set_add_service(
-          &executor->wait_set, executor->handles[i].service,
-          &executor->handles[i].index);
-        if (rc == RCL_RET_OK) {
-          RCUTILS_LOG_DEBUG_NAMED(
-            ROS_PACKAGE_NAME, "Service added to wait_set_service[%ld]",
-            executor->handles[i].index);
-        } else {
-          PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_service);
-          return rc;
-        }
-        break;
-
-
-      case RCLC_CLIENT:
-      case RCLC_CLIENT_WITH_REQUEST_ID:
-        // case RCLC_CLIENT_WITH_CONTEXT:
-        // add client to wait_set and save index
-        rc = rcl_wait_set_add_client(
-          &executor->wait_set, executor->handles[i].client,
-          &executor->handles[i].index);
-        if (rc == RCL_RET_OK) {
-          RCUTILS_LOG_DEBUG_NAMED(
-            ROS_PACKAGE_NAME, "Client added to wait_set_client[%ld]",
-            executor->handles[i].index);
-        } else {
-          PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_client);
-          return rc;
-        }
-        break;
-
-      case RCLC_GUARD_CONDITION:
-        // case RCLC_GUARD_CONDITION_WITH_CONTEXT:
-        // add guard_condition to wait_set and save index
-        rc = rcl_wait_set_add_guard_condition(
-          &executor->wait_set, executor->handles[i].gc,
-          &executor->handles[i].index);
-        if (rc == RCL_RET_OK) {
-          RCUTILS_LOG_DEBUG_NAMED(
-            ROS_PACKAGE_NAME, "Guard_condition added to wait_set_client[%ld]",
-            executor->handles[i].index);
-        } else {
-          PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_guard_condition);
-          return rc;
-        }
-        break;
-
-      case RCLC_ACTION_CLIENT:
-        // add action client to wait_set and save index
-        rc = rcl_action_wait_set_add_action_client(
-          &executor->wait_set, &executor->handles[i].action_client->rcl_handle,
-          &executor->handles[i].index, NULL);
-        if (rc == RCL_RET_OK) {
-          RCUTILS_LOG_DEBUG_NAMED(
-            ROS_PACKAGE_NAME,
-            "Action client added to wait_set_action_clients[%ld]",
-            executor->handles[i].index);
-        } else {
-          PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_action_client);
-          return rc;
-        }
-        break;
-
-      case RCLC_ACTION_SERVER:
-        // add action server to wait_set and save index
-        rc = rcl_action_wait_set_add_action_server(
-          &executor->wait_set, &executor->handles[i].action_server->rcl_handle,
-          &executor->handles[i].index);
-        if (rc == RCL_RET_OK) {
-          RCUTILS_LOG_DEBUG_NAMED(
-            ROS_PACKAGE_NAME,
-            "Action server added to wait_set_action_servers[%ld]",
-            executor->handles[i].index);
-        } else {
-          PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_action_server);
-          return rc;
-        }
-        break;
-
-      default:
-        RCUTILS_LOG_DEBUG_NAMED(
-          ROS_PACKAGE_NAME, "Error: unknown handle type: %d",
-          executor->handles[i].type);
-        PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_unknown_handle);
-        return RCL_RET_ERROR;
+    rc = _rclc_executor_add_handle_to_wait_set(executor, &executor->handles[i]);
+    if (rc != RCL_RET_OK) {
+      return rc;
     }
   }
 
   // wait up to 'timeout_ns' to receive notification about which handles reveived
   // new data from DDS queue.
-  rc = rcl_wait(&executor->wait_set, timeout_ns);
-  RCLC_UNUSED(rc);
+  rcutils_time_point_value_t wait_start = 0;
+  if (NULL != executor->stats) {
+    rcutils_ret_t ret = rcutils_steady_time_now(&wait_start);
+    RCLC_UNUSED(ret);
+  }
+  int64_t wait_timeout = (timeout_ns > INT64_MAX) ? INT64_MAX : (int64_t) timeout_ns;
+  wait_timeout = _rclc_executor_wait_timeout(executor, wait_timeout);
+  if (0 == executor->index) {
+    // rcl_wait returns immediately on an empty wait_set, e.g. with only scheduled tasks
+    _rclc_executor_sleep(wait_timeout);
+  } else {
+    rc = rcl_wait(&executor->wait_set, wait_timeout);
+    RCLC_UNUSED(rc);
+  }
+  if (NULL != executor->stats) {
+    rclc_executor_stats_record_wait(executor->stats, wait_start);
+  }
+
+  // the timers are checked at the first callback boundary of the spin
+  executor->timer_deadline = 0;
 
   // based on semantics process input data
   switch (executor->data_comm_semantics) {
@@ -1967,6 +3441,14 @@ rclc_executor_spin_some(rclc_executor_t * executor, const uint64_t timeout_ns)
       return RCL_RET_ERROR;
   }
 
+  // due tasks are executed after the callbacks of the handles
+  if (rc == RCL_RET_OK && NULL != executor->tasks) {
+    rclc_executor_tasks_execute(executor->tasks);
+  }
+
+  if (NULL != executor->stats) {
+    rclc_executor_stats_record_spin(executor->stats);
+  }
   return rc;
 }
 
@@ -1975,7 +3457,7 @@ rclc_executor_spin(rclc_executor_t * executor)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
   rcl_ret_t ret = RCL_RET_OK;
-  RCUTILS_LOG_DEBUG_NAMED(
+  RCLC_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME,
     "INFO: rcl_wait timeout %ld ms",
     ((executor->timeout_ns / 1000) / 1000));
@@ -0,0 +1,476 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(__unix__) || defined(__APPLE__)
+#define RCLC_EXECUTOR_DAG_PTHREAD
+#if !defined(_POSIX_C_SOURCE) && !defined(_GNU_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#endif
+
+#include "./executor_dag_internal.h"
+
+#ifdef RCLC_EXECUTOR_DAG_PTHREAD
+#include <pthread.h>
+#endif
+
+#include <rcl/error_handling.h>
+#include <rcutils/logging_macros.h>
+
+#include "rclc/types.h"
+
+/// Dependency: the handle of 'after' is executed after the handle of 'before'
+typedef struct
+{
+  const void * before;
+  const void * after;
+} rclc_executor_dag_edge_t;
+
+struct rclc_executor_dag_t
+{
+  rcl_allocator_t allocator;
+  rclc_executor_dag_edge_t * edges;
+  size_t number_of_edges;
+  size_t max_edges;
+  // graph of the current handle list, successors of node i are
+  // successors[first_successor[i] .. first_successor[i + 1] - 1]
+  size_t max_handles;
+  size_t number_of_nodes;
+  size_t * in_degree;
+  size_t * first_successor;
+  size_t * successors;
+  // state of the current cycle, guarded by mutex
+  size_t * pending;
+  size_t * ready;
+  size_t ready_head;
+  size_t ready_tail;
+  size_t completed;
+  bool parallel;
+  bool stop;
+  rcl_ret_t result;
+  rclc_executor_dag_execute_t execute;
+  void * context;
+#ifdef RCLC_EXECUTOR_DAG_PTHREAD
+  pthread_mutex_t mutex;
+  pthread_cond_t changed;
+  pthread_t * threads;
+#endif
+  size_t number_of_threads;
+};
+
+#ifdef RCLC_EXECUTOR_DAG_PTHREAD
+#define DAG_LOCK(dag) pthread_mutex_lock(&(dag)->mutex)
+#define DAG_UNLOCK(dag) pthread_mutex_unlock(&(dag)->mutex)
+#define DAG_WAIT(dag) pthread_cond_wait(&(dag)->changed, &(dag)->mutex)
+#define DAG_BROADCAST(dag) pthread_cond_broadcast(&(dag)->changed)
+#else
+#define DAG_LOCK(dag)
+#define DAG_UNLOCK(dag)
+#define DAG_WAIT(dag)
+#define DAG_BROADCAST(dag)
+#endif
+
+// Takes the next ready handle, executes it without holding the mutex and
+// releases its successors. The mutex must be held.
+static
+void
+_rclc_executor_dag_process_one(rclc_executor_dag_t * dag)
+{
+  size_t index = dag->ready[dag->ready_head++];
+  bool run = (RCL_RET_OK == dag->result);
+  rclc_executor_dag_execute_t execute = dag->execute;
+  void * context = dag->context;
+  DAG_UNLOCK(dag);
+  rcl_ret_t rc = run ? execute(context, index) : RCL_RET_OK;
+  DAG_LOCK(dag);
+  if (rc != RCL_RET_OK && RCL_RET_OK == dag->result) {
+    dag->result = rc;
+  }
+  for (size_t k = dag->first_successor[index]; k < dag->first_successor[index + 1]; k++) {
+    size_t successor = dag->successors[k];
+    if (0 == --dag->pending[successor]) {
+      dag->ready[dag->ready_tail++] = successor;
+    }
+  }
+  dag->completed++;
+  DAG_BROADCAST(dag);
+}
+
+#ifdef RCLC_EXECUTOR_DAG_PTHREAD
+static
+void *
+_rclc_executor_dag_worker(void * arg)
+{
+  rclc_executor_dag_t * dag = arg;
+  DAG_LOCK(dag);
+  for (;;) {
+    while (!dag->stop && (!dag->parallel || dag->ready_head == dag->ready_tail)) {
+      DAG_WAIT(dag);
+    }
+    if (dag->stop) {
+      break;
+    }
+    _rclc_executor_dag_process_one(dag);
+  }
+  DAG_UNLOCK(dag);
+  return NULL;
+}
+#endif
+
+// Returns the index of the handle of rcl_handle or number_of_handles if it is not found.
+static
+size_t
+_rclc_executor_dag_find(
+  rclc_executor_handle_t * handles,
+  size_t number_of_handles,
+  const void * rcl_handle)
+{
+  for (size_t i = 0; i < number_of_handles; i++) {
+    if (rcl_handle == rclc_executor_handle_get_ptr(&handles[i])) {
+      return i;
+    }
+  }
+  return number_of_handles;
+}
+
+// Sets reachable to true if 'to' can be reached from 'from' by following the
+// dependencies. Each dependency is followed at most once.
+static
+rcl_ret_t
+_rclc_executor_dag_reachable(
+  const rclc_executor_dag_t * dag,
+  const void * from,
+  const void * to,
+  bool * reachable)
+{
+  *reachable = (from == to);
+  if (*reachable || 0 == dag->number_of_edges) {
+    return RCL_RET_OK;
+  }
+  const rcl_allocator_t * allocator = &dag->allocator;
+  bool * visited = allocator->zero_allocate(
+    dag->number_of_edges, sizeof(bool), allocator->state);
+  const void ** stack = allocator->allocate(
+    (dag->number_of_edges + 1) * sizeof(const void *), allocator->state);
+  if (NULL == visited || NULL == stack) {
+    if (NULL != visited) {
+      allocator->deallocate(visited, allocator->state);
+    }
+    if (NULL != stack) {
+      allocator->deallocate((void *) stack, allocator->state);
+    }
+    RCL_SET_ERROR_MSG("Could not allocate memory for the cycle check.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  size_t top = 0;
+  stack[top++] = from;
+  while (top > 0 && !*reachable) {
+    const void * node = stack[--top];
+    for (size_t e = 0; e < dag->number_of_edges; e++) {
+      if (!visited[e] && dag->edges[e].before == node) {
+        visited[e] = true;
+        if (dag->edges[e].after == to) {
+          *reachable = true;
+          break;
+        }
+        stack[top++] = dag->edges[e].after;
+      }
+    }
+  }
+  allocator->deallocate(visited, allocator->state);
+  allocator->deallocate((void *) stack, allocator->state);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_dag_init(
+  rclc_executor_dag_t ** dag,
+  size_t max_handles,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(dag, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+
+  rclc_executor_dag_t * d = allocator->zero_allocate(
+    1, sizeof(rclc_executor_dag_t), allocator->state);
+  if (NULL == d) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for 'dag'.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  d->allocator = *allocator;
+  d->max_handles = max_handles;
+  d->in_degree = allocator->zero_allocate(max_handles, sizeof(size_t), allocator->state);
+  d->first_successor = allocator->zero_allocate(max_handles + 1, sizeof(size_t), allocator->state);
+  d->pending = allocator->zero_allocate(max_handles, sizeof(size_t), allocator->state);
+  d->ready = allocator->zero_allocate(max_handles, sizeof(size_t), allocator->state);
+  if (NULL == d->in_degree || NULL == d->first_successor || NULL == d->pending ||
+    NULL == d->ready)
+  {
+    RCL_SET_ERROR_MSG("Could not allocate memory for the dependency graph.");
+    rclc_executor_dag_fini(&d, allocator);
+    return RCL_RET_BAD_ALLOC;
+  }
+#ifdef RCLC_EXECUTOR_DAG_PTHREAD
+  if (0 != pthread_mutex_init(&d->mutex, NULL)) {
+    RCL_SET_ERROR_MSG("Could not initialize the mutex of the dependency graph.");
+    allocator->deallocate(d->ready, allocator->state);
+    allocator->deallocate(d->pending, allocator->state);
+    allocator->deallocate(d->first_successor, allocator->state);
+    allocator->deallocate(d->in_degree, allocator->state);
+    allocator->deallocate(d, allocator->state);
+    return RCL_RET_ERROR;
+  }
+  if (0 != pthread_cond_init(&d->changed, NULL)) {
+    RCL_SET_ERROR_MSG("Could not initialize the condition variable of the dependency graph.");
+    pthread_mutex_destroy(&d->mutex);
+    allocator->deallocate(d->ready, allocator->state);
+    allocator->deallocate(d->pending, allocator->state);
+    allocator->deallocate(d->first_successor, allocator->state);
+    allocator->deallocate(d->in_degree, allocator->state);
+    allocator->deallocate(d, allocator->state);
+    return RCL_RET_ERROR;
+  }
+#endif
+  d->result = RCL_RET_OK;
+  *dag = d;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_dag_fini(
+  rclc_executor_dag_t ** dag,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(dag, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  rclc_executor_dag_t * d = *dag;
+  if (NULL == d) {
+    return RCL_RET_OK;
+  }
+  rcl_ret_t result = RCL_RET_OK;
+#ifdef RCLC_EXECUTOR_DAG_PTHREAD
+  // a partially initialized graph has neither a mutex nor threads
+  if (NULL != d->in_degree && NULL != d->first_successor && NULL != d->pending &&
+    NULL != d->ready)
+  {
+    DAG_LOCK(d);
+    d->stop = true;
+    DAG_BROADCAST(d);
+    DAG_UNLOCK(d);
+    for (size_t i = 0; i < d->number_of_threads; i++) {
+      if (0 != pthread_join(d->threads[i], NULL)) {
+        RCL_SET_ERROR_MSG("Could not join a worker thread.");
+        result = RCL_RET_ERROR;
+      }
+    }
+    pthread_cond_destroy(&d->changed);
+    pthread_mutex_destroy(&d->mutex);
+  }
+  if (NULL != d->threads) {
+    allocator->deallocate(d->threads, allocator->state);
+  }
+#endif
+  if (NULL != d->edges) {
+    allocator->deallocate(d->edges, allocator->state);
+  }
+  if (NULL != d->successors) {
+    allocator->deallocate(d->successors, allocator->state);
+  }
+  if (NULL != d->ready) {
+    allocator->deallocate(d->ready, allocator->state);
+  }
+  if (NULL != d->pending) {
+    allocator->deallocate(d->pending, allocator->state);
+  }
+  if (NULL != d->first_successor) {
+    allocator->deallocate(d->first_successor, allocator->state);
+  }
+  if (NULL != d->in_degree) {
+    allocator->deallocate(d->in_degree, allocator->state);
+  }
+  allocator->deallocate(d, allocator->state);
+  *dag = NULL;
+  return result;
+}
+
+rcl_ret_t
+rclc_executor_dag_start_workers(
+  rclc_executor_dag_t * dag,
+  size_t number_of_threads)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(dag, RCL_RET_INVALID_ARGUMENT);
+  if (0 != dag->number_of_threads) {
+    RCL_SET_ERROR_MSG("The worker threads have already been started.");
+    return RCL_RET_ERROR;
+  }
+  if (0 == number_of_threads) {
+    return RCL_RET_OK;
+  }
+#ifdef RCLC_EXECUTOR_DAG_PTHREAD
+  dag->threads = dag->allocator.allocate(
+    number_of_threads * sizeof(pthread_t), dag->allocator.state);
+  if (NULL == dag->threads) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for the worker threads.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  for (size_t i = 0; i < number_of_threads; i++) {
+    if (0 != pthread_create(&dag->threads[i], NULL, _rclc_executor_dag_worker, dag)) {
+      // the threads started so far are joined by rclc_executor_dag_fini
+      RCL_SET_ERROR_MSG("Could not start a worker thread.");
+      return RCL_RET_ERROR;
+    }
+    dag->number_of_threads++;
+  }
+  return RCL_RET_OK;
+#else
+  RCL_SET_ERROR_MSG("Threads are not supported on this platform.");
+  return RCL_RET_UNSUPPORTED;
+#endif
+}
+
+bool
+rclc_executor_dag_has_workers(const rclc_executor_dag_t * dag)
+{
+  return 0 != dag->number_of_threads;
+}
+
+rcl_ret_t
+rclc_executor_dag_add_dependency(
+  rclc_executor_dag_t * dag,
+  const void * before,
+  const void * after,
+  rclc_executor_handle_t * handles,
+  size_t number_of_handles)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(dag, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(before, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(after, RCL_RET_INVALID_ARGUMENT);
+  bool cycle = false;
+  rcl_ret_t rc = _rclc_executor_dag_reachable(dag, after, before, &cycle);
+  if (rc != RCL_RET_OK) {
+    return rc;
+  }
+  if (cycle) {
+    RCL_SET_ERROR_MSG("The dependency would create a cycle.");
+    return RCL_RET_ERROR;
+  }
+  if (dag->number_of_edges == dag->max_edges) {
+    size_t max_edges = (0 == dag->max_edges) ? 8 : 2 * dag->max_edges;
+    rclc_executor_dag_edge_t * edges = dag->allocator.reallocate(
+      dag->edges, max_edges * sizeof(rclc_executor_dag_edge_t), dag->allocator.state);
+    if (NULL == edges) {
+      RCL_SET_ERROR_MSG("Could not allocate memory for the dependencies.");
+      return RCL_RET_BAD_ALLOC;
+    }
+    dag->edges = edges;
+    size_t * successors = dag->allocator.reallocate(
+      dag->successors, max_edges * sizeof(size_t), dag->allocator.state);
+    if (NULL == successors) {
+      RCL_SET_ERROR_MSG("Could not allocate memory for the dependencies.");
+      return RCL_RET_BAD_ALLOC;
+    }
+    dag->successors = successors;
+    dag->max_edges = max_edges;
+  }
+  dag->edges[dag->number_of_edges].before = before;
+  dag->edges[dag->number_of_edges].after = after;
+  dag->number_of_edges++;
+  rclc_executor_dag_update_handles(dag, handles, number_of_handles);
+  return RCL_RET_OK;
+}
+
+void
+rclc_executor_dag_update_handles(
+  rclc_executor_dag_t * dag,
+  rclc_executor_handle_t * handles,
+  size_t number_of_handles)
+{
+  if (NULL == dag) {
+    return;
+  }
+  size_t n = (number_of_handles < dag->max_handles) ? number_of_handles : dag->max_handles;
+  DAG_LOCK(dag);
+  dag->number_of_nodes = n;
+  for (size_t i = 0; i <= n; i++) {
+    dag->first_successor[i] = 0;
+  }
+  for (size_t i = 0; i < n; i++) {
+    dag->in_degree[i] = 0;
+  }
+  // count the successors of each node, then fill them in
+  for (size_t e = 0; e < dag->number_of_edges; e++) {
+    size_t before = _rclc_executor_dag_find(handles, n, dag->edges[e].before);
+    size_t after = _rclc_executor_dag_find(handles, n, dag->edges[e].after);
+    if (before < n && after < n) {
+      dag->first_successor[before + 1]++;
+      dag->in_degree[after]++;
+    }
+  }
+  for (size_t i = 0; i < n; i++) {
+    dag->first_successor[i + 1] += dag->first_successor[i];
+  }
+  for (size_t i = 0; i < n; i++) {
+    dag->pending[i] = dag->first_successor[i];
+  }
+  for (size_t e = 0; e < dag->number_of_edges; e++) {
+    size_t before = _rclc_executor_dag_find(handles, n, dag->edges[e].before);
+    size_t after = _rclc_executor_dag_find(handles, n, dag->edges[e].after);
+    if (before < n && after < n) {
+      dag->successors[dag->pending[before]++] = after;
+    }
+  }
+  DAG_UNLOCK(dag);
+}
+
+rcl_ret_t
+rclc_executor_dag_execute(
+  rclc_executor_dag_t * dag,
+  rclc_executor_dag_execute_t execute,
+  void * context,
+  bool parallel)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(dag, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(execute, RCL_RET_INVALID_ARGUMENT);
+  DAG_LOCK(dag);
+  dag->execute = execute;
+  dag->context = context;
+  dag->result = RCL_RET_OK;
+  dag->completed = 0;
+  dag->ready_head = 0;
+  dag->ready_tail = 0;
+  // handles without dependencies start in the order of the handle list
+  for (size_t i = 0; i < dag->number_of_nodes; i++) {
+    dag->pending[i] = dag->in_degree[i];
+    if (0 == dag->in_degree[i]) {
+      dag->ready[dag->ready_tail++] = i;
+    }
+  }
+  dag->parallel = parallel && (dag->number_of_threads > 0);
+  if (dag->parallel) {
+    DAG_BROADCAST(dag);
+  }
+  // the calling thread executes handles as well
+  while (dag->completed < dag->number_of_nodes) {
+    if (dag->ready_head < dag->ready_tail) {
+      _rclc_executor_dag_process_one(dag);
+    } else {
+      DAG_WAIT(dag);
+    }
+  }
+  dag->parallel = false;
+  rcl_ret_t result = dag->result;
+  DAG_UNLOCK(dag);
+  return result;
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLC__EXECUTOR_DAG_INTERNAL_H_
+#define RCLC__EXECUTOR_DAG_INTERNAL_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <rcl/rcl.h>
+
+#include "rclc/executor_handle.h"
+
+/// Dependencies between the handles of an executor and the worker threads, which
+/// execute independent handles of one LET cycle in parallel. The dependencies are
+/// stored as pairs of rcl handles and resolved to handle indices whenever the
+/// handle list changes.
+typedef struct rclc_executor_dag_t rclc_executor_dag_t;
+
+/// Executes the handle with the index in the handle list. Called concurrently
+/// for independent handles.
+typedef rcl_ret_t (* rclc_executor_dag_execute_t)(void * context, size_t index);
+
+rcl_ret_t
+rclc_executor_dag_init(
+  rclc_executor_dag_t ** dag,
+  size_t max_handles,
+  const rcl_allocator_t * allocator);
+
+/// Stops the worker threads.
+rcl_ret_t
+rclc_executor_dag_fini(
+  rclc_executor_dag_t ** dag,
+  const rcl_allocator_t * allocator);
+
+/// Starts number_of_threads worker threads. Can only be called once.
+rcl_ret_t
+rclc_executor_dag_start_workers(
+  rclc_executor_dag_t * dag,
+  size_t number_of_threads);
+
+/// True if worker threads have been started, i.e. rclc_executor_dag_execute can
+/// execute handles in parallel.
+bool
+rclc_executor_dag_has_workers(const rclc_executor_dag_t * dag);
+
+/// Adds the dependency 'after' runs after 'before' and resolves the graph.
+/// Returns RCL_RET_ERROR if the dependency would close a cycle.
+rcl_ret_t
+rclc_executor_dag_add_dependency(
+  rclc_executor_dag_t * dag,
+  const void * before,
+  const void * after,
+  rclc_executor_handle_t * handles,
+  size_t number_of_handles);
+
+/// Resolves the dependencies for a changed handle list. Dependencies on handles,
+/// which are not in the list, are ignored.
+void
+rclc_executor_dag_update_handles(
+  rclc_executor_dag_t * dag,
+  rclc_executor_handle_t * handles,
+  size_t number_of_handles);
+
+/// Executes all handles in a topological order of the dependencies. Independent
+/// handles are executed in parallel by the worker threads and the calling thread,
+/// unless parallel is false. After the first error no further handle is started.
+rcl_ret_t
+rclc_executor_dag_execute(
+  rclc_executor_dag_t * dag,
+  rclc_executor_dag_execute_t execute,
+  void * context,
+  bool parallel);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__EXECUTOR_DAG_INTERNAL_H_
@@ -0,0 +1,452 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./executor_events_internal.h"
+
+#include <stdatomic.h>
+
+#include <rcl/error_handling.h>
+#include <rcutils/logging_macros.h>
+#include <rcutils/time.h>
+
+#include "rclc/types.h"
+#include "./executor_heap_internal.h"
+
+/// Cell of the bounded MPSC queue (D. Vyukov, bounded MPMC queue).
+typedef struct
+{
+  atomic_size_t sequence;
+  size_t index;
+} rclc_executor_event_cell_t;
+
+/// User data of the RMW listener callback of one handle.
+typedef struct
+{
+  struct rclc_executor_events_t * events;
+  size_t index;
+  /// Number of events not yet processed by the executor.
+  atomic_size_t pending;
+} rclc_executor_event_listener_t;
+
+struct rclc_executor_events_t
+{
+  rclc_executor_event_cell_t * cells;
+  size_t mask;
+  atomic_size_t enqueue_pos;
+  atomic_size_t dequeue_pos;
+
+  rclc_executor_event_listener_t * listeners;
+  size_t max_handles;
+
+  rclc_executor_heap_t timers;
+  rcl_guard_condition_t guard_condition;
+};
+
+static
+void
+_rclc_executor_events_reset_queue(rclc_executor_events_t * events)
+{
+  for (size_t i = 0; i <= events->mask; i++) {
+    atomic_init(&events->cells[i].sequence, i);
+    events->cells[i].index = 0;
+  }
+  atomic_init(&events->enqueue_pos, 0);
+  atomic_init(&events->dequeue_pos, 0);
+}
+
+// called by the threads of the middleware
+static
+bool
+_rclc_executor_events_push(rclc_executor_events_t * events, size_t index)
+{
+  rclc_executor_event_cell_t * cell;
+  size_t pos = atomic_load_explicit(&events->enqueue_pos, memory_order_relaxed);
+  while (true) {
+    cell = &events->cells[pos & events->mask];
+    size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+    intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+    if (0 == diff) {
+      if (atomic_compare_exchange_weak_explicit(
+          &events->enqueue_pos, &pos, pos + 1,
+          memory_order_relaxed, memory_order_relaxed))
+      {
+        break;
+      }
+    } else if (diff < 0) {
+      // queue full
+      return false;
+    } else {
+      pos = atomic_load_explicit(&events->enqueue_pos, memory_order_relaxed);
+    }
+  }
+  cell->index = index;
+  atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+  return true;
+}
+
+// called only by the executor thread
+static
+bool
+_rclc_executor_events_pop_index(rclc_executor_events_t * events, size_t * index)
+{
+  size_t pos = atomic_load_explicit(&events->dequeue_pos, memory_order_relaxed);
+  rclc_executor_event_cell_t * cell = &events->cells[pos & events->mask];
+  size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+  if ((intptr_t) seq - (intptr_t) (pos + 1) < 0) {
+    // queue empty
+    return false;
+  }
+  *index = cell->index;
+  atomic_store_explicit(&events->dequeue_pos, pos + 1, memory_order_relaxed);
+  atomic_store_explicit(&cell->sequence, pos + events->mask + 1, memory_order_release);
+  return true;
+}
+
+// Signature of rcl_event_callback_t, which does not exist before Humble
+typedef void (* rclc_executor_event_callback_t)(const void * user_data, size_t number_of_events);
+
+// RMW listener callback
+static
+void
+_rclc_executor_events_on_new_event(const void * user_data, size_t number_of_events)
+{
+  rclc_executor_event_listener_t * listener = (rclc_executor_event_listener_t *) user_data;
+  if (0 == number_of_events) {
+    return;
+  }
+  // only the first notification enqueues the handle, following notifications are
+  // accumulated in the counter until the executor has processed the handle.
+  if (0 == atomic_fetch_add(&listener->pending, number_of_events)) {
+    if (_rclc_executor_events_push(listener->events, listener->index)) {
+      rcl_ret_t rc = rcl_trigger_guard_condition(&listener->events->guard_condition);
+      RCLC_UNUSED(rc);
+    }
+  }
+}
+
+rcl_ret_t
+rclc_executor_events_init(
+  rclc_executor_events_t ** events,
+  rcl_context_t * context,
+  size_t max_handles,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(events, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  if (0 == max_handles) {
+    RCL_SET_ERROR_MSG("max_handles is 0. Must be larger or equal to 1");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  rclc_executor_events_t * e = allocator->zero_allocate(
+    1, sizeof(rclc_executor_events_t), allocator->state);
+  if (NULL == e) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for 'events'.");
+    return RCL_RET_BAD_ALLOC;
+  }
+
+  // queue capacity: smallest power of two which holds every handle once
+  size_t capacity = 1;
+  while (capacity < max_handles) {
+    capacity <<= 1;
+  }
+  e->mask = capacity - 1;
+  e->max_handles = max_handles;
+  e->cells = allocator->allocate(capacity * sizeof(rclc_executor_event_cell_t), allocator->state);
+  e->listeners = allocator->allocate(
+    max_handles * sizeof(rclc_executor_event_listener_t), allocator->state);
+  e->timers = rclc_executor_heap_get_zero_initialized();
+  e->guard_condition = rcl_get_zero_initialized_guard_condition();
+  rcl_ret_t rc = RCL_RET_BAD_ALLOC;
+  if (NULL == e->cells || NULL == e->listeners) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for event queue.");
+    goto fail;
+  }
+  rc = rclc_executor_heap_init(&e->timers, max_handles, allocator);
+  if (RCL_RET_OK != rc) {
+    goto fail;
+  }
+  rc = rcl_guard_condition_init(
+    &e->guard_condition, context, rcl_guard_condition_get_default_options());
+  if (RCL_RET_OK != rc) {
+    PRINT_RCLC_ERROR(rclc_executor_events_init, rcl_guard_condition_init);
+    goto fail;
+  }
+
+  _rclc_executor_events_reset_queue(e);
+  for (size_t i = 0; i < max_handles; i++) {
+    e->listeners[i].events = e;
+    e->listeners[i].index = i;
+    atomic_init(&e->listeners[i].pending, 0);
+  }
+  *events = e;
+  return RCL_RET_OK;
+
+fail:
+  rclc_executor_heap_fini(&e->timers, allocator);
+  if (NULL != e->cells) {
+    allocator->deallocate(e->cells, allocator->state);
+  }
+  if (NULL != e->listeners) {
+    allocator->deallocate(e->listeners, allocator->state);
+  }
+  allocator->deallocate(e, allocator->state);
+  return rc;
+}
+
+rcl_ret_t
+rclc_executor_events_fini(
+  rclc_executor_events_t ** events,
+  rclc_executor_handle_t * handles,
+  size_t number_of_handles,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(events, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  rclc_executor_events_t * e = *events;
+  if (NULL == e) {
+    return RCL_RET_OK;
+  }
+
+  rcl_ret_t rc = RCL_RET_OK;
+  if (NULL != handles) {
+    rc = rclc_executor_events_detach(e, handles, number_of_handles);
+  }
+  if (RCL_RET_OK != rcl_guard_condition_fini(&e->guard_condition)) {
+    PRINT_RCLC_ERROR(rclc_executor_events_fini, rcl_guard_condition_fini);
+    rc = RCL_RET_ERROR;
+  }
+  rclc_executor_heap_fini(&e->timers, allocator);
+  allocator->deallocate(e->cells, allocator->state);
+  allocator->deallocate(e->listeners, allocator->state);
+  allocator->deallocate(e, allocator->state);
+  *events = NULL;
+  return rc;
+}
+
+static
+rcl_ret_t
+_rclc_executor_events_set_listener(
+  rclc_executor_handle_t * handle,
+  rclc_executor_event_callback_t callback,
+  const void * user_data)
+{
+#ifdef RCLC_HAVE_LISTENER_API
+  rcl_ret_t rc = RCL_RET_OK;
+  switch (handle->type) {
+    case RCLC_SUBSCRIPTION:
+    case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+    case RCLC_SUBSCRIPTION_LATEST_VALUE:
+      rc = rcl_subscription_set_on_new_message_callback(
+        handle->subscription, callback, user_data);
+      break;
+
+    case RCLC_SERVICE:
+    case RCLC_SERVICE_WITH_REQUEST_ID:
+    case RCLC_SERVICE_WITH_CONTEXT:
+      rc = rcl_service_set_on_new_request_callback(
+        handle->service, callback, user_data);
+      break;
+
+    case RCLC_CLIENT:
+    case RCLC_CLIENT_WITH_REQUEST_ID:
+      rc = rcl_client_set_on_new_response_callback(
+        handle->client, callback, user_data);
+      break;
+
+    default:
+      // timers are kept in the timer heap, all other handles remain in the wait_set
+      break;
+  }
+  return rc;
+#else
+  RCLC_UNUSED(handle);
+  RCLC_UNUSED(callback);
+  RCLC_UNUSED(user_data);
+  RCL_SET_ERROR_MSG("listener callbacks are not supported by this rcl version.");
+  return RCL_RET_UNSUPPORTED;
+#endif
+}
+
+rcl_ret_t
+rclc_executor_events_attach(
+  rclc_executor_events_t * events,
+  rclc_executor_handle_t * handles,
+  size_t number_of_handles)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(events, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(handles, RCL_RET_INVALID_ARGUMENT);
+  if (number_of_handles > events->max_handles) {
+    RCL_SET_ERROR_MSG("number_of_handles exceeds max_handles of event queue");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  rcl_ret_t rc = RCL_RET_OK;
+  rclc_executor_heap_clear(&events->timers);
+  for (size_t i = 0; i < number_of_handles && handles[i].initialized; i++) {
+    if (RCLC_TIMER == handles[i].type) {
+      rc = rclc_executor_events_schedule_timer(events, handles, i);
+    } else if (ALWAYS == handles[i].invocation) {
+      // called once per spin, the executor waits for it in the wait_set
+      continue;
+    } else {
+      // if messages are already waiting, the middleware calls the listener
+      // immediately with the number of unread messages
+      rc = _rclc_executor_events_set_listener(
+        &handles[i], _rclc_executor_events_on_new_event, &events->listeners[i]);
+    }
+    if (RCL_RET_OK != rc) {
+      PRINT_RCLC_ERROR(rclc_executor_events_attach, set_on_new_event_callback);
+      return rc;
+    }
+  }
+  return rc;
+}
+
+rcl_ret_t
+rclc_executor_events_detach(
+  rclc_executor_events_t * events,
+  rclc_executor_handle_t * handles,
+  size_t number_of_handles)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(events, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(handles, RCL_RET_INVALID_ARGUMENT);
+
+  rcl_ret_t rc = RCL_RET_OK;
+  for (size_t i = 0; i < number_of_handles && handles[i].initialized; i++) {
+    if (RCL_RET_OK != _rclc_executor_events_set_listener(&handles[i], NULL, NULL)) {
+      PRINT_RCLC_ERROR(rclc_executor_events_detach, set_on_new_event_callback);
+      rc = RCL_RET_ERROR;
+    }
+  }
+  // no listener is active anymore, pending events are re-announced by
+  // the middleware on the next call of rclc_executor_events_attach
+  _rclc_executor_events_reset_queue(events);
+  for (size_t i = 0; i < events->max_handles; i++) {
+    atomic_store(&events->listeners[i].pending, 0);
+  }
+  rclc_executor_heap_clear(&events->timers);
+  return rc;
+}
+
+rcl_guard_condition_t *
+rclc_executor_events_get_guard_condition(rclc_executor_events_t * events)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(events, "events is NULL", return NULL);
+  return &events->guard_condition;
+}
+
+bool
+rclc_executor_events_pending(rclc_executor_events_t * events)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(events, "events is NULL", return false);
+  size_t pos = atomic_load_explicit(&events->dequeue_pos, memory_order_relaxed);
+  rclc_executor_event_cell_t * cell = &events->cells[pos & events->mask];
+  size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+  return seq == pos + 1;
+}
+
+bool
+rclc_executor_events_pop(
+  rclc_executor_events_t * events,
+  size_t * index,
+  size_t * count)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(events, "events is NULL", return false);
+  RCL_CHECK_FOR_NULL_WITH_MSG(index, "index is NULL", return false);
+  RCL_CHECK_FOR_NULL_WITH_MSG(count, "count is NULL", return false);
+
+  if (!_rclc_executor_events_pop_index(events, index)) {
+    return false;
+  }
+  // collect all events, which arrived until now. Events arriving after this
+  // point will enqueue the handle again.
+  *count = atomic_exchange(&events->listeners[*index].pending, 0);
+  return true;
+}
+
+bool
+rclc_executor_events_get_timer_timeout(
+  rclc_executor_events_t * events,
+  int64_t * timeout_ns)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(events, "events is NULL", return false);
+  RCL_CHECK_FOR_NULL_WITH_MSG(timeout_ns, "timeout_ns is NULL", return false);
+
+  rclc_executor_heap_entry_t next;
+  if (!rclc_executor_heap_peek(&events->timers, &next)) {
+    return false;
+  }
+  rcutils_time_point_value_t now;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    return false;
+  }
+  *timeout_ns = (next.key > now) ? (next.key - now) : 0;
+  return true;
+}
+
+bool
+rclc_executor_events_pop_expired_timer(
+  rclc_executor_events_t * events,
+  size_t * index)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(events, "events is NULL", return false);
+  RCL_CHECK_FOR_NULL_WITH_MSG(index, "index is NULL", return false);
+
+  rclc_executor_heap_entry_t next;
+  rcutils_time_point_value_t now;
+  if (!rclc_executor_heap_peek(&events->timers, &next) ||
+    RCUTILS_RET_OK != rcutils_steady_time_now(&now) ||
+    next.key > now)
+  {
+    return false;
+  }
+  rclc_executor_heap_pop(&events->timers, &next);
+  *index = next.value;
+  return true;
+}
+
+rcl_ret_t
+rclc_executor_events_schedule_timer(
+  rclc_executor_events_t * events,
+  rclc_executor_handle_t * handles,
+  size_t index)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(events, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(handles, RCL_RET_INVALID_ARGUMENT);
+
+  // the heap is ordered by steady time. For timers with another clock
+  // the key is only a hint: rcl_timer_is_ready is checked before execution.
+  rcutils_time_point_value_t now;
+  rcl_ret_t rc = rcutils_steady_time_now(&now);
+  if (RCUTILS_RET_OK != rc) {
+    return RCL_RET_ERROR;
+  }
+  int64_t time_until_next_call = 0;
+  rc = rcl_timer_get_time_until_next_call(handles[index].timer, &time_until_next_call);
+  if (RCL_RET_TIMER_CANCELED == rc) {
+    // a cancelled timer might be reset later, check again after one period
+    rc = rcl_timer_get_period(handles[index].timer, &time_until_next_call);
+  }
+  if (RCL_RET_OK != rc) {
+    PRINT_RCLC_ERROR(rclc_executor_events_schedule_timer, rcl_timer_get_time_until_next_call);
+    return rc;
+  }
+  if (time_until_next_call < 0) {
+    time_until_next_call = 0;
+  }
+  return rclc_executor_heap_push(&events->timers, now + time_until_next_call, index);
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__EXECUTOR_EVENTS_INTERNAL_H_
+#define RCLC__EXECUTOR_EVENTS_INTERNAL_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <rcl/rcl.h>
+
+#include "rclc/executor_handle.h"
+
+/// Event-queue state of an executor in events mode (see rclc_executor_set_events_mode).
+///
+/// Subscriptions, services and clients register an RMW listener callback. The callback
+/// adds the number of new events to a per-handle counter and, if the counter was zero,
+/// pushes the handle index into a bounded lock-free MPSC queue and triggers a guard condition.
+/// Because every handle is at most once in the queue, the queue can never overflow.
+/// Timers are kept in a min-heap ordered by their next expiration time.
+typedef struct rclc_executor_events_t rclc_executor_events_t;
+
+rcl_ret_t
+rclc_executor_events_init(
+  rclc_executor_events_t ** events,
+  rcl_context_t * context,
+  size_t max_handles,
+  const rcl_allocator_t * allocator);
+
+rcl_ret_t
+rclc_executor_events_fini(
+  rclc_executor_events_t ** events,
+  rclc_executor_handle_t * handles,
+  size_t number_of_handles,
+  const rcl_allocator_t * allocator);
+
+/// Registers the RMW listeners of all handles and builds the timer heap.
+rcl_ret_t
+rclc_executor_events_attach(
+  rclc_executor_events_t * events,
+  rclc_executor_handle_t * handles,
+  size_t number_of_handles);
+
+/// Unregisters all RMW listeners and drops pending events.
+rcl_ret_t
+rclc_executor_events_detach(
+  rclc_executor_events_t * events,
+  rclc_executor_handle_t * handles,
+  size_t number_of_handles);
+
+/// Guard condition, which is triggered whenever a new event is queued.
+rcl_guard_condition_t *
+rclc_executor_events_get_guard_condition(rclc_executor_events_t * events);
+
+/// Returns true if at least one event is queued.
+bool
+rclc_executor_events_pending(rclc_executor_events_t * events);
+
+/// Pops the next event: index of the handle and the number of new events.
+bool
+rclc_executor_events_pop(
+  rclc_executor_events_t * events,
+  size_t * index,
+  size_t * count);
+
+/// Time in nanoseconds until the next timer expires. Returns false if there is no timer.
+bool
+rclc_executor_events_get_timer_timeout(
+  rclc_executor_events_t * events,
+  int64_t * timeout_ns);
+
+/// Pops the index of a timer handle, whose expiration time has passed.
+bool
+rclc_executor_events_pop_expired_timer(
+  rclc_executor_events_t * events,
+  size_t * index);
+
+/// (Re-)inserts timer handle handles[index] into the timer heap.
+rcl_ret_t
+rclc_executor_events_schedule_timer(
+  rclc_executor_events_t * events,
+  rclc_executor_handle_t * handles,
+  size_t index);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__EXECUTOR_EVENTS_INTERNAL_H_
@@ -49,6 +49,8 @@ rclc_executor_handle_init(
   handle->data = NULL;
   handle->data_response_msg = NULL;
   handle->callback_context = NULL;
+  handle->service_cache = NULL;
+  handle->topic_statistics = NULL;
 
   handle->subscription_callback = NULL;
   // because of union structure:
@@ -89,6 +91,7 @@ rclc_executor_handle_print(rclc_executor_handle_t * handle)
       break;
     case RCLC_SUBSCRIPTION:
     case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+    case RCLC_SUBSCRIPTION_LATEST_VALUE:
       typeName = "Sub";
       break;
     case RCLC_TIMER:
@@ -130,6 +133,7 @@ rclc_executor_handle_get_ptr(rclc_executor_handle_t * handle)
   switch (handle->type) {
     case RCLC_SUBSCRIPTION:
     case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+    case RCLC_SUBSCRIPTION_LATEST_VALUE:
       ptr = handle->subscription;
       break;
     case RCLC_TIMER:
@@ -150,6 +154,9 @@ rclc_executor_handle_get_ptr(rclc_executor_handle_t * handle)
       // case RCLC_GUARD_CONDITION_WITH_CONTEXT:
       ptr = handle->gc;
       break;
+    case RCLC_DISCOVERY:
+      ptr = handle->discovery;
+      break;
     case RCLC_NONE:
     default:
       ptr = NULL;
@@ -0,0 +1,157 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./executor_heap_internal.h"
+
+#include <rcl/error_handling.h>
+
+rclc_executor_heap_t
+rclc_executor_heap_get_zero_initialized(void)
+{
+  static rclc_executor_heap_t null_heap = {
+    .entries = NULL,
+    .size = 0,
+    .capacity = 0
+  };
+  return null_heap;
+}
+
+rcl_ret_t
+rclc_executor_heap_init(
+  rclc_executor_heap_t * heap,
+  size_t capacity,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(heap, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  if (0 == capacity) {
+    RCL_SET_ERROR_MSG("capacity is 0. Must be larger or equal to 1");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  heap->entries = allocator->allocate(
+    capacity * sizeof(rclc_executor_heap_entry_t), allocator->state);
+  if (NULL == heap->entries) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for 'heap->entries'.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  heap->size = 0;
+  heap->capacity = capacity;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_heap_fini(
+  rclc_executor_heap_t * heap,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(heap, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  if (NULL != heap->entries) {
+    allocator->deallocate(heap->entries, allocator->state);
+  }
+  *heap = rclc_executor_heap_get_zero_initialized();
+  return RCL_RET_OK;
+}
+
+void
+rclc_executor_heap_clear(rclc_executor_heap_t * heap)
+{
+  if (NULL != heap) {
+    heap->size = 0;
+  }
+}
+
+static
+void
+_rclc_executor_heap_swap(rclc_executor_heap_t * heap, size_t a, size_t b)
+{
+  rclc_executor_heap_entry_t tmp = heap->entries[a];
+  heap->entries[a] = heap->entries[b];
+  heap->entries[b] = tmp;
+}
+
+rcl_ret_t
+rclc_executor_heap_push(
+  rclc_executor_heap_t * heap,
+  int64_t key,
+  size_t value)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(heap, RCL_RET_INVALID_ARGUMENT);
+  if (heap->size >= heap->capacity) {
+    RCL_SET_ERROR_MSG("Buffer overflow of 'heap->entries'.");
+    return RCL_RET_ERROR;
+  }
+
+  // sift up
+  size_t i = heap->size++;
+  heap->entries[i].key = key;
+  heap->entries[i].value = value;
+  while (i > 0) {
+    size_t parent = (i - 1) / 2;
+    if (heap->entries[parent].key <= heap->entries[i].key) {
+      break;
+    }
+    _rclc_executor_heap_swap(heap, parent, i);
+    i = parent;
+  }
+  return RCL_RET_OK;
+}
+
+bool
+rclc_executor_heap_peek(
+  const rclc_executor_heap_t * heap,
+  rclc_executor_heap_entry_t * entry)
+{
+  if (NULL == heap || 0 == heap->size) {
+    return false;
+  }
+  if (NULL != entry) {
+    *entry = heap->entries[0];
+  }
+  return true;
+}
+
+bool
+rclc_executor_heap_pop(
+  rclc_executor_heap_t * heap,
+  rclc_executor_heap_entry_t * entry)
+{
+  if (!rclc_executor_heap_peek(heap, entry)) {
+    return false;
+  }
+
+  // move last entry to the root and sift down
+  heap->size--;
+  heap->entries[0] = heap->entries[heap->size];
+  size_t i = 0;
+  while (true) {
+    size_t left = 2 * i + 1;
+    size_t right = left + 1;
+    size_t smallest = i;
+    if (left < heap->size && heap->entries[left].key < heap->entries[smallest].key) {
+      smallest = left;
+    }
+    if (right < heap->size && heap->entries[right].key < heap->entries[smallest].key) {
+      smallest = right;
+    }
+    if (smallest == i) {
+      break;
+    }
+    _rclc_executor_heap_swap(heap, smallest, i);
+    i = smallest;
+  }
+  return true;
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__EXECUTOR_HEAP_INTERNAL_H_
+#define RCLC__EXECUTOR_HEAP_INTERNAL_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <rcl/allocator.h>
+#include <rcl/types.h>
+
+/// Entry of a binary min-heap: ordered by key, value is opaque for the heap.
+typedef struct
+{
+  int64_t key;
+  size_t value;
+} rclc_executor_heap_entry_t;
+
+/// Fixed-capacity binary min-heap. Memory is allocated once in init.
+typedef struct
+{
+  rclc_executor_heap_entry_t * entries;
+  size_t size;
+  size_t capacity;
+} rclc_executor_heap_t;
+
+rclc_executor_heap_t
+rclc_executor_heap_get_zero_initialized(void);
+
+rcl_ret_t
+rclc_executor_heap_init(
+  rclc_executor_heap_t * heap,
+  size_t capacity,
+  const rcl_allocator_t * allocator);
+
+rcl_ret_t
+rclc_executor_heap_fini(
+  rclc_executor_heap_t * heap,
+  const rcl_allocator_t * allocator);
+
+void
+rclc_executor_heap_clear(rclc_executor_heap_t * heap);
+
+rcl_ret_t
+rclc_executor_heap_push(
+  rclc_executor_heap_t * heap,
+  int64_t key,
+  size_t value);
+
+bool
+rclc_executor_heap_peek(
+  const rclc_executor_heap_t * heap,
+  rclc_executor_heap_entry_t * entry);
+
+bool
+rclc_executor_heap_pop(
+  rclc_executor_heap_t * heap,
+  rclc_executor_heap_entry_t * entry);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__EXECUTOR_HEAP_INTERNAL_H_
@@ -0,0 +1,207 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./executor_staging_internal.h"
+
+#include <stdatomic.h>
+
+#include <rcl/error_handling.h>
+#include <rcutils/logging_macros.h>
+
+#include "rclc/types.h"
+
+/// Cell of the bounded MPSC queue (D. Vyukov, bounded MPMC queue).
+typedef struct
+{
+  atomic_size_t sequence;
+  rclc_executor_staged_request_t request;
+} rclc_executor_staging_cell_t;
+
+struct rclc_executor_staging_t
+{
+  rclc_executor_staging_cell_t * cells;
+  size_t mask;
+  atomic_size_t enqueue_pos;
+  atomic_size_t dequeue_pos;
+  /// number of applied requests, compared with enqueue_pos
+  atomic_size_t applied;
+  /// number of applied requests, which failed
+  atomic_size_t failed;
+  rcl_guard_condition_t guard_condition;
+};
+
+rcl_ret_t
+rclc_executor_staging_init(
+  rclc_executor_staging_t ** staging,
+  rcl_context_t * context,
+  size_t queue_size,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(staging, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  if (0 == queue_size) {
+    RCL_SET_ERROR_MSG("queue_size is 0. Must be larger or equal to 1");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  rclc_executor_staging_t * s = allocator->zero_allocate(
+    1, sizeof(rclc_executor_staging_t), allocator->state);
+  if (NULL == s) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for 'staging'.");
+    return RCL_RET_BAD_ALLOC;
+  }
+
+  // queue capacity: smallest power of two which holds queue_size requests
+  size_t capacity = 1;
+  while (capacity < queue_size) {
+    capacity <<= 1;
+  }
+  s->mask = capacity - 1;
+  s->cells = allocator->zero_allocate(
+    capacity, sizeof(rclc_executor_staging_cell_t), allocator->state);
+  if (NULL == s->cells) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for staging queue.");
+    allocator->deallocate(s, allocator->state);
+    return RCL_RET_BAD_ALLOC;
+  }
+  s->guard_condition = rcl_get_zero_initialized_guard_condition();
+  rcl_ret_t rc = rcl_guard_condition_init(
+    &s->guard_condition, context, rcl_guard_condition_get_default_options());
+  if (RCL_RET_OK != rc) {
+    PRINT_RCLC_ERROR(rclc_executor_staging_init, rcl_guard_condition_init);
+    allocator->deallocate(s->cells, allocator->state);
+    allocator->deallocate(s, allocator->state);
+    return rc;
+  }
+
+  for (size_t i = 0; i < capacity; i++) {
+    atomic_init(&s->cells[i].sequence, i);
+  }
+  atomic_init(&s->enqueue_pos, 0);
+  atomic_init(&s->dequeue_pos, 0);
+  atomic_init(&s->applied, 0);
+  atomic_init(&s->failed, 0);
+  *staging = s;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_staging_fini(
+  rclc_executor_staging_t ** staging,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(staging, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  rclc_executor_staging_t * s = *staging;
+  if (NULL == s) {
+    return RCL_RET_OK;
+  }
+
+  rcl_ret_t rc = RCL_RET_OK;
+  if (RCL_RET_OK != rcl_guard_condition_fini(&s->guard_condition)) {
+    PRINT_RCLC_ERROR(rclc_executor_staging_fini, rcl_guard_condition_fini);
+    rc = RCL_RET_ERROR;
+  }
+  allocator->deallocate(s->cells, allocator->state);
+  allocator->deallocate(s, allocator->state);
+  *staging = NULL;
+  return rc;
+}
+
+rcl_ret_t
+rclc_executor_staging_push(
+  rclc_executor_staging_t * staging,
+  const rclc_executor_staged_request_t * request)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(staging, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(request, RCL_RET_INVALID_ARGUMENT);
+
+  rclc_executor_staging_cell_t * cell;
+  size_t pos = atomic_load_explicit(&staging->enqueue_pos, memory_order_relaxed);
+  while (true) {
+    cell = &staging->cells[pos & staging->mask];
+    size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+    intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+    if (0 == diff) {
+      if (atomic_compare_exchange_weak_explicit(
+          &staging->enqueue_pos, &pos, pos + 1,
+          memory_order_relaxed, memory_order_relaxed))
+      {
+        break;
+      }
+    } else if (diff < 0) {
+      RCL_SET_ERROR_MSG("Staging queue is full. Increase 'queue_size'");
+      return RCL_RET_ERROR;
+    } else {
+      pos = atomic_load_explicit(&staging->enqueue_pos, memory_order_relaxed);
+    }
+  }
+  cell->request = *request;
+  atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+
+  rcl_ret_t rc = rcl_trigger_guard_condition(&staging->guard_condition);
+  if (RCL_RET_OK != rc) {
+    // the request is applied in the next spin anyway
+    PRINT_RCLC_ERROR(rclc_executor_staging_push, rcl_trigger_guard_condition);
+  }
+  return RCL_RET_OK;
+}
+
+bool
+rclc_executor_staging_pop(
+  rclc_executor_staging_t * staging,
+  rclc_executor_staged_request_t * request)
+{
+  size_t pos = atomic_load_explicit(&staging->dequeue_pos, memory_order_relaxed);
+  rclc_executor_staging_cell_t * cell = &staging->cells[pos & staging->mask];
+  size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+  if ((intptr_t) seq - (intptr_t) (pos + 1) < 0) {
+    // queue empty
+    return false;
+  }
+  *request = cell->request;
+  atomic_store_explicit(&staging->dequeue_pos, pos + 1, memory_order_relaxed);
+  atomic_store_explicit(&cell->sequence, pos + staging->mask + 1, memory_order_release);
+  return true;
+}
+
+void
+rclc_executor_staging_mark_applied(rclc_executor_staging_t * staging, bool success)
+{
+  if (!success) {
+    atomic_fetch_add_explicit(&staging->failed, 1, memory_order_relaxed);
+  }
+  atomic_fetch_add_explicit(&staging->applied, 1, memory_order_release);
+}
+
+size_t
+rclc_executor_staging_failed(rclc_executor_staging_t * staging)
+{
+  return atomic_load_explicit(&staging->failed, memory_order_acquire);
+}
+
+bool
+rclc_executor_staging_all_applied(rclc_executor_staging_t * staging)
+{
+  size_t applied = atomic_load_explicit(&staging->applied, memory_order_acquire);
+  return applied == atomic_load_explicit(&staging->enqueue_pos, memory_order_acquire);
+}
+
+rcl_guard_condition_t *
+rclc_executor_staging_get_guard_condition(rclc_executor_staging_t * staging)
+{
+  return &staging->guard_condition;
+}
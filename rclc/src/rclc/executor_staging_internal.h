@@ -0,0 +1,106 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__EXECUTOR_STAGING_INTERNAL_H_
+#define RCLC__EXECUTOR_STAGING_INTERNAL_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <rcl/rcl.h>
+
+#include "rclc/executor_handle.h"
+
+/// Operation of a staged request
+typedef enum
+{
+  RCLC_STAGED_ADD,
+  RCLC_STAGED_REMOVE
+} rclc_executor_staged_operation_t;
+
+/// Add or remove request of another thread (see rclc_executor_enable_staging).
+/// For RCLC_STAGED_REMOVE only `rcl_handle` is used.
+typedef struct
+{
+  rclc_executor_staged_operation_t operation;
+  rclc_executor_handle_type_t type;
+  rclc_executor_handle_invocation_t invocation;
+  /// rcl_subscription_t, rcl_timer_t, rcl_client_t, rcl_service_t or rcl_guard_condition_t
+  void * rcl_handle;
+  /// message of a subscription, request of a service, response of a client
+  void * data;
+  /// response of a service
+  void * data_response_msg;
+  void * callback_context;
+  union {
+    rclc_subscription_callback_t subscription_callback;
+    rclc_subscription_callback_with_context_t subscription_callback_with_context;
+    rclc_service_callback_t service_callback;
+    rclc_client_callback_t client_callback;
+    rclc_gc_callback_t gc_callback;
+  };
+} rclc_executor_staged_request_t;
+
+/// Request queue of an executor. Any thread may push, only the executor thread pops.
+/// The queue is a bounded lock-free MPSC queue; every push triggers a guard condition,
+/// which wakes up the executor from rcl_wait.
+typedef struct rclc_executor_staging_t rclc_executor_staging_t;
+
+rcl_ret_t
+rclc_executor_staging_init(
+  rclc_executor_staging_t ** staging,
+  rcl_context_t * context,
+  size_t queue_size,
+  const rcl_allocator_t * allocator);
+
+rcl_ret_t
+rclc_executor_staging_fini(
+  rclc_executor_staging_t ** staging,
+  const rcl_allocator_t * allocator);
+
+/// Thread-safe. Returns RCL_RET_ERROR if the queue is full.
+rcl_ret_t
+rclc_executor_staging_push(
+  rclc_executor_staging_t * staging,
+  const rclc_executor_staged_request_t * request);
+
+/// Only called by the executor thread. Returns false if the queue is empty.
+bool
+rclc_executor_staging_pop(
+  rclc_executor_staging_t * staging,
+  rclc_executor_staged_request_t * request);
+
+/// Marks one popped request as applied. A failed request is counted, before it is
+/// marked as applied, so it is visible once rclc_executor_staging_all_applied is true.
+void
+rclc_executor_staging_mark_applied(rclc_executor_staging_t * staging, bool success);
+
+/// Thread-safe. Number of requests, which could not be applied.
+size_t
+rclc_executor_staging_failed(rclc_executor_staging_t * staging);
+
+/// Thread-safe. True if every request pushed so far has been applied.
+bool
+rclc_executor_staging_all_applied(rclc_executor_staging_t * staging);
+
+rcl_guard_condition_t *
+rclc_executor_staging_get_guard_condition(rclc_executor_staging_t * staging);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__EXECUTOR_STAGING_INTERNAL_H_
@@ -0,0 +1,689 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(__unix__) || defined(__APPLE__)
+#define RCLC_EXECUTOR_STATS_SHM
+#if defined(__linux__)
+// perf_event_open has no libc wrapper
+#define RCLC_EXECUTOR_STATS_PERF
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#elif !defined(_POSIX_C_SOURCE) && !defined(_GNU_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#endif
+
+#include "./executor_stats_internal.h"
+#include "./histogram_internal.h"
+
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef RCLC_EXECUTOR_STATS_SHM
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef RCLC_EXECUTOR_STATS_PERF
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include <rcl/error_handling.h>
+#include <rcl_action/rcl_action.h>
+#include <rcutils/time.h>
+
+#include "rclc/types.h"
+
+// The sequence numbers and the magic are plain uint64_t in the shared layout and
+// are accessed with atomic operations.
+#define ATOMIC_U64(x) ((_Atomic uint64_t *) (x))
+
+// "/" + prefix + pid + "." + name
+#define RCLC_EXECUTOR_STATS_SEGMENT_NAME_SIZE \
+  (1 + sizeof(RCLC_EXECUTOR_STATS_SEGMENT_PREFIX) + 12 + RCLC_EXECUTOR_STATS_NAME_SIZE)
+
+// cycles, instructions, cache misses, context switches
+#define RCLC_EXECUTOR_STATS_COUNTERS 4
+
+struct rclc_executor_stats_t
+{
+  rclc_executor_stats_segment_t * segment;
+  rclc_executor_stats_handle_t * handles;
+  size_t size;
+  char segment_name[RCLC_EXECUTOR_STATS_SEGMENT_NAME_SIZE];
+
+  // phase times of the current spin
+  uint64_t wait_time_ns;
+  uint64_t take_time_ns;
+  uint64_t execute_time_ns;
+
+  // perf event group of the executor thread, -1 if not opened
+  int group_fd;
+  int counter_fds[RCLC_EXECUTOR_STATS_COUNTERS];
+  // position of each counter in the group read, -1 if not available
+  int counter_slots[RCLC_EXECUTOR_STATS_COUNTERS];
+  size_t number_of_counters;
+  uint64_t counters_start[RCLC_EXECUTOR_STATS_COUNTERS];
+  bool counters_started;
+};
+
+static
+void
+_rclc_executor_stats_write_begin(uint64_t * sequence)
+{
+  uint64_t seq = atomic_load_explicit(ATOMIC_U64(sequence), memory_order_relaxed);
+  atomic_store_explicit(ATOMIC_U64(sequence), seq + 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+}
+
+static
+void
+_rclc_executor_stats_write_end(uint64_t * sequence)
+{
+  uint64_t seq = atomic_load_explicit(ATOMIC_U64(sequence), memory_order_relaxed);
+  atomic_store_explicit(ATOMIC_U64(sequence), seq + 1, memory_order_release);
+}
+
+// Copies 'size' bytes, which are protected by the sequence lock 'sequence'.
+// Returns false, if no consistent copy was made within RCLC_EXECUTOR_STATS_READ_ATTEMPTS
+// attempts, e.g. because the writer died with an odd sequence number.
+static
+bool
+_rclc_executor_stats_read(
+  const uint64_t * sequence,
+  void * dst,
+  const void * src,
+  size_t size)
+{
+  for (unsigned int i = 0; i < RCLC_EXECUTOR_STATS_READ_ATTEMPTS; i++) {
+    uint64_t before = atomic_load_explicit(ATOMIC_U64(sequence), memory_order_acquire);
+    if (0 == (before & 1)) {
+      memcpy(dst, src, size);
+      atomic_thread_fence(memory_order_acquire);
+      uint64_t after = atomic_load_explicit(ATOMIC_U64(sequence), memory_order_relaxed);
+      if (before == after) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static
+uint64_t
+_rclc_executor_stats_elapsed(rcutils_time_point_value_t start)
+{
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now) || now < start) {
+    return 0;
+  }
+  return (uint64_t) (now - start);
+}
+
+static
+void
+_rclc_executor_stats_handle_name(
+  const rclc_executor_handle_t * handle,
+  char * name)
+{
+  const char * handle_name = NULL;
+  int64_t period = 0;
+  switch (handle->type) {
+    case RCLC_SUBSCRIPTION:
+    case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+    case RCLC_SUBSCRIPTION_LATEST_VALUE:
+      handle_name = rcl_subscription_get_topic_name(handle->subscription);
+      break;
+    case RCLC_TIMER:
+      if (RCL_RET_OK == rcl_timer_get_period(handle->timer, &period)) {
+        snprintf(
+          name, RCLC_EXECUTOR_STATS_NAME_SIZE, "timer %" PRId64 "ms",
+          (int64_t) RCL_NS_TO_MS(period));
+        return;
+      }
+      handle_name = "timer";
+      break;
+    case RCLC_CLIENT:
+    case RCLC_CLIENT_WITH_REQUEST_ID:
+      handle_name = rcl_client_get_service_name(handle->client);
+      break;
+    case RCLC_SERVICE:
+    case RCLC_SERVICE_WITH_REQUEST_ID:
+    case RCLC_SERVICE_WITH_CONTEXT:
+      handle_name = rcl_service_get_service_name(handle->service);
+      break;
+    case RCLC_ACTION_CLIENT:
+      handle_name = rcl_action_client_get_action_name(&handle->action_client->rcl_handle);
+      break;
+    case RCLC_ACTION_SERVER:
+      handle_name = rcl_action_server_get_action_name(&handle->action_server->rcl_handle);
+      break;
+    case RCLC_GUARD_CONDITION:
+      handle_name = "guard_condition";
+      break;
+    case RCLC_DISCOVERY:
+      handle_name = "discovery";
+      break;
+    default:
+      break;
+  }
+  snprintf(name, RCLC_EXECUTOR_STATS_NAME_SIZE, "%s", (NULL != handle_name) ? handle_name : "");
+}
+
+rcl_ret_t
+rclc_executor_stats_init(
+  rclc_executor_stats_t ** stats,
+  const char * name,
+  size_t max_handles,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  size_t name_length = strlen(name);
+  if (0 == name_length || name_length >= RCLC_EXECUTOR_STATS_NAME_SIZE ||
+    NULL != strchr(name, '/'))
+  {
+    RCL_SET_ERROR_MSG("name is empty, too long or contains '/'");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+#ifdef RCLC_EXECUTOR_STATS_SHM
+  rclc_executor_stats_t * s = allocator->zero_allocate(
+    1, sizeof(rclc_executor_stats_t), allocator->state);
+  if (NULL == s) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for the executor statistics.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  s->group_fd = -1;
+  for (size_t i = 0; i < RCLC_EXECUTOR_STATS_COUNTERS; i++) {
+    s->counter_fds[i] = -1;
+    s->counter_slots[i] = -1;
+  }
+  int32_t pid = (int32_t) getpid();
+  snprintf(
+    s->segment_name, sizeof(s->segment_name), "/%s%" PRId32 ".%s",
+    RCLC_EXECUTOR_STATS_SEGMENT_PREFIX, pid, name);
+  s->size = sizeof(rclc_executor_stats_segment_t) +
+    max_handles * sizeof(rclc_executor_stats_handle_t);
+
+  int fd = shm_open(s->segment_name, O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0 && EEXIST == errno) {
+    // left over by a terminated process with the same pid
+    shm_unlink(s->segment_name);
+    fd = shm_open(s->segment_name, O_CREAT | O_EXCL | O_RDWR, 0644);
+  }
+  if (fd < 0) {
+    RCL_SET_ERROR_MSG("Could not create the shared-memory segment.");
+    allocator->deallocate(s, allocator->state);
+    return RCL_RET_ERROR;
+  }
+  void * memory = MAP_FAILED;
+  if (0 == ftruncate(fd, (off_t) s->size)) {
+    memory = mmap(NULL, s->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (MAP_FAILED == memory) {
+    RCL_SET_ERROR_MSG("Could not map the shared-memory segment.");
+    shm_unlink(s->segment_name);
+    allocator->deallocate(s, allocator->state);
+    return RCL_RET_ERROR;
+  }
+
+  // the segment is zero-filled, the magic is written last
+  s->segment = (rclc_executor_stats_segment_t *) memory;
+  s->handles = (rclc_executor_stats_handle_t *) (s->segment + 1);
+  s->segment->version = RCLC_EXECUTOR_STATS_VERSION;
+  s->segment->pid = pid;
+  snprintf(s->segment->name, RCLC_EXECUTOR_STATS_NAME_SIZE, "%s", name);
+  s->segment->max_handles = max_handles;
+  atomic_store_explicit(
+    ATOMIC_U64(&s->segment->magic), RCLC_EXECUTOR_STATS_MAGIC, memory_order_release);
+
+  *stats = s;
+  return RCL_RET_OK;
+#else
+  RCLC_UNUSED(max_handles);
+  RCL_SET_ERROR_MSG("Shared memory is not supported on this platform.");
+  return RCL_RET_UNSUPPORTED;
+#endif
+}
+
+rcl_ret_t
+rclc_executor_stats_fini(
+  rclc_executor_stats_t ** stats,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  rclc_executor_stats_t * s = *stats;
+  if (NULL == s) {
+    return RCL_RET_OK;
+  }
+  rcl_ret_t ret = RCL_RET_OK;
+#ifdef RCLC_EXECUTOR_STATS_PERF
+  for (size_t i = 0; i < RCLC_EXECUTOR_STATS_COUNTERS; i++) {
+    if (s->counter_fds[i] >= 0) {
+      close(s->counter_fds[i]);
+    }
+  }
+#endif
+#ifdef RCLC_EXECUTOR_STATS_SHM
+  if (0 != munmap(s->segment, s->size) || 0 != shm_unlink(s->segment_name)) {
+    RCL_SET_ERROR_MSG("Could not remove the shared-memory segment.");
+    ret = RCL_RET_ERROR;
+  }
+#endif
+  allocator->deallocate(s, allocator->state);
+  *stats = NULL;
+  return ret;
+}
+
+void
+rclc_executor_stats_update_handles(
+  rclc_executor_stats_t * stats,
+  const rclc_executor_handle_t * handles,
+  size_t number_of_handles)
+{
+  if (NULL == stats || NULL == handles) {
+    return;
+  }
+  size_t old_number_of_handles = (size_t) stats->segment->number_of_handles;
+  if (number_of_handles > stats->segment->max_handles) {
+    number_of_handles = (size_t) stats->segment->max_handles;
+  }
+
+  // Handles are only appended or removed, so a handle, which is still in the
+  // executor, is found at the same or a larger index in the old list.
+  size_t next = 0;
+  for (size_t i = 0; i < number_of_handles; i++) {
+    // the rcl objects of all handle types are members of a union
+    uint64_t id = (uint64_t) (uintptr_t) handles[i].subscription;
+    size_t k = next;
+    while (k < old_number_of_handles && stats->handles[k].id != id) {
+      k++;
+    }
+    rclc_executor_stats_handle_t * record = &stats->handles[i];
+    _rclc_executor_stats_write_begin(&record->sequence);
+    if (k < old_number_of_handles) {
+      if (k != i) {
+        const rclc_executor_stats_handle_t * old = &stats->handles[k];
+        record->invocations = old->invocations;
+        record->take_failures = old->take_failures;
+        record->callback_time_ns = old->callback_time_ns;
+        record->callback_time_max_ns = old->callback_time_max_ns;
+        memcpy(
+          record->callback_time_histogram, old->callback_time_histogram,
+          sizeof(record->callback_time_histogram));
+        record->cycles = old->cycles;
+        record->instructions = old->instructions;
+        record->cache_misses = old->cache_misses;
+        record->context_switches = old->context_switches;
+      }
+      next = k + 1;
+    } else {
+      record->invocations = 0;
+      record->take_failures = 0;
+      record->callback_time_ns = 0;
+      record->callback_time_max_ns = 0;
+      memset(record->callback_time_histogram, 0, sizeof(record->callback_time_histogram));
+      record->cycles = 0;
+      record->instructions = 0;
+      record->cache_misses = 0;
+      record->context_switches = 0;
+    }
+    record->type = (uint32_t) handles[i].type;
+    record->id = id;
+    _rclc_executor_stats_handle_name(&handles[i], record->name);
+    _rclc_executor_stats_write_end(&record->sequence);
+  }
+
+  _rclc_executor_stats_write_begin(&stats->segment->sequence);
+  stats->segment->number_of_handles = number_of_handles;
+  _rclc_executor_stats_write_end(&stats->segment->sequence);
+}
+
+void
+rclc_executor_stats_record_wait(
+  rclc_executor_stats_t * stats,
+  rcutils_time_point_value_t start)
+{
+  stats->wait_time_ns += _rclc_executor_stats_elapsed(start);
+}
+
+void
+rclc_executor_stats_record_take(
+  rclc_executor_stats_t * stats,
+  size_t index,
+  rcutils_time_point_value_t start,
+  rcl_ret_t rc)
+{
+  stats->take_time_ns += _rclc_executor_stats_elapsed(start);
+  if ((rc == RCL_RET_SUBSCRIPTION_TAKE_FAILED) || (rc == RCL_RET_SERVICE_TAKE_FAILED) ||
+    (rc == RCL_RET_CLIENT_TAKE_FAILED))
+  {
+    if (index < stats->segment->number_of_handles) {
+      rclc_executor_stats_handle_t * record = &stats->handles[index];
+      _rclc_executor_stats_write_begin(&record->sequence);
+      record->take_failures++;
+      _rclc_executor_stats_write_end(&record->sequence);
+    }
+  }
+}
+
+#ifdef RCLC_EXECUTOR_STATS_PERF
+static
+int
+_rclc_executor_stats_perf_open(uint32_t type, uint64_t config, bool exclude_kernel, int group_fd)
+{
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.read_format = PERF_FORMAT_GROUP;
+  attr.disabled = (group_fd < 0) ? 1 : 0;
+  // user space of the callbacks only, which unprivileged processes may count
+  attr.exclude_kernel = exclude_kernel ? 1 : 0;
+  attr.exclude_hv = 1;
+  // calling thread on any CPU
+  return (int) syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC);
+}
+
+// Reads the values of the group into counters, 0 for unavailable counters.
+static
+bool
+_rclc_executor_stats_perf_read(
+  const rclc_executor_stats_t * stats,
+  uint64_t * counters)
+{
+  uint64_t values[1 + RCLC_EXECUTOR_STATS_COUNTERS];
+  ssize_t size = (ssize_t) ((1 + stats->number_of_counters) * sizeof(uint64_t));
+  if (read(stats->group_fd, values, (size_t) size) != size) {
+    return false;
+  }
+  for (size_t i = 0; i < RCLC_EXECUTOR_STATS_COUNTERS; i++) {
+    counters[i] = (stats->counter_slots[i] >= 0) ? values[1 + stats->counter_slots[i]] : 0;
+  }
+  return true;
+}
+#endif
+
+rcl_ret_t
+rclc_executor_stats_enable_counters(
+  rclc_executor_stats_t * stats,
+  uint32_t * counters)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(counters, RCL_RET_INVALID_ARGUMENT);
+  *counters = 0;
+#ifdef RCLC_EXECUTOR_STATS_PERF
+  if (stats->group_fd < 0) {
+    const struct
+    {
+      uint32_t type;
+      uint64_t config;
+      bool exclude_kernel;
+    } events[RCLC_EXECUTOR_STATS_COUNTERS] = {
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, true},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, true},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, true},
+      // context switches are counted in the kernel
+      {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, false},
+    };
+    // The first counter, which can be opened, leads the group. Without a PMU or
+    // with a restrictive perf_event_paranoid none is opened, which leaves the
+    // callback times.
+    for (size_t i = 0; i < RCLC_EXECUTOR_STATS_COUNTERS; i++) {
+      int fd = _rclc_executor_stats_perf_open(
+        events[i].type, events[i].config, events[i].exclude_kernel, stats->group_fd);
+      if (fd < 0) {
+        continue;
+      }
+      if (stats->group_fd < 0) {
+        stats->group_fd = fd;
+      }
+      stats->counter_fds[i] = fd;
+      stats->counter_slots[i] = (int) stats->number_of_counters;
+      stats->number_of_counters++;
+    }
+    if (stats->group_fd >= 0 &&
+      0 != ioctl(stats->group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP))
+    {
+      for (size_t i = 0; i < RCLC_EXECUTOR_STATS_COUNTERS; i++) {
+        if (stats->counter_fds[i] >= 0) {
+          close(stats->counter_fds[i]);
+        }
+        stats->counter_fds[i] = -1;
+        stats->counter_slots[i] = -1;
+      }
+      stats->group_fd = -1;
+      stats->number_of_counters = 0;
+    }
+  }
+  for (size_t i = 0; i < RCLC_EXECUTOR_STATS_COUNTERS; i++) {
+    if (stats->counter_slots[i] >= 0) {
+      *counters |= 1u << i;
+    }
+  }
+#endif
+  _rclc_executor_stats_write_begin(&stats->segment->sequence);
+  stats->segment->counters = *counters;
+  _rclc_executor_stats_write_end(&stats->segment->sequence);
+  return RCL_RET_OK;
+}
+
+void
+rclc_executor_stats_begin_execute(rclc_executor_stats_t * stats)
+{
+#ifdef RCLC_EXECUTOR_STATS_PERF
+  stats->counters_started = stats->group_fd >= 0 &&
+    _rclc_executor_stats_perf_read(stats, stats->counters_start);
+#else
+  RCLC_UNUSED(stats);
+#endif
+}
+
+void
+rclc_executor_stats_record_execute(
+  rclc_executor_stats_t * stats,
+  size_t index,
+  rcutils_time_point_value_t start,
+  bool invoked)
+{
+  uint64_t duration = _rclc_executor_stats_elapsed(start);
+  stats->execute_time_ns += duration;
+  if (invoked && index < stats->segment->number_of_handles) {
+    rclc_executor_stats_handle_t * record = &stats->handles[index];
+    _rclc_executor_stats_write_begin(&record->sequence);
+    record->invocations++;
+    record->callback_time_ns += duration;
+    if (duration > record->callback_time_max_ns) {
+      record->callback_time_max_ns = duration;
+    }
+    record->callback_time_histogram[
+      rclc_histogram_bucket(duration, RCLC_EXECUTOR_STATS_HISTOGRAM_SIZE)]++;
+#ifdef RCLC_EXECUTOR_STATS_PERF
+    uint64_t counters[RCLC_EXECUTOR_STATS_COUNTERS];
+    if (stats->counters_started && _rclc_executor_stats_perf_read(stats, counters)) {
+      record->cycles += counters[0] - stats->counters_start[0];
+      record->instructions += counters[1] - stats->counters_start[1];
+      record->cache_misses += counters[2] - stats->counters_start[2];
+      record->context_switches += counters[3] - stats->counters_start[3];
+    }
+#endif
+    _rclc_executor_stats_write_end(&record->sequence);
+  }
+}
+
+void
+rclc_executor_stats_record_spin(rclc_executor_stats_t * stats)
+{
+  rcutils_time_point_value_t now = 0;
+  rcutils_ret_t rc = rcutils_steady_time_now(&now);
+  RCLC_UNUSED(rc);
+
+  rclc_executor_stats_segment_t * segment = stats->segment;
+  _rclc_executor_stats_write_begin(&segment->sequence);
+  segment->spins++;
+  segment->wait_time_ns += stats->wait_time_ns;
+  segment->take_time_ns += stats->take_time_ns;
+  segment->execute_time_ns += stats->execute_time_ns;
+  segment->timestamp_ns = (uint64_t) now;
+  _rclc_executor_stats_write_end(&segment->sequence);
+
+  stats->wait_time_ns = 0;
+  stats->take_time_ns = 0;
+  stats->execute_time_ns = 0;
+}
+
+rclc_executor_stats_view_t
+rclc_executor_stats_view_get_zero_initialized(void)
+{
+  static rclc_executor_stats_view_t null_view = {
+    .segment = NULL,
+    .size = 0
+  };
+  return null_view;
+}
+
+rcl_ret_t
+rclc_executor_stats_attach(
+  rclc_executor_stats_view_t * view,
+  const char * segment_name)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(view, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(segment_name, RCL_RET_INVALID_ARGUMENT);
+
+#ifdef RCLC_EXECUTOR_STATS_SHM
+  char name[RCLC_EXECUTOR_STATS_SEGMENT_NAME_SIZE];
+  int length = snprintf(
+    name, sizeof(name), "%s%s", ('/' == segment_name[0]) ? "" : "/", segment_name);
+  if (length < 0 || (size_t) length >= sizeof(name)) {
+    RCL_SET_ERROR_MSG("segment_name is too long");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  int fd = shm_open(name, O_RDONLY, 0);
+  if (fd < 0) {
+    RCL_SET_ERROR_MSG("Could not open the shared-memory segment.");
+    return RCL_RET_ERROR;
+  }
+  struct stat st;
+  void * memory = MAP_FAILED;
+  if (0 == fstat(fd, &st) && (size_t) st.st_size >= sizeof(rclc_executor_stats_segment_t)) {
+    memory = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (MAP_FAILED == memory) {
+    RCL_SET_ERROR_MSG("Could not map the shared-memory segment.");
+    return RCL_RET_ERROR;
+  }
+
+  const rclc_executor_stats_segment_t * segment = (const rclc_executor_stats_segment_t *) memory;
+  size_t size = (size_t) st.st_size;
+  if (RCLC_EXECUTOR_STATS_MAGIC !=
+    atomic_load_explicit(ATOMIC_U64(&segment->magic), memory_order_acquire) ||
+    RCLC_EXECUTOR_STATS_VERSION != segment->version ||
+    segment->max_handles > (size - sizeof(rclc_executor_stats_segment_t)) /
+    sizeof(rclc_executor_stats_handle_t))
+  {
+    RCL_SET_ERROR_MSG("The shared-memory segment is not an initialized statistics segment.");
+    munmap(memory, size);
+    return RCL_RET_ERROR;
+  }
+  view->segment = segment;
+  view->size = size;
+  return RCL_RET_OK;
+#else
+  RCL_SET_ERROR_MSG("Shared memory is not supported on this platform.");
+  return RCL_RET_UNSUPPORTED;
+#endif
+}
+
+rcl_ret_t
+rclc_executor_stats_detach(rclc_executor_stats_view_t * view)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(view, RCL_RET_INVALID_ARGUMENT);
+#ifdef RCLC_EXECUTOR_STATS_SHM
+  if (NULL != view->segment) {
+    munmap((void *) view->segment, view->size);
+  }
+#endif
+  *view = rclc_executor_stats_view_get_zero_initialized();
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_stats_read_segment(
+  const rclc_executor_stats_view_t * view,
+  rclc_executor_stats_segment_t * segment)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(view, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(view->segment, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(segment, RCL_RET_INVALID_ARGUMENT);
+  if (!_rclc_executor_stats_read(
+      &view->segment->sequence, segment, view->segment, sizeof(rclc_executor_stats_segment_t)))
+  {
+    RCL_SET_ERROR_MSG("The statistics segment is stale.");
+    return RCL_RET_TIMEOUT;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_stats_read_handle(
+  const rclc_executor_stats_view_t * view,
+  size_t index,
+  rclc_executor_stats_handle_t * handle)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(view, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(view->segment, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(handle, RCL_RET_INVALID_ARGUMENT);
+  if (index >= view->segment->max_handles) {
+    RCL_SET_ERROR_MSG("index is larger than max_handles");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  const rclc_executor_stats_handle_t * record =
+    &((const rclc_executor_stats_handle_t *) (view->segment + 1))[index];
+  if (!_rclc_executor_stats_read(
+      &record->sequence, handle, record, sizeof(rclc_executor_stats_handle_t)))
+  {
+    RCL_SET_ERROR_MSG("The statistics of the handle are stale.");
+    return RCL_RET_TIMEOUT;
+  }
+  return RCL_RET_OK;
+}
+
+uint64_t
+rclc_executor_stats_percentile(
+  const rclc_executor_stats_handle_t * handle,
+  double percentile)
+{
+  if (NULL == handle) {
+    return 0;
+  }
+  return rclc_histogram_percentile(
+    handle->callback_time_histogram, RCLC_EXECUTOR_STATS_HISTOGRAM_SIZE,
+    handle->invocations, handle->callback_time_max_ns, percentile);
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__EXECUTOR_STATS_INTERNAL_H_
+#define RCLC__EXECUTOR_STATS_INTERNAL_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <rcl/rcl.h>
+
+#include "rclc/executor_handle.h"
+#include "rclc/executor_stats.h"
+
+/// Writer side of the statistics segment of an executor
+/// (see rclc_executor_set_stats_export). Only the executor thread calls these functions.
+typedef struct rclc_executor_stats_t rclc_executor_stats_t;
+
+/// Creates the shared-memory segment `/rclc_stats.<pid>.<name>`.
+rcl_ret_t
+rclc_executor_stats_init(
+  rclc_executor_stats_t ** stats,
+  const char * name,
+  size_t max_handles,
+  const rcl_allocator_t * allocator);
+
+/// Unmaps and removes the shared-memory segment.
+rcl_ret_t
+rclc_executor_stats_fini(
+  rclc_executor_stats_t ** stats,
+  const rcl_allocator_t * allocator);
+
+/// Updates the handle list. The statistics of handles, which are still in the
+/// executor, are kept.
+void
+rclc_executor_stats_update_handles(
+  rclc_executor_stats_t * stats,
+  const rclc_executor_handle_t * handles,
+  size_t number_of_handles);
+
+/// Adds the duration since \p start to the wait phase of the current spin.
+void
+rclc_executor_stats_record_wait(
+  rclc_executor_stats_t * stats,
+  rcutils_time_point_value_t start);
+
+/// Adds the duration since \p start to the take phase of the current spin and
+/// counts a take failure of the handle with \p index if \p rc indicates one.
+void
+rclc_executor_stats_record_take(
+  rclc_executor_stats_t * stats,
+  size_t index,
+  rcutils_time_point_value_t start,
+  rcl_ret_t rc);
+
+/// Opens the counters of the calling thread, which are available, and sets
+/// \p counters to their RCLC_EXECUTOR_STATS_COUNTER_* bits, 0 if none is.
+rcl_ret_t
+rclc_executor_stats_enable_counters(
+  rclc_executor_stats_t * stats,
+  uint32_t * counters);
+
+/// Samples the counters before a callback is invoked.
+void
+rclc_executor_stats_begin_execute(rclc_executor_stats_t * stats);
+
+/// Adds the duration since \p start to the execute phase of the current spin and,
+/// if \p invoked, records a callback invocation of the handle with \p index
+/// and the counter deltas since rclc_executor_stats_begin_execute.
+void
+rclc_executor_stats_record_execute(
+  rclc_executor_stats_t * stats,
+  size_t index,
+  rcutils_time_point_value_t start,
+  bool invoked);
+
+/// Publishes the phase times of the current spin.
+void
+rclc_executor_stats_record_spin(rclc_executor_stats_t * stats);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__EXECUTOR_STATS_INTERNAL_H_
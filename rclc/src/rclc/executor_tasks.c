@@ -0,0 +1,275 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./executor_tasks_internal.h"
+
+#include <rcl/error_handling.h>
+#include <rcutils/time.h>
+
+#include "./executor_heap_internal.h"
+
+typedef enum
+{
+  RCLC_EXECUTOR_TASK_FREE,
+  RCLC_EXECUTOR_TASK_SCHEDULED,
+  RCLC_EXECUTOR_TASK_CANCELLED
+} rclc_executor_task_state_t;
+
+typedef struct
+{
+  rclc_executor_task_callback_t callback;
+  void * context;
+  // incremented with each use of the slot, so that the ids of executed or
+  // cancelled tasks do not match a new task in the same slot
+  uint32_t generation;
+  rclc_executor_task_state_t state;
+  // index + 1 of the next free slot
+  size_t next_free;
+} rclc_executor_task_t;
+
+struct rclc_executor_tasks_t
+{
+  rclc_executor_task_t * slots;
+  size_t max_tasks;
+  // index + 1 of the first free slot, 0 if all slots are in use
+  size_t free;
+  // scheduled tasks, which have been neither executed nor cancelled
+  size_t pending;
+  // steady time and slot index of the scheduled and cancelled tasks
+  rclc_executor_heap_t heap;
+};
+
+// the lower half of a task id is the slot index + 1, the upper half its generation
+#define TASK_ID(generation, index) \
+  ((((rclc_executor_task_id_t) (generation)) << 32) | ((rclc_executor_task_id_t) (index) + 1))
+#define TASK_ID_INDEX(task_id) ((size_t) ((task_id) & UINT32_MAX) - 1)
+#define TASK_ID_GENERATION(task_id) ((uint32_t) ((task_id) >> 32))
+
+rcl_ret_t
+rclc_executor_tasks_init(
+  rclc_executor_tasks_t ** tasks,
+  size_t max_tasks,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(tasks, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  if (0 == max_tasks || max_tasks >= UINT32_MAX) {
+    RCL_SET_ERROR_MSG("max_tasks is 0 or too large");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  rclc_executor_tasks_t * t = allocator->zero_allocate(
+    1, sizeof(rclc_executor_tasks_t), allocator->state);
+  if (NULL == t) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for the scheduled tasks.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  t->slots = allocator->zero_allocate(max_tasks, sizeof(rclc_executor_task_t), allocator->state);
+  if (NULL == t->slots) {
+    allocator->deallocate(t, allocator->state);
+    RCL_SET_ERROR_MSG("Could not allocate memory for the scheduled tasks.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  t->heap = rclc_executor_heap_get_zero_initialized();
+  rcl_ret_t rc = rclc_executor_heap_init(&t->heap, max_tasks, allocator);
+  if (RCL_RET_OK != rc) {
+    allocator->deallocate(t->slots, allocator->state);
+    allocator->deallocate(t, allocator->state);
+    return rc;
+  }
+
+  for (size_t i = 0; i < max_tasks; i++) {
+    t->slots[i].next_free = (i + 1 < max_tasks) ? i + 2 : 0;
+  }
+  t->max_tasks = max_tasks;
+  t->free = 1;
+  t->pending = 0;
+  *tasks = t;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_tasks_fini(
+  rclc_executor_tasks_t ** tasks,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(tasks, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  rclc_executor_tasks_t * t = *tasks;
+  if (NULL == t) {
+    return RCL_RET_OK;
+  }
+  rcl_ret_t rc = rclc_executor_heap_fini(&t->heap, allocator);
+  allocator->deallocate(t->slots, allocator->state);
+  allocator->deallocate(t, allocator->state);
+  *tasks = NULL;
+  return rc;
+}
+
+static
+void
+_rclc_executor_tasks_free_slot(rclc_executor_tasks_t * tasks, size_t index)
+{
+  rclc_executor_task_t * task = &tasks->slots[index];
+  task->state = RCLC_EXECUTOR_TASK_FREE;
+  task->callback = NULL;
+  task->context = NULL;
+  task->next_free = tasks->free;
+  tasks->free = index + 1;
+}
+
+// Removes the heap entries of cancelled tasks and frees their slots
+static
+void
+_rclc_executor_tasks_purge(rclc_executor_tasks_t * tasks)
+{
+  size_t size = tasks->heap.size;
+  size_t kept = 0;
+  for (size_t i = 0; i < size; i++) {
+    rclc_executor_heap_entry_t entry = tasks->heap.entries[i];
+    if (RCLC_EXECUTOR_TASK_CANCELLED == tasks->slots[entry.value].state) {
+      _rclc_executor_tasks_free_slot(tasks, entry.value);
+    } else {
+      tasks->heap.entries[kept++] = entry;
+    }
+  }
+  // rebuild the heap from the kept entries, pushing never overwrites an entry not read yet
+  rclc_executor_heap_clear(&tasks->heap);
+  for (size_t i = 0; i < kept; i++) {
+    rclc_executor_heap_entry_t entry = tasks->heap.entries[i];
+    rcl_ret_t rc = rclc_executor_heap_push(&tasks->heap, entry.key, entry.value);
+    RCLC_UNUSED(rc);
+  }
+}
+
+rcl_ret_t
+rclc_executor_tasks_schedule(
+  rclc_executor_tasks_t * tasks,
+  rcutils_time_point_value_t time,
+  rclc_executor_task_callback_t callback,
+  void * context,
+  rclc_executor_task_id_t * task_id)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(tasks, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+
+  if (0 == tasks->free) {
+    _rclc_executor_tasks_purge(tasks);
+  }
+  if (0 == tasks->free) {
+    RCL_SET_ERROR_MSG("All task slots are in use. Increase 'max_tasks'");
+    return RCL_RET_ERROR;
+  }
+
+  size_t index = tasks->free - 1;
+  rclc_executor_task_t * task = &tasks->slots[index];
+  rcl_ret_t rc = rclc_executor_heap_push(&tasks->heap, time, index);
+  if (RCL_RET_OK != rc) {
+    return rc;
+  }
+  tasks->free = task->next_free;
+  task->callback = callback;
+  task->context = context;
+  task->generation++;
+  task->state = RCLC_EXECUTOR_TASK_SCHEDULED;
+  tasks->pending++;
+  if (NULL != task_id) {
+    *task_id = TASK_ID(task->generation, index);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_tasks_cancel(
+  rclc_executor_tasks_t * tasks,
+  rclc_executor_task_id_t task_id)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(tasks, RCL_RET_INVALID_ARGUMENT);
+
+  size_t index = TASK_ID_INDEX(task_id);
+  if (RCLC_EXECUTOR_TASK_INVALID_ID == task_id || index >= tasks->max_tasks ||
+    tasks->slots[index].generation != TASK_ID_GENERATION(task_id) ||
+    RCLC_EXECUTOR_TASK_SCHEDULED != tasks->slots[index].state)
+  {
+    RCL_SET_ERROR_MSG("task has already been executed or cancelled");
+    return RCL_RET_ERROR;
+  }
+  // the slot is freed, when its heap entry is popped or purged
+  tasks->slots[index].state = RCLC_EXECUTOR_TASK_CANCELLED;
+  tasks->pending--;
+  return RCL_RET_OK;
+}
+
+bool
+rclc_executor_tasks_get_timeout(
+  rclc_executor_tasks_t * tasks,
+  int64_t * timeout_ns)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(tasks, "tasks is NULL", return false);
+  RCL_CHECK_FOR_NULL_WITH_MSG(timeout_ns, "timeout_ns is NULL", return false);
+
+  // cancelled tasks do not wake up the executor
+  rclc_executor_heap_entry_t next;
+  while (rclc_executor_heap_peek(&tasks->heap, &next) &&
+    RCLC_EXECUTOR_TASK_CANCELLED == tasks->slots[next.value].state)
+  {
+    rclc_executor_heap_pop(&tasks->heap, &next);
+    _rclc_executor_tasks_free_slot(tasks, next.value);
+  }
+  if (!rclc_executor_heap_peek(&tasks->heap, &next)) {
+    return false;
+  }
+  rcutils_time_point_value_t now;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    return false;
+  }
+  *timeout_ns = (next.key > now) ? (next.key - now) : 0;
+  return true;
+}
+
+void
+rclc_executor_tasks_execute(rclc_executor_tasks_t * tasks)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(tasks, "tasks is NULL", return );
+
+  rcutils_time_point_value_t now;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    return;
+  }
+  // bounded, so that a task scheduling itself without delay does not block the executor
+  size_t n = tasks->heap.size;
+  rclc_executor_heap_entry_t next;
+  for (size_t k = 0; k < n && rclc_executor_heap_peek(&tasks->heap, &next) && next.key <= now;
+    k++)
+  {
+    rclc_executor_heap_pop(&tasks->heap, &next);
+    rclc_executor_task_t * task = &tasks->slots[next.value];
+    bool scheduled = (RCLC_EXECUTOR_TASK_SCHEDULED == task->state);
+    rclc_executor_task_callback_t callback = task->callback;
+    void * context = task->context;
+    // the slot can be reused by the callback
+    _rclc_executor_tasks_free_slot(tasks, next.value);
+    if (scheduled) {
+      tasks->pending--;
+      callback(context);
+    }
+  }
+}
+
+size_t
+rclc_executor_tasks_pending(const rclc_executor_tasks_t * tasks)
+{
+  return (NULL == tasks) ? 0 : tasks->pending;
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLC__EXECUTOR_TASKS_INTERNAL_H_
+#define RCLC__EXECUTOR_TASKS_INTERNAL_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <rcl/allocator.h>
+#include <rcl/types.h>
+
+#include "rclc/executor.h"
+
+/// One-shot tasks of an executor (see rclc_executor_enable_scheduled_tasks). The task
+/// slots and a min-heap ordered by the steady time of the tasks are allocated once.
+/// A cancelled task keeps its heap entry until it is due or the heap is full.
+/// Only the executor thread may use the tasks.
+typedef struct rclc_executor_tasks_t rclc_executor_tasks_t;
+
+rcl_ret_t
+rclc_executor_tasks_init(
+  rclc_executor_tasks_t ** tasks,
+  size_t max_tasks,
+  const rcl_allocator_t * allocator);
+
+rcl_ret_t
+rclc_executor_tasks_fini(
+  rclc_executor_tasks_t ** tasks,
+  const rcl_allocator_t * allocator);
+
+/// Returns RCL_RET_ERROR if all task slots are in use.
+rcl_ret_t
+rclc_executor_tasks_schedule(
+  rclc_executor_tasks_t * tasks,
+  rcutils_time_point_value_t time,
+  rclc_executor_task_callback_t callback,
+  void * context,
+  rclc_executor_task_id_t * task_id);
+
+/// Returns RCL_RET_ERROR if the task has already been executed or cancelled.
+rcl_ret_t
+rclc_executor_tasks_cancel(
+  rclc_executor_tasks_t * tasks,
+  rclc_executor_task_id_t task_id);
+
+/// Time in nanoseconds until the next task is due. Returns false if no task is pending.
+bool
+rclc_executor_tasks_get_timeout(
+  rclc_executor_tasks_t * tasks,
+  int64_t * timeout_ns);
+
+/// Executes the tasks, which are due. Tasks scheduled by the callbacks for the
+/// current time are executed in the next call.
+void
+rclc_executor_tasks_execute(rclc_executor_tasks_t * tasks);
+
+/// Number of scheduled tasks, which have been neither executed nor cancelled.
+size_t
+rclc_executor_tasks_pending(const rclc_executor_tasks_t * tasks);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__EXECUTOR_TASKS_INTERNAL_H_
@@ -0,0 +1,52 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "./histogram_internal.h"
+
+size_t
+rclc_histogram_bucket(uint64_t value_ns, size_t size)
+{
+  size_t bucket = 0;
+  while (value_ns > 0 && bucket < size - 1) {
+    value_ns >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+uint64_t
+rclc_histogram_percentile(
+  const uint64_t * buckets,
+  size_t size,
+  uint64_t count,
+  uint64_t max_ns,
+  double percentile)
+{
+  if (0 == count) {
+    return 0;
+  }
+  uint64_t rank = (uint64_t) (percentile * (double) count);
+  if (rank < 1) {
+    rank = 1;
+  }
+  uint64_t sum = 0;
+  for (size_t k = 0; k < size; k++) {
+    sum += buckets[k];
+    if (sum >= rank) {
+      uint64_t upper_bound = (0 == k) ? 0 : (((uint64_t) 1) << k);
+      return (upper_bound < max_ns) ? upper_bound : max_ns;
+    }
+  }
+  return max_ns;
+}
@@ -0,0 +1,49 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__HISTOGRAM_INTERNAL_H_
+#define RCLC__HISTOGRAM_INTERNAL_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// Log2 histogram of durations, shared by the executor statistics and the chain
+/// tracer. Bucket 0 counts the value 0, bucket k > 0 the values in [2^(k-1), 2^k),
+/// the last bucket all larger values.
+
+/// Returns the bucket of \p value_ns in a histogram of \p size buckets.
+size_t
+rclc_histogram_bucket(uint64_t value_ns, size_t size);
+
+/// Returns the upper bound of the bucket, which contains the \p percentile
+/// (0.0 to 1.0) of the \p count values, limited to the maximum value \p max_ns.
+/// Returns 0 if the histogram is empty.
+uint64_t
+rclc_histogram_percentile(
+  const uint64_t * buckets,
+  size_t size,
+  uint64_t count,
+  uint64_t max_ns,
+  double percentile);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__HISTOGRAM_INTERNAL_H_
@@ -0,0 +1,202 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclc/latest_value.h"
+#include "./latest_value_internal.h"
+
+#include <stdatomic.h>
+
+#include <rcl/error_handling.h>
+#include <rcutils/logging_macros.h>
+#include <rmw/serialized_message.h>
+
+#include "rclc/types.h"
+
+// The public struct stores plain integers, so that the header can be used from C++.
+// All accesses from several threads are done with sequentially consistent atomic
+// operations: a reader increments the reader count of the newest buffer and then
+// checks that the buffer is still the newest one, the executor publishes a new
+// buffer and then checks the reader count of the buffer it takes into. So either
+// the reader sees the new buffer and retries, or the executor sees the reader.
+#define ATOMIC_LATEST(latest_value) ((atomic_uintptr_t *) &(latest_value)->latest)
+#define ATOMIC_READERS(buffer) ((atomic_uintptr_t *) &(buffer)->readers)
+
+rclc_latest_value_t
+rclc_latest_value_get_zero_initialized(void)
+{
+  static rclc_latest_value_t null_latest_value = {
+    .buffers = NULL,
+    .number_of_buffers = 0,
+    .latest = 0,
+    .sequence_number = 0,
+    .dropped = 0
+  };
+  return null_latest_value;
+}
+
+rcl_ret_t
+rclc_latest_value_init(
+  rclc_latest_value_t * latest_value,
+  void ** msgs,
+  size_t number_of_msgs,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    latest_value, "latest_value is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    msgs, "msgs is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "allocator is invalid", return RCL_RET_INVALID_ARGUMENT);
+  if (number_of_msgs < RCLC_LATEST_VALUE_MIN_BUFFERS) {
+    RCL_SET_ERROR_MSG("number_of_msgs must be at least RCLC_LATEST_VALUE_MIN_BUFFERS");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  for (size_t i = 0; i < number_of_msgs; i++) {
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      msgs[i], "msgs contains a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  }
+
+  (*latest_value) = rclc_latest_value_get_zero_initialized();
+  // the serialized message for dropped messages grows on demand
+  latest_value->dropped_msg = rmw_get_zero_initialized_serialized_message();
+  if (RMW_RET_OK != rmw_serialized_message_init(&latest_value->dropped_msg, 0, allocator)) {
+    PRINT_RCLC_ERROR(rclc_latest_value_init, rmw_serialized_message_init);
+    return RCL_RET_BAD_ALLOC;
+  }
+  latest_value->buffers = allocator->allocate(
+    number_of_msgs * sizeof(rclc_latest_value_buffer_t), allocator->state);
+  if (NULL == latest_value->buffers) {
+    (void) rmw_serialized_message_fini(&latest_value->dropped_msg);
+    RCL_SET_ERROR_MSG("Could not allocate memory for 'buffers'.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  for (size_t i = 0; i < number_of_msgs; i++) {
+    latest_value->buffers[i].msg = msgs[i];
+    latest_value->buffers[i].sequence_number = 0;
+    atomic_init(ATOMIC_READERS(&latest_value->buffers[i]), 0);
+  }
+  latest_value->number_of_buffers = number_of_msgs;
+  latest_value->allocator = *allocator;
+  atomic_init(ATOMIC_LATEST(latest_value), 0);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_latest_value_fini(rclc_latest_value_t * latest_value)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    latest_value, "latest_value is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (NULL != latest_value->buffers) {
+    latest_value->allocator.deallocate(latest_value->buffers, latest_value->allocator.state);
+  }
+  if (NULL != latest_value->dropped_msg.allocator.deallocate) {
+    if (RMW_RET_OK != rmw_serialized_message_fini(&latest_value->dropped_msg)) {
+      PRINT_RCLC_ERROR(rclc_latest_value_fini, rmw_serialized_message_fini);
+    }
+  }
+  (*latest_value) = rclc_latest_value_get_zero_initialized();
+  return RCL_RET_OK;
+}
+
+const void *
+rclc_latest_value_acquire(
+  rclc_latest_value_t * latest_value,
+  uint64_t * sequence_number)
+{
+  if (NULL == latest_value) {
+    return NULL;
+  }
+  uintptr_t latest = atomic_load(ATOMIC_LATEST(latest_value));
+  while (0 != latest) {
+    rclc_latest_value_buffer_t * buffer = &latest_value->buffers[latest - 1];
+    atomic_fetch_add(ATOMIC_READERS(buffer), 1);
+    uintptr_t current = atomic_load(ATOMIC_LATEST(latest_value));
+    if (current == latest) {
+      if (NULL != sequence_number) {
+        *sequence_number = buffer->sequence_number;
+      }
+      return buffer->msg;
+    }
+    // a newer message was published meanwhile, the executor may reuse this buffer
+    atomic_fetch_sub(ATOMIC_READERS(buffer), 1);
+    latest = current;
+  }
+  return NULL;
+}
+
+rcl_ret_t
+rclc_latest_value_release(
+  rclc_latest_value_t * latest_value,
+  const void * msg)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    latest_value, "latest_value is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    msg, "msg is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  for (size_t i = 0; i < latest_value->number_of_buffers; i++) {
+    if (latest_value->buffers[i].msg == msg) {
+      atomic_fetch_sub(ATOMIC_READERS(&latest_value->buffers[i]), 1);
+      return RCL_RET_OK;
+    }
+  }
+  RCL_SET_ERROR_MSG("msg is not a buffer of latest_value");
+  return RCL_RET_INVALID_ARGUMENT;
+}
+
+rclc_latest_value_buffer_t *
+rclc_latest_value_get_free_buffer(rclc_latest_value_t * latest_value)
+{
+  // only the executor modifies 'latest'
+  uintptr_t latest = atomic_load_explicit(ATOMIC_LATEST(latest_value), memory_order_relaxed);
+  for (size_t i = 0; i < latest_value->number_of_buffers; i++) {
+    if ((i + 1 != latest) &&
+      (0 == atomic_load(ATOMIC_READERS(&latest_value->buffers[i]))))
+    {
+      return &latest_value->buffers[i];
+    }
+  }
+  return NULL;
+}
+
+void
+rclc_latest_value_publish(
+  rclc_latest_value_t * latest_value,
+  rclc_latest_value_buffer_t * buffer)
+{
+  buffer->sequence_number = ++latest_value->sequence_number;
+  atomic_store(ATOMIC_LATEST(latest_value), (uintptr_t) (buffer - latest_value->buffers) + 1);
+}
+
+void *
+rclc_latest_value_get_newest_msg(rclc_latest_value_t * latest_value)
+{
+  uintptr_t latest = atomic_load_explicit(ATOMIC_LATEST(latest_value), memory_order_relaxed);
+  return (0 == latest) ? NULL : latest_value->buffers[latest - 1].msg;
+}
+
+rcl_ret_t
+rclc_latest_value_drop(
+  rclc_latest_value_t * latest_value,
+  const rcl_subscription_t * subscription,
+  rmw_message_info_t * message_info)
+{
+  rcl_ret_t rc = rcl_take_serialized_message(
+    subscription, &latest_value->dropped_msg, message_info, NULL);
+  if (RCL_RET_OK == rc) {
+    latest_value->sequence_number++;
+    latest_value->dropped++;
+  }
+  return rc;
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__LATEST_VALUE_INTERNAL_H_
+#define RCLC__LATEST_VALUE_INTERNAL_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <rclc/latest_value.h>
+
+// The following functions are only called by the executor, which is the
+// single writer of a latest-value slot.
+
+// Returns a buffer which is neither the newest one nor held by a reader,
+// NULL if all buffers are in use.
+rclc_latest_value_buffer_t * rclc_latest_value_get_free_buffer(
+  rclc_latest_value_t * latest_value);
+
+// Publishes the message in 'buffer' as the newest message.
+void rclc_latest_value_publish(
+  rclc_latest_value_t * latest_value,
+  rclc_latest_value_buffer_t * buffer);
+
+// Takes the next message of 'subscription' in serialized form and drops it,
+// if no buffer is free. Returns the result of rcl_take_serialized_message().
+rcl_ret_t rclc_latest_value_drop(
+  rclc_latest_value_t * latest_value,
+  const rcl_subscription_t * subscription,
+  rmw_message_info_t * message_info);
+
+// Returns the newest message without holding it.
+void * rclc_latest_value_get_newest_msg(
+  rclc_latest_value_t * latest_value);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__LATEST_VALUE_INTERNAL_H_
@@ -0,0 +1,217 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclc/logging.h"
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <rcl/error_handling.h>
+
+/// Maximum length of a formatted message
+#define RCLC_LOGGING_ASYNC_MAX_MSG_LEN 256
+
+/// Cell of the ring buffer (D. Vyukov, bounded MPMC queue).
+typedef struct
+{
+  atomic_size_t sequence;
+  int severity;
+  const char * name;
+  const char * format;
+  long args[RCLC_LOGGING_ASYNC_MAX_ARGS];
+} rclc_logging_async_cell_t;
+
+typedef struct
+{
+  rclc_logging_async_cell_t * cells;
+  size_t mask;
+  atomic_size_t enqueue_pos;
+  atomic_size_t dequeue_pos;
+  atomic_size_t dropped;
+  rcl_allocator_t allocator;
+} rclc_logging_async_t;
+
+static rclc_logging_async_t _rclc_logging_async;
+static _Atomic(rclc_logging_async_t *) _rclc_logging_async_sink = NULL;
+
+rcl_ret_t
+rclc_logging_async_init(
+  size_t capacity,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  if (0 == capacity) {
+    RCL_SET_ERROR_MSG("capacity is 0. Must be larger or equal to 1");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (NULL != atomic_load(&_rclc_logging_async_sink)) {
+    RCL_SET_ERROR_MSG("asynchronous log sink is already initialized");
+    return RCL_RET_ALREADY_INIT;
+  }
+
+  size_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  rclc_logging_async_t * sink = &_rclc_logging_async;
+  sink->cells = allocator->allocate(size * sizeof(rclc_logging_async_cell_t), allocator->state);
+  if (NULL == sink->cells) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for log ring buffer.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  for (size_t i = 0; i < size; i++) {
+    atomic_init(&sink->cells[i].sequence, i);
+  }
+  sink->mask = size - 1;
+  sink->allocator = *allocator;
+  atomic_init(&sink->enqueue_pos, 0);
+  atomic_init(&sink->dequeue_pos, 0);
+  atomic_init(&sink->dropped, 0);
+  atomic_store(&_rclc_logging_async_sink, sink);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_logging_async_fini(void)
+{
+  if (NULL == atomic_load(&_rclc_logging_async_sink)) {
+    return RCL_RET_OK;
+  }
+  rclc_logging_async_flush();
+  rclc_logging_async_t * sink = atomic_exchange(&_rclc_logging_async_sink, NULL);
+  sink->allocator.deallocate(sink->cells, sink->allocator.state);
+  sink->cells = NULL;
+  return RCL_RET_OK;
+}
+
+bool
+rclc_logging_async_is_initialized(void)
+{
+  return NULL != atomic_load_explicit(&_rclc_logging_async_sink, memory_order_acquire);
+}
+
+bool
+rclc_logging_async_write(
+  int severity,
+  const char * name,
+  const char * format,
+  ...)
+{
+  rclc_logging_async_t * sink = atomic_load_explicit(
+    &_rclc_logging_async_sink, memory_order_acquire);
+  if (NULL == sink || NULL == format) {
+    return false;
+  }
+
+  // count the conversions, messages with too many arguments or with other
+  // conversions than %ld, %lu and %lx are logged synchronously
+  size_t num_args = 0;
+  for (const char * c = format; *c != '\0'; c++) {
+    if (*c != '%') {
+      continue;
+    }
+    c++;
+    if (*c == '%') {
+      continue;
+    }
+    if (*c != 'l' || (*(c + 1) != 'd' && *(c + 1) != 'u' && *(c + 1) != 'x')) {
+      return false;
+    }
+    c++;
+    num_args++;
+  }
+  if (num_args > RCLC_LOGGING_ASYNC_MAX_ARGS) {
+    return false;
+  }
+
+  rclc_logging_async_cell_t * cell;
+  size_t pos = atomic_load_explicit(&sink->enqueue_pos, memory_order_relaxed);
+  while (true) {
+    cell = &sink->cells[pos & sink->mask];
+    size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+    intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+    if (0 == diff) {
+      if (atomic_compare_exchange_weak_explicit(
+          &sink->enqueue_pos, &pos, pos + 1,
+          memory_order_relaxed, memory_order_relaxed))
+      {
+        break;
+      }
+    } else if (diff < 0) {
+      // ring buffer full
+      atomic_fetch_add_explicit(&sink->dropped, 1, memory_order_relaxed);
+      return true;
+    } else {
+      pos = atomic_load_explicit(&sink->enqueue_pos, memory_order_relaxed);
+    }
+  }
+
+  cell->severity = severity;
+  cell->name = name;
+  cell->format = format;
+  va_list args;
+  va_start(args, format);
+  for (size_t i = 0; i < num_args; i++) {
+    cell->args[i] = va_arg(args, long);
+  }
+  va_end(args);
+  atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+  return true;
+}
+
+size_t
+rclc_logging_async_flush(void)
+{
+  rclc_logging_async_t * sink = atomic_load_explicit(
+    &_rclc_logging_async_sink, memory_order_acquire);
+  if (NULL == sink) {
+    return 0;
+  }
+
+  size_t n = 0;
+  char msg[RCLC_LOGGING_ASYNC_MAX_MSG_LEN];
+  while (true) {
+    size_t pos = atomic_load_explicit(&sink->dequeue_pos, memory_order_relaxed);
+    rclc_logging_async_cell_t * cell = &sink->cells[pos & sink->mask];
+    size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+    if ((intptr_t) seq - (intptr_t) (pos + 1) < 0) {
+      break;
+    }
+
+    if (rcutils_logging_logger_is_enabled_for(cell->name, cell->severity)) {
+      snprintf(
+        msg, sizeof(msg), cell->format,
+        cell->args[0], cell->args[1], cell->args[2], cell->args[3]);
+      rcutils_log(NULL, cell->severity, cell->name, "%s", msg);
+    }
+    atomic_store_explicit(&sink->dequeue_pos, pos + 1, memory_order_relaxed);
+    atomic_store_explicit(&cell->sequence, pos + sink->mask + 1, memory_order_release);
+    n++;
+  }
+  return n;
+}
+
+size_t
+rclc_logging_async_get_dropped(void)
+{
+  rclc_logging_async_t * sink = atomic_load_explicit(
+    &_rclc_logging_async_sink, memory_order_acquire);
+  if (NULL == sink) {
+    return 0;
+  }
+  return atomic_load_explicit(&sink->dropped, memory_order_relaxed);
+}
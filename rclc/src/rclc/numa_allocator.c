@@ -0,0 +1,406 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(__linux__)
+#define RCLC_NUMA_ALLOCATOR_LINUX
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#endif
+
+#include "rclc/numa_allocator.h"
+
+#include <pthread.h>
+#include <string.h>
+
+#ifdef RCLC_NUMA_ALLOCATOR_LINUX
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <rcl/error_handling.h>
+
+#include "rclc/types.h"
+
+// Memory policy of mbind(2), defined here to avoid a dependency on libnuma
+#define RCLC_MPOL_PREFERRED 1
+#define RCLC_MPOL_MF_MOVE (1 << 1)
+// Number of NUMA nodes of the node mask passed to mbind(2)
+#define RCLC_NUMA_MAX_NODES 1024
+
+// Alignment of all blocks, sufficient for any message type
+#define RCLC_NUMA_ALIGNMENT 16u
+
+#define RCLC_NUMA_ALIGN(size) \
+  (((size) + RCLC_NUMA_ALIGNMENT - 1) & ~((size_t) RCLC_NUMA_ALIGNMENT - 1))
+
+// Header of a block of the region. Free blocks are in a list sorted by address,
+// so that adjacent free blocks are merged when a block is deallocated.
+typedef struct rclc_numa_block_t
+{
+  // size of the block including the header
+  size_t size;
+  // next free block, only valid for free blocks
+  struct rclc_numa_block_t * next;
+} rclc_numa_block_t;
+
+#define RCLC_NUMA_HEADER_SIZE RCLC_NUMA_ALIGN(sizeof(rclc_numa_block_t))
+#define RCLC_NUMA_MIN_BLOCK_SIZE (RCLC_NUMA_HEADER_SIZE + RCLC_NUMA_ALIGNMENT)
+
+// State of the allocator, stored at the beginning of its region
+typedef struct
+{
+  pthread_mutex_t mutex;
+  uint8_t * region;
+  size_t size;
+  rclc_numa_block_t * free_list;
+  size_t used;
+  uint64_t fallback_allocations;
+  int numa_node;
+  bool huge_pages;
+  rcl_allocator_t fallback;
+} rclc_numa_allocator_state_t;
+
+rclc_numa_allocator_options_t
+rclc_numa_allocator_get_default_options(void)
+{
+  static rclc_numa_allocator_options_t default_options = {
+    .numa_node = RCLC_NUMA_NODE_CURRENT,
+    .size = 16u * 1024u * 1024u,
+    .huge_pages = true
+  };
+  return default_options;
+}
+
+#ifdef RCLC_NUMA_ALLOCATOR_LINUX
+
+static
+bool
+_rclc_numa_owns(const rclc_numa_allocator_state_t * state, const void * pointer)
+{
+  const uint8_t * p = (const uint8_t *) pointer;
+  return p >= state->region && p < state->region + state->size;
+}
+
+static
+void *
+_rclc_numa_allocate(size_t size, void * state_ptr)
+{
+  rclc_numa_allocator_state_t * state = (rclc_numa_allocator_state_t *) state_ptr;
+  if (size <= state->size) {
+    size_t needed = RCLC_NUMA_HEADER_SIZE + RCLC_NUMA_ALIGN(size > 0 ? size : 1);
+    pthread_mutex_lock(&state->mutex);
+    // first fit
+    rclc_numa_block_t ** link = &state->free_list;
+    while (NULL != *link && (*link)->size < needed) {
+      link = &(*link)->next;
+    }
+    rclc_numa_block_t * block = *link;
+    if (NULL != block) {
+      if (block->size - needed >= RCLC_NUMA_MIN_BLOCK_SIZE) {
+        rclc_numa_block_t * rest = (rclc_numa_block_t *) ((uint8_t *) block + needed);
+        rest->size = block->size - needed;
+        rest->next = block->next;
+        block->size = needed;
+        *link = rest;
+      } else {
+        *link = block->next;
+      }
+      block->next = NULL;
+      state->used += block->size;
+      pthread_mutex_unlock(&state->mutex);
+      return (uint8_t *) block + RCLC_NUMA_HEADER_SIZE;
+    }
+    pthread_mutex_unlock(&state->mutex);
+  }
+  // the region is exhausted
+  void * pointer = state->fallback.allocate(size, state->fallback.state);
+  if (NULL != pointer) {
+    pthread_mutex_lock(&state->mutex);
+    state->fallback_allocations++;
+    pthread_mutex_unlock(&state->mutex);
+  }
+  return pointer;
+}
+
+static
+void
+_rclc_numa_deallocate(void * pointer, void * state_ptr)
+{
+  rclc_numa_allocator_state_t * state = (rclc_numa_allocator_state_t *) state_ptr;
+  if (NULL == pointer) {
+    return;
+  }
+  if (!_rclc_numa_owns(state, pointer)) {
+    state->fallback.deallocate(pointer, state->fallback.state);
+    return;
+  }
+  rclc_numa_block_t * block = (rclc_numa_block_t *) ((uint8_t *) pointer - RCLC_NUMA_HEADER_SIZE);
+  pthread_mutex_lock(&state->mutex);
+  state->used -= block->size;
+  rclc_numa_block_t * previous = NULL;
+  rclc_numa_block_t * next = state->free_list;
+  while (NULL != next && next < block) {
+    previous = next;
+    next = next->next;
+  }
+  // merge with the following block
+  if (NULL != next && (uint8_t *) block + block->size == (uint8_t *) next) {
+    block->size += next->size;
+    block->next = next->next;
+  } else {
+    block->next = next;
+  }
+  // merge with the preceding block
+  if (NULL != previous && (uint8_t *) previous + previous->size == (uint8_t *) block) {
+    previous->size += block->size;
+    previous->next = block->next;
+  } else if (NULL != previous) {
+    previous->next = block;
+  } else {
+    state->free_list = block;
+  }
+  pthread_mutex_unlock(&state->mutex);
+}
+
+static
+void *
+_rclc_numa_reallocate(void * pointer, size_t size, void * state_ptr)
+{
+  rclc_numa_allocator_state_t * state = (rclc_numa_allocator_state_t *) state_ptr;
+  if (NULL == pointer) {
+    return _rclc_numa_allocate(size, state_ptr);
+  }
+  if (!_rclc_numa_owns(state, pointer)) {
+    return state->fallback.reallocate(pointer, size, state->fallback.state);
+  }
+  rclc_numa_block_t * block = (rclc_numa_block_t *) ((uint8_t *) pointer - RCLC_NUMA_HEADER_SIZE);
+  size_t capacity = block->size - RCLC_NUMA_HEADER_SIZE;
+  if (size <= capacity) {
+    return pointer;
+  }
+  void * new_pointer = _rclc_numa_allocate(size, state_ptr);
+  if (NULL == new_pointer) {
+    return NULL;
+  }
+  memcpy(new_pointer, pointer, capacity);
+  _rclc_numa_deallocate(pointer, state_ptr);
+  return new_pointer;
+}
+
+static
+void *
+_rclc_numa_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state_ptr)
+{
+  if (0 != size_of_element && number_of_elements > SIZE_MAX / size_of_element) {
+    return NULL;
+  }
+  size_t size = number_of_elements * size_of_element;
+  void * pointer = _rclc_numa_allocate(size, state_ptr);
+  if (NULL != pointer) {
+    memset(pointer, 0, size);
+  }
+  return pointer;
+}
+
+// Returns the NUMA node of the CPU of the calling thread, -1 if it is unknown.
+static
+int
+_rclc_numa_current_node(void)
+{
+  unsigned int cpu = 0;
+  unsigned int node = 0;
+  if (0 != syscall(SYS_getcpu, &cpu, &node, NULL)) {
+    return -1;
+  }
+  return (int) node;
+}
+
+// Binds the pages of the region to the node, before they are touched the first time.
+static
+bool
+_rclc_numa_bind(void * region, size_t size, int node)
+{
+  if (node < 0 || node >= RCLC_NUMA_MAX_NODES) {
+    return false;
+  }
+  unsigned long nodemask[RCLC_NUMA_MAX_NODES / (8 * sizeof(unsigned long))];
+  memset(nodemask, 0, sizeof(nodemask));
+  nodemask[(size_t) node / (8 * sizeof(unsigned long))] =
+    1UL << ((size_t) node % (8 * sizeof(unsigned long)));
+  return 0 == syscall(
+    SYS_mbind, region, size, RCLC_MPOL_PREFERRED, nodemask,
+    (unsigned long) RCLC_NUMA_MAX_NODES + 1, RCLC_MPOL_MF_MOVE);
+}
+
+rcl_ret_t
+rclc_numa_allocator_init(
+  rcl_allocator_t * allocator,
+  const rclc_numa_allocator_options_t * options)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    allocator, "allocator is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    options, "options is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (0 == options->size) {
+    RCL_SET_ERROR_MSG("size must not be 0");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  size_t page_size = (size_t) sysconf(_SC_PAGESIZE);
+  size_t size = options->size + RCLC_NUMA_ALIGN(sizeof(rclc_numa_allocator_state_t));
+  bool huge_pages = false;
+  void * region = MAP_FAILED;
+  if (options->huge_pages) {
+    size_t huge_size = (size + RCLC_NUMA_ALLOCATOR_HUGE_PAGE_SIZE - 1) &
+      ~((size_t) RCLC_NUMA_ALLOCATOR_HUGE_PAGE_SIZE - 1);
+    region = mmap(
+      NULL, huge_size, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (MAP_FAILED != region) {
+      size = huge_size;
+      huge_pages = true;
+    }
+  }
+  if (MAP_FAILED == region) {
+    size = (size + page_size - 1) & ~(page_size - 1);
+    region = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == region) {
+      RCL_SET_ERROR_MSG("Could not map the memory region.");
+      return RCL_RET_BAD_ALLOC;
+    }
+#ifdef MADV_HUGEPAGE
+    if (options->huge_pages) {
+      // no reserved huge pages, ask for transparent huge pages
+      int rc = madvise(region, size, MADV_HUGEPAGE);
+      RCLC_UNUSED(rc);
+    }
+#endif
+  }
+
+  int node = (RCLC_NUMA_NODE_CURRENT == options->numa_node) ?
+    _rclc_numa_current_node() : options->numa_node;
+  if (!_rclc_numa_bind(region, size, node)) {
+    // no NUMA support, the pages are placed on first touch by this thread
+    node = -1;
+  }
+  // fault in all pages now, so that the executor does not page-fault later
+  memset(region, 0, size);
+
+  rclc_numa_allocator_state_t * state = (rclc_numa_allocator_state_t *) region;
+  if (0 != pthread_mutex_init(&state->mutex, NULL)) {
+    int rc = munmap(region, size);
+    RCLC_UNUSED(rc);
+    RCL_SET_ERROR_MSG("Could not initialize the mutex of the allocator.");
+    return RCL_RET_ERROR;
+  }
+  size_t state_size = RCLC_NUMA_ALIGN(sizeof(rclc_numa_allocator_state_t));
+  state->region = (uint8_t *) region + state_size;
+  state->size = size - state_size;
+  state->free_list = (rclc_numa_block_t *) state->region;
+  state->free_list->size = state->size;
+  state->free_list->next = NULL;
+  state->used = 0;
+  state->fallback_allocations = 0;
+  state->numa_node = node;
+  state->huge_pages = huge_pages;
+  state->fallback = rcl_get_default_allocator();
+
+  allocator->allocate = _rclc_numa_allocate;
+  allocator->deallocate = _rclc_numa_deallocate;
+  allocator->reallocate = _rclc_numa_reallocate;
+  allocator->zero_allocate = _rclc_numa_zero_allocate;
+  allocator->state = state;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_numa_allocator_fini(rcl_allocator_t * allocator)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    allocator, "allocator is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (_rclc_numa_allocate != allocator->allocate || NULL == allocator->state) {
+    RCL_SET_ERROR_MSG("allocator is not a NUMA allocator");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rclc_numa_allocator_state_t * state = (rclc_numa_allocator_state_t *) allocator->state;
+  size_t state_size = RCLC_NUMA_ALIGN(sizeof(rclc_numa_allocator_state_t));
+  pthread_mutex_destroy(&state->mutex);
+  if (0 != munmap(state, state->size + state_size)) {
+    RCL_SET_ERROR_MSG("Could not unmap the memory region.");
+    return RCL_RET_ERROR;
+  }
+  memset(allocator, 0, sizeof(rcl_allocator_t));
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_numa_allocator_get_info(
+  const rcl_allocator_t * allocator,
+  rclc_numa_allocator_info_t * info)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    allocator, "allocator is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    info, "info is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (_rclc_numa_allocate != allocator->allocate || NULL == allocator->state) {
+    RCL_SET_ERROR_MSG("allocator is not a NUMA allocator");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rclc_numa_allocator_state_t * state = (rclc_numa_allocator_state_t *) allocator->state;
+  pthread_mutex_lock(&state->mutex);
+  info->numa_node = state->numa_node;
+  info->size = state->size;
+  info->huge_pages = state->huge_pages;
+  info->used = state->used;
+  info->fallback_allocations = state->fallback_allocations;
+  pthread_mutex_unlock(&state->mutex);
+  return RCL_RET_OK;
+}
+
+#else  // RCLC_NUMA_ALLOCATOR_LINUX
+
+rcl_ret_t
+rclc_numa_allocator_init(
+  rcl_allocator_t * allocator,
+  const rclc_numa_allocator_options_t * options)
+{
+  RCLC_UNUSED(allocator);
+  RCLC_UNUSED(options);
+  RCL_SET_ERROR_MSG("NUMA allocator is only supported on Linux");
+  return RCL_RET_UNSUPPORTED;
+}
+
+rcl_ret_t
+rclc_numa_allocator_fini(rcl_allocator_t * allocator)
+{
+  RCLC_UNUSED(allocator);
+  RCL_SET_ERROR_MSG("NUMA allocator is only supported on Linux");
+  return RCL_RET_UNSUPPORTED;
+}
+
+rcl_ret_t
+rclc_numa_allocator_get_info(
+  const rcl_allocator_t * allocator,
+  rclc_numa_allocator_info_t * info)
+{
+  RCLC_UNUSED(allocator);
+  RCLC_UNUSED(info);
+  RCL_SET_ERROR_MSG("NUMA allocator is only supported on Linux");
+  return RCL_RET_UNSUPPORTED;
+}
+
+#endif  // RCLC_NUMA_ALLOCATOR_LINUX
@@ -19,6 +19,10 @@
 #include <rcl/error_handling.h>
 #include <rcutils/logging_macros.h>
 #include <rmw/qos_profiles.h>
+#include <rmw/rmw.h>
+#include <rmw/serialized_message.h>
+
+#include <string.h>
 
 rcl_ret_t
 rclc_publisher_init_default(
@@ -77,3 +81,129 @@ rclc_publisher_init(
   }
   return rc;
 }
+
+rclc_change_publisher_t
+rclc_change_publisher_get_zero_initialized(void)
+{
+  static rclc_change_publisher_t null_change_publisher = {
+    .publisher = NULL,
+    .type_support = NULL,
+    .last = 0,
+    .has_last = false,
+    .heartbeat_ns = 0,
+    .last_publish_time = 0,
+    .suppressed = 0
+  };
+  return null_change_publisher;
+}
+
+rcl_ret_t
+rclc_change_publisher_init(
+  rclc_change_publisher_t * change_publisher,
+  rcl_publisher_t * publisher,
+  const rosidl_message_type_support_t * type_support,
+  int64_t heartbeat_ns,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    change_publisher, "change_publisher is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    publisher, "publisher is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    type_support, "type_support is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "allocator is invalid", return RCL_RET_INVALID_ARGUMENT);
+  if (heartbeat_ns < 0) {
+    RCL_SET_ERROR_MSG("heartbeat_ns must not be negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  (*change_publisher) = rclc_change_publisher_get_zero_initialized();
+  for (size_t i = 0; i < 2; i++) {
+    change_publisher->serialized_msgs[i] = rmw_get_zero_initialized_serialized_message();
+    if (RMW_RET_OK != rmw_serialized_message_init(
+        &change_publisher->serialized_msgs[i], 0, allocator))
+    {
+      PRINT_RCLC_ERROR(rclc_change_publisher_init, rmw_serialized_message_init);
+      if (1 == i) {
+        (void) rmw_serialized_message_fini(&change_publisher->serialized_msgs[0]);
+      }
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+  change_publisher->publisher = publisher;
+  change_publisher->type_support = type_support;
+  change_publisher->heartbeat_ns = heartbeat_ns;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_change_publisher_publish(
+  rclc_change_publisher_t * change_publisher,
+  const void * ros_message,
+  bool * published)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    change_publisher, "change_publisher is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    ros_message, "ros_message is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (NULL != published) {
+    *published = false;
+  }
+
+  // serialize into the buffer, which does not hold the last published message
+  size_t current = change_publisher->has_last ? 1 - change_publisher->last : 0;
+  rcl_serialized_message_t * serialized_msg = &change_publisher->serialized_msgs[current];
+  if (RMW_RET_OK != rmw_serialize(ros_message, change_publisher->type_support, serialized_msg)) {
+    PRINT_RCLC_ERROR(rclc_change_publisher_publish, rmw_serialize);
+    return RCL_RET_ERROR;
+  }
+
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    PRINT_RCLC_ERROR(rclc_change_publisher_publish, rcutils_steady_time_now);
+    return RCL_RET_ERROR;
+  }
+
+  if (change_publisher->has_last) {
+    const rcl_serialized_message_t * last_msg =
+      &change_publisher->serialized_msgs[change_publisher->last];
+    bool unchanged = (last_msg->buffer_length == serialized_msg->buffer_length) &&
+      (0 == memcmp(last_msg->buffer, serialized_msg->buffer, serialized_msg->buffer_length));
+    bool heartbeat_due = (change_publisher->heartbeat_ns > 0) &&
+      (now - change_publisher->last_publish_time >= change_publisher->heartbeat_ns);
+    if (unchanged && !heartbeat_due) {
+      change_publisher->suppressed++;
+      return RCL_RET_OK;
+    }
+  }
+
+  rcl_ret_t rc = rcl_publish_serialized_message(change_publisher->publisher, serialized_msg, NULL);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_change_publisher_publish, rcl_publish_serialized_message);
+    return rc;
+  }
+  change_publisher->last = current;
+  change_publisher->has_last = true;
+  change_publisher->last_publish_time = now;
+  if (NULL != published) {
+    *published = true;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_change_publisher_fini(rclc_change_publisher_t * change_publisher)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    change_publisher, "change_publisher is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t result = RCL_RET_OK;
+  for (size_t i = 0; i < 2; i++) {
+    if (RMW_RET_OK != rmw_serialized_message_fini(&change_publisher->serialized_msgs[i])) {
+      PRINT_RCLC_ERROR(rclc_change_publisher_fini, rmw_serialized_message_fini);
+      result = RCL_RET_ERROR;
+    }
+  }
+  (*change_publisher) = rclc_change_publisher_get_zero_initialized();
+  return result;
+}
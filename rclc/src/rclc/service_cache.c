@@ -0,0 +1,261 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclc/service_cache.h"
+#include "./service_cache_internal.h"
+
+#include <string.h>
+
+#include <rcl/error_handling.h>
+#include <rcutils/logging_macros.h>
+#include <rmw/rmw.h>
+#include <rmw/serialized_message.h>
+
+#include "rclc/types.h"
+
+// 64 bit FNV-1a hash
+static
+uint64_t
+_rclc_service_cache_hash(const rcl_serialized_message_t * msg)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < msg->buffer_length; i++) {
+    hash ^= msg->buffer[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+static
+rcl_ret_t
+_rclc_service_cache_serialize_request(rclc_service_cache_t * cache, const void * request)
+{
+  if (RMW_RET_OK != rmw_serialize(request, cache->request_type_support, &cache->request)) {
+    PRINT_RCLC_ERROR(rclc_service_cache, rmw_serialize);
+    // an empty request is never stored
+    cache->request.buffer_length = 0;
+    return RCL_RET_ERROR;
+  }
+  cache->request_hash = _rclc_service_cache_hash(&cache->request);
+  return RCL_RET_OK;
+}
+
+// returns the entry of the request in cache->request
+static
+rclc_service_cache_entry_t *
+_rclc_service_cache_find(rclc_service_cache_t * cache)
+{
+  for (size_t i = 0; i < cache->capacity; i++) {
+    rclc_service_cache_entry_t * entry = &cache->entries[i];
+    if (entry->valid && (entry->hash == cache->request_hash) &&
+      (entry->request.buffer_length == cache->request.buffer_length) &&
+      (0 == memcmp(entry->request.buffer, cache->request.buffer, cache->request.buffer_length)))
+    {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+// finalizes a serialized message, which may not have been initialized
+static
+void
+_rclc_service_cache_serialized_message_fini(rcl_serialized_message_t * msg)
+{
+  if (NULL != msg->allocator.deallocate) {
+    if (RMW_RET_OK != rmw_serialized_message_fini(msg)) {
+      PRINT_RCLC_ERROR(rclc_service_cache_fini, rmw_serialized_message_fini);
+    }
+  }
+}
+
+rclc_service_cache_t
+rclc_service_cache_get_zero_initialized(void)
+{
+  static rclc_service_cache_t null_cache = {
+    .request_type_support = NULL,
+    .response_type_support = NULL,
+    .entries = NULL,
+    .capacity = 0,
+    .clock = 0,
+    .request_hash = 0,
+    .hits = 0,
+    .misses = 0
+  };
+  return null_cache;
+}
+
+rcl_ret_t
+rclc_service_cache_init(
+  rclc_service_cache_t * cache,
+  size_t capacity,
+  const rosidl_message_type_support_t * request_type_support,
+  const rosidl_message_type_support_t * response_type_support,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    cache, "cache is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    request_type_support, "request_type_support is a null pointer",
+    return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    response_type_support, "response_type_support is a null pointer",
+    return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "allocator is invalid", return RCL_RET_INVALID_ARGUMENT);
+  if (0 == capacity) {
+    RCL_SET_ERROR_MSG("capacity must be larger than 0");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  (*cache) = rclc_service_cache_get_zero_initialized();
+  cache->entries = allocator->zero_allocate(
+    capacity, sizeof(rclc_service_cache_entry_t), allocator->state);
+  if (NULL == cache->entries) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for 'entries'.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  cache->capacity = capacity;
+  cache->allocator = *allocator;
+
+  // the serialized messages grow on demand
+  rmw_ret_t ret = rmw_serialized_message_init(&cache->request, 0, allocator);
+  for (size_t i = 0; (RMW_RET_OK == ret) && (i < capacity); i++) {
+    ret = rmw_serialized_message_init(&cache->entries[i].request, 0, allocator);
+    if (RMW_RET_OK == ret) {
+      ret = rmw_serialized_message_init(&cache->entries[i].response, 0, allocator);
+    }
+  }
+  if (RMW_RET_OK != ret) {
+    PRINT_RCLC_ERROR(rclc_service_cache_init, rmw_serialized_message_init);
+    (void) rclc_service_cache_fini(cache);
+    return RCL_RET_BAD_ALLOC;
+  }
+  cache->request_type_support = request_type_support;
+  cache->response_type_support = response_type_support;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_service_cache_fini(rclc_service_cache_t * cache)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    cache, "cache is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (NULL != cache->entries) {
+    for (size_t i = 0; i < cache->capacity; i++) {
+      _rclc_service_cache_serialized_message_fini(&cache->entries[i].request);
+      _rclc_service_cache_serialized_message_fini(&cache->entries[i].response);
+    }
+    _rclc_service_cache_serialized_message_fini(&cache->request);
+    cache->allocator.deallocate(cache->entries, cache->allocator.state);
+  }
+  (*cache) = rclc_service_cache_get_zero_initialized();
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_service_cache_clear(rclc_service_cache_t * cache)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    cache, "cache is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  for (size_t i = 0; i < cache->capacity; i++) {
+    cache->entries[i].valid = false;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_service_cache_invalidate(
+  rclc_service_cache_t * cache,
+  const void * request)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    cache, "cache is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    request, "request is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t rc = _rclc_service_cache_serialize_request(cache, request);
+  if (rc != RCL_RET_OK) {
+    return rc;
+  }
+  rclc_service_cache_entry_t * entry = _rclc_service_cache_find(cache);
+  if (NULL != entry) {
+    entry->valid = false;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_service_cache_lookup(
+  rclc_service_cache_t * cache,
+  const void * request,
+  void * response,
+  bool * hit)
+{
+  *hit = false;
+  rcl_ret_t rc = _rclc_service_cache_serialize_request(cache, request);
+  if (rc != RCL_RET_OK) {
+    return rc;
+  }
+  rclc_service_cache_entry_t * entry = _rclc_service_cache_find(cache);
+  if (NULL == entry) {
+    cache->misses++;
+    return RCL_RET_OK;
+  }
+  // may reallocate the strings and sequences of the response with the default allocator
+  if (RMW_RET_OK != rmw_deserialize(&entry->response, cache->response_type_support, response)) {
+    PRINT_RCLC_ERROR(rclc_service_cache_lookup, rmw_deserialize);
+    entry->valid = false;
+    cache->misses++;
+    return RCL_RET_ERROR;
+  }
+  entry->last_used = ++cache->clock;
+  cache->hits++;
+  *hit = true;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_service_cache_store(
+  rclc_service_cache_t * cache,
+  const void * response)
+{
+  // the lookup failed to serialize the request
+  if (0 == cache->request.buffer_length) {
+    return RCL_RET_OK;
+  }
+
+  // replace an empty entry or the least recently used one
+  rclc_service_cache_entry_t * victim = &cache->entries[0];
+  for (size_t i = 0; i < cache->capacity && victim->valid; i++) {
+    rclc_service_cache_entry_t * entry = &cache->entries[i];
+    if (!entry->valid || (entry->last_used < victim->last_used)) {
+      victim = entry;
+    }
+  }
+
+  victim->valid = false;
+  if (RMW_RET_OK != rmw_serialize(response, cache->response_type_support, &victim->response)) {
+    PRINT_RCLC_ERROR(rclc_service_cache_store, rmw_serialize);
+    return RCL_RET_ERROR;
+  }
+  // the serialized request of the lookup moves into the entry without copying
+  rcl_serialized_message_t request = victim->request;
+  victim->request = cache->request;
+  cache->request = request;
+  victim->hash = cache->request_hash;
+  victim->last_used = ++cache->clock;
+  victim->valid = true;
+  return RCL_RET_OK;
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__SERVICE_CACHE_INTERNAL_H_
+#define RCLC__SERVICE_CACHE_INTERNAL_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <rclc/service_cache.h>
+
+// Looks up the response of 'request'. On a hit the cached response is
+// deserialized into 'response'. The serialized request is kept for a
+// following rclc_service_cache_store().
+rcl_ret_t rclc_service_cache_lookup(
+  rclc_service_cache_t * cache,
+  const void * request,
+  void * response,
+  bool * hit);
+
+// Stores 'response' for the request of the last rclc_service_cache_lookup().
+rcl_ret_t rclc_service_cache_store(
+  rclc_service_cache_t * cache,
+  const void * response);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__SERVICE_CACHE_INTERNAL_H_
@@ -0,0 +1,320 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclc/topic_statistics.h"
+#include "./topic_statistics_internal.h"
+
+#include <math.h>
+#include <string.h>
+
+#include <rcl/error_handling.h>
+#include <rcutils/time.h>
+#include <rmw/rmw.h>
+#ifdef RCLC_HAVE_STATISTICS_MSGS
+#include <rosidl_runtime_c/string_functions.h>
+#include <statistics_msgs/msg/statistic_data_type.h>
+#endif
+
+#include "rclc/publisher.h"
+#include "rclc/types.h"
+
+// average, minimum, maximum, standard deviation and sample count, as in rclcpp
+#define RCLC_TOPIC_STATISTICS_DATA_POINTS 5
+
+#define RCLC_TOPIC_STATISTICS_NS_TO_MS(ns) ((ns) / 1e6)
+
+static
+void
+_rclc_topic_statistics_metric_clear(rclc_topic_statistics_metric_t * metric)
+{
+  memset(metric, 0, sizeof(*metric));
+}
+
+static
+void
+_rclc_topic_statistics_metric_add(rclc_topic_statistics_metric_t * metric, double value)
+{
+  metric->count++;
+  double delta = value - metric->mean;
+  metric->mean += delta / (double) metric->count;
+  metric->m2 += delta * (value - metric->mean);
+  if (1 == metric->count || value < metric->min) {
+    metric->min = value;
+  }
+  if (1 == metric->count || value > metric->max) {
+    metric->max = value;
+  }
+}
+
+// Counts the messages missing between the last and the current sequence number
+// of the publisher of the message.
+static
+void
+_rclc_topic_statistics_record_sequence(
+  rclc_topic_statistics_t * stats,
+  const rmw_message_info_t * message_info)
+{
+#ifdef RCLC_HAVE_PUBLICATION_SEQUENCE_NUMBER
+  uint64_t sequence_number = message_info->publication_sequence_number;
+  if (RMW_MESSAGE_INFO_SEQUENCE_NUMBER_UNSUPPORTED == sequence_number) {
+    return;
+  }
+  for (size_t i = 0; i < stats->number_of_sequences; i++) {
+    rclc_topic_statistics_sequence_t * sequence = &stats->sequences[i];
+    if (0 == memcmp(sequence->gid.data, message_info->publisher_gid.data, RMW_GID_STORAGE_SIZE)) {
+      if (sequence_number > sequence->sequence_number) {
+        stats->dropped += sequence_number - sequence->sequence_number - 1;
+        sequence->sequence_number = sequence_number;
+      }
+      return;
+    }
+  }
+  // first message of the publisher, replaces the oldest entry if all are used
+  rclc_topic_statistics_sequence_t * sequence = &stats->sequences[stats->next_sequence];
+  sequence->gid = message_info->publisher_gid;
+  sequence->sequence_number = sequence_number;
+  stats->next_sequence = (stats->next_sequence + 1) % RCLC_TOPIC_STATISTICS_MAX_PUBLISHERS;
+  if (stats->number_of_sequences < RCLC_TOPIC_STATISTICS_MAX_PUBLISHERS) {
+    stats->number_of_sequences++;
+  }
+#else
+  // the message info of this ROS 2 distribution has no sequence numbers
+  RCLC_UNUSED(stats);
+  RCLC_UNUSED(message_info);
+#endif
+}
+
+rclc_topic_statistics_t
+rclc_topic_statistics_get_zero_initialized(void)
+{
+  static rclc_topic_statistics_t null_stats;
+  return null_stats;
+}
+
+rcl_ret_t
+rclc_topic_statistics_init(rclc_topic_statistics_t * stats)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  *stats = rclc_topic_statistics_get_zero_initialized();
+  rcutils_ret_t rc = rcutils_system_time_now(&stats->window_start);
+  RCLC_UNUSED(rc);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_topic_statistics_reset(rclc_topic_statistics_t * stats)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  _rclc_topic_statistics_metric_clear(&stats->period);
+  _rclc_topic_statistics_metric_clear(&stats->age);
+  stats->messages = 0;
+  stats->dropped = 0;
+  rcutils_ret_t rc = rcutils_system_time_now(&stats->window_start);
+  RCLC_UNUSED(rc);
+  return RCL_RET_OK;
+}
+
+double
+rclc_topic_statistics_variance(const rclc_topic_statistics_metric_t * metric)
+{
+  if (NULL == metric || metric->count < 2) {
+    return 0.0;
+  }
+  return metric->m2 / (double) (metric->count - 1);
+}
+
+void
+rclc_topic_statistics_record(
+  rclc_topic_statistics_t * stats,
+  const rmw_message_info_t * message_info)
+{
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_system_time_now(&now)) {
+    return;
+  }
+  stats->messages++;
+
+  rcutils_time_point_value_t arrival =
+    (0 != message_info->received_timestamp) ? message_info->received_timestamp : now;
+  if (0 != stats->last_arrival) {
+    _rclc_topic_statistics_metric_add(&stats->period, (double) (arrival - stats->last_arrival));
+  }
+  stats->last_arrival = arrival;
+
+  if (0 != message_info->source_timestamp) {
+    _rclc_topic_statistics_metric_add(
+      &stats->age, (double) (now - message_info->source_timestamp));
+  }
+
+  _rclc_topic_statistics_record_sequence(stats, message_info);
+}
+
+#ifdef RCLC_HAVE_STATISTICS_MSGS
+rclc_topic_statistics_publisher_t
+rclc_topic_statistics_publisher_get_zero_initialized(void)
+{
+  static rclc_topic_statistics_publisher_t null_publisher;
+  rclc_topic_statistics_publisher_t publisher = null_publisher;
+  publisher.publisher = rcl_get_zero_initialized_publisher();
+  return publisher;
+}
+
+// Initializes a metrics message with the data points of rclcpp.
+static
+bool
+_rclc_topic_statistics_msg_init(
+  statistics_msgs__msg__MetricsMessage * msg,
+  const char * node_name,
+  const char * metrics_source)
+{
+  if (!statistics_msgs__msg__MetricsMessage__init(msg)) {
+    return false;
+  }
+  if (!rosidl_runtime_c__String__assign(&msg->measurement_source_name, node_name) ||
+    !rosidl_runtime_c__String__assign(&msg->metrics_source, metrics_source) ||
+    !rosidl_runtime_c__String__assign(&msg->unit, "ms") ||
+    !statistics_msgs__msg__StatisticDataPoint__Sequence__init(
+      &msg->statistics, RCLC_TOPIC_STATISTICS_DATA_POINTS))
+  {
+    statistics_msgs__msg__MetricsMessage__fini(msg);
+    return false;
+  }
+  msg->statistics.data[0].data_type =
+    statistics_msgs__msg__StatisticDataType__STATISTICS_DATA_TYPE_AVERAGE;
+  msg->statistics.data[1].data_type =
+    statistics_msgs__msg__StatisticDataType__STATISTICS_DATA_TYPE_MINIMUM;
+  msg->statistics.data[2].data_type =
+    statistics_msgs__msg__StatisticDataType__STATISTICS_DATA_TYPE_MAXIMUM;
+  msg->statistics.data[3].data_type =
+    statistics_msgs__msg__StatisticDataType__STATISTICS_DATA_TYPE_STDDEV;
+  msg->statistics.data[4].data_type =
+    statistics_msgs__msg__StatisticDataType__STATISTICS_DATA_TYPE_SAMPLE_COUNT;
+  return true;
+}
+
+rcl_ret_t
+rclc_topic_statistics_publisher_init(
+  rclc_topic_statistics_publisher_t * publisher,
+  rcl_node_t * node,
+  const char * topic_name)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(publisher, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node, RCL_RET_INVALID_ARGUMENT);
+  if (NULL == topic_name) {
+    topic_name = RCLC_TOPIC_STATISTICS_DEFAULT_TOPIC;
+  }
+  const char * node_name = rcl_node_get_name(node);
+  if (NULL == node_name) {
+    RCL_SET_ERROR_MSG("node is not initialized");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  if (!_rclc_topic_statistics_msg_init(&publisher->age_msg, node_name, "message_age")) {
+    RCL_SET_ERROR_MSG("Could not initialize the metrics message.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  if (!_rclc_topic_statistics_msg_init(&publisher->period_msg, node_name, "message_period")) {
+    statistics_msgs__msg__MetricsMessage__fini(&publisher->age_msg);
+    RCL_SET_ERROR_MSG("Could not initialize the metrics message.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  rcl_ret_t ret = rclc_publisher_init_default(
+    &publisher->publisher, node,
+    ROSIDL_GET_MSG_TYPE_SUPPORT(statistics_msgs, msg, MetricsMessage), topic_name);
+  if (RCL_RET_OK != ret) {
+    PRINT_RCLC_ERROR(rclc_topic_statistics_publisher_init, rclc_publisher_init_default);
+    statistics_msgs__msg__MetricsMessage__fini(&publisher->age_msg);
+    statistics_msgs__msg__MetricsMessage__fini(&publisher->period_msg);
+    return RCL_RET_ERROR;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_topic_statistics_publisher_fini(
+  rclc_topic_statistics_publisher_t * publisher,
+  rcl_node_t * node)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(publisher, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = rcl_publisher_fini(&publisher->publisher, node);
+  if (RCL_RET_OK != ret) {
+    PRINT_RCLC_ERROR(rclc_topic_statistics_publisher_fini, rcl_publisher_fini);
+    ret = RCL_RET_ERROR;
+  }
+  statistics_msgs__msg__MetricsMessage__fini(&publisher->age_msg);
+  statistics_msgs__msg__MetricsMessage__fini(&publisher->period_msg);
+  return ret;
+}
+
+static
+void
+_rclc_topic_statistics_time(builtin_interfaces__msg__Time * time, rcutils_time_point_value_t ns)
+{
+  time->sec = (int32_t) (ns / RCUTILS_S_TO_NS(1));
+  time->nanosec = (uint32_t) (ns % RCUTILS_S_TO_NS(1));
+}
+
+// Writes the data points of a metric in nanoseconds in milliseconds.
+static
+void
+_rclc_topic_statistics_msg_fill(
+  statistics_msgs__msg__MetricsMessage * msg,
+  const rclc_topic_statistics_metric_t * metric,
+  rcutils_time_point_value_t window_start,
+  rcutils_time_point_value_t window_stop)
+{
+  _rclc_topic_statistics_time(&msg->window_start, window_start);
+  _rclc_topic_statistics_time(&msg->window_stop, window_stop);
+  statistics_msgs__msg__StatisticDataPoint * data = msg->statistics.data;
+  if (0 == metric->count) {
+    data[0].data = NAN;
+    data[1].data = NAN;
+    data[2].data = NAN;
+    data[3].data = NAN;
+  } else {
+    data[0].data = RCLC_TOPIC_STATISTICS_NS_TO_MS(metric->mean);
+    data[1].data = RCLC_TOPIC_STATISTICS_NS_TO_MS(metric->min);
+    data[2].data = RCLC_TOPIC_STATISTICS_NS_TO_MS(metric->max);
+    data[3].data = RCLC_TOPIC_STATISTICS_NS_TO_MS(sqrt(rclc_topic_statistics_variance(metric)));
+  }
+  data[4].data = (double) metric->count;
+}
+
+rcl_ret_t
+rclc_topic_statistics_publish(
+  rclc_topic_statistics_publisher_t * publisher,
+  rclc_topic_statistics_t * stats)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(publisher, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  rcutils_time_point_value_t now = 0;
+  rcutils_ret_t rc = rcutils_system_time_now(&now);
+  RCLC_UNUSED(rc);
+
+  _rclc_topic_statistics_msg_fill(&publisher->age_msg, &stats->age, stats->window_start, now);
+  _rclc_topic_statistics_msg_fill(
+    &publisher->period_msg, &stats->period, stats->window_start, now);
+  rcl_ret_t ret = rcl_publish(&publisher->publisher, &publisher->age_msg, NULL);
+  if (RCL_RET_OK == ret) {
+    ret = rcl_publish(&publisher->publisher, &publisher->period_msg, NULL);
+  }
+  if (RCL_RET_OK != ret) {
+    PRINT_RCLC_ERROR(rclc_topic_statistics_publish, rcl_publish);
+    return RCL_RET_ERROR;
+  }
+  return rclc_topic_statistics_reset(stats);
+}
+#endif  // RCLC_HAVE_STATISTICS_MSGS
@@ -0,0 +1,35 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLC__TOPIC_STATISTICS_INTERNAL_H_
+#define RCLC__TOPIC_STATISTICS_INTERNAL_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <rclc/topic_statistics.h>
+
+// Updates the statistics with a taken message.
+void rclc_topic_statistics_record(
+  rclc_topic_statistics_t * stats,
+  const rmw_message_info_t * message_info);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__TOPIC_STATISTICS_INTERNAL_H_
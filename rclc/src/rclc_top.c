@@ -0,0 +1,345 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// rclc_top shows the live load of the handles of all rclc executors on this
+// host, which export their statistics with rclc_executor_set_stats_export().
+// It maps the statistics segments read-only and does not use ROS at all.
+//
+// Usage: rclc_top [-d seconds] [-n iterations] [segment ...]
+
+#if !defined(_POSIX_C_SOURCE) && !defined(_GNU_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <dirent.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <rcutils/error_handling.h>
+#include <rcutils/time.h>
+
+#include "rclc/executor_handle.h"
+#include "rclc/executor_stats.h"
+
+#define RCLC_TOP_MAX_EXECUTORS 64
+#define RCLC_TOP_SHM_DIRECTORY "/dev/shm"
+
+/// Snapshot of an executor of the previous refresh
+typedef struct
+{
+  char segment_name[256];
+  rclc_executor_stats_segment_t segment;
+  rclc_executor_stats_handle_t * handles;
+  size_t max_handles;
+  bool seen;
+} rclc_top_executor_t;
+
+static rclc_top_executor_t executors[RCLC_TOP_MAX_EXECUTORS];
+static size_t number_of_executors = 0;
+
+static const char *
+type_name(uint32_t type)
+{
+  switch ((rclc_executor_handle_type_t) type) {
+    case RCLC_SUBSCRIPTION:
+    case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+    case RCLC_SUBSCRIPTION_LATEST_VALUE:
+      return "sub";
+    case RCLC_TIMER:
+      return "timer";
+    case RCLC_CLIENT:
+    case RCLC_CLIENT_WITH_REQUEST_ID:
+      return "client";
+    case RCLC_SERVICE:
+    case RCLC_SERVICE_WITH_REQUEST_ID:
+    case RCLC_SERVICE_WITH_CONTEXT:
+      return "service";
+    case RCLC_ACTION_CLIENT:
+      return "act_cli";
+    case RCLC_ACTION_SERVER:
+      return "act_srv";
+    case RCLC_GUARD_CONDITION:
+      return "guard";
+    case RCLC_DISCOVERY:
+      return "discov";
+    default:
+      return "?";
+  }
+}
+
+static double
+percent(uint64_t part, uint64_t total)
+{
+  return (0 == total) ? 0.0 : 100.0 * (double) part / (double) total;
+}
+
+// Prints the counter columns of a handle, '-' for counters, which are not sampled.
+static void
+print_counters(
+  uint64_t counters,
+  const rclc_executor_stats_handle_t * delta)
+{
+  double calls = (0 == delta->invocations) ? 1.0 : (double) delta->invocations;
+  if ((counters & RCLC_EXECUTOR_STATS_COUNTER_CYCLES) &&
+    (counters & RCLC_EXECUTOR_STATS_COUNTER_INSTRUCTIONS) && delta->cycles > 0)
+  {
+    printf(" %6.2f", (double) delta->instructions / (double) delta->cycles);
+  } else {
+    printf(" %6s", "-");
+  }
+  if (counters & RCLC_EXECUTOR_STATS_COUNTER_CACHE_MISSES) {
+    printf(" %10.1f", (double) delta->cache_misses / calls);
+  } else {
+    printf(" %10s", "-");
+  }
+  if (counters & RCLC_EXECUTOR_STATS_COUNTER_CONTEXT_SWITCHES) {
+    printf(" %8.2f", (double) delta->context_switches / calls);
+  } else {
+    printf(" %8s", "-");
+  }
+}
+
+static rclc_top_executor_t *
+find_executor(const char * segment_name)
+{
+  for (size_t i = 0; i < number_of_executors; i++) {
+    if (0 == strcmp(executors[i].segment_name, segment_name)) {
+      return &executors[i];
+    }
+  }
+  if (number_of_executors == RCLC_TOP_MAX_EXECUTORS) {
+    return NULL;
+  }
+  rclc_top_executor_t * executor = &executors[number_of_executors++];
+  memset(executor, 0, sizeof(*executor));
+  snprintf(executor->segment_name, sizeof(executor->segment_name), "%s", segment_name);
+  return executor;
+}
+
+// Finds the previous statistics of the handle with the given id.
+static const rclc_executor_stats_handle_t *
+find_handle(const rclc_top_executor_t * executor, uint64_t id)
+{
+  for (size_t i = 0; i < executor->segment.number_of_handles && i < executor->max_handles; i++) {
+    if (executor->handles[i].id == id) {
+      return &executor->handles[i];
+    }
+  }
+  return NULL;
+}
+
+static void
+show_executor(const char * segment_name, uint64_t interval_ns)
+{
+  rclc_executor_stats_view_t view = rclc_executor_stats_view_get_zero_initialized();
+  if (RCL_RET_OK != rclc_executor_stats_attach(&view, segment_name)) {
+    return;
+  }
+
+  rclc_executor_stats_segment_t segment;
+  if (RCL_RET_OK != rclc_executor_stats_read_segment(&view, &segment)) {
+    // the executor died while updating the segment
+    rcutils_reset_error();
+    printf("\n%-24s %8s\n", segment_name, "stale");
+    rclc_executor_stats_detach(&view);
+    return;
+  }
+  if (0 != kill((pid_t) segment.pid, 0) && ESRCH == errno) {
+    // left over by a crashed process
+    rclc_executor_stats_detach(&view);
+    return;
+  }
+
+  rclc_top_executor_t * previous = find_executor(segment_name);
+  if (NULL == previous) {
+    rclc_executor_stats_detach(&view);
+    return;
+  }
+  if (previous->max_handles < segment.max_handles) {
+    rclc_executor_stats_handle_t * handles = realloc(
+      previous->handles, segment.max_handles * sizeof(rclc_executor_stats_handle_t));
+    if (NULL == handles) {
+      rclc_executor_stats_detach(&view);
+      return;
+    }
+    previous->handles = handles;
+    previous->max_handles = segment.max_handles;
+  }
+  bool has_previous = previous->seen;
+
+  uint64_t spins = segment.spins - previous->segment.spins;
+  uint64_t wait_ns = segment.wait_time_ns - previous->segment.wait_time_ns;
+  uint64_t take_ns = segment.take_time_ns - previous->segment.take_time_ns;
+  uint64_t execute_ns = segment.execute_time_ns - previous->segment.execute_time_ns;
+  printf(
+    "\n%-24s %8" PRId32 " %10.1f %7.1f %7.1f %7.1f\n",
+    segment.name, segment.pid,
+    has_previous ? (double) spins * 1e9 / (double) interval_ns : 0.0,
+    has_previous ? percent(wait_ns, interval_ns) : 0.0,
+    has_previous ? percent(take_ns, interval_ns) : 0.0,
+    has_previous ? percent(execute_ns, interval_ns) : 0.0);
+  printf(
+    "  %-8s %-32s %10s %9s %9s %9s %9s %7s",
+    "TYPE", "NAME", "CALLS/s", "TAKE_FAIL", "P50[us]", "P99[us]", "MAX[us]", "LOAD%");
+  if (0 != segment.counters) {
+    printf(" %6s %10s %8s", "IPC", "MISS/call", "CSW/call");
+  }
+  printf("\n");
+
+  rclc_executor_stats_handle_t * handles = malloc(
+    (segment.max_handles > 0 ? segment.max_handles : 1) * sizeof(rclc_executor_stats_handle_t));
+  if (NULL == handles) {
+    rclc_executor_stats_detach(&view);
+    return;
+  }
+  for (size_t i = 0; i < segment.number_of_handles && i < segment.max_handles; i++) {
+    rclc_executor_stats_handle_t * handle = &handles[i];
+    if (RCL_RET_OK != rclc_executor_stats_read_handle(&view, i, handle)) {
+      rcutils_reset_error();
+      memset(handle, 0, sizeof(rclc_executor_stats_handle_t));
+      printf("  %-8s %-32s %10s\n", "?", "?", "stale");
+      continue;
+    }
+
+    // statistics of the last interval
+    rclc_executor_stats_handle_t delta = *handle;
+    const rclc_executor_stats_handle_t * old = has_previous ? find_handle(previous, handle->id) :
+      NULL;
+    if (NULL != old) {
+      delta.invocations -= old->invocations;
+      delta.take_failures -= old->take_failures;
+      delta.callback_time_ns -= old->callback_time_ns;
+      for (size_t k = 0; k < RCLC_EXECUTOR_STATS_HISTOGRAM_SIZE; k++) {
+        delta.callback_time_histogram[k] -= old->callback_time_histogram[k];
+      }
+      delta.cycles -= old->cycles;
+      delta.instructions -= old->instructions;
+      delta.cache_misses -= old->cache_misses;
+      delta.context_switches -= old->context_switches;
+    }
+    printf(
+      "  %-8s %-32.32s %10.1f %9" PRIu64 " %9.1f %9.1f %9.1f %7.1f",
+      type_name(handle->type), handle->name,
+      (NULL != old) ? (double) delta.invocations * 1e9 / (double) interval_ns : 0.0,
+      delta.take_failures,
+      (double) rclc_executor_stats_percentile(&delta, 0.5) / 1e3,
+      (double) rclc_executor_stats_percentile(&delta, 0.99) / 1e3,
+      (double) handle->callback_time_max_ns / 1e3,
+      (NULL != old) ? percent(delta.callback_time_ns, interval_ns) : 0.0);
+    if (0 != segment.counters) {
+      print_counters(segment.counters, &delta);
+    }
+    printf("\n");
+  }
+
+  memcpy(
+    previous->handles, handles,
+    segment.number_of_handles * sizeof(rclc_executor_stats_handle_t));
+  previous->segment = segment;
+  previous->seen = true;
+  free(handles);
+  rclc_executor_stats_detach(&view);
+}
+
+static void
+usage(void)
+{
+  fprintf(stderr, "Usage: rclc_top [-d seconds] [-n iterations] [segment ...]\n");
+  fprintf(
+    stderr,
+    "Shows the statistics of all rclc executors exporting them with\n"
+    "rclc_executor_set_stats_export(), or only of the given segments.\n");
+}
+
+int
+main(int argc, char ** argv)
+{
+  double delay = 1.0;
+  long iterations = -1;
+  int opt;
+  while (-1 != (opt = getopt(argc, argv, "d:n:h"))) {
+    switch (opt) {
+      case 'd':
+        delay = atof(optarg);
+        break;
+      case 'n':
+        iterations = atol(optarg);
+        break;
+      default:
+        usage();
+        return 'h' == opt ? 0 : 1;
+    }
+  }
+  if (delay <= 0.0) {
+    usage();
+    return 1;
+  }
+  bool interactive = isatty(STDOUT_FILENO);
+
+  rcutils_time_point_value_t last = 0;
+  rcutils_steady_time_now(&last);
+  for (long n = 0; iterations < 0 || n < iterations; n++) {
+    struct timespec sleep_time;
+    sleep_time.tv_sec = (time_t) delay;
+    sleep_time.tv_nsec = (long) ((delay - (double) sleep_time.tv_sec) * 1e9);
+    if (n > 0) {
+      nanosleep(&sleep_time, NULL);
+    }
+    rcutils_time_point_value_t now = 0;
+    rcutils_steady_time_now(&now);
+    uint64_t interval_ns = (now > last) ? (uint64_t) (now - last) : 1;
+    last = now;
+
+    if (interactive) {
+      printf("\033[H\033[J");
+    }
+    printf(
+      "%-24s %8s %10s %7s %7s %7s\n",
+      "EXECUTOR", "PID", "SPINS/s", "WAIT%", "TAKE%", "EXEC%");
+    if (optind < argc) {
+      for (int i = optind; i < argc; i++) {
+        show_executor(argv[i], interval_ns);
+      }
+    } else {
+      DIR * directory = opendir(RCLC_TOP_SHM_DIRECTORY);
+      if (NULL == directory) {
+        fprintf(stderr, "Could not open " RCLC_TOP_SHM_DIRECTORY ", pass the segment names.\n");
+        return 1;
+      }
+      struct dirent * entry;
+      while (NULL != (entry = readdir(directory))) {
+        if (0 == strncmp(
+            entry->d_name, RCLC_EXECUTOR_STATS_SEGMENT_PREFIX,
+            strlen(RCLC_EXECUTOR_STATS_SEGMENT_PREFIX)))
+        {
+          show_executor(entry->d_name, interval_ns);
+        }
+      }
+      closedir(directory);
+    }
+    fflush(stdout);
+  }
+
+  for (size_t i = 0; i < number_of_executors; i++) {
+    free(executors[i].handles);
+  }
+  return 0;
+}
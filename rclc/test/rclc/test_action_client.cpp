@@ -20,12 +20,16 @@ extern "C"
 #include <rclc/rclc.h>
 #include <rclc/executor.h>
 #include <example_interfaces/action/fibonacci.h>
+#include "rclc/action_client_internal.h"
+#include "rclc/action_goal_handle_internal.h"
 }
 
 #include <chrono>
+#include <cstring>
 #include <thread>
 #include <memory>
 #include <map>
+#include <set>
 #include <vector>
 #include <utility>
 
@@ -915,4 +919,101 @@ TEST_F(ActionClientTest, multi_goal_accept_feedback_and_result) {
 }
 
 
+TEST_F(ActionClientTest, concurrent_goal_accept) {
+  const size_t num_threads = 5;
+  const size_t goals_per_thread = RCLC_MAX_GOALS / num_threads;
+
+  server_handle_goal = [](const rclcpp_action::GoalUUID & /* uuid */,
+      std::shared_ptr<const Fibonacci::Goal>/* goal */) -> rclcpp_action::GoalResponse {
+      return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+    };
+
+  size_t goal_response_count = 0;
+  handle_goal = [&](rclc_action_goal_handle_t * /* goal_handle */, bool accepted,
+      void * /* context */) {
+      EXPECT_TRUE(accepted);
+      goal_response_count++;
+    };
+
+  // send goals from several threads, while the executor is spinning
+  std::vector<example_interfaces__action__Fibonacci_SendGoal_Request> requests(RCLC_MAX_GOALS);
+  std::vector<unique_identifier_msgs__msg__UUID> goal_ids(RCLC_MAX_GOALS);
+  std::vector<rcl_ret_t> results(RCLC_MAX_GOALS, RCL_RET_ERROR);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; t++) {
+    threads.emplace_back(
+      [&, t]() {
+        for (size_t i = t * goals_per_thread; i < (t + 1) * goals_per_thread; i++) {
+          requests[i].goal.order = 10;
+          rclc_action_goal_handle_t * handle = nullptr;
+          results[i] = rclc_action_send_goal_request(&action_client, &requests[i], &handle);
+          if (RCL_RET_OK == results[i]) {
+            goal_ids[i] = handle->goal_id;
+          }
+        }
+      });
+  }
+  for (size_t i = 0; i < 10; i++) {
+    rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  // all goals got a goal handle and a unique goal id
+  std::set<unique_identifier_msgs__msg__UUID> unique_goal_ids;
+  for (size_t i = 0; i < RCLC_MAX_GOALS; i++) {
+    EXPECT_EQ(RCL_RET_OK, results[i]);
+    unique_goal_ids.insert(goal_ids[i]);
+    EXPECT_TRUE(
+      0 == memcmp(requests[i].goal_id.uuid, goal_ids[i].uuid, sizeof(goal_ids[i].uuid)));
+  }
+  EXPECT_EQ(unique_goal_ids.size(), (size_t) RCLC_MAX_GOALS);
+
+  // the pool is exhausted
+  example_interfaces__action__Fibonacci_SendGoal_Request req;
+  req.goal.order = 10;
+  EXPECT_EQ(RCL_RET_ERROR, rclc_action_send_goal_request(&action_client, &req, nullptr));
+  rcutils_reset_error();
+
+  for (size_t i = 0; i < 50 && goal_response_count < RCLC_MAX_GOALS; i++) {
+    rclc_executor_spin_some(&executor, RCL_MS_TO_NS(100));
+  }
+  EXPECT_EQ(goal_response_count, (size_t) RCLC_MAX_GOALS);
+}
+
+TEST_F(ActionClientTest, goal_response_before_goal_handle) {
+  size_t goal_response_count = 0;
+  handle_goal = [&](rclc_action_goal_handle_t * /* goal_handle */, bool accepted,
+      void * /* context */) {
+      EXPECT_FALSE(accepted);
+      goal_response_count++;
+    };
+
+  // the executor took the response, before the sending thread inserted the goal handle
+  rclc_action_client_match_goal_response(&action_client, 1000, false);
+  EXPECT_EQ(action_client.number_of_pending_goal_responses, (size_t) 1);
+  rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+  EXPECT_EQ(action_client.number_of_pending_goal_responses, (size_t) 1);
+  EXPECT_EQ(goal_response_count, (size_t) 0);
+
+  // the response is matched on the next spin after the goal handle is inserted
+  rclc_action_goal_handle_t * handle = rclc_action_take_free_goal_handle(&action_client);
+  ASSERT_NE(handle, nullptr);
+  handle->goal_request_sequence_number = 1000;
+  rclc_action_put_goal_handle_in_list(&action_client.used_goal_handles, handle);
+  rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+  EXPECT_EQ(action_client.number_of_pending_goal_responses, (size_t) 0);
+  EXPECT_EQ(goal_response_count, (size_t) 1);
+
+  // a response without goal handle is dropped after a timeout
+  rclc_action_client_match_goal_response(&action_client, 2000, false);
+  EXPECT_EQ(action_client.number_of_pending_goal_responses, (size_t) 1);
+  std::this_thread::sleep_for(
+    std::chrono::nanoseconds(RCLC_ACTION_CLIENT_PENDING_GOAL_RESPONSE_TIMEOUT_NS));
+  rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+  EXPECT_EQ(action_client.number_of_pending_goal_responses, (size_t) 0);
+  EXPECT_EQ(goal_response_count, (size_t) 1);
+}
+
 // test more than N goals sequentiall
@@ -21,9 +21,12 @@ extern "C"
 #include <rclc/rclc.h>
 #include <rclc/executor.h>
 #include <example_interfaces/action/fibonacci.h>
+#include "rclc/action_goal_handle_internal.h"
 }
 
+#include <atomic>
 #include <chrono>
+#include <cstring>
 #include <thread>
 #include <memory>
 #include <map>
@@ -593,6 +596,146 @@ TEST_F(ActionServerTest, goal_accept_cancel_reject) {
   ASSERT_TRUE(accepted);
 }
 
+TEST_F(ActionServerTest, multi_goal_cancel_all) {
+  // Prepare RCLC
+  size_t num_goals = RCLC_MAX_GOALS / 2;
+  std::atomic<size_t> cancel_calls{0};
+  handle_goal =
+    [&](rclc_action_goal_handle_t * /* goal_handle */, void * /* context */) -> rcl_ret_t {
+      return RCL_RET_ACTION_GOAL_ACCEPTED;
+    };
+
+  handle_cancel = [&](rclc_action_goal_handle_t * /* goal_handle */, void * /* context */) -> bool {
+      cancel_calls++;
+      return true;
+    };
+
+  // Run RCLCPP
+  auto goal_msg = Fibonacci::Goal();
+  goal_msg.order = 10;
+
+  for (size_t i = 0; i < num_goals; i++) {
+    auto goal_handle = action_client->async_send_goal(goal_msg, send_goal_options);
+    ASSERT_EQ(
+      rclcpp::spin_until_future_complete(
+        action_client_node, goal_handle,
+        rclcpp_timeout), rclcpp::FutureReturnCode::SUCCESS);
+  }
+
+  // one request and one response for all goals
+  auto cancel_response = action_client->async_cancel_all_goals();
+  ASSERT_EQ(
+    rclcpp::spin_until_future_complete(
+      action_client_node, cancel_response,
+      rclcpp_timeout), rclcpp::FutureReturnCode::SUCCESS);
+  auto response = cancel_response.get();
+  EXPECT_EQ(response->return_code, action_msgs__srv__CancelGoal_Response__ERROR_NONE);
+  EXPECT_EQ(response->goals_canceling.size(), num_goals);
+  EXPECT_EQ(cancel_calls, num_goals);
+
+  // canceling goals are not canceled again
+  cancel_response = action_client->async_cancel_all_goals();
+  ASSERT_EQ(
+    rclcpp::spin_until_future_complete(
+      action_client_node, cancel_response,
+      rclcpp_timeout), rclcpp::FutureReturnCode::SUCCESS);
+  response = cancel_response.get();
+  EXPECT_EQ(response->return_code, action_msgs__srv__CancelGoal_Response__ERROR_GOAL_TERMINATED);
+  EXPECT_EQ(response->goals_canceling.size(), 0U);
+  EXPECT_EQ(cancel_calls, num_goals);
+}
+
+TEST_F(ActionServerTest, goal_cancel_before_stamp) {
+  // Prepare RCLC
+  handle_goal =
+    [&](rclc_action_goal_handle_t * /* goal_handle */, void * /* context */) -> rcl_ret_t {
+      return RCL_RET_ACTION_GOAL_ACCEPTED;
+    };
+
+  handle_cancel = [&](rclc_action_goal_handle_t * /* goal_handle */, void * /* context */) -> bool {
+      return true;
+    };
+
+  // Run RCLCPP
+  auto goal_msg = Fibonacci::Goal();
+  goal_msg.order = 10;
+
+  auto first_goal = action_client->async_send_goal(goal_msg, send_goal_options);
+  ASSERT_EQ(
+    rclcpp::spin_until_future_complete(
+      action_client_node, first_goal,
+      rclcpp_timeout), rclcpp::FutureReturnCode::SUCCESS);
+  std::this_thread::sleep_for(100ms);
+  rclcpp::Time stamp = rclcpp::Clock(RCL_SYSTEM_TIME).now();
+  std::this_thread::sleep_for(100ms);
+  auto second_goal = action_client->async_send_goal(goal_msg, send_goal_options);
+  ASSERT_EQ(
+    rclcpp::spin_until_future_complete(
+      action_client_node, second_goal,
+      rclcpp_timeout), rclcpp::FutureReturnCode::SUCCESS);
+
+  // only the goal accepted before the stamp is canceled
+  auto cancel_response = action_client->async_cancel_goals_before(stamp);
+  ASSERT_EQ(
+    rclcpp::spin_until_future_complete(
+      action_client_node, cancel_response,
+      rclcpp_timeout), rclcpp::FutureReturnCode::SUCCESS);
+  auto response = cancel_response.get();
+  EXPECT_EQ(response->return_code, action_msgs__srv__CancelGoal_Response__ERROR_NONE);
+  ASSERT_EQ(response->goals_canceling.size(), 1U);
+  EXPECT_EQ(response->goals_canceling[0].goal_id.uuid, first_goal.get()->get_goal_id());
+}
+
+TEST_F(ActionServerTest, goal_cancel_all_before_accept) {
+  // Prepare RCLC
+  std::atomic<size_t> cancel_calls{0};
+  handle_goal =
+    [&](rclc_action_goal_handle_t * /* goal_handle */, void * /* context */) -> rcl_ret_t {
+      return RCL_RET_ACTION_GOAL_ACCEPTED;
+    };
+
+  handle_cancel = [&](rclc_action_goal_handle_t * /* goal_handle */, void * /* context */) -> bool {
+      cancel_calls++;
+      return true;
+    };
+
+  // Run RCLCPP
+  auto goal_msg = Fibonacci::Goal();
+  goal_msg.order = 10;
+  auto accepted_goal = action_client->async_send_goal(goal_msg, send_goal_options);
+  ASSERT_EQ(
+    rclcpp::spin_until_future_complete(
+      action_client_node, accepted_goal,
+      rclcpp_timeout), rclcpp::FutureReturnCode::SUCCESS);
+
+  // a goal request, which has been taken, but not accepted by the goal callback yet
+  rclc_action_goal_handle_t * taken_goal = rclc_action_take_goal_handle(&action_server);
+  ASSERT_NE(taken_goal, nullptr);
+  for (size_t i = 0; i < sizeof(taken_goal->goal_id.uuid); i++) {
+    taken_goal->goal_id.uuid[i] = static_cast<uint8_t>(0xA0 + i);
+  }
+  ASSERT_EQ(taken_goal->status, GOAL_STATE_UNKNOWN);
+
+  // cancel-all selects only the accepted goal
+  auto cancel_response = action_client->async_cancel_all_goals();
+  ASSERT_EQ(
+    rclcpp::spin_until_future_complete(
+      action_client_node, cancel_response,
+      rclcpp_timeout), rclcpp::FutureReturnCode::SUCCESS);
+  auto response = cancel_response.get();
+  EXPECT_EQ(response->return_code, action_msgs__srv__CancelGoal_Response__ERROR_NONE);
+  ASSERT_EQ(response->goals_canceling.size(), 1U);
+  EXPECT_EQ(response->goals_canceling[0].goal_id.uuid, accepted_goal.get()->get_goal_id());
+  for (const auto & goal_info : response->goals_canceling) {
+    EXPECT_NE(
+      0, memcmp(
+        goal_info.goal_id.uuid.data(), taken_goal->goal_id.uuid,
+        sizeof(taken_goal->goal_id.uuid)));
+  }
+  EXPECT_EQ(cancel_calls, 1U);
+  EXPECT_EQ(taken_goal->status, GOAL_STATE_UNKNOWN);
+}
+
 TEST_F(ActionServerTest, multi_goal_accept_feedback_and_result) {
   // Prepare RCLC
   std::vector<std::thread> feedback_thread_pool;
@@ -699,6 +842,72 @@ TEST_F(ActionServerTest, multi_goal_accept_feedback_and_result) {
   ASSERT_EQ(goals.size(), 0U);
 }
 
+TEST_F(ActionServerTest, goal_result_stored_before_request) {
+  // tests with invalid arguments
+  rcl_ret_t rc = rclc_action_server_set_result_storage(
+    nullptr, sizeof(example_interfaces__action__Fibonacci_GetResult_Response), nullptr, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_action_server_set_result_storage(&action_server, 0, nullptr, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_action_server_set_result_storage(
+    &action_server,
+    sizeof(example_interfaces__action__Fibonacci_GetResult_Response),
+    (rclc_action_server_result_copy_t)
+    example_interfaces__action__Fibonacci_GetResult_Response__copy,
+    (rclc_action_server_result_fini_t)
+    example_interfaces__action__Fibonacci_GetResult_Response__fini);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_action_server_set_result_storage(
+    &action_server,
+    sizeof(example_interfaces__action__Fibonacci_GetResult_Response), nullptr, nullptr);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  // the goal is finished in the goal callback, long before the result is requested
+  std::atomic<rcl_ret_t> send_rc{RCL_RET_ERROR};
+  std::atomic<rcl_ret_t> resend_rc{RCL_RET_OK};
+  handle_goal = [&](rclc_action_goal_handle_t * goal_handle, void * /* context */) -> rcl_ret_t {
+      int32_t data[] = {0, 1, 1, 2};
+      example_interfaces__action__Fibonacci_GetResult_Response response;
+      response.result.sequence.capacity = sizeof(data) / sizeof(data[0]);
+      response.result.sequence.size = response.result.sequence.capacity;
+      response.result.sequence.data = data;
+      send_rc = rclc_action_send_result(goal_handle, GOAL_STATE_SUCCEEDED, &response);
+      resend_rc = rclc_action_send_result(goal_handle, GOAL_STATE_SUCCEEDED, &response);
+      rcutils_reset_error();
+      // the stored result is a copy
+      data[3] = 0;
+      return RCL_RET_ACTION_GOAL_ACCEPTED;
+    };
+
+  // Run RCLCPP without requesting the result together with the goal
+  auto goal_msg = Fibonacci::Goal();
+  goal_msg.order = 4;
+  auto goal_handle_future = action_client->async_send_goal(goal_msg, send_goal_options);
+  ASSERT_EQ(
+    rclcpp::spin_until_future_complete(
+      action_client_node, goal_handle_future,
+      rclcpp_timeout), rclcpp::FutureReturnCode::SUCCESS);
+  auto goal_handle = goal_handle_future.get();
+  ASSERT_NE(nullptr, goal_handle);
+  EXPECT_EQ(RCL_RET_OK, send_rc);
+  EXPECT_EQ(RCL_RET_ERROR, resend_rc);
+
+  std::this_thread::sleep_for(200ms);
+  auto result_future = action_client->async_get_result(goal_handle);
+  ASSERT_EQ(
+    rclcpp::spin_until_future_complete(
+      action_client_node, result_future,
+      rclcpp_timeout), rclcpp::FutureReturnCode::SUCCESS);
+  auto result = result_future.get();
+  EXPECT_EQ(result.code, rclcpp_action::ResultCode::SUCCEEDED);
+  std::vector<int32_t> expected = {0, 1, 1, 2};
+  EXPECT_EQ(result.result->sequence, expected);
+}
+
 TEST(Test, rclc_action_server_regression_1) {
   rclc_support_t support;
   rcl_node_t node;
@@ -746,6 +955,114 @@ TEST(Test, rclc_action_server_regression_1) {
   EXPECT_EQ(RCL_RET_OK, rclc_action_server_fini(&action_server, &node));
 }
 
+TEST(Test, rclc_action_server_elastic_goal_handles) {
+  rclc_support_t support;
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rcl_ret_t rc;
+
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_node_init_default(&node, "my_node", "", &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_action_server_t action_server;
+  rc = rclc_action_server_init_default(
+    &action_server,
+    &node,
+    &support,
+    ROSIDL_GET_ACTION_TYPE_SUPPORT(example_interfaces, Fibonacci),
+    "fibonacci"
+  );
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // not added to an executor yet
+  rclc_action_goal_handle_pool_options_t options = {2, 6, RCL_MS_TO_NS(100)};
+  rc = rclc_action_server_set_elastic_goal_handles(&action_server, &options);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  rclc_executor_t executor;
+  rclc_executor_init(&executor, &support.context, 1, &allocator);
+  example_interfaces__action__Fibonacci_SendGoal_Request ros_goal_request[2];
+  std::atomic<size_t> accepted_goals{0};
+  rc = rclc_executor_add_action_server(
+    &executor,
+    &action_server,
+    2,
+    ros_goal_request,
+    sizeof(example_interfaces__action__Fibonacci_SendGoal_Request),
+    [](rclc_action_goal_handle_t * /* goal_handle */, void * context) -> rcl_ret_t {
+      (*static_cast<std::atomic<size_t> *>(context))++;
+      return RCL_RET_ACTION_GOAL_ACCEPTED;
+    },
+    [](rclc_action_goal_handle_t * /* goal_handle */, void * /* context */) -> bool {
+      return false;
+    },
+    &accepted_goals);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // tests with invalid arguments
+  rc = rclc_action_server_set_elastic_goal_handles(nullptr, &options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_action_server_set_elastic_goal_handles(&action_server, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rclc_action_goal_handle_pool_options_t invalid_options = {0, 6, 0};
+  rc = rclc_action_server_set_elastic_goal_handles(&action_server, &invalid_options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  invalid_options = {2, 3, 0};
+  rc = rclc_action_server_set_elastic_goal_handles(&action_server, &invalid_options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_action_server_set_elastic_goal_handles(&action_server, &options);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_action_server_set_elastic_goal_handles(&action_server, &options);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  std::atomic<bool> run_server{true};
+  std::thread server_thread(
+    [&]() {
+      while (run_server) {
+        rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+      }
+    });
+
+  // the pool grows from 2 to 6 goal handles, further goals wait for a free goal handle
+  rclcpp::init(0, NULL);
+  auto action_client_node = rclcpp::Node::make_shared("action_aux_client");
+  auto action_client = rclcpp_action::create_client<Fibonacci>(action_client_node, "fibonacci");
+  EXPECT_TRUE(action_client->wait_for_action_server(std::chrono::seconds(10)));
+  auto goal_msg = Fibonacci::Goal();
+  goal_msg.order = 10;
+  for (size_t i = 0; i < 8; i++) {
+    action_client->async_send_goal(goal_msg);
+  }
+  for (size_t i = 0; i < 100 && accepted_goals < 6; i++) {
+    rclcpp::spin_some(action_client_node);
+    std::this_thread::sleep_for(10ms);
+  }
+  std::this_thread::sleep_for(200ms);
+  EXPECT_EQ(accepted_goals, 6U);
+
+  // clean up
+  run_server = false;
+  server_thread.join();
+  rclcpp::shutdown();
+  rc = rclc_action_server_fini(&action_server, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
+
 int main(int args, char ** argv)
 {
   ::testing::InitGoogleTest(&args, argv);
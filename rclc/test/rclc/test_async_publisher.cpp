@@ -0,0 +1,255 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <rclc/rclc.h>
+#include <rclc/async_publisher.h>
+#include <rclc/executor.h>
+#include <std_msgs/msg/int32.h>
+
+#include "rcl/error_handling.h"
+
+#define NUMBER_OF_MSGS 4
+
+static unsigned int async_callback_cnt = 0;
+static int32_t async_last_data = -1;
+static bool async_in_order = true;
+
+static void async_callback(const void * msgin)
+{
+  const std_msgs__msg__Int32 * msg = (const std_msgs__msg__Int32 *) msgin;
+  if (NULL != msg) {
+    if (msg->data <= async_last_data) {
+      async_in_order = false;
+    }
+    async_last_data = msg->data;
+    async_callback_cnt++;
+  }
+}
+
+static bool copy_int32(const void * input, void * output)
+{
+  return std_msgs__msg__Int32__copy(
+    (const std_msgs__msg__Int32 *) input, (std_msgs__msg__Int32 *) output);
+}
+
+TEST(Test, rclc_async_publisher_init_fini) {
+  rclc_support_t support;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_ret_t rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_async_publisher_node", "", &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32);
+  rc = rclc_publisher_init_default(&publisher, &node, type_support, "async_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  std_msgs__msg__Int32 storage[NUMBER_OF_MSGS];
+  void * msgs[NUMBER_OF_MSGS];
+  for (size_t i = 0; i < NUMBER_OF_MSGS; i++) {
+    std_msgs__msg__Int32__init(&storage[i]);
+    msgs[i] = &storage[i];
+  }
+
+  // tests with invalid arguments
+  rclc_async_publisher_t async_publisher = rclc_async_publisher_get_zero_initialized();
+  rc = rclc_async_publisher_init(
+    nullptr, &publisher, msgs, NUMBER_OF_MSGS, copy_int32,
+    RCLC_ASYNC_PUBLISHER_BLOCK, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_async_publisher_init(
+    &async_publisher, nullptr, msgs, NUMBER_OF_MSGS, copy_int32,
+    RCLC_ASYNC_PUBLISHER_BLOCK, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_async_publisher_init(
+    &async_publisher, &publisher, nullptr, NUMBER_OF_MSGS, copy_int32,
+    RCLC_ASYNC_PUBLISHER_BLOCK, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_async_publisher_init(
+    &async_publisher, &publisher, msgs, 1, copy_int32,
+    RCLC_ASYNC_PUBLISHER_BLOCK, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  std_msgs__msg__Int32 msg;
+  std_msgs__msg__Int32__init(&msg);
+  rc = rclc_async_publisher_publish(&async_publisher, &msg, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  // without copy function only publish_move is possible
+  rc = rclc_async_publisher_init(
+    &async_publisher, &publisher, msgs, NUMBER_OF_MSGS, nullptr,
+    RCLC_ASYNC_PUBLISHER_BLOCK, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  bool queued = true;
+  rc = rclc_async_publisher_publish(&async_publisher, &msg, &queued);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  EXPECT_FALSE(queued);
+  rcutils_reset_error();
+  rc = rclc_async_publisher_publish_move(&async_publisher, nullptr, &queued);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_async_publisher_fini(&async_publisher);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(async_publisher.worker, nullptr);
+  rc = rclc_async_publisher_fini(nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  // clean up
+  std_msgs__msg__Int32__fini(&msg);
+  for (size_t i = 0; i < NUMBER_OF_MSGS; i++) {
+    std_msgs__msg__Int32__fini(&storage[i]);
+  }
+  rc = rcl_publisher_fini(&publisher, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
+
+TEST(Test, rclc_async_publisher_publish) {
+  rclc_support_t support;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_ret_t rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_async_publisher_node", "", &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  const rosidl_message_type_support_t * type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rc = rclc_publisher_init_default(&publisher, &node, type_support, "async_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rc = rclc_subscription_init_default(&subscription, &node, type_support, "async_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &support.context, 1, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  std_msgs__msg__Int32 sub_msg;
+  std_msgs__msg__Int32__init(&sub_msg);
+  rc = rclc_executor_add_subscription(
+    &executor, &subscription, &sub_msg, &async_callback, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  // wait for discovery
+  for (unsigned int k = 0; k < 10; k++) {
+    rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+  }
+
+  std_msgs__msg__Int32 storage[NUMBER_OF_MSGS];
+  void * msgs[NUMBER_OF_MSGS];
+  for (size_t i = 0; i < NUMBER_OF_MSGS; i++) {
+    std_msgs__msg__Int32__init(&storage[i]);
+    msgs[i] = &storage[i];
+  }
+  rclc_async_publisher_t async_publisher = rclc_async_publisher_get_zero_initialized();
+  rc = rclc_async_publisher_init(
+    &async_publisher, &publisher, msgs, NUMBER_OF_MSGS, copy_int32,
+    RCLC_ASYNC_PUBLISHER_BLOCK, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // copied messages
+  std_msgs__msg__Int32 pub_msg;
+  std_msgs__msg__Int32__init(&pub_msg);
+  async_callback_cnt = 0;
+  async_last_data = -1;
+  async_in_order = true;
+  bool queued = false;
+  for (int32_t i = 0; i < 5; i++) {
+    pub_msg.data = i;
+    rc = rclc_async_publisher_publish(&async_publisher, &pub_msg, &queued);
+    EXPECT_EQ(RCL_RET_OK, rc);
+    EXPECT_TRUE(queued);
+  }
+
+  // moved message: a message of the queue is returned
+  std_msgs__msg__Int32 move_msg;
+  std_msgs__msg__Int32__init(&move_msg);
+  move_msg.data = 5;
+  void * move_ptr = &move_msg;
+  rc = rclc_async_publisher_publish_move(&async_publisher, &move_ptr, &queued);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_TRUE(queued);
+  EXPECT_NE(move_ptr, &move_msg);
+
+  for (unsigned int k = 0; k < 100 && async_callback_cnt < 6; k++) {
+    rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+  }
+  EXPECT_EQ(async_callback_cnt, (unsigned int) 6);
+  EXPECT_TRUE(async_in_order);
+  EXPECT_EQ(async_last_data, 5);
+  rclc_async_publisher_statistics_t statistics;
+  rc = rclc_async_publisher_get_statistics(&async_publisher, &statistics);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(statistics.published, (uint64_t) 6);
+  EXPECT_EQ(statistics.dropped, (uint64_t) 0);
+  EXPECT_EQ(statistics.errors, (uint64_t) 0);
+  EXPECT_EQ(statistics.queued, (size_t) 0);
+
+  // the moved message is owned by the async publisher until fini
+  rc = rclc_async_publisher_fini(&async_publisher);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  size_t owned = 0;
+  for (size_t i = 0; i < NUMBER_OF_MSGS; i++) {
+    if (msgs[i] == &move_msg) {
+      owned++;
+    }
+  }
+  EXPECT_EQ(owned, (size_t) 1);
+
+  // drop the newest messages of a full queue
+  rc = rclc_async_publisher_init(
+    &async_publisher, &publisher, msgs, NUMBER_OF_MSGS, copy_int32,
+    RCLC_ASYNC_PUBLISHER_DROP_NEWEST, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  for (int32_t i = 0; i < 100; i++) {
+    pub_msg.data = i;
+    rc = rclc_async_publisher_publish(&async_publisher, &pub_msg, nullptr);
+    EXPECT_EQ(RCL_RET_OK, rc);
+  }
+  do {
+    rc = rclc_async_publisher_get_statistics(&async_publisher, &statistics);
+    EXPECT_EQ(RCL_RET_OK, rc);
+  } while (statistics.queued > 0);
+  EXPECT_EQ(statistics.published + statistics.dropped + statistics.errors, (uint64_t) 100);
+  rc = rclc_async_publisher_fini(&async_publisher);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // clean up
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  std_msgs__msg__Int32__fini(&pub_msg);
+  std_msgs__msg__Int32__fini(&sub_msg);
+  for (size_t i = 0; i < NUMBER_OF_MSGS; i++) {
+    std_msgs__msg__Int32__fini(static_cast<std_msgs__msg__Int32 *>(msgs[i]));
+  }
+  std_msgs__msg__Int32__fini(static_cast<std_msgs__msg__Int32 *>(move_ptr));
+  rc = rcl_subscription_fini(&subscription, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_publisher_fini(&publisher, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
@@ -0,0 +1,230 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+#include <std_msgs/msg/int32.h>
+
+#include "rcl/error_handling.h"
+
+// sense (timer) -> plan (subscription a) -> act (subscription b) -> output
+static rclc_chain_tracer_t chain_tracer;
+static rcl_publisher_t publisher_a;
+static rcl_publisher_t publisher_b;
+static rcl_publisher_t publisher_out;
+static unsigned int out_cnt = 0;
+
+static void sense_callback(rcl_timer_t * timer, int64_t last_call_time)
+{
+  RCLC_UNUSED(last_call_time);
+  if (NULL != timer) {
+    std_msgs__msg__Int32 msg;
+    msg.data = 1;
+    rcl_ret_t rc = rclc_chain_tracer_publish(&chain_tracer, &publisher_a, &msg, NULL);
+    EXPECT_EQ(RCL_RET_OK, rc);
+  }
+}
+
+static void plan_callback(const void * msgin)
+{
+  if (NULL != msgin) {
+    const std_msgs__msg__Int32 * msg = (const std_msgs__msg__Int32 *) msgin;
+    std_msgs__msg__Int32 out;
+    out.data = msg->data + 1;
+    rcl_ret_t rc = rclc_chain_tracer_publish(&chain_tracer, &publisher_b, &out, NULL);
+    EXPECT_EQ(RCL_RET_OK, rc);
+  }
+}
+
+static void act_callback(const void * msgin)
+{
+  if (NULL != msgin) {
+    const std_msgs__msg__Int32 * msg = (const std_msgs__msg__Int32 *) msgin;
+    std_msgs__msg__Int32 out;
+    out.data = msg->data + 1;
+    rcl_ret_t rc = rclc_chain_tracer_publish(&chain_tracer, &publisher_out, &out, NULL);
+    EXPECT_EQ(RCL_RET_OK, rc);
+    out_cnt++;
+  }
+}
+
+TEST(Test, rclc_chain_tracer_init_fini) {
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rclc_chain_tracer_t tracer = rclc_chain_tracer_get_zero_initialized();
+  rcl_ret_t rc = rclc_chain_tracer_init(nullptr, 10, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_chain_tracer_init(&tracer, 0, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_chain_tracer_init(&tracer, 10, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_chain_tracer_init(&tracer, 10, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(tracer.capacity, (size_t) 10);
+  EXPECT_EQ(tracer.number_of_events, (uint64_t) 0);
+
+  // no events, no chains
+  rclc_chain_tracer_histogram_t histogram;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rc = rclc_chain_tracer_analyze(&tracer, &publisher, &publisher, &histogram);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(histogram.count, (uint64_t) 0);
+  rc = rclc_chain_tracer_analyze(&tracer, nullptr, &publisher, &histogram);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_chain_tracer_fini(&tracer);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(tracer.events, nullptr);
+  rc = rclc_chain_tracer_fini(nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+}
+
+TEST(Test, rclc_chain_tracer_percentile) {
+  rclc_chain_tracer_histogram_t histogram = {};
+  EXPECT_EQ(rclc_chain_tracer_percentile(&histogram, 0.5), (uint64_t) 0);
+  EXPECT_EQ(rclc_chain_tracer_percentile(nullptr, 0.5), (uint64_t) 0);
+
+  // 9 chains in [0.5ms, 1ms), 1 chain in [8ms, 16ms)
+  histogram.count = 10;
+  histogram.buckets[20] = 9;
+  histogram.buckets[24] = 1;
+  histogram.max_ns = 10000000;
+  EXPECT_EQ(rclc_chain_tracer_percentile(&histogram, 0.5), (uint64_t) 1 << 20);
+  EXPECT_EQ(rclc_chain_tracer_percentile(&histogram, 0.99), (uint64_t) 10000000);
+}
+
+TEST(Test, rclc_chain_tracer_sense_plan_act) {
+  rclc_support_t support;
+  rcl_ret_t rc;
+
+  // preliminary setup
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_chain_tracer_node", "", &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  const rosidl_message_type_support_t * type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32);
+
+  publisher_a = rcl_get_zero_initialized_publisher();
+  rc = rclc_publisher_init_default(&publisher_a, &node, type_support, "chain_a");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  publisher_b = rcl_get_zero_initialized_publisher();
+  rc = rclc_publisher_init_default(&publisher_b, &node, type_support, "chain_b");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  publisher_out = rcl_get_zero_initialized_publisher();
+  rc = rclc_publisher_init_default(&publisher_out, &node, type_support, "chain_out");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_subscription_t subscription_a = rcl_get_zero_initialized_subscription();
+  rc = rclc_subscription_init_default(&subscription_a, &node, type_support, "chain_a");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_subscription_t subscription_b = rcl_get_zero_initialized_subscription();
+  rc = rclc_subscription_init_default(&subscription_b, &node, type_support, "chain_b");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  rc = rclc_timer_init_default(&timer, &support, RCL_MS_TO_NS(20), sense_callback);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  chain_tracer = rclc_chain_tracer_get_zero_initialized();
+  rc = rclc_chain_tracer_init(&chain_tracer, 1000, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &support.context, 3, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  std_msgs__msg__Int32 msg_a;
+  std_msgs__msg__Int32 msg_b;
+  rc = rclc_executor_add_timer(&executor, &timer);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_add_subscription(
+    &executor, &subscription_a, &msg_a, &plan_callback, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_add_subscription(
+    &executor, &subscription_b, &msg_b, &act_callback, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // tests with invalid arguments
+  rc = rclc_executor_set_chain_tracer(nullptr, &chain_tracer);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rclc_executor_t uninitialized_executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_set_chain_tracer(&uninitialized_executor, &chain_tracer);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  rclc_chain_tracer_t uninitialized_tracer = rclc_chain_tracer_get_zero_initialized();
+  rc = rclc_executor_set_chain_tracer(&executor, &uninitialized_tracer);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_set_chain_tracer(&executor, &chain_tracer);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  out_cnt = 0;
+  for (unsigned int k = 0; k < 500 && out_cnt < 5; k++) {
+    rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+  }
+  ASSERT_GE(out_cnt, (unsigned int) 5);
+  rc = rclc_executor_set_chain_tracer(&executor, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // every output was caused by the timer and by a message of subscription a
+  rclc_chain_tracer_histogram_t histogram;
+  rc = rclc_chain_tracer_analyze(&chain_tracer, &timer, &publisher_out, &histogram);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(histogram.count, (uint64_t) out_cnt);
+  EXPECT_LE(histogram.min_ns, histogram.max_ns);
+  EXPECT_LE(rclc_chain_tracer_percentile(&histogram, 0.5), histogram.max_ns);
+
+  rclc_chain_tracer_histogram_t histogram_a;
+  rc = rclc_chain_tracer_analyze(&chain_tracer, &subscription_a, &publisher_out, &histogram_a);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(histogram_a.count, (uint64_t) out_cnt);
+  // the chain from subscription a is a part of the chain from the timer
+  EXPECT_LE(histogram_a.sum_ns, histogram.sum_ns);
+
+  // subscription b is not caused by the output
+  rc = rclc_chain_tracer_analyze(&chain_tracer, &subscription_b, &publisher_a, &histogram);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(histogram.count, (uint64_t) 0);
+
+  // clean up
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_chain_tracer_fini(&chain_tracer);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_timer_fini(&timer);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_subscription_fini(&subscription_b, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_subscription_fini(&subscription_a, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_publisher_fini(&publisher_out, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_publisher_fini(&publisher_b, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_publisher_fini(&publisher_a, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
@@ -0,0 +1,185 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <rclc/rclc.h>
+#include <rclc/component.h>
+#include <rclc/executor.h>
+#include <std_msgs/msg/int32.h>
+#include <test_msgs/srv/basic_types.h>
+
+#include "rcl/error_handling.h"
+
+static unsigned int component_callback_cnt = 0;
+
+static void component_callback(const void * msgin)
+{
+  if (NULL != msgin) {
+    component_callback_cnt++;
+  }
+}
+
+TEST(Test, rclc_component_init_fini) {
+  rclc_support_t support;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_ret_t rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_component_node", "", &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // tests with invalid arguments
+  rclc_component_t component = rclc_component_get_zero_initialized();
+  rc = rclc_component_init(nullptr, "camera", &node, 2, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_component_init(&component, nullptr, &node, 2, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_component_init(&component, "camera", nullptr, 2, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  const char * invalid_names[] = {"", "/camera", "camera/", "1camera", "cam//era", "cam-era"};
+  for (const char * name : invalid_names) {
+    rc = rclc_component_init(&component, name, &node, 2, &allocator);
+    EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc) << name;
+    rcutils_reset_error();
+  }
+
+  rc = rclc_component_init(&component, "arm/left", &node, 2, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_STREQ(component.name, "arm/left");
+  EXPECT_EQ(component.number_of_entities, (size_t) 0);
+  rc = rclc_component_fini(&component);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(component.name, nullptr);
+  rc = rclc_component_fini(nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  // clean up
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
+
+TEST(Test, rclc_component_entities) {
+  rclc_support_t support;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_ret_t rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_component_node", "robot", &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  const rosidl_message_type_support_t * type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32);
+  const rosidl_service_type_support_t * service_type_support =
+    ROSIDL_GET_SRV_TYPE_SUPPORT(test_msgs, srv, BasicTypes);
+
+  // two components on one node
+  rclc_component_t camera = rclc_component_get_zero_initialized();
+  rc = rclc_component_init(&camera, "camera", &node, 4, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rclc_component_t detector = rclc_component_get_zero_initialized();
+  rc = rclc_component_init(&detector, "detector", &node, 3, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rc = rclc_component_publisher_init(&publisher, &camera, type_support, "image", nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_STREQ(rcl_publisher_get_topic_name(&publisher), "/robot/camera/image");
+  rcl_publisher_t private_publisher = rcl_get_zero_initialized_publisher();
+  rc = rclc_component_publisher_init(
+    &private_publisher, &camera, type_support, "~/status", nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_STREQ(
+    rcl_publisher_get_topic_name(&private_publisher),
+    "/robot/test_component_node/camera/status");
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rc = rclc_component_service_init(&service, &camera, service_type_support, "add", nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_STREQ(rcl_service_get_service_name(&service), "/robot/camera/add");
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  rc = rclc_component_timer_init(&timer, &camera, &support, RCL_MS_TO_NS(100), nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(camera.number_of_entities, (size_t) 4);
+
+  // no space left
+  rcl_publisher_t publisher_too_many = rcl_get_zero_initialized_publisher();
+  rc = rclc_component_publisher_init(
+    &publisher_too_many, &camera, type_support, "too_many", nullptr);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  // absolute names are not changed
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rc = rclc_component_subscription_init(
+    &subscription, &detector, type_support, "/robot/camera/image", nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_STREQ(rcl_subscription_get_topic_name(&subscription), "/robot/camera/image");
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rc = rclc_component_client_init(&client, &detector, service_type_support, "add", nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_STREQ(rcl_client_get_service_name(&client), "/robot/detector/add");
+
+  // the components communicate through the node
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &support.context, 3, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  std_msgs__msg__Int32 sub_msg;
+  rc = rclc_executor_add_subscription(
+    &executor, &subscription, &sub_msg, &component_callback, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_add_timer(&executor, &timer);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  std_msgs__msg__Int32 pub_msg;
+  pub_msg.data = 1;
+  component_callback_cnt = 0;
+  rc = rcl_publish(&publisher, &pub_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  for (unsigned int k = 0; k < 20 && component_callback_cnt < 1; k++) {
+    rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+  }
+  EXPECT_EQ(component_callback_cnt, (unsigned int) 1);
+
+  // removing a component removes only its handles
+  rc = rclc_component_remove_from_executor(&detector, &executor);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(executor.index, (size_t) 1);
+  EXPECT_EQ(executor.handles[0].timer, &timer);
+  rc = rclc_component_remove_from_executor(&camera, &executor);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(executor.index, (size_t) 0);
+  rc = rclc_component_remove_from_executor(&camera, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  // clean up
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_component_fini(&detector);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_FALSE(rcl_subscription_is_valid(&subscription));
+  rcutils_reset_error();
+  rc = rclc_component_fini(&camera);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_FALSE(rcl_publisher_is_valid(&publisher));
+  rcutils_reset_error();
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
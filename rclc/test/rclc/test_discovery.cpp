@@ -0,0 +1,169 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+#include <std_msgs/msg/int32.h>
+#include "test_msgs/srv/basic_types.h"
+#include "rcl/error_handling.h"
+
+static unsigned int discovery_cnt = 0;
+
+static void discovery_callback(void * context)
+{
+  unsigned int * cnt = static_cast<unsigned int *>(context);
+  (*cnt)++;
+}
+
+TEST(Test, rclc_discovery_init) {
+  rclc_support_t support;
+  rcl_ret_t rc;
+
+  // preliminary setup
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_discovery_node", "", &support);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rc = rclc_publisher_init_default(
+    &publisher, &node, ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32),
+    "discovery_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rc = rclc_client_init_default(
+    &client, &node, ROSIDL_GET_SRV_TYPE_SUPPORT(test_msgs, srv, BasicTypes),
+    "discovery_service");
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_discovery_t discovery = rclc_discovery_get_zero_initialized();
+
+  // tests with invalid arguments
+  rc = rclc_discovery_init_service_server(nullptr, &node, &client);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_discovery_init_service_server(&discovery, nullptr, &client);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_discovery_init_service_server(&discovery, &node, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_discovery_init_action_server(&discovery, &node, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_discovery_init_subscriptions(&discovery, &node, nullptr, 1);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_discovery_init_subscriptions(&discovery, &node, &publisher, 0);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_discovery_wait(nullptr, &support.context, 0, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  // no service server available
+  rc = rclc_discovery_init_service_server(&discovery, &node, &client);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_discovery_wait(&discovery, &support.context, RCL_MS_TO_NS(100), &allocator);
+  EXPECT_EQ(RCL_RET_TIMEOUT, rc);
+  EXPECT_FALSE(discovery.matched);
+
+  // wait for a subscription
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rc = rclc_subscription_init_default(
+    &subscription, &node, ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32),
+    "discovery_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_discovery_init_subscriptions(&discovery, &node, &publisher, 1);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_discovery_wait(&discovery, &support.context, RCL_MS_TO_NS(5000), &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_TRUE(discovery.matched);
+
+  // clean up
+  rc = rcl_subscription_fini(&subscription, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_client_fini(&client, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_publisher_fini(&publisher, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
+
+TEST(Test, rclc_executor_discovery) {
+  rclc_support_t support;
+  rcl_ret_t rc;
+
+  // preliminary setup
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_executor_discovery_node", "", &support);
+  const rosidl_service_type_support_t * type_support =
+    ROSIDL_GET_SRV_TYPE_SUPPORT(test_msgs, srv, BasicTypes);
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rc = rclc_client_init_default(&client, &node, type_support, "executor_discovery_service");
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &support.context, 1, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_discovery_t discovery = rclc_discovery_get_zero_initialized();
+  rc = rclc_discovery_init_service_server(&discovery, &node, &client);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_add_discovery(&executor, &discovery, nullptr, &discovery_cnt);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_add_discovery(&executor, &discovery, &discovery_callback, &discovery_cnt);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(executor.info.number_of_guard_conditions, (size_t) 1);
+
+  // no server: callback is not called
+  discovery_cnt = 0;
+  rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+  EXPECT_EQ(discovery_cnt, (unsigned int) 0);
+
+  // server appears: callback is called exactly once
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rc = rclc_service_init_default(&service, &node, type_support, "executor_discovery_service");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  for (unsigned int i = 0; i < 50 && 0 == discovery_cnt; i++) {
+    rclc_executor_spin_some(&executor, RCL_MS_TO_NS(100));
+  }
+  EXPECT_EQ(discovery_cnt, (unsigned int) 1);
+  EXPECT_TRUE(discovery.matched);
+  rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+  EXPECT_EQ(discovery_cnt, (unsigned int) 1);
+
+  rc = rclc_executor_remove_discovery(&executor, &discovery);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(executor.info.number_of_guard_conditions, (size_t) 0);
+
+  // clean up
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_service_fini(&service, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_client_fini(&client, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
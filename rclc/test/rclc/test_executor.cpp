@@ -354,6 +354,13 @@ void gc_callback()
   printf("guard_condition signaled\n");
 }
 
+// guard condition callback, which runs longer than the period of timer1
+void long_gc_callback()
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  gc1_cnt++;
+}
+
 // callback for unit test 'spin_period'
 static const unsigned int TC_SPIN_PERIOD_MAX_INVOCATIONS = 100;
 static rcutils_duration_value_t _tc_spin_period_timepoints[TC_SPIN_PERIOD_MAX_INVOCATIONS];
@@ -2804,3 +2811,199 @@ TEST_F(TestDefaultExecutor, executor_test_remove_guard_condition) {
   rc = rclc_executor_fini(&executor);
   EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
 }
+
+TEST_F(TestDefaultExecutor, executor_timer_interleaving) {
+  rcl_ret_t rc;
+  rclc_executor_t executor;
+  executor = rclc_executor_get_zero_initialized_executor();
+
+  // test invalid arguments
+  rc = rclc_executor_set_timer_interleaving(NULL, true);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc) << rcl_get_error_string().str;
+  rcutils_reset_error();
+  rc = rclc_executor_set_timer_interleaving(&executor, true);
+  EXPECT_EQ(RCL_RET_ERROR, rc) << rcl_get_error_string().str;
+  rcutils_reset_error();
+
+  rc = rclc_executor_init(&executor, &this->context, 2, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_FALSE(executor.timer_interleaving);
+
+  // initialize guard condition
+  rcl_guard_condition_t guard_cond = rcl_get_zero_initialized_guard_condition();
+  rc = rcl_guard_condition_init(
+    &guard_cond, &this->context, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // the long callback comes before the timer
+  rc = rclc_executor_add_guard_condition(&executor, &guard_cond, &long_gc_callback);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_timer(&executor, &this->timer1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // without interleaving, the timer expiring during the callback waits for the next spin
+  gc1_cnt = 0;
+  _cbt_cnt = 0;
+  rc = rcl_timer_reset(&this->timer1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rcl_trigger_guard_condition(&guard_cond);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(gc1_cnt, (unsigned int) 1);
+  EXPECT_EQ(_cbt_cnt, (unsigned int) 0);
+
+  // with interleaving, it is executed right after the callback
+  rc = rclc_executor_set_timer_interleaving(&executor, true);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_TRUE(executor.timer_interleaving);
+  rc = rcl_timer_reset(&this->timer1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rcl_trigger_guard_condition(&guard_cond);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(gc1_cnt, (unsigned int) 2);
+  EXPECT_EQ(_cbt_cnt, (unsigned int) 1);
+
+  // also with LET semantics and callbacks executed in the order of dependencies
+  rc = rclc_executor_set_semantics(&executor, LET);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_dependency(&executor, &guard_cond, &this->timer1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rcl_timer_reset(&this->timer1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rcl_trigger_guard_condition(&guard_cond);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(gc1_cnt, (unsigned int) 3);
+  EXPECT_EQ(_cbt_cnt, (unsigned int) 2);
+
+  // tear down
+  rc = rcl_guard_condition_fini(&guard_cond);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+TEST_F(TestDefaultExecutor, executor_events_mode) {
+  rcl_ret_t rc;
+  rclc_executor_t executor;
+  executor = rclc_executor_get_zero_initialized_executor();
+
+  // test invalid arguments
+  rc = rclc_executor_set_events_mode(NULL, true);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc) << rcl_get_error_string().str;
+  rcutils_reset_error();
+  rc = rclc_executor_set_events_mode(&executor, true);
+  EXPECT_EQ(RCL_RET_ERROR, rc) << rcl_get_error_string().str;
+  rcutils_reset_error();
+
+  rc = rclc_executor_init(&executor, &this->context, 2, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+#ifndef RCLC_HAVE_LISTENER_API
+  // rcl has no listener callbacks before Humble
+  rc = rclc_executor_set_events_mode(&executor, true);
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, rc);
+  rcutils_reset_error();
+  EXPECT_EQ(executor.events, nullptr);
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  return;
+#endif
+  rc = rclc_executor_set_events_mode(&executor, true);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_NE(executor.events, nullptr);
+
+  _results_callback_init();
+  _cbt_cnt = 0;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub1, &this->sub1_msg, &CALLBACK_1, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_timer(&executor, &this->timer1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_prepare(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // every published message is processed exactly once
+  const unsigned int num_msgs = 3;
+  this->pub1_msg.data = 1;
+  for (unsigned int i = 0; i < num_msgs; i++) {
+    rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+    EXPECT_EQ(RCL_RET_OK, rc) << " pub1 not published";
+  }
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  for (unsigned int i = 0; i < 10; i++) {
+    rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  }
+  EXPECT_EQ(_cb1_cnt, num_msgs);
+  EXPECT_EQ(_cb1_int_value, (unsigned int) 1);
+
+  // the timer is executed from the timer heap
+  EXPECT_GT(_cbt_cnt, (unsigned int) 0);
+
+  // disabling events mode falls back to the wait_set
+  rc = rclc_executor_set_events_mode(&executor, false);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.events, nullptr);
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " pub1 not published";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(_cb1_cnt, num_msgs + 1);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+TEST_F(TestDefaultExecutor, executor_events_mode_invocation_always) {
+  rcl_ret_t rc;
+  rclc_executor_t executor;
+  executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 2, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+#ifndef RCLC_HAVE_LISTENER_API
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  return;
+#endif
+  rc = rclc_executor_set_events_mode(&executor, true);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  _results_callback_init();
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub1, &this->sub1_msg, &CALLBACK_1, ALWAYS);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub2, &this->sub2_msg, &CALLBACK_2, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // the callback of an ALWAYS subscription is called once per spin, with or without data
+  this->pub1_msg.data = 1;
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " pub1 not published";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 1);
+  EXPECT_EQ(_cb1_int_value, (unsigned int) 1);
+  const uint64_t short_timeout_ns = 1000000;  // 1ms
+  rc = rclc_executor_spin_some(&executor, short_timeout_ns);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 2);
+  EXPECT_EQ(_cb2_cnt, (unsigned int) 0);
+
+  // ON_NEW_DATA subscriptions are still dispatched from the event queue
+  this->pub2_msg.data = 2;
+  rc = rcl_publish(&this->pub2, &this->pub2_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " pub2 not published";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rc = rclc_executor_spin_some(&executor, short_timeout_ns);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 3);
+  EXPECT_EQ(_cb2_cnt, (unsigned int) 1);
+  EXPECT_EQ(_cb2_int_value, (unsigned int) 2);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
@@ -0,0 +1,152 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <rclc/executor.hpp>
+#include <std_msgs/msg/int32.h>
+
+#include <memory>
+#include <utility>
+
+#include "rcl/error_handling.h"
+
+RCLC_DECLARE_MESSAGE_TYPE_SUPPORT(std_msgs, msg, Int32)
+
+class Counter
+{
+public:
+  void on_message(const std_msgs__msg__Int32 & msg)
+  {
+    sum += msg.data;
+  }
+
+  int sum = 0;
+};
+
+TEST(Test, rclc_inplace_function) {
+  rclc::InplaceFunction<int(int)> empty;
+  EXPECT_FALSE(empty);
+
+  // lambda with captures, moved between instances
+  int offset = 10;
+  rclc::InplaceFunction<int(int)> add = [offset](int x) {return x + offset;};
+  EXPECT_TRUE(add);
+  EXPECT_EQ(add(1), 11);
+  rclc::InplaceFunction<int(int)> moved = std::move(add);
+  EXPECT_FALSE(add);
+  EXPECT_EQ(moved(2), 12);
+
+  // mutable state and destruction of the callable
+  auto counter = std::make_shared<int>(0);
+  {
+    rclc::InplaceFunction<void()> increment = [counter]() {(*counter)++;};
+    increment();
+    increment();
+    EXPECT_EQ(counter.use_count(), 2);
+  }
+  EXPECT_EQ(*counter, 2);
+  EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(Test, rclc_executor_cpp) {
+  rclc_support_t support;
+  rcl_ret_t rc;
+
+  // preliminary setup
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_executor_cpp_node", "", &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // type support is deduced from the message type
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rc = rclc::publisher_init_default<std_msgs__msg__Int32>(&publisher, &node, "cpp_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_subscription_t subscription1 = rcl_get_zero_initialized_subscription();
+  rc = rclc::subscription_init_default<std_msgs__msg__Int32>(&subscription1, &node, "cpp_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_subscription_t subscription2 = rcl_get_zero_initialized_subscription();
+  rc = rclc::subscription_init_default<std_msgs__msg__Int32>(&subscription2, &node, "cpp_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc::Executor<3> executor;
+  rc = executor.init(&support.context, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // lambda with captures
+  int lambda_sum = 0;
+  std_msgs__msg__Int32 msg1;
+  rc = executor.add_subscription(
+    &subscription1, &msg1,
+    [&lambda_sum](const std_msgs__msg__Int32 & msg) {lambda_sum += msg.data;});
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // member function
+  Counter counter;
+  std_msgs__msg__Int32 msg2;
+  rc = executor.add_subscription(&subscription2, &msg2, &counter, &Counter::on_message);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // timer with a capturing callback
+  unsigned int timer_cnt = 0;
+  rclc::Timer<> timer;
+  rc = timer.init(&support, RCL_MS_TO_NS(1), [&timer_cnt]() {timer_cnt++;});
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = executor.add_timer(timer);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // all slots are used
+  std_msgs__msg__Int32 msg3;
+  rc = executor.add_subscription(&subscription1, &msg3, [](const std_msgs__msg__Int32 &) {});
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  std_msgs__msg__Int32 pub_msg;
+  pub_msg.data = 3;
+  for (unsigned int i = 0; i < 50 && (lambda_sum < 3 || counter.sum < 3); i++) {
+    if (0 == i % 10) {
+      rc = rcl_publish(&publisher, &pub_msg, nullptr);
+      EXPECT_EQ(RCL_RET_OK, rc);
+    }
+    executor.spin_some(RCL_MS_TO_NS(10));
+  }
+  EXPECT_GE(lambda_sum, 3);
+  EXPECT_GE(counter.sum, 3);
+  EXPECT_GT(timer_cnt, (unsigned int) 0);
+
+  // a removed subscription frees its slot
+  rc = executor.remove_subscription(&subscription1);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = executor.add_subscription(&subscription1, &msg3, [](const std_msgs__msg__Int32 &) {});
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // clean up
+  rc = executor.fini();
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = timer.fini();
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_subscription_fini(&subscription1, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_subscription_fini(&subscription2, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_publisher_fini(&publisher, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
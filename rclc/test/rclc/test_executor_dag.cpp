@@ -0,0 +1,234 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "rcl/error_handling.h"
+
+#define NUMBER_OF_GCS 3
+
+static std::atomic<unsigned int> dag_order_index{0};
+static std::atomic<int> dag_order[NUMBER_OF_GCS * 2];
+static std::atomic<bool> dag_a_running{false};
+static std::atomic<bool> dag_b_running{false};
+static std::atomic<bool> dag_overlapped{false};
+
+static void dag_record(int id)
+{
+  unsigned int i = dag_order_index++;
+  if (i < NUMBER_OF_GCS * 2) {
+    dag_order[i] = id;
+  }
+}
+
+// waits for the other callback, which only succeeds if both run in parallel
+static void dag_wait_for(std::atomic<bool> & other)
+{
+  auto start = std::chrono::steady_clock::now();
+  while (!other && std::chrono::steady_clock::now() - start < std::chrono::seconds(1)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  if (other) {
+    dag_overlapped = true;
+  }
+}
+
+static void dag_callback_a()
+{
+  dag_a_running = true;
+  dag_wait_for(dag_b_running);
+  dag_record(0);
+}
+
+static void dag_callback_b()
+{
+  dag_b_running = true;
+  dag_wait_for(dag_a_running);
+  dag_record(1);
+}
+
+static void dag_callback_c()
+{
+  dag_record(2);
+}
+
+static void dag_callback_0()
+{
+  dag_record(0);
+}
+
+static void dag_callback_1()
+{
+  dag_record(1);
+}
+
+class TestExecutorDag : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    allocator = rcl_get_default_allocator();
+    rcl_ret_t rc = rclc_support_init(&support, 0, nullptr, &allocator);
+    ASSERT_EQ(RCL_RET_OK, rc);
+    for (size_t i = 0; i < NUMBER_OF_GCS; i++) {
+      gcs[i] = rcl_get_zero_initialized_guard_condition();
+      rc = rcl_guard_condition_init(
+        &gcs[i], &support.context, rcl_guard_condition_get_default_options());
+      ASSERT_EQ(RCL_RET_OK, rc);
+    }
+    executor = rclc_executor_get_zero_initialized_executor();
+    rc = rclc_executor_init(&executor, &support.context, NUMBER_OF_GCS, &allocator);
+    ASSERT_EQ(RCL_RET_OK, rc);
+    rc = rclc_executor_set_semantics(&executor, LET);
+    ASSERT_EQ(RCL_RET_OK, rc);
+    dag_order_index = 0;
+    dag_a_running = false;
+    dag_b_running = false;
+    dag_overlapped = false;
+  }
+
+  void TearDown() override
+  {
+    rcl_ret_t rc = rclc_executor_fini(&executor);
+    EXPECT_EQ(RCL_RET_OK, rc);
+    EXPECT_EQ(executor.dag, nullptr);
+    for (size_t i = 0; i < NUMBER_OF_GCS; i++) {
+      rc = rcl_guard_condition_fini(&gcs[i]);
+      EXPECT_EQ(RCL_RET_OK, rc);
+    }
+    rc = rclc_support_fini(&support);
+    EXPECT_EQ(RCL_RET_OK, rc);
+  }
+
+  void trigger_all()
+  {
+    for (size_t i = 0; i < NUMBER_OF_GCS; i++) {
+      rcl_ret_t rc = rcl_trigger_guard_condition(&gcs[i]);
+      EXPECT_EQ(RCL_RET_OK, rc);
+    }
+  }
+
+  rcl_allocator_t allocator;
+  rclc_support_t support;
+  rcl_guard_condition_t gcs[NUMBER_OF_GCS];
+  rclc_executor_t executor;
+};
+
+TEST_F(TestExecutorDag, arguments) {
+  rcl_ret_t rc = rclc_executor_add_dependency(nullptr, &gcs[0], &gcs[1]);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_add_dependency(&executor, nullptr, &gcs[1]);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_add_dependency(&executor, &gcs[0], nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_enable_parallel_execution(nullptr, 2);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_enable_parallel_execution(&executor, 0);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  // cycles are rejected
+  rc = rclc_executor_add_dependency(&executor, &gcs[0], &gcs[1]);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_add_dependency(&executor, &gcs[1], &gcs[2]);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_add_dependency(&executor, &gcs[2], &gcs[0]);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_add_dependency(&executor, &gcs[1], &gcs[1]);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_enable_parallel_execution(&executor, 1);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_enable_parallel_execution(&executor, 1);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+}
+
+TEST_F(TestExecutorDag, topological_order) {
+  // the first handle in the list depends on the last one,
+  // the dependency is declared before the handles are added
+  rcl_ret_t rc = rclc_executor_add_dependency(&executor, &gcs[2], &gcs[0]);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_add_guard_condition(&executor, &gcs[0], &dag_callback_0);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_add_guard_condition(&executor, &gcs[1], &dag_callback_1);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_add_guard_condition(&executor, &gcs[2], &dag_callback_c);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // without worker threads, the callbacks are executed one after another:
+  // 1 and 2 have no dependencies and keep their order, 0 runs last
+  trigger_all();
+  rclc_executor_spin_some(&executor, RCL_MS_TO_NS(100));
+  ASSERT_EQ(dag_order_index, (unsigned int) NUMBER_OF_GCS);
+  EXPECT_EQ(dag_order[0], 1);
+  EXPECT_EQ(dag_order[1], 2);
+  EXPECT_EQ(dag_order[2], 0);
+
+  // dependencies on removed handles are ignored
+  rc = rclc_executor_remove_guard_condition(&executor, &gcs[2]);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  dag_order_index = 0;
+  trigger_all();
+  rclc_executor_spin_some(&executor, RCL_MS_TO_NS(100));
+  ASSERT_EQ(dag_order_index, (unsigned int) 2);
+  EXPECT_EQ(dag_order[0], 0);
+  EXPECT_EQ(dag_order[1], 1);
+}
+
+TEST_F(TestExecutorDag, parallel_execution) {
+  rcl_ret_t rc = rclc_executor_add_guard_condition(&executor, &gcs[0], &dag_callback_a);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_add_guard_condition(&executor, &gcs[1], &dag_callback_b);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_add_guard_condition(&executor, &gcs[2], &dag_callback_c);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  // c depends on both a and b, which are independent
+  rc = rclc_executor_add_dependency(&executor, &gcs[0], &gcs[2]);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_add_dependency(&executor, &gcs[1], &gcs[2]);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_enable_parallel_execution(&executor, 2);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  trigger_all();
+  rclc_executor_spin_some(&executor, RCL_MS_TO_NS(100));
+  ASSERT_EQ(dag_order_index, (unsigned int) NUMBER_OF_GCS);
+  EXPECT_TRUE(dag_overlapped);
+  EXPECT_EQ(dag_order[2], 2);
+
+  // the next cycle uses the same workers
+  dag_order_index = 0;
+  dag_a_running = false;
+  dag_b_running = false;
+  dag_overlapped = false;
+  trigger_all();
+  rclc_executor_spin_some(&executor, RCL_MS_TO_NS(100));
+  ASSERT_EQ(dag_order_index, (unsigned int) NUMBER_OF_GCS);
+  EXPECT_TRUE(dag_overlapped);
+  EXPECT_EQ(dag_order[2], 2);
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+#include "rclc/executor_heap_internal.h"
+
+
+TEST(Test, executor_heap_init) {
+  rcl_ret_t rc;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rclc_executor_heap_t heap = rclc_executor_heap_get_zero_initialized();
+
+  // test invalid arguments
+  rc = rclc_executor_heap_init(nullptr, 1, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_heap_init(&heap, 1, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_heap_init(&heap, 0, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_heap_init(&heap, 4, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(heap.capacity, (size_t) 4);
+  EXPECT_EQ(heap.size, (size_t) 0);
+  EXPECT_FALSE(rclc_executor_heap_peek(&heap, nullptr));
+
+  rc = rclc_executor_heap_fini(&heap, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(heap.entries, nullptr);
+}
+
+TEST(Test, executor_heap_order) {
+  rcl_ret_t rc;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rclc_executor_heap_t heap = rclc_executor_heap_get_zero_initialized();
+  rc = rclc_executor_heap_init(&heap, 5, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  const int64_t keys[] = {30, 10, 50, 20, 40};
+  for (size_t i = 0; i < 5; i++) {
+    rc = rclc_executor_heap_push(&heap, keys[i], i);
+    EXPECT_EQ(RCL_RET_OK, rc);
+  }
+  // heap is full
+  rc = rclc_executor_heap_push(&heap, 0, 0);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  rclc_executor_heap_entry_t entry;
+  EXPECT_TRUE(rclc_executor_heap_peek(&heap, &entry));
+  EXPECT_EQ(entry.key, 10);
+  EXPECT_EQ(entry.value, (size_t) 1);
+
+  int64_t last_key = 0;
+  size_t n = 0;
+  while (rclc_executor_heap_pop(&heap, &entry)) {
+    EXPECT_GE(entry.key, last_key);
+    EXPECT_EQ(entry.key, keys[entry.value]);
+    last_key = entry.key;
+    n++;
+  }
+  EXPECT_EQ(n, (size_t) 5);
+
+  // clear
+  rc = rclc_executor_heap_push(&heap, 1, 1);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rclc_executor_heap_clear(&heap);
+  EXPECT_FALSE(rclc_executor_heap_pop(&heap, &entry));
+
+  rc = rclc_executor_heap_fini(&heap, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
@@ -0,0 +1,199 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+#include <std_msgs/msg/int32.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "rcl/error_handling.h"
+
+static std::atomic<unsigned int> staging_callback_cnt{0};
+
+static void staging_callback(const void * msgin)
+{
+  if (NULL != msgin) {
+    staging_callback_cnt++;
+  }
+}
+
+TEST(Test, rclc_executor_staging_arguments) {
+  rclc_support_t support;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_ret_t rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  rc = rclc_timer_init_default(&timer, &support, RCL_MS_TO_NS(100), nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_enable_staging(&executor, 4);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_init(&executor, &support.context, 2, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // staging is not enabled
+  rc = rclc_executor_stage_add_timer(&executor, &timer);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  EXPECT_TRUE(rclc_executor_staging_is_idle(&executor));
+
+  rc = rclc_executor_enable_staging(nullptr, 4);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_enable_staging(&executor, 0);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_enable_staging(&executor, 2);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(executor.index, (size_t) 1);
+  rc = rclc_executor_enable_staging(&executor, 2);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_stage_add_timer(&executor, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_stage_remove(&executor, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  // queue full
+  rc = rclc_executor_stage_add_timer(&executor, &timer);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_stage_remove(&executor, &timer);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_stage_add_timer(&executor, &timer);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  EXPECT_FALSE(rclc_executor_staging_is_idle(&executor));
+
+  // requests are applied in their order
+  rclc_executor_spin_some(&executor, 0);
+  EXPECT_TRUE(rclc_executor_staging_is_idle(&executor));
+  EXPECT_EQ(executor.index, (size_t) 1);
+  EXPECT_EQ(executor.info.number_of_timers, (size_t) 0);
+  EXPECT_EQ(rclc_executor_staging_get_failed_count(&executor), (size_t) 0);
+
+  // failed requests are counted: no handle is left for the second timer
+  rc = rclc_executor_stage_add_timer(&executor, &timer);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_stage_add_timer(&executor, &timer);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rclc_executor_spin_some(&executor, 0);
+  rcutils_reset_error();
+  EXPECT_TRUE(rclc_executor_staging_is_idle(&executor));
+  EXPECT_EQ(executor.index, (size_t) 2);
+  EXPECT_EQ(rclc_executor_staging_get_failed_count(&executor), (size_t) 1);
+  rc = rclc_executor_stage_remove(&executor, &timer);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rclc_executor_spin_some(&executor, 0);
+  EXPECT_TRUE(rclc_executor_staging_is_idle(&executor));
+  EXPECT_EQ(executor.index, (size_t) 1);
+  EXPECT_EQ(rclc_executor_staging_get_failed_count(&executor), (size_t) 1);
+
+  // clean up
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(executor.staging, nullptr);
+  rc = rcl_timer_fini(&timer);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
+
+TEST(Test, rclc_executor_staging_from_other_thread) {
+  rclc_support_t support;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_ret_t rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_executor_staging_node", "", &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  const rosidl_message_type_support_t * type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rc = rclc_publisher_init_default(&publisher, &node, type_support, "staging_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rc = rclc_subscription_init_default(&subscription, &node, type_support, "staging_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &support.context, 2, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_enable_staging(&executor, 8);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // the staging thread adds the subscription, while the executor waits
+  std_msgs__msg__Int32 sub_msg;
+  std::thread stager([&]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      rcl_ret_t ret = rclc_executor_stage_add_subscription(
+        &executor, &subscription, &sub_msg, &staging_callback, ON_NEW_DATA);
+      EXPECT_EQ(RCL_RET_OK, ret);
+    });
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int k = 0; k < 100 && executor.index < 2; k++) {
+    rclc_executor_spin_some(&executor, RCL_MS_TO_NS(1000));
+  }
+  stager.join();
+  // the guard condition woke up the executor before the timeout of 1s
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(900));
+  EXPECT_EQ(executor.index, (size_t) 2);
+  EXPECT_EQ(executor.info.number_of_subscriptions, (size_t) 1);
+  EXPECT_TRUE(rclc_executor_staging_is_idle(&executor));
+
+  std_msgs__msg__Int32 pub_msg;
+  pub_msg.data = 1;
+  staging_callback_cnt = 0;
+  rc = rcl_publish(&publisher, &pub_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  for (unsigned int k = 0; k < 20 && staging_callback_cnt < 1; k++) {
+    rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+  }
+  EXPECT_EQ(staging_callback_cnt, (unsigned int) 1);
+
+  // the staging thread removes the subscription and waits until it was applied
+  std::thread remover([&]() {
+      rcl_ret_t ret = rclc_executor_stage_remove(&executor, &subscription);
+      EXPECT_EQ(RCL_RET_OK, ret);
+      while (!rclc_executor_staging_is_idle(&executor)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    });
+  for (unsigned int k = 0; k < 100 && executor.index > 1; k++) {
+    rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+  }
+  remover.join();
+  EXPECT_EQ(executor.index, (size_t) 1);
+  EXPECT_EQ(executor.info.number_of_subscriptions, (size_t) 0);
+
+  // clean up
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_subscription_fini(&subscription, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_publisher_fini(&publisher, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
@@ -0,0 +1,288 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+#include <std_msgs/msg/int32.h>
+#include <example_interfaces/action/fibonacci.h>
+#include <unistd.h>
+
+#include <string>
+
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp_action/rclcpp_action.hpp>
+#include <example_interfaces/action/fibonacci.hpp>
+
+#include "rcl/error_handling.h"
+
+static unsigned int stats_callback_cnt = 0;
+
+static void stats_callback(const void * msgin)
+{
+  if (NULL != msgin) {
+    stats_callback_cnt++;
+  }
+}
+
+static unsigned int stats_goal_cnt = 0;
+
+static rcl_ret_t stats_goal_callback(rclc_action_goal_handle_t *, void *)
+{
+  stats_goal_cnt++;
+  return RCL_RET_ACTION_GOAL_ACCEPTED;
+}
+
+static bool stats_cancel_callback(rclc_action_goal_handle_t *, void *)
+{
+  return false;
+}
+
+TEST(Test, rclc_executor_stats_percentile) {
+  rclc_executor_stats_handle_t handle = {};
+  EXPECT_EQ(rclc_executor_stats_percentile(&handle, 0.5), (uint64_t) 0);
+  EXPECT_EQ(rclc_executor_stats_percentile(nullptr, 0.5), (uint64_t) 0);
+
+  // 90 callbacks in [512, 1024) ns, 10 callbacks in [65536, 131072) ns
+  handle.invocations = 100;
+  handle.callback_time_histogram[10] = 90;
+  handle.callback_time_histogram[17] = 10;
+  handle.callback_time_max_ns = 100000;
+  EXPECT_EQ(rclc_executor_stats_percentile(&handle, 0.5), (uint64_t) 1024);
+  EXPECT_EQ(rclc_executor_stats_percentile(&handle, 0.9), (uint64_t) 1024);
+  // the upper bound of the bucket is limited by the maximum
+  EXPECT_EQ(rclc_executor_stats_percentile(&handle, 0.99), (uint64_t) 100000);
+}
+
+TEST(Test, rclc_executor_stats_read_stale) {
+  // a segment with one handle, left behind by a writer which died while updating it
+  struct
+  {
+    rclc_executor_stats_segment_t segment;
+    rclc_executor_stats_handle_t handle;
+  } memory = {};
+  memory.segment.max_handles = 1;
+  memory.segment.number_of_handles = 1;
+  rclc_executor_stats_view_t view = rclc_executor_stats_view_get_zero_initialized();
+  view.segment = &memory.segment;
+  view.size = sizeof(memory);
+
+  rclc_executor_stats_segment_t segment;
+  rclc_executor_stats_handle_t handle;
+  rcl_ret_t rc = rclc_executor_stats_read_segment(&view, &segment);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_stats_read_handle(&view, 0, &handle);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  memory.segment.sequence = 1;
+  rc = rclc_executor_stats_read_segment(&view, &segment);
+  EXPECT_EQ(RCL_RET_TIMEOUT, rc);
+  rcutils_reset_error();
+  memory.handle.sequence = 3;
+  rc = rclc_executor_stats_read_handle(&view, 0, &handle);
+  EXPECT_EQ(RCL_RET_TIMEOUT, rc);
+  rcutils_reset_error();
+}
+
+TEST(Test, rclc_executor_set_stats_export) {
+  rclc_support_t support;
+  rcl_ret_t rc;
+
+  // preliminary setup
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_executor_stats_node", "", &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  const rosidl_message_type_support_t * type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rc = rclc_publisher_init_default(&publisher, &node, type_support, "stats_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rc = rclc_subscription_init_default(&subscription, &node, type_support, "stats_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &support.context, 2, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  std_msgs__msg__Int32 sub_msg;
+  rc = rclc_executor_add_subscription(
+    &executor, &subscription, &sub_msg, &stats_callback, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // tests with invalid arguments
+  rc = rclc_executor_set_stats_export(nullptr, "test_stats");
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_stats_export(&executor, "test/stats");
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_stats_export(&executor, "");
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_enable_stats_counters(nullptr, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  // counters need the statistics export
+  rc = rclc_executor_enable_stats_counters(&executor, nullptr);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_set_stats_export(&executor, "test_stats");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  // succeeds without any available counter, e.g. in a virtual machine
+  uint32_t counters = 0xffffffff;
+  rc = rclc_executor_enable_stats_counters(&executor, &counters);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(counters & ~0xfu, 0u);
+
+  std_msgs__msg__Int32 pub_msg;
+  stats_callback_cnt = 0;
+  for (int32_t i = 1; i <= 3; i++) {
+    pub_msg.data = i;
+    rc = rcl_publish(&publisher, &pub_msg, nullptr);
+    EXPECT_EQ(RCL_RET_OK, rc);
+    for (unsigned int k = 0; k < 20 && stats_callback_cnt < (unsigned int) i; k++) {
+      rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+    }
+  }
+  EXPECT_EQ(stats_callback_cnt, (unsigned int) 3);
+
+  // read the statistics like another process
+  std::string segment_name = std::string(RCLC_EXECUTOR_STATS_SEGMENT_PREFIX) +
+    std::to_string(getpid()) + ".test_stats";
+  rclc_executor_stats_view_t view = rclc_executor_stats_view_get_zero_initialized();
+  rc = rclc_executor_stats_attach(&view, segment_name.c_str());
+  ASSERT_EQ(RCL_RET_OK, rc);
+
+  rclc_executor_stats_segment_t segment;
+  rc = rclc_executor_stats_read_segment(&view, &segment);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_STREQ(segment.name, "test_stats");
+  EXPECT_EQ(segment.pid, (int32_t) getpid());
+  EXPECT_EQ(segment.max_handles, (uint64_t) 2);
+  EXPECT_EQ(segment.number_of_handles, (uint64_t) 1);
+  EXPECT_GE(segment.spins, (uint64_t) 3);
+  EXPECT_EQ(segment.counters, (uint64_t) counters);
+
+  rclc_executor_stats_handle_t handle;
+  rc = rclc_executor_stats_read_handle(&view, 0, &handle);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(handle.type, (uint32_t) RCLC_SUBSCRIPTION);
+  EXPECT_STREQ(handle.name, "/stats_topic");
+  EXPECT_EQ(handle.invocations, (uint64_t) 3);
+  EXPECT_LE(rclc_executor_stats_percentile(&handle, 0.5), handle.callback_time_max_ns);
+  if (counters & RCLC_EXECUTOR_STATS_COUNTER_INSTRUCTIONS) {
+    EXPECT_GT(handle.instructions, (uint64_t) 0);
+  } else {
+    EXPECT_EQ(handle.instructions, (uint64_t) 0);
+  }
+  rc = rclc_executor_stats_read_handle(&view, 2, &handle);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_stats_detach(&view);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // disabling the export removes the segment
+  rc = rclc_executor_set_stats_export(&executor, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_stats_attach(&view, segment_name.c_str());
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  // clean up
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_subscription_fini(&subscription, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_publisher_fini(&publisher, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
+
+TEST(Test, rclc_executor_stats_action_server) {
+  rclc_support_t support;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_ret_t rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_executor_stats_action_node", "", &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rclc_action_server_t action_server;
+  rc = rclc_action_server_init_default(
+    &action_server, &node, &support,
+    ROSIDL_GET_ACTION_TYPE_SUPPORT(example_interfaces, Fibonacci), "stats_fibonacci");
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &support.context, 1, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  example_interfaces__action__Fibonacci_SendGoal_Request ros_goal_request[2];
+  rc = rclc_executor_add_action_server(
+    &executor, &action_server, 2, ros_goal_request,
+    sizeof(example_interfaces__action__Fibonacci_SendGoal_Request),
+    stats_goal_callback, stats_cancel_callback, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_set_stats_export(&executor, "test_stats_action");
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // the callbacks of an action server are counted as invocations
+  rclcpp::init(0, nullptr);
+  auto client_node = rclcpp::Node::make_shared("stats_action_client");
+  auto client = rclcpp_action::create_client<example_interfaces::action::Fibonacci>(
+    client_node, "stats_fibonacci");
+  EXPECT_TRUE(client->wait_for_action_server(std::chrono::seconds(10)));
+  example_interfaces::action::Fibonacci::Goal goal;
+  goal.order = 5;
+  stats_goal_cnt = 0;
+  auto goal_handle_future = client->async_send_goal(goal);
+  for (unsigned int k = 0; k < 100 && stats_goal_cnt < 1; k++) {
+    rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+  }
+  EXPECT_EQ(stats_goal_cnt, (unsigned int) 1);
+
+  std::string segment_name = std::string(RCLC_EXECUTOR_STATS_SEGMENT_PREFIX) +
+    std::to_string(getpid()) + ".test_stats_action";
+  rclc_executor_stats_view_t view = rclc_executor_stats_view_get_zero_initialized();
+  rc = rclc_executor_stats_attach(&view, segment_name.c_str());
+  ASSERT_EQ(RCL_RET_OK, rc);
+  rclc_executor_stats_handle_t handle;
+  rc = rclc_executor_stats_read_handle(&view, 0, &handle);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(handle.type, (uint32_t) RCLC_ACTION_SERVER);
+  EXPECT_GE(handle.invocations, (uint64_t) 1);
+  rc = rclc_executor_stats_detach(&view);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // clean up
+  client.reset();
+  client_node.reset();
+  rclcpp::shutdown();
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_action_server_fini(&action_server, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
@@ -0,0 +1,209 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+
+#include "rcl/error_handling.h"
+
+#define MAX_TASKS 3
+
+static unsigned int task_order_index = 0;
+static int task_order[MAX_TASKS * 2];
+
+static void task_callback(void * context)
+{
+  if (task_order_index < MAX_TASKS * 2) {
+    task_order[task_order_index] = *static_cast<int *>(context);
+  }
+  task_order_index++;
+}
+
+static void gc_callback()
+{
+}
+
+class TestExecutorTasks : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    allocator = rcl_get_default_allocator();
+    rcl_ret_t rc = rclc_support_init(&support, 0, nullptr, &allocator);
+    ASSERT_EQ(RCL_RET_OK, rc);
+    // the executor waits on a guard condition, which is never triggered
+    gc = rcl_get_zero_initialized_guard_condition();
+    rc = rcl_guard_condition_init(&gc, &support.context, rcl_guard_condition_get_default_options());
+    ASSERT_EQ(RCL_RET_OK, rc);
+    executor = rclc_executor_get_zero_initialized_executor();
+    rc = rclc_executor_init(&executor, &support.context, 1, &allocator);
+    ASSERT_EQ(RCL_RET_OK, rc);
+    rc = rclc_executor_add_guard_condition(&executor, &gc, &gc_callback);
+    ASSERT_EQ(RCL_RET_OK, rc);
+    task_order_index = 0;
+  }
+
+  void TearDown() override
+  {
+    rcl_ret_t rc = rclc_executor_fini(&executor);
+    EXPECT_EQ(RCL_RET_OK, rc);
+    EXPECT_EQ(executor.tasks, nullptr);
+    rc = rcl_guard_condition_fini(&gc);
+    EXPECT_EQ(RCL_RET_OK, rc);
+    rc = rclc_support_fini(&support);
+    EXPECT_EQ(RCL_RET_OK, rc);
+  }
+
+  rcl_allocator_t allocator;
+  rclc_support_t support;
+  rcl_guard_condition_t gc;
+  rclc_executor_t executor;
+};
+
+TEST_F(TestExecutorTasks, arguments) {
+  int context = 0;
+  rcl_ret_t rc = rclc_executor_enable_scheduled_tasks(nullptr, MAX_TASKS);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_enable_scheduled_tasks(&executor, 0);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  // the tasks must be enabled first
+  rc = rclc_executor_schedule_after(&executor, 0, &task_callback, &context, nullptr);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_cancel_task(&executor, 1);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_enable_scheduled_tasks(&executor, MAX_TASKS);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_enable_scheduled_tasks(&executor, MAX_TASKS);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_schedule_at(nullptr, 0, &task_callback, &context, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_schedule_at(&executor, 0, nullptr, &context, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_cancel_task(nullptr, 1);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_cancel_task(&executor, RCLC_EXECUTOR_TASK_INVALID_ID);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+}
+
+TEST_F(TestExecutorTasks, order_and_cancel) {
+  int contexts[MAX_TASKS] = {0, 1, 2};
+  rclc_executor_task_id_t ids[MAX_TASKS];
+  rcl_ret_t rc = rclc_executor_enable_scheduled_tasks(&executor, MAX_TASKS);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // scheduled in reverse order of their time
+  rcutils_time_point_value_t now = 0;
+  rcutils_steady_time_now(&now);
+  for (int i = MAX_TASKS - 1; i >= 0; i--) {
+    rc = rclc_executor_schedule_at(
+      &executor, now - RCL_MS_TO_NS(MAX_TASKS - i), &task_callback, &contexts[i], &ids[i]);
+    EXPECT_EQ(RCL_RET_OK, rc);
+    EXPECT_NE(ids[i], (rclc_executor_task_id_t) RCLC_EXECUTOR_TASK_INVALID_ID);
+  }
+  // all slots are in use
+  rc = rclc_executor_schedule_after(&executor, 0, &task_callback, &contexts[0], nullptr);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_cancel_task(&executor, ids[1]);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_cancel_task(&executor, ids[1]);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  // the slot of the cancelled task is reused
+  rc = rclc_executor_schedule_after(
+    &executor, RCL_S_TO_NS(10), &task_callback, &contexts[1], &ids[1]);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_executor_spin_some(&executor, 0);
+  ASSERT_EQ(task_order_index, (unsigned int) 2);
+  EXPECT_EQ(task_order[0], 0);
+  EXPECT_EQ(task_order[1], 2);
+
+  // executed tasks cannot be cancelled, pending ones can
+  rc = rclc_executor_cancel_task(&executor, ids[0]);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_cancel_task(&executor, ids[1]);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rclc_executor_spin_some(&executor, 0);
+  EXPECT_EQ(task_order_index, (unsigned int) 2);
+}
+
+TEST_F(TestExecutorTasks, wait_timeout) {
+  int context = 0;
+  rcl_ret_t rc = rclc_executor_enable_scheduled_tasks(&executor, MAX_TASKS);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_schedule_after(
+    &executor, RCL_MS_TO_NS(50), &task_callback, &context, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // the executor wakes up for the task instead of waiting for the full timeout
+  rcutils_time_point_value_t start = 0;
+  rcutils_time_point_value_t end = 0;
+  rcutils_steady_time_now(&start);
+  for (unsigned int k = 0; k < 3 && task_order_index == 0; k++) {
+    rclc_executor_spin_some(&executor, RCL_S_TO_NS(5));
+  }
+  rcutils_steady_time_now(&end);
+  EXPECT_EQ(task_order_index, (unsigned int) 1);
+  EXPECT_GE(end - start, RCL_MS_TO_NS(50));
+  EXPECT_LT(end - start, RCL_S_TO_NS(2));
+}
+
+TEST_F(TestExecutorTasks, tasks_only) {
+  // an executor without handles sleeps instead of waiting on an empty wait_set
+  rclc_executor_t tasks_executor = rclc_executor_get_zero_initialized_executor();
+  rcl_ret_t rc = rclc_executor_init(&tasks_executor, &support.context, 1, &allocator);
+  ASSERT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_enable_scheduled_tasks(&tasks_executor, MAX_TASKS);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rcutils_time_point_value_t start = 0;
+  rcutils_time_point_value_t end = 0;
+  rcutils_steady_time_now(&start);
+  rc = rclc_executor_spin_some(&tasks_executor, RCL_MS_TO_NS(50));
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcutils_steady_time_now(&end);
+  EXPECT_GE(end - start, RCL_MS_TO_NS(50));
+
+  // one spin sleeps until the task is due and executes it
+  int context = 0;
+  rc = rclc_executor_schedule_after(
+    &tasks_executor, RCL_MS_TO_NS(50), &task_callback, &context, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcutils_steady_time_now(&start);
+  rc = rclc_executor_spin_some(&tasks_executor, RCL_S_TO_NS(5));
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcutils_steady_time_now(&end);
+  EXPECT_EQ(task_order_index, (unsigned int) 1);
+  EXPECT_GE(end - start, RCL_MS_TO_NS(50));
+  EXPECT_LT(end - start, RCL_S_TO_NS(2));
+
+  rc = rclc_executor_fini(&tasks_executor);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
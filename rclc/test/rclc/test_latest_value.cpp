@@ -0,0 +1,296 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+#include <std_msgs/msg/int32.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "rcl/error_handling.h"
+#include "rclc/latest_value_internal.h"
+
+static unsigned int latest_value_callback_cnt = 0;
+
+static void latest_value_callback(const void * msgin)
+{
+  if (NULL != msgin) {
+    latest_value_callback_cnt++;
+  }
+}
+
+TEST(Test, rclc_latest_value) {
+  rcl_ret_t rc;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  std_msgs__msg__Int32 msgs[3];
+  void * msg_ptrs[3] = {&msgs[0], &msgs[1], &msgs[2]};
+  rclc_latest_value_t latest_value = rclc_latest_value_get_zero_initialized();
+
+  // tests with invalid arguments
+  rc = rclc_latest_value_init(nullptr, msg_ptrs, 3, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_latest_value_init(&latest_value, nullptr, 3, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_latest_value_init(&latest_value, msg_ptrs, 2, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_latest_value_init(&latest_value, msg_ptrs, 3, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // nothing published yet
+  uint64_t sequence_number = 0;
+  EXPECT_EQ(rclc_latest_value_acquire(&latest_value, &sequence_number), nullptr);
+  EXPECT_EQ(rclc_latest_value_acquire(nullptr, &sequence_number), nullptr);
+
+  // publish a message like the executor does
+  rclc_latest_value_buffer_t * buffer = rclc_latest_value_get_free_buffer(&latest_value);
+  ASSERT_NE(buffer, nullptr);
+  static_cast<std_msgs__msg__Int32 *>(buffer->msg)->data = 1;
+  rclc_latest_value_publish(&latest_value, buffer);
+
+  // two readers share the newest message
+  auto msg1 = static_cast<const std_msgs__msg__Int32 *>(
+    rclc_latest_value_acquire(&latest_value, &sequence_number));
+  ASSERT_NE(msg1, nullptr);
+  EXPECT_EQ(msg1->data, 1);
+  EXPECT_EQ(sequence_number, (uint64_t) 1);
+  auto msg2 = static_cast<const std_msgs__msg__Int32 *>(
+    rclc_latest_value_acquire(&latest_value, nullptr));
+  EXPECT_EQ(msg1, msg2);
+
+  // the held message is never handed out for writing
+  buffer = rclc_latest_value_get_free_buffer(&latest_value);
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_NE(buffer->msg, msg1);
+  static_cast<std_msgs__msg__Int32 *>(buffer->msg)->data = 2;
+  rclc_latest_value_publish(&latest_value, buffer);
+  EXPECT_EQ(msg1->data, 1);
+
+  // a third reader holds the newest message: all buffers are in use
+  auto msg3 = static_cast<const std_msgs__msg__Int32 *>(
+    rclc_latest_value_acquire(&latest_value, &sequence_number));
+  ASSERT_NE(msg3, nullptr);
+  EXPECT_EQ(msg3->data, 2);
+  EXPECT_EQ(sequence_number, (uint64_t) 2);
+  buffer = rclc_latest_value_get_free_buffer(&latest_value);
+  ASSERT_NE(buffer, nullptr);
+  rclc_latest_value_publish(&latest_value, buffer);
+  EXPECT_EQ(rclc_latest_value_get_free_buffer(&latest_value), nullptr);
+
+  // releasing the old message frees its buffer
+  rc = rclc_latest_value_release(&latest_value, msg1);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(rclc_latest_value_get_free_buffer(&latest_value), nullptr);
+  rc = rclc_latest_value_release(&latest_value, msg2);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_NE(rclc_latest_value_get_free_buffer(&latest_value), nullptr);
+  rc = rclc_latest_value_release(&latest_value, msg3);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // unknown message
+  std_msgs__msg__Int32 other;
+  rc = rclc_latest_value_release(&latest_value, &other);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_latest_value_fini(&latest_value);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
+
+TEST(Test, rclc_latest_value_concurrent_readers) {
+  rcl_ret_t rc;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  constexpr size_t number_of_readers = 4;
+  std_msgs__msg__Int32 msgs[number_of_readers + 2];
+  void * msg_ptrs[number_of_readers + 2];
+  for (size_t i = 0; i < number_of_readers + 2; i++) {
+    msg_ptrs[i] = &msgs[i];
+  }
+  rclc_latest_value_t latest_value = rclc_latest_value_get_zero_initialized();
+  rc = rclc_latest_value_init(&latest_value, msg_ptrs, number_of_readers + 2, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // the message data equals its sequence number, a torn read would break this
+  std::atomic<bool> done{false};
+  std::atomic<unsigned int> errors{0};
+  std::vector<std::thread> readers;
+  for (size_t r = 0; r < number_of_readers; r++) {
+    readers.emplace_back(
+      [&]() {
+        uint64_t last = 0;
+        while (!done) {
+          uint64_t sequence_number = 0;
+          auto msg = static_cast<const std_msgs__msg__Int32 *>(
+            rclc_latest_value_acquire(&latest_value, &sequence_number));
+          if (NULL == msg) {
+            continue;
+          }
+          if ((uint64_t) msg->data != sequence_number || sequence_number < last) {
+            errors++;
+          }
+          last = sequence_number;
+          rclc_latest_value_release(&latest_value, msg);
+        }
+      });
+  }
+
+  // with number_of_readers + 2 buffers the writer always finds a free buffer
+  for (int32_t i = 1; i <= 100000; i++) {
+    rclc_latest_value_buffer_t * buffer = rclc_latest_value_get_free_buffer(&latest_value);
+    ASSERT_NE(buffer, nullptr);
+    static_cast<std_msgs__msg__Int32 *>(buffer->msg)->data = i;
+    rclc_latest_value_publish(&latest_value, buffer);
+  }
+  done = true;
+  for (auto & reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(errors, (unsigned int) 0);
+
+  rc = rclc_latest_value_fini(&latest_value);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
+
+TEST(Test, rclc_executor_add_subscription_latest_value) {
+  rclc_support_t support;
+  rcl_ret_t rc;
+
+  // preliminary setup
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_latest_value_node", "", &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  const rosidl_message_type_support_t * type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rc = rclc_publisher_init_default(&publisher, &node, type_support, "latest_value_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rc = rclc_subscription_init_default(&subscription, &node, type_support, "latest_value_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  std_msgs__msg__Int32 msgs[3];
+  void * msg_ptrs[3] = {&msgs[0], &msgs[1], &msgs[2]};
+  rclc_latest_value_t latest_value = rclc_latest_value_get_zero_initialized();
+  rc = rclc_latest_value_init(&latest_value, msg_ptrs, 3, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &support.context, 1, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // tests with invalid arguments
+  rc = rclc_executor_add_subscription_latest_value(
+    &executor, &subscription, nullptr, &latest_value_callback, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_add_subscription_latest_value(
+    &executor, &subscription, &latest_value, &latest_value_callback, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  std_msgs__msg__Int32 pub_msg;
+  latest_value_callback_cnt = 0;
+  for (int32_t i = 1; i <= 3; i++) {
+    pub_msg.data = i;
+    rc = rcl_publish(&publisher, &pub_msg, nullptr);
+    EXPECT_EQ(RCL_RET_OK, rc);
+    for (unsigned int k = 0; k < 20 && latest_value_callback_cnt < (unsigned int) i; k++) {
+      rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+    }
+  }
+  EXPECT_EQ(latest_value_callback_cnt, (unsigned int) 3);
+
+  // read the newest message from another thread
+  int32_t data = 0;
+  uint64_t sequence_number = 0;
+  std::thread reader(
+    [&]() {
+      auto msg = static_cast<const std_msgs__msg__Int32 *>(
+        rclc_latest_value_acquire(&latest_value, &sequence_number));
+      if (NULL != msg) {
+        data = msg->data;
+        rclc_latest_value_release(&latest_value, msg);
+      }
+    });
+  reader.join();
+  EXPECT_EQ(data, 3);
+  EXPECT_EQ(sequence_number, (uint64_t) 3);
+
+  // hold all buffers: the next message is dropped instead of staying in the queue
+  const void * held[3];
+  for (int32_t i = 0; i < 3; i++) {
+    if (i > 0) {
+      pub_msg.data = 3 + i;
+      rc = rcl_publish(&publisher, &pub_msg, nullptr);
+      EXPECT_EQ(RCL_RET_OK, rc);
+      for (unsigned int k = 0; k < 20 && latest_value_callback_cnt < (unsigned int) (3 + i); k++) {
+        rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+      }
+    }
+    held[i] = rclc_latest_value_acquire(&latest_value, nullptr);
+    EXPECT_NE(held[i], nullptr);
+  }
+  EXPECT_EQ(latest_value_callback_cnt, (unsigned int) 5);
+  pub_msg.data = 6;
+  rc = rcl_publish(&publisher, &pub_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  for (unsigned int k = 0; k < 20 && latest_value.dropped < 1; k++) {
+    rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+  }
+  EXPECT_EQ(latest_value.dropped, (uint64_t) 1);
+  EXPECT_EQ(latest_value_callback_cnt, (unsigned int) 5);
+  for (int32_t i = 0; i < 3; i++) {
+    rc = rclc_latest_value_release(&latest_value, held[i]);
+    EXPECT_EQ(RCL_RET_OK, rc);
+  }
+
+  // the sequence number shows the gap of the dropped message
+  pub_msg.data = 7;
+  rc = rcl_publish(&publisher, &pub_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  for (unsigned int k = 0; k < 20 && latest_value_callback_cnt < 6; k++) {
+    rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+  }
+  auto newest = static_cast<const std_msgs__msg__Int32 *>(
+    rclc_latest_value_acquire(&latest_value, &sequence_number));
+  ASSERT_NE(newest, nullptr);
+  EXPECT_EQ(newest->data, 7);
+  EXPECT_EQ(sequence_number, (uint64_t) 7);
+  rc = rclc_latest_value_release(&latest_value, newest);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // clean up
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_latest_value_fini(&latest_value);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_subscription_fini(&subscription, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_publisher_fini(&publisher, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
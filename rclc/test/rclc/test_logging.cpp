@@ -0,0 +1,90 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <rclc/logging.h>
+#include "rcl/error_handling.h"
+
+TEST(Test, rclc_logging_async) {
+  rcl_ret_t rc;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+
+  // not initialized: messages are logged synchronously
+  EXPECT_FALSE(rclc_logging_async_is_initialized());
+  EXPECT_FALSE(rclc_logging_async_write(RCLC_LOG_SEVERITY_INFO, "rclc", "message"));
+  EXPECT_EQ(rclc_logging_async_flush(), (size_t) 0);
+  rc = rclc_logging_async_fini();
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // tests with invalid arguments
+  rc = rclc_logging_async_init(0, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_logging_async_init(4, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_logging_async_init(3, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_TRUE(rclc_logging_async_is_initialized());
+  rc = rclc_logging_async_init(3, &allocator);
+  EXPECT_EQ(RCL_RET_ALREADY_INIT, rc);
+  rcutils_reset_error();
+
+  // capacity is rounded up to 4
+  for (long i = 0; i < 6; i++) {
+    EXPECT_TRUE(
+      rclc_logging_async_write(
+        RCLC_LOG_SEVERITY_INFO, "rclc", "message %ld of %ld", i, 6L));
+  }
+  EXPECT_EQ(rclc_logging_async_get_dropped(), (size_t) 2);
+  EXPECT_EQ(rclc_logging_async_flush(), (size_t) 4);
+  EXPECT_EQ(rclc_logging_async_flush(), (size_t) 0);
+
+  // too many arguments: logged synchronously
+  EXPECT_FALSE(
+    rclc_logging_async_write(
+      RCLC_LOG_SEVERITY_INFO, "rclc", "%ld %ld %ld %ld %ld", 1L, 2L, 3L, 4L, 5L));
+  // other conversions than %ld, %lu and %lx: logged synchronously
+  EXPECT_FALSE(rclc_logging_async_write(RCLC_LOG_SEVERITY_INFO, "rclc", "%s", "string"));
+  EXPECT_FALSE(rclc_logging_async_write(RCLC_LOG_SEVERITY_INFO, "rclc", "%d", 1));
+  EXPECT_FALSE(rclc_logging_async_write(RCLC_LOG_SEVERITY_INFO, "rclc", "%lf", 1.0));
+  EXPECT_FALSE(rclc_logging_async_write(RCLC_LOG_SEVERITY_INFO, "rclc", "%5ld", 1L));
+  EXPECT_FALSE(rclc_logging_async_write(RCLC_LOG_SEVERITY_INFO, "rclc", "trailing %"));
+  EXPECT_TRUE(
+    rclc_logging_async_write(
+      RCLC_LOG_SEVERITY_INFO, "rclc", "%ld %lu %lx", 1L, 2UL, 3UL));
+  // escaped percent signs are not counted as arguments
+  EXPECT_TRUE(
+    rclc_logging_async_write(
+      RCLC_LOG_SEVERITY_INFO, "rclc", "%%%%%%%% %ld%%", 100L));
+
+  // the macros use the asynchronous sink
+  RCLC_LOG_INFO_NAMED("rclc", "macro %ld", 1L);
+  EXPECT_EQ(rclc_logging_async_flush(), (size_t) 3);
+
+  // messages below the severity of the logger are not enqueued
+  rc = rcutils_logging_set_logger_level("rclc", RCUTILS_LOG_SEVERITY_WARN);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  RCLC_LOG_INFO_NAMED("rclc", "macro %ld", 2L);
+  RCLC_LOG_WARN_NAMED("rclc", "macro %ld", 3L);
+  EXPECT_EQ(rclc_logging_async_flush(), (size_t) 1);
+  rc = rcutils_logging_set_logger_level("rclc", RCUTILS_LOG_SEVERITY_UNSET);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rc = rclc_logging_async_fini();
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_FALSE(rclc_logging_async_write(RCLC_LOG_SEVERITY_INFO, "rclc", "message"));
+}
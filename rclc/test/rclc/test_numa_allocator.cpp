@@ -0,0 +1,129 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+#include <std_msgs/msg/int32.h>
+
+#include <cstring>
+
+#include "rcl/error_handling.h"
+
+TEST(Test, rclc_numa_allocator_init_fini) {
+  rcl_allocator_t allocator;
+  rclc_numa_allocator_options_t options = rclc_numa_allocator_get_default_options();
+  EXPECT_EQ(options.numa_node, RCLC_NUMA_NODE_CURRENT);
+
+  // tests with invalid arguments
+  rcl_ret_t rc = rclc_numa_allocator_init(nullptr, &options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_numa_allocator_init(&allocator, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  options.size = 0;
+  rc = rclc_numa_allocator_init(&allocator, &options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rcl_allocator_t default_allocator = rcl_get_default_allocator();
+  rc = rclc_numa_allocator_fini(&default_allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  options.size = 64 * 1024;
+  rc = rclc_numa_allocator_init(&allocator, &options);
+  ASSERT_EQ(RCL_RET_OK, rc);
+  EXPECT_TRUE(rcutils_allocator_is_valid(&allocator));
+  rclc_numa_allocator_info_t info;
+  rc = rclc_numa_allocator_get_info(&allocator, &info);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_GE(info.size, options.size);
+  EXPECT_EQ(info.used, (size_t) 0);
+
+  // blocks are aligned and freed blocks are merged again
+  void * a = allocator.allocate(100, allocator.state);
+  void * b = allocator.zero_allocate(10, 30, allocator.state);
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % 16, (uintptr_t) 0);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 16, (uintptr_t) 0);
+  EXPECT_EQ(static_cast<uint8_t *>(b)[299], 0);
+  memset(a, 0xff, 100);
+  a = allocator.reallocate(a, 1000, allocator.state);
+  ASSERT_NE(a, nullptr);
+  EXPECT_EQ(static_cast<uint8_t *>(a)[99], 0xff);
+  rc = rclc_numa_allocator_get_info(&allocator, &info);
+  EXPECT_GT(info.used, (size_t) 1300);
+  allocator.deallocate(a, allocator.state);
+  allocator.deallocate(b, allocator.state);
+  rc = rclc_numa_allocator_get_info(&allocator, &info);
+  EXPECT_EQ(info.used, (size_t) 0);
+
+  // allocations larger than the region use the default allocator
+  void * large = allocator.allocate(info.size + 1, allocator.state);
+  ASSERT_NE(large, nullptr);
+  rc = rclc_numa_allocator_get_info(&allocator, &info);
+  EXPECT_EQ(info.fallback_allocations, (uint64_t) 1);
+  EXPECT_EQ(info.used, (size_t) 0);
+  allocator.deallocate(large, allocator.state);
+
+  rc = rclc_numa_allocator_fini(&allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
+
+TEST(Test, rclc_numa_allocator_executor) {
+  rcl_allocator_t allocator;
+  rclc_numa_allocator_options_t options = rclc_numa_allocator_get_default_options();
+  options.size = 4 * 1024 * 1024;
+  rcl_ret_t rc = rclc_numa_allocator_init(&allocator, &options);
+  ASSERT_EQ(RCL_RET_OK, rc);
+
+  rclc_support_t support;
+  rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_numa_allocator_node", "", &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  rc = rclc_timer_init_default(&timer, &support, RCL_MS_TO_NS(10), nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &support.context, 10, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_add_timer(&executor, &timer);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_executor_spin_some(&executor, RCL_MS_TO_NS(20));
+  EXPECT_TRUE(RCL_RET_OK == rc || RCL_RET_TIMEOUT == rc);
+
+  // the handles of the executor are in the region
+  rclc_numa_allocator_info_t info;
+  rc = rclc_numa_allocator_get_info(&allocator, &info);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_GE(info.used, 10 * sizeof(rclc_executor_handle_t));
+
+  // clean up
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_timer_fini(&timer);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_numa_allocator_fini(&allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
@@ -16,6 +16,7 @@
 #include <std_msgs/msg/int32.h>
 #include <gtest/gtest.h>
 #include <rclc/rclc.h>
+#include <rclc/sleep.h>
 
 TEST(Test, rclc_publisher_init_default) {
   rclc_support_t support;
@@ -154,3 +155,84 @@ TEST(Test, rclc_publisher_init_qos) {
   rc = rclc_support_fini(&support);
   EXPECT_EQ(RCL_RET_OK, rc);
 }
+
+TEST(Test, rclc_change_publisher) {
+  rclc_support_t support;
+  rcl_ret_t rc;
+
+  // preliminary setup
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_pub_change", "test_namespace", &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32);
+  rc = rclc_publisher_init_default(&publisher, &node, type_support, "topic1");
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_change_publisher_t change_publisher = rclc_change_publisher_get_zero_initialized();
+
+  // tests with invalid arguments
+  rc = rclc_change_publisher_init(nullptr, &publisher, type_support, 0, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_change_publisher_init(&change_publisher, nullptr, type_support, 0, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_change_publisher_init(&change_publisher, &publisher, nullptr, 0, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_change_publisher_init(&change_publisher, &publisher, type_support, -1, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  // no heartbeat: unchanged messages are suppressed
+  rc = rclc_change_publisher_init(&change_publisher, &publisher, type_support, 0, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  std_msgs__msg__Int32 msg;
+  msg.data = 1;
+  bool published = false;
+  rc = rclc_change_publisher_publish(&change_publisher, &msg, &published);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_TRUE(published);
+  rc = rclc_change_publisher_publish(&change_publisher, &msg, &published);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_FALSE(published);
+  msg.data = 2;
+  rc = rclc_change_publisher_publish(&change_publisher, &msg, &published);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_TRUE(published);
+  rc = rclc_change_publisher_publish(&change_publisher, &msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(change_publisher.suppressed, (size_t) 2);
+  rc = rclc_change_publisher_publish(&change_publisher, nullptr, &published);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_change_publisher_fini(&change_publisher);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // heartbeat: unchanged messages are sent again after the interval
+  rc = rclc_change_publisher_init(
+    &change_publisher, &publisher, type_support, RCL_MS_TO_NS(20), &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_change_publisher_publish(&change_publisher, &msg, &published);
+  EXPECT_TRUE(published);
+  rc = rclc_change_publisher_publish(&change_publisher, &msg, &published);
+  EXPECT_FALSE(published);
+  rclc_sleep_ms(30);
+  rc = rclc_change_publisher_publish(&change_publisher, &msg, &published);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_TRUE(published);
+  rc = rclc_change_publisher_fini(&change_publisher);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // clean up
+  rc = rcl_publisher_fini(&publisher, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
@@ -0,0 +1,212 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+#include <example_interfaces/srv/add_two_ints.h>
+
+#include "rcl/error_handling.h"
+#include "rclc/service_cache_internal.h"
+
+static unsigned int add_two_ints_cnt = 0;
+
+static void add_two_ints_callback(const void * req_msg, void * resp_msg)
+{
+  const example_interfaces__srv__AddTwoInts_Request * req =
+    (const example_interfaces__srv__AddTwoInts_Request *) req_msg;
+  example_interfaces__srv__AddTwoInts_Response * resp =
+    (example_interfaces__srv__AddTwoInts_Response *) resp_msg;
+  resp->sum = req->a + req->b;
+  add_two_ints_cnt++;
+}
+
+TEST(Test, rclc_service_cache) {
+  rcl_ret_t rc;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  const rosidl_message_type_support_t * request_type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(example_interfaces, srv, AddTwoInts_Request);
+  const rosidl_message_type_support_t * response_type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(example_interfaces, srv, AddTwoInts_Response);
+  rclc_service_cache_t cache = rclc_service_cache_get_zero_initialized();
+
+  // tests with invalid arguments
+  rc = rclc_service_cache_init(
+    nullptr, 2, request_type_support, response_type_support, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_service_cache_init(
+    &cache, 0, request_type_support, response_type_support, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_service_cache_init(&cache, 2, nullptr, response_type_support, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_service_cache_init(
+    &cache, 2, request_type_support, response_type_support, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  example_interfaces__srv__AddTwoInts_Request req1, req2, req3;
+  example_interfaces__srv__AddTwoInts_Response resp;
+  req1.a = 1; req1.b = 2;
+  req2.a = 3; req2.b = 4;
+  req3.a = 5; req3.b = 6;
+
+  // miss, then store the response
+  bool hit = true;
+  rc = rclc_service_cache_lookup(&cache, &req1, &resp, &hit);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_FALSE(hit);
+  resp.sum = 3;
+  rc = rclc_service_cache_store(&cache, &resp);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // hit
+  resp.sum = 0;
+  rc = rclc_service_cache_lookup(&cache, &req1, &resp, &hit);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_TRUE(hit);
+  EXPECT_EQ(resp.sum, 3);
+
+  // fill the cache, req1 was used last, so req2 is replaced by req3
+  rc = rclc_service_cache_lookup(&cache, &req2, &resp, &hit);
+  EXPECT_FALSE(hit);
+  resp.sum = 7;
+  rc = rclc_service_cache_store(&cache, &resp);
+  rc = rclc_service_cache_lookup(&cache, &req1, &resp, &hit);
+  EXPECT_TRUE(hit);
+  rc = rclc_service_cache_lookup(&cache, &req3, &resp, &hit);
+  EXPECT_FALSE(hit);
+  resp.sum = 11;
+  rc = rclc_service_cache_store(&cache, &resp);
+  rc = rclc_service_cache_lookup(&cache, &req2, &resp, &hit);
+  EXPECT_FALSE(hit);
+  rc = rclc_service_cache_lookup(&cache, &req3, &resp, &hit);
+  EXPECT_TRUE(hit);
+  EXPECT_EQ(resp.sum, 11);
+  rc = rclc_service_cache_lookup(&cache, &req1, &resp, &hit);
+  EXPECT_TRUE(hit);
+  EXPECT_EQ(resp.sum, 3);
+  EXPECT_EQ(cache.hits, (size_t) 4);
+  EXPECT_EQ(cache.misses, (size_t) 4);
+
+  // invalidation of a single request and of all requests
+  rc = rclc_service_cache_invalidate(&cache, &req1);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_service_cache_lookup(&cache, &req1, &resp, &hit);
+  EXPECT_FALSE(hit);
+  rc = rclc_service_cache_lookup(&cache, &req3, &resp, &hit);
+  EXPECT_TRUE(hit);
+  rc = rclc_service_cache_clear(&cache);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_service_cache_lookup(&cache, &req3, &resp, &hit);
+  EXPECT_FALSE(hit);
+
+  rc = rclc_service_cache_fini(&cache);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
+
+TEST(Test, rclc_executor_set_service_cache) {
+  rclc_support_t support;
+  rcl_ret_t rc;
+
+  // preliminary setup
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_service_cache_node", "", &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  const rosidl_service_type_support_t * type_support =
+    ROSIDL_GET_SRV_TYPE_SUPPORT(example_interfaces, srv, AddTwoInts);
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rc = rclc_service_init_default(&service, &node, type_support, "cached_add_two_ints");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rc = rclc_client_init_default(&client, &node, type_support, "cached_add_two_ints");
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_service_cache_t cache = rclc_service_cache_get_zero_initialized();
+  rc = rclc_service_cache_init(
+    &cache, 4,
+    ROSIDL_GET_MSG_TYPE_SUPPORT(example_interfaces, srv, AddTwoInts_Request),
+    ROSIDL_GET_MSG_TYPE_SUPPORT(example_interfaces, srv, AddTwoInts_Response),
+    &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &support.context, 1, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  example_interfaces__srv__AddTwoInts_Request service_req;
+  example_interfaces__srv__AddTwoInts_Response service_resp;
+  rc = rclc_executor_add_service(
+    &executor, &service, &service_req, &service_resp, &add_two_ints_callback);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // tests with invalid arguments
+  rc = rclc_executor_set_service_cache(&executor, nullptr, &cache);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rcl_service_t other_service = rcl_get_zero_initialized_service();
+  rc = rclc_executor_set_service_cache(&executor, &other_service, &cache);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_set_service_cache(&executor, &service, &cache);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // the same request three times: the callback is called once
+  rclc_discovery_t discovery = rclc_discovery_get_zero_initialized();
+  rc = rclc_discovery_init_service_server(&discovery, &node, &client);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_discovery_wait(&discovery, &support.context, RCL_S_TO_NS(5), &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  add_two_ints_cnt = 0;
+  example_interfaces__srv__AddTwoInts_Request req;
+  example_interfaces__srv__AddTwoInts_Response resp;
+  rmw_service_info_t response_header;
+  req.a = 20;
+  req.b = 22;
+  for (unsigned int i = 0; i < 3; i++) {
+    int64_t seq = 0;
+    rc = rcl_send_request(&client, &req, &seq);
+    EXPECT_EQ(RCL_RET_OK, rc);
+    resp.sum = 0;
+    for (unsigned int k = 0; k < 100; k++) {
+      rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+      if (RCL_RET_OK == rcl_take_response_with_info(&client, &response_header, &resp)) {
+        break;
+      }
+    }
+    EXPECT_EQ(resp.sum, 42);
+  }
+  EXPECT_EQ(add_two_ints_cnt, (unsigned int) 1);
+  EXPECT_EQ(cache.hits, (size_t) 2);
+
+  // clean up
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_service_cache_fini(&cache);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_client_fini(&client, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_service_fini(&service, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <rclc/rclc.h>
+#include <rclc/static_executor.hpp>
+#include <std_msgs/msg/int32.h>
+
+#include <vector>
+
+#include "rcl/error_handling.h"
+
+TEST(Test, rclc_static_executor) {
+  rclc_support_t support;
+  rcl_ret_t rc;
+
+  // preliminary setup
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_static_executor_node", "", &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  const rosidl_message_type_support_t * type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rc = rclc_publisher_init_default(&publisher, &node, type_support, "static_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_subscription_t subscription1 = rcl_get_zero_initialized_subscription();
+  rc = rclc_subscription_init_default(&subscription1, &node, type_support, "static_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_subscription_t subscription2 = rcl_get_zero_initialized_subscription();
+  rc = rclc_subscription_init_default(&subscription2, &node, type_support, "static_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // timer without an rcl callback, it is dispatched by the static executor
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  rc = rclc_timer_init_default(&timer, &support, RCL_MS_TO_NS(1), NULL);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // the callbacks record the processing order
+  std::vector<int> order;
+  int sum = 0;
+  unsigned int timer_cnt = 0;
+  std_msgs__msg__Int32 msg1;
+  std_msgs__msg__Int32 msg2;
+  {
+    rclc::static_executor executor(
+      rclc::static_subscription(
+        &subscription1, &msg1,
+        [&](const std_msgs__msg__Int32 & msg) {order.push_back(1); sum += msg.data;}),
+      rclc::static_subscription(
+        &subscription2, &msg2,
+        [&](const std_msgs__msg__Int32 & msg) {order.push_back(2); sum += msg.data;}),
+      rclc::static_timer(&timer, [&](rcl_timer_t *, int64_t) {timer_cnt++;}));
+    static_assert(decltype(executor)::number_of_subscriptions == 2, "two subscriptions");
+    static_assert(decltype(executor)::number_of_timers == 1, "one timer");
+    static_assert(decltype(executor)::number_of_services == 0, "no service");
+
+    rc = executor.init(&support.context, allocator);
+    EXPECT_EQ(RCL_RET_OK, rc);
+
+    std_msgs__msg__Int32 pub_msg;
+    pub_msg.data = 3;
+    rc = rcl_publish(&publisher, &pub_msg, nullptr);
+    EXPECT_EQ(RCL_RET_OK, rc);
+    for (unsigned int i = 0; i < 50 && sum < 6; i++) {
+      rc = executor.spin_some(RCL_MS_TO_NS(10));
+      EXPECT_TRUE(RCL_RET_OK == rc || RCL_RET_TIMEOUT == rc);
+    }
+    EXPECT_EQ(sum, 6);
+    EXPECT_GT(timer_cnt, (unsigned int) 0);
+    // each subscription has taken the message once
+    ASSERT_EQ(order.size(), (size_t) 2);
+    EXPECT_NE(order[0], order[1]);
+
+    rc = executor.fini();
+    EXPECT_EQ(RCL_RET_OK, rc);
+    // a second fini is a no-op, the destructor calls it as well
+    rc = executor.fini();
+    EXPECT_EQ(RCL_RET_OK, rc);
+  }
+
+  // clean up
+  rc = rcl_timer_fini(&timer);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_subscription_fini(&subscription1, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_subscription_fini(&subscription2, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_publisher_fini(&publisher, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
@@ -0,0 +1,210 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+#include <std_msgs/msg/int32.h>
+
+#include <string.h>
+
+#include "rcl/error_handling.h"
+#include "rclc/topic_statistics_internal.h"
+
+static unsigned int topic_statistics_cnt = 0;
+
+static void topic_statistics_callback(const void * msgin)
+{
+  (void) msgin;
+  topic_statistics_cnt++;
+}
+
+// the message info has publication sequence numbers since Humble
+static void set_sequence_number(rmw_message_info_t * message_info, uint64_t sequence_number)
+{
+#ifdef RCLC_HAVE_PUBLICATION_SEQUENCE_NUMBER
+  message_info->publication_sequence_number = sequence_number;
+#else
+  (void) message_info;
+  (void) sequence_number;
+#endif
+}
+
+TEST(Test, rclc_topic_statistics_record) {
+  rclc_topic_statistics_t stats = rclc_topic_statistics_get_zero_initialized();
+  rcl_ret_t rc = rclc_topic_statistics_init(nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_topic_statistics_init(&stats);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_GT(stats.window_start, 0);
+
+  // messages of one publisher received every 10ms +- 2ms, sequence number 4 is lost
+  const int64_t periods_ms[] = {0, 8, 12, 10, 10};
+  const uint64_t sequence_numbers[] = {1, 2, 3, 5, 6};
+  rmw_message_info_t message_info;
+  memset(&message_info, 0, sizeof(message_info));
+  message_info.publisher_gid.data[0] = 1;
+  rcutils_time_point_value_t now = 0;
+  rcutils_system_time_now(&now);
+  rcutils_time_point_value_t received = now - RCL_MS_TO_NS(100);
+  for (size_t i = 0; i < 5; i++) {
+    received += RCL_MS_TO_NS(periods_ms[i]);
+    message_info.received_timestamp = received;
+    message_info.source_timestamp = received - RCL_MS_TO_NS(1);
+    set_sequence_number(&message_info, sequence_numbers[i]);
+    rclc_topic_statistics_record(&stats, &message_info);
+  }
+  EXPECT_EQ(stats.messages, (uint64_t) 5);
+  EXPECT_EQ(stats.period.count, (uint64_t) 4);
+  EXPECT_DOUBLE_EQ(stats.period.mean, (double) RCL_MS_TO_NS(10));
+  EXPECT_DOUBLE_EQ(stats.period.min, (double) RCL_MS_TO_NS(8));
+  EXPECT_DOUBLE_EQ(stats.period.max, (double) RCL_MS_TO_NS(12));
+  // (4 + 4 + 0 + 0) ms^2 / 3
+  EXPECT_NEAR(
+    rclc_topic_statistics_variance(&stats.period), 8.0 / 3.0 * 1e12, 1e6);
+  EXPECT_EQ(stats.age.count, (uint64_t) 5);
+  EXPECT_GE(stats.age.min, (double) RCL_MS_TO_NS(1));
+  EXPECT_LE(stats.age.min, stats.age.max);
+#ifdef RCLC_HAVE_PUBLICATION_SEQUENCE_NUMBER
+  EXPECT_EQ(stats.dropped, (uint64_t) 1);
+#endif
+
+  // the next window continues the period of the last message
+  rc = rclc_topic_statistics_reset(&stats);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(stats.messages, (uint64_t) 0);
+  EXPECT_EQ(stats.period.count, (uint64_t) 0);
+  EXPECT_EQ(stats.dropped, (uint64_t) 0);
+  received += RCL_MS_TO_NS(10);
+  message_info.received_timestamp = received;
+  set_sequence_number(&message_info, 9);
+  rclc_topic_statistics_record(&stats, &message_info);
+  EXPECT_EQ(stats.period.count, (uint64_t) 1);
+  EXPECT_DOUBLE_EQ(stats.period.mean, (double) RCL_MS_TO_NS(10));
+  EXPECT_DOUBLE_EQ(rclc_topic_statistics_variance(&stats.period), 0.0);
+#ifdef RCLC_HAVE_PUBLICATION_SEQUENCE_NUMBER
+  EXPECT_EQ(stats.dropped, (uint64_t) 2);
+#endif
+
+  // the first message of another publisher is no gap
+  message_info.publisher_gid.data[0] = 2;
+  set_sequence_number(&message_info, 100);
+  rclc_topic_statistics_record(&stats, &message_info);
+#ifdef RCLC_HAVE_PUBLICATION_SEQUENCE_NUMBER
+  EXPECT_EQ(stats.dropped, (uint64_t) 2);
+#endif
+}
+
+TEST(Test, rclc_executor_set_topic_statistics) {
+  rclc_support_t support;
+  rcl_ret_t rc;
+
+  // preliminary setup
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, "test_topic_statistics_node", "", &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  const rosidl_message_type_support_t * type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rc = rclc_publisher_init_default(&publisher, &node, type_support, "topic_statistics_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rc = rclc_subscription_init_default(
+    &subscription, &node, type_support, "topic_statistics_topic");
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &support.context, 1, &allocator);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  std_msgs__msg__Int32 sub_msg;
+  rc = rclc_executor_add_subscription(
+    &executor, &subscription, &sub_msg, &topic_statistics_callback, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rclc_topic_statistics_t stats = rclc_topic_statistics_get_zero_initialized();
+  rc = rclc_topic_statistics_init(&stats);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // tests with invalid arguments
+  rc = rclc_executor_set_topic_statistics(nullptr, &subscription, &stats);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_topic_statistics(&executor, nullptr, &stats);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rcl_subscription_t other_subscription = rcl_get_zero_initialized_subscription();
+  rc = rclc_executor_set_topic_statistics(&executor, &other_subscription, &stats);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_set_topic_statistics(&executor, &subscription, &stats);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  std_msgs__msg__Int32 pub_msg;
+  topic_statistics_cnt = 0;
+  for (int32_t i = 1; i <= 3; i++) {
+    pub_msg.data = i;
+    rc = rcl_publish(&publisher, &pub_msg, nullptr);
+    EXPECT_EQ(RCL_RET_OK, rc);
+    for (unsigned int k = 0; k < 20 && topic_statistics_cnt < (unsigned int) i; k++) {
+      rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+    }
+  }
+  EXPECT_EQ(topic_statistics_cnt, (unsigned int) 3);
+  EXPECT_EQ(stats.messages, (uint64_t) 3);
+  EXPECT_EQ(stats.period.count, (uint64_t) 2);
+  EXPECT_GE(stats.period.min, 0.0);
+  EXPECT_EQ(stats.dropped, (uint64_t) 0);
+
+#ifdef RCLC_HAVE_STATISTICS_MSGS
+  // publish in the rclcpp format, which starts a new window
+  rclc_topic_statistics_publisher_t statistics_publisher =
+    rclc_topic_statistics_publisher_get_zero_initialized();
+  rc = rclc_topic_statistics_publisher_init(&statistics_publisher, nullptr, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_topic_statistics_publisher_init(&statistics_publisher, &node, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_STREQ(
+    rcl_publisher_get_topic_name(&statistics_publisher.publisher),
+    RCLC_TOPIC_STATISTICS_DEFAULT_TOPIC);
+  EXPECT_STREQ(
+    statistics_publisher.age_msg.measurement_source_name.data, "test_topic_statistics_node");
+  EXPECT_STREQ(statistics_publisher.period_msg.metrics_source.data, "message_period");
+  rc = rclc_topic_statistics_publish(&statistics_publisher, &stats);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  ASSERT_EQ(statistics_publisher.period_msg.statistics.size, (size_t) 5);
+  EXPECT_EQ(statistics_publisher.period_msg.statistics.data[4].data, 2.0);
+  EXPECT_EQ(stats.messages, (uint64_t) 0);
+  rc = rclc_topic_statistics_publisher_fini(&statistics_publisher, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+#endif
+
+  // clean-up
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_subscription_fini(&subscription, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_publisher_fini(&publisher, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
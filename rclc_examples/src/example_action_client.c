@@ -191,7 +191,13 @@ int main()
     (void *) &action_client
   );
 
-  sleep(1);
+  // Wait until the action server has been discovered before sending the goal
+  rclc_discovery_t discovery = rclc_discovery_get_zero_initialized();
+  rclc_discovery_init_action_server(&discovery, &node, &action_client.rcl_handle);
+  if (RCL_RET_OK != rclc_discovery_wait(&discovery, &support.context, -1, &allocator)) {
+    printf("Error waiting for action server\n");
+    return 1;
+  }
 
   if (RCL_RET_OK !=
     rclc_action_send_goal_request(&action_client, &ros_goal_request[0], NULL))
@@ -78,11 +78,11 @@ void * fibonacci_worker(void * args)
 
   printf("Goal %d %s\n", req->goal.order, goalResult[goal_state]);
 
-  rcl_ret_t rc;
-  do {
-    rc = rclc_action_send_result(goal_handle, goal_state, &response);
-    usleep(1e6);
-  } while (rc != RCL_RET_OK);
+  // the result is stored if the client has not requested it yet
+  rcl_ret_t rc = rclc_action_send_result(goal_handle, goal_state, &response);
+  if (rc != RCL_RET_OK) {
+    printf("Error sending result of goal %d\n", req->goal.order);
+  }
 
   free(feedback.feedback.sequence.data);
   pthread_exit(NULL);
@@ -116,6 +116,21 @@ bool handle_cancel(rclc_action_goal_handle_t * goal_handle, void * context)
   return true;
 }
 
+// Result storage callbacks: the generated functions take typed pointers, so they are
+// wrapped instead of casting them to the untyped callback types
+bool copy_result(const void * ros_response, void * ros_result_response)
+{
+  return example_interfaces__action__Fibonacci_GetResult_Response__copy(
+    (const example_interfaces__action__Fibonacci_GetResult_Response *) ros_response,
+    (example_interfaces__action__Fibonacci_GetResult_Response *) ros_result_response);
+}
+
+void fini_result(void * ros_result_response)
+{
+  example_interfaces__action__Fibonacci_GetResult_Response__fini(
+    (example_interfaces__action__Fibonacci_GetResult_Response *) ros_result_response);
+}
+
 int main()
 {
   rcl_allocator_t allocator = rcl_get_default_allocator();
@@ -159,6 +174,17 @@ int main()
     handle_cancel,
     (void *) &action_server);
 
+  // results finished before the client requests them are sent by the executor
+  if (RCL_RET_OK != rclc_action_server_set_result_storage(
+      &action_server,
+      sizeof(example_interfaces__action__Fibonacci_GetResult_Response),
+      copy_result,
+      fini_result))
+  {
+    printf("Error setting the result storage\n");
+    return 1;
+  }
+
   while (1) {
     rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
     usleep(100000);
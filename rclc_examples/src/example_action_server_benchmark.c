@@ -0,0 +1,348 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures how the cost of an action server grows with the number of goals in
+// flight. For each number of goals, a local action client sends all goals to a
+// local action server, which keeps them active. Then the server publishes one
+// feedback per goal, the client cancels every second goal and finally the server
+// sends all results. The requests of each phase are issued with at most WINDOW
+// outstanding ones, so that no request is dropped by the queues of the middleware.
+//
+// Reported are the mean and maximum time of a spin of the server executor and
+// the mean round-trip time of each phase: goal request to goal response, feedback
+// publish to feedback callback, cancel request to cancel response and result send
+// to result callback. Most of the time depends on the number of goals through the
+// lookup of the goal handles by their id.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <rcl/rcl.h>
+#include <rcl/error_handling.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+#include <rclc/discovery.h>
+
+#include <example_interfaces/action/fibonacci.h>
+
+#define RCCHECK(fn) { \
+    rcl_ret_t temp_rc = fn; \
+    if ((temp_rc != RCL_RET_OK)) { \
+      printf( \
+        "Failed status on line %d: %d. Aborting.\n", __LINE__, (int)temp_rc); \
+      return 1; \
+    } \
+}
+
+#define WINDOW 8
+#define PROGRESS_TIMEOUT_NS RCL_S_TO_NS(10)
+
+static const size_t goal_counts[] = {1, 10, 100, 1000};
+
+typedef struct
+{
+  int64_t sum;
+  int64_t max;
+  size_t count;
+} measurement_t;
+
+static measurement_t spin_time;
+static measurement_t goal_rtt;
+static measurement_t feedback_rtt;
+static measurement_t cancel_rtt;
+static measurement_t result_rtt;
+
+static rclc_executor_t server_executor;
+static rclc_executor_t client_executor;
+static rclc_action_client_t action_client;
+
+// state of the goals of a run, indexed by the order of the goal
+static example_interfaces__action__Fibonacci_SendGoal_Request * goal_requests = NULL;
+static rclc_action_goal_handle_t ** server_goals = NULL;
+static rclc_action_goal_handle_t ** client_goals = NULL;
+static rcutils_time_point_value_t * issue_times = NULL;
+static example_interfaces__action__Fibonacci_FeedbackMessage server_feedback;
+
+static size_t goals_answered = 0;
+static size_t feedbacks_received = 0;
+static size_t cancels_answered = 0;
+static size_t results_received = 0;
+
+static rcutils_time_point_value_t now(void)
+{
+  rcutils_time_point_value_t time = 0;
+  rcutils_ret_t rc = rcutils_steady_time_now(&time);
+  RCLC_UNUSED(rc);
+  return time;
+}
+
+static void measurement_add(measurement_t * m, int64_t ns)
+{
+  m->sum += ns;
+  m->count++;
+  if (ns > m->max) {
+    m->max = ns;
+  }
+}
+
+static double measurement_mean_us(const measurement_t * m)
+{
+  return (0 == m->count) ? 0.0 : (double) m->sum / (double) m->count / 1000.0;
+}
+
+static size_t goal_index(rclc_action_goal_handle_t * goal_handle)
+{
+  example_interfaces__action__Fibonacci_SendGoal_Request * request =
+    (example_interfaces__action__Fibonacci_SendGoal_Request *) goal_handle->ros_goal_request;
+  return (size_t) request->goal.order;
+}
+
+static void record_answer(size_t index, measurement_t * m, size_t * answered)
+{
+  measurement_add(m, now() - issue_times[index]);
+  (*answered)++;
+}
+
+// server callbacks
+rcl_ret_t handle_goal(rclc_action_goal_handle_t * goal_handle, void * context)
+{
+  (void) context;
+  server_goals[goal_index(goal_handle)] = goal_handle;
+  return RCL_RET_ACTION_GOAL_ACCEPTED;
+}
+
+bool handle_cancel(rclc_action_goal_handle_t * goal_handle, void * context)
+{
+  (void) context;
+  (void) goal_handle;
+  return true;
+}
+
+// client callbacks
+void goal_request_callback(rclc_action_goal_handle_t * goal_handle, bool accepted, void * context)
+{
+  (void) context;
+  (void) accepted;
+  record_answer(goal_index(goal_handle), &goal_rtt, &goals_answered);
+}
+
+void feedback_callback(rclc_action_goal_handle_t * goal_handle, void * ros_feedback, void * context)
+{
+  (void) context;
+  (void) ros_feedback;
+  record_answer(goal_index(goal_handle), &feedback_rtt, &feedbacks_received);
+}
+
+void result_request_callback(
+  rclc_action_goal_handle_t * goal_handle, void * ros_result_response,
+  void * context)
+{
+  (void) context;
+  (void) ros_result_response;
+  record_answer(goal_index(goal_handle), &result_rtt, &results_received);
+}
+
+void cancel_request_callback(
+  rclc_action_goal_handle_t * goal_handle, bool cancelled,
+  void * context)
+{
+  (void) context;
+  (void) cancelled;
+  record_answer(goal_index(goal_handle), &cancel_rtt, &cancels_answered);
+}
+
+// requests of the phases, the index is the goal order
+static rcl_ret_t send_goal(size_t index)
+{
+  issue_times[index] = now();
+  return rclc_action_send_goal_request(
+    &action_client, &goal_requests[index], &client_goals[index]);
+}
+
+static rcl_ret_t publish_feedback(size_t index)
+{
+  issue_times[index] = now();
+  return rclc_action_publish_feedback(server_goals[index], &server_feedback);
+}
+
+// every second goal is cancelled
+static rcl_ret_t send_cancel(size_t k)
+{
+  size_t index = 2 * k + 1;
+  issue_times[index] = now();
+  return rclc_action_send_cancel_request(client_goals[index]);
+}
+
+static rcl_ret_t send_result(size_t index)
+{
+  example_interfaces__action__Fibonacci_GetResult_Response response = {0};
+  rcl_action_goal_state_t status = (index % 2) ? GOAL_STATE_CANCELED : GOAL_STATE_SUCCEEDED;
+  issue_times[index] = now();
+  return rclc_action_send_result(server_goals[index], status, &response);
+}
+
+static void spin_once(void)
+{
+  rcutils_time_point_value_t start = now();
+  rcl_ret_t rc = rclc_executor_spin_some(&server_executor, 0);
+  measurement_add(&spin_time, now() - start);
+  rc = rclc_executor_spin_some(&client_executor, 0);
+  RCLC_UNUSED(rc);
+}
+
+// issues count requests with at most WINDOW outstanding ones and spins both
+// executors until all have been answered
+static rcl_ret_t run_phase(
+  const char * name, size_t count, rcl_ret_t (* issue)(size_t),
+  const size_t * answered)
+{
+  size_t issued = 0;
+  size_t last_answered = *answered;
+  rcutils_time_point_value_t last_progress = now();
+  while (*answered < count) {
+    while (issued < count && issued - *answered < WINDOW) {
+      rcl_ret_t rc = issue(issued);
+      if (RCL_RET_OK != rc) {
+        printf("%s: request %zu failed: %s\n", name, issued, rcl_get_error_string().str);
+        rcl_reset_error();
+        return rc;
+      }
+      issued++;
+    }
+    spin_once();
+    if (*answered != last_answered) {
+      last_answered = *answered;
+      last_progress = now();
+    } else if (now() - last_progress > PROGRESS_TIMEOUT_NS) {
+      printf("%s: only %zu of %zu requests answered\n", name, *answered, count);
+      return RCL_RET_TIMEOUT;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+static int run(rclc_support_t * support, rcl_node_t * node, rcl_allocator_t * allocator, size_t n)
+{
+  goal_requests = calloc(n, sizeof(example_interfaces__action__Fibonacci_SendGoal_Request));
+  example_interfaces__action__Fibonacci_SendGoal_Request * server_requests =
+    calloc(n, sizeof(example_interfaces__action__Fibonacci_SendGoal_Request));
+  server_goals = calloc(n, sizeof(rclc_action_goal_handle_t *));
+  client_goals = calloc(n, sizeof(rclc_action_goal_handle_t *));
+  issue_times = calloc(n, sizeof(rcutils_time_point_value_t));
+  if (NULL == goal_requests || NULL == server_requests || NULL == server_goals ||
+    NULL == client_goals || NULL == issue_times)
+  {
+    printf("Could not allocate memory for %zu goals\n", n);
+    return 1;
+  }
+  for (size_t i = 0; i < n; i++) {
+    goal_requests[i].goal.order = (int32_t) i;
+  }
+  spin_time = goal_rtt = feedback_rtt = cancel_rtt = result_rtt = (measurement_t) {0};
+  goals_answered = feedbacks_received = cancels_answered = results_received = 0;
+
+  // each run uses its own action, so the client does not discover the previous server
+  char action_name[64];
+  snprintf(action_name, sizeof(action_name), "fibonacci_benchmark_%zu", n);
+  const rosidl_action_type_support_t * type_support =
+    ROSIDL_GET_ACTION_TYPE_SUPPORT(example_interfaces, Fibonacci);
+
+  rclc_action_server_t action_server;
+  RCCHECK(
+    rclc_action_server_init_default(&action_server, node, support, type_support, action_name));
+  server_executor = rclc_executor_get_zero_initialized_executor();
+  RCCHECK(rclc_executor_init(&server_executor, &support->context, 1, allocator));
+  RCCHECK(
+    rclc_executor_add_action_server(
+      &server_executor, &action_server, n, server_requests,
+      sizeof(example_interfaces__action__Fibonacci_SendGoal_Request),
+      handle_goal, handle_cancel, NULL));
+  RCCHECK(
+    rclc_action_server_set_result_storage(
+      &action_server, sizeof(example_interfaces__action__Fibonacci_GetResult_Response),
+      (rclc_action_server_result_copy_t)
+      example_interfaces__action__Fibonacci_GetResult_Response__copy,
+      (rclc_action_server_result_fini_t)
+      example_interfaces__action__Fibonacci_GetResult_Response__fini));
+
+  example_interfaces__action__Fibonacci_FeedbackMessage client_feedback;
+  example_interfaces__action__Fibonacci_GetResult_Response client_result;
+  example_interfaces__action__Fibonacci_FeedbackMessage__init(&client_feedback);
+  example_interfaces__action__Fibonacci_GetResult_Response__init(&client_result);
+  RCCHECK(rclc_action_client_init_default(&action_client, node, type_support, action_name));
+  client_executor = rclc_executor_get_zero_initialized_executor();
+  RCCHECK(rclc_executor_init(&client_executor, &support->context, 1, allocator));
+  RCCHECK(
+    rclc_executor_add_action_client(
+      &client_executor, &action_client, n, &client_result, &client_feedback,
+      goal_request_callback, feedback_callback, result_request_callback,
+      cancel_request_callback, NULL));
+
+  rclc_discovery_t discovery = rclc_discovery_get_zero_initialized();
+  RCCHECK(rclc_discovery_init_action_server(&discovery, node, &action_client.rcl_handle));
+  RCCHECK(rclc_discovery_wait(&discovery, &support->context, RCL_S_TO_NS(10), allocator));
+
+  // all goals are in flight after the first phase
+  RCCHECK(run_phase("goal", n, send_goal, &goals_answered));
+  RCCHECK(run_phase("feedback", n, publish_feedback, &feedbacks_received));
+  RCCHECK(run_phase("cancel", n / 2, send_cancel, &cancels_answered));
+  RCCHECK(run_phase("result", n, send_result, &results_received));
+
+  printf(
+    "%5zu | %9.2f | %8.2f | %8.2f | %8.2f | %8.2f | %8.2f\n",
+    n, measurement_mean_us(&spin_time), (double) spin_time.max / 1000.0,
+    measurement_mean_us(&goal_rtt), measurement_mean_us(&feedback_rtt),
+    measurement_mean_us(&cancel_rtt), measurement_mean_us(&result_rtt));
+
+  // clean up
+  RCCHECK(rclc_executor_fini(&client_executor));
+  RCCHECK(rclc_action_client_fini(&action_client, node));
+  RCCHECK(rclc_executor_fini(&server_executor));
+  RCCHECK(rclc_action_server_fini(&action_server, node));
+  example_interfaces__action__Fibonacci_FeedbackMessage__fini(&client_feedback);
+  example_interfaces__action__Fibonacci_GetResult_Response__fini(&client_result);
+  free(goal_requests);
+  free(server_requests);
+  free(server_goals);
+  free(client_goals);
+  free(issue_times);
+  return 0;
+}
+
+int main(int argc, const char * argv[])
+{
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rclc_support_t support;
+
+  RCCHECK(rclc_support_init(&support, argc, argv, &allocator));
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  RCCHECK(rclc_node_init_default(&node, "action_server_benchmark", "", &support));
+  example_interfaces__action__Fibonacci_FeedbackMessage__init(&server_feedback);
+
+  printf(
+    "goals | spin mean | spin max | goal rtt | feedback |   cancel |   result\n"
+    "      |      [us] |     [us] |     [us] |     [us] |     [us] |     [us]\n");
+  for (size_t i = 0; i < sizeof(goal_counts) / sizeof(goal_counts[0]); i++) {
+    if (0 != run(&support, &node, &allocator, goal_counts[i])) {
+      return 1;
+    }
+  }
+
+  // clean up
+  example_interfaces__action__Fibonacci_FeedbackMessage__fini(&server_feedback);
+  RCCHECK(rcl_node_fini(&node));
+  RCCHECK(rclc_support_fini(&support));
+  return 0;
+}
@@ -75,7 +75,10 @@ int main(int argc, const char * const * argv)
   req.a = 24;
   req.b = 42;
 
-  rclc_sleep_ms(2000);   // Sleep a while to ensure DDS matching before sending request
+  // Wait until the service server has been discovered before sending the request
+  rclc_discovery_t discovery = rclc_discovery_get_zero_initialized();
+  RCCHECK(rclc_discovery_init_service_server(&discovery, &node, &client));
+  RCCHECK(rclc_discovery_wait(&discovery, &support.context, -1, &allocator));
 
   RCCHECK(rcl_send_request(&client, &req, &seq))
   printf("Send service request %ld + %ld.\n", req.a, req.b);
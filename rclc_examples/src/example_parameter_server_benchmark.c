@@ -0,0 +1,303 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures how the parameter server scales with the number of parameters.
+// For 10 to 10000 integer parameters, in full and in low memory mode, it reports
+// - the heap memory allocated by rclc_parameter_server_init_with_option and the
+//   declaration of the parameters, including the services of the middleware
+// - the mean time of rclc_parameter_get_int and rclc_parameter_set_int over all
+//   parameters
+// - the mean round-trip time of the get, set, list and describe services from a
+//   local client. In full mode, the get, set and describe requests contain all
+//   parameters; in low memory mode, which accepts only one parameter per request,
+//   they contain the last declared parameter.
+// Parameter events are disabled, so that a set only measures the server.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include <rcl/rcl.h>
+#include <rcl/error_handling.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+#include <rclc/discovery.h>
+
+#include <rclc_parameter/rclc_parameter.h>
+
+#define RCCHECK(fn) { \
+    rcl_ret_t temp_rc = fn; \
+    if ((temp_rc != RCL_RET_OK)) { \
+      printf( \
+        "Failed status on line %d: %d. Aborting.\n", __LINE__, (int)temp_rc); \
+      return 1; \
+    } \
+}
+
+#define NUMBER_OF_ROUND_TRIPS 20
+#define NUMBER_OF_CLIENTS 4
+#define RESPONSE_TIMEOUT_NS RCL_S_TO_NS(10)
+#define NAME_LENGTH 32
+
+static const size_t parameter_counts[] = {10, 100, 1000, 10000};
+
+static rclc_parameter_server_t param_server;
+static rclc_executor_t server_executor;
+static rclc_executor_t client_executor;
+static size_t responses = 0;
+
+static rcutils_time_point_value_t now(void)
+{
+  rcutils_time_point_value_t time = 0;
+  rcutils_ret_t rc = rcutils_steady_time_now(&time);
+  RCLC_UNUSED(rc);
+  return time;
+}
+
+// heap memory in use in bytes, -1 if it cannot be determined on this platform
+static long heap_in_use(void)
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  struct mallinfo2 info = mallinfo2();
+  return (long) info.uordblks;
+#else
+  return -1;
+#endif
+}
+
+static void parameter_name(char * name, size_t size, size_t index)
+{
+  snprintf(name, size, "param_%05zu", index);
+}
+
+static void response_callback(const void * msg)
+{
+  RCLC_UNUSED(msg);
+  responses++;
+}
+
+// sends the request and spins both executors until the response has been received,
+// returns the round-trip time in nanoseconds or -1 on a failure
+static int64_t round_trip(rcl_client_t * client, const void * request)
+{
+  size_t expected = responses + 1;
+  int64_t sequence_number = 0;
+  rcutils_time_point_value_t start = now();
+  if (RCL_RET_OK != rcl_send_request(client, request, &sequence_number)) {
+    return -1;
+  }
+  while (responses < expected) {
+    rcl_ret_t rc = rclc_executor_spin_some(&server_executor, 0);
+    rc = rclc_executor_spin_some(&client_executor, 0);
+    RCLC_UNUSED(rc);
+    if (now() - start > RESPONSE_TIMEOUT_NS) {
+      return -1;
+    }
+  }
+  return now() - start;
+}
+
+// returns the mean round-trip time of the request in microseconds or -1 on a failure
+static double mean_round_trip_us(rcl_client_t * client, const void * request)
+{
+  int64_t sum = 0;
+  for (size_t i = 0; i < NUMBER_OF_ROUND_TRIPS; i++) {
+    int64_t rtt = round_trip(client, request);
+    if (rtt < 0) {
+      return -1.0;
+    }
+    sum += rtt;
+  }
+  return (double) sum / NUMBER_OF_ROUND_TRIPS / 1000.0;
+}
+
+static int run(rclc_support_t * support, rcl_allocator_t * allocator, size_t n, bool low_mem_mode)
+{
+  char name[NAME_LENGTH];
+
+  // each run uses its own node, so the clients do not discover the previous server
+  char node_name[64];
+  snprintf(
+    node_name, sizeof(node_name), "parameter_benchmark_%zu_%s", n,
+    low_mem_mode ? "low" : "full");
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  RCCHECK(rclc_node_init_default(&node, node_name, "", support));
+
+  // memory footprint
+  const rclc_parameter_options_t options = {
+    .notify_changed_over_dds = false,
+    .max_params = n,
+    .allow_undeclared_parameters = false,
+    .low_mem_mode = low_mem_mode
+  };
+  long heap_before = heap_in_use();
+  RCCHECK(rclc_parameter_server_init_with_option(&param_server, &node, &options));
+  for (size_t i = 0; i < n; i++) {
+    parameter_name(name, sizeof(name), i);
+    RCCHECK(rclc_add_parameter(&param_server, name, RCLC_PARAMETER_INT));
+  }
+  long heap_after = heap_in_use();
+
+  // local API
+  rcutils_time_point_value_t start = now();
+  for (size_t i = 0; i < n; i++) {
+    int64_t value = 0;
+    parameter_name(name, sizeof(name), i);
+    RCCHECK(rclc_parameter_get_int(&param_server, name, &value));
+  }
+  double get_ns = (double) (now() - start) / (double) n;
+  start = now();
+  for (size_t i = 0; i < n; i++) {
+    parameter_name(name, sizeof(name), i);
+    RCCHECK(rclc_parameter_set_int(&param_server, name, (int64_t) i));
+  }
+  double set_ns = (double) (now() - start) / (double) n;
+
+  // services
+  server_executor = rclc_executor_get_zero_initialized_executor();
+  RCCHECK(
+    rclc_executor_init(
+      &server_executor, &support->context, RCLC_EXECUTOR_PARAMETER_SERVER_HANDLES, allocator));
+  RCCHECK(rclc_executor_add_parameter_server(&server_executor, &param_server, NULL));
+
+  const char * service_names[NUMBER_OF_CLIENTS] =
+  {"get_parameters", "set_parameters", "list_parameters", "describe_parameters"};
+  const rosidl_service_type_support_t * type_supports[NUMBER_OF_CLIENTS] = {
+    ROSIDL_GET_SRV_TYPE_SUPPORT(rcl_interfaces, srv, GetParameters),
+    ROSIDL_GET_SRV_TYPE_SUPPORT(rcl_interfaces, srv, SetParameters),
+    ROSIDL_GET_SRV_TYPE_SUPPORT(rcl_interfaces, srv, ListParameters),
+    ROSIDL_GET_SRV_TYPE_SUPPORT(rcl_interfaces, srv, DescribeParameters)};
+  GetParameters_Response get_response;
+  SetParameters_Response set_response;
+  ListParameters_Response list_response;
+  DescribeParameters_Response describe_response;
+  rcl_interfaces__srv__GetParameters_Response__init(&get_response);
+  rcl_interfaces__srv__SetParameters_Response__init(&set_response);
+  rcl_interfaces__srv__ListParameters_Response__init(&list_response);
+  rcl_interfaces__srv__DescribeParameters_Response__init(&describe_response);
+  void * client_responses[NUMBER_OF_CLIENTS] =
+  {&get_response, &set_response, &list_response, &describe_response};
+
+  rcl_client_t clients[NUMBER_OF_CLIENTS];
+  client_executor = rclc_executor_get_zero_initialized_executor();
+  RCCHECK(rclc_executor_init(&client_executor, &support->context, NUMBER_OF_CLIENTS, allocator));
+  for (size_t i = 0; i < NUMBER_OF_CLIENTS; i++) {
+    char service_name[128];
+    snprintf(service_name, sizeof(service_name), "%s/%s", node_name, service_names[i]);
+    clients[i] = rcl_get_zero_initialized_client();
+    RCCHECK(
+      rclc_client_init(
+        &clients[i], &node, type_supports[i], service_name, &rmw_qos_profile_parameters));
+    RCCHECK(
+      rclc_executor_add_client(
+        &client_executor, &clients[i], client_responses[i], response_callback));
+    rclc_discovery_t discovery = rclc_discovery_get_zero_initialized();
+    RCCHECK(rclc_discovery_init_service_server(&discovery, &node, &clients[i]));
+    RCCHECK(rclc_discovery_wait(&discovery, &support->context, RCL_S_TO_NS(10), allocator));
+  }
+
+  // low memory mode accepts one parameter per request
+  size_t batch = low_mem_mode ? 1 : n;
+  size_t first = n - batch;
+  GetParameters_Request get_request;
+  SetParameters_Request set_request;
+  ListParameters_Request list_request;
+  DescribeParameters_Request describe_request;
+  rcl_interfaces__srv__GetParameters_Request__init(&get_request);
+  rcl_interfaces__srv__SetParameters_Request__init(&set_request);
+  rcl_interfaces__srv__ListParameters_Request__init(&list_request);
+  rcl_interfaces__srv__DescribeParameters_Request__init(&describe_request);
+  if (!rosidl_runtime_c__String__Sequence__init(&get_request.names, batch) ||
+    !rosidl_runtime_c__String__Sequence__init(&describe_request.names, batch) ||
+    !rcl_interfaces__msg__Parameter__Sequence__init(&set_request.parameters, batch))
+  {
+    printf("Could not allocate memory for the requests\n");
+    return 1;
+  }
+  for (size_t i = 0; i < batch; i++) {
+    parameter_name(name, sizeof(name), first + i);
+    rosidl_runtime_c__String__assign(&get_request.names.data[i], name);
+    rosidl_runtime_c__String__assign(&describe_request.names.data[i], name);
+    rosidl_runtime_c__String__assign(&set_request.parameters.data[i].name, name);
+    set_request.parameters.data[i].value.type = RCLC_PARAMETER_INT;
+    set_request.parameters.data[i].value.integer_value = (int64_t) i;
+  }
+  list_request.depth = rcl_interfaces__srv__ListParameters_Request__DEPTH_RECURSIVE;
+
+  double get_rtt = mean_round_trip_us(&clients[0], &get_request);
+  double set_rtt = mean_round_trip_us(&clients[1], &set_request);
+  double list_rtt = mean_round_trip_us(&clients[2], &list_request);
+  double describe_rtt = mean_round_trip_us(&clients[3], &describe_request);
+  if (get_rtt < 0 || set_rtt < 0 || list_rtt < 0 || describe_rtt < 0) {
+    printf("No response of the parameter server with %zu parameters\n", n);
+    return 1;
+  }
+
+  if (heap_before < 0) {
+    printf("%6zu | %4s | %9s |", n, low_mem_mode ? "low" : "full", "n/a");
+  } else {
+    printf(
+      "%6zu | %4s | %9ld |", n, low_mem_mode ? "low" : "full", heap_after - heap_before);
+  }
+  printf(
+    " %8.1f | %8.1f | %5zu | %9.1f | %9.1f | %9.1f | %9.1f\n",
+    get_ns, set_ns, batch, get_rtt, set_rtt, list_rtt, describe_rtt);
+
+  // clean up
+  rcl_interfaces__srv__GetParameters_Request__fini(&get_request);
+  rcl_interfaces__srv__SetParameters_Request__fini(&set_request);
+  rcl_interfaces__srv__ListParameters_Request__fini(&list_request);
+  rcl_interfaces__srv__DescribeParameters_Request__fini(&describe_request);
+  RCCHECK(rclc_executor_fini(&client_executor));
+  for (size_t i = 0; i < NUMBER_OF_CLIENTS; i++) {
+    RCCHECK(rcl_client_fini(&clients[i], &node));
+  }
+  rcl_interfaces__srv__GetParameters_Response__fini(&get_response);
+  rcl_interfaces__srv__SetParameters_Response__fini(&set_response);
+  rcl_interfaces__srv__ListParameters_Response__fini(&list_response);
+  rcl_interfaces__srv__DescribeParameters_Response__fini(&describe_response);
+  RCCHECK(rclc_executor_fini(&server_executor));
+  RCCHECK(rclc_parameter_server_fini(&param_server, &node));
+  RCCHECK(rcl_node_fini(&node));
+  return 0;
+}
+
+int main(int argc, const char * argv[])
+{
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rclc_support_t support;
+
+  RCCHECK(rclc_support_init(&support, argc, argv, &allocator));
+
+  printf(
+    "params | mode |      heap |  get_int |  set_int | batch |   get rtt |   set rtt |"
+    "  list rtt |  desc rtt\n"
+    "       |      |   [bytes] |     [ns] |     [ns] |       |      [us] |      [us] |"
+    "      [us] |      [us]\n");
+  for (size_t i = 0; i < sizeof(parameter_counts) / sizeof(parameter_counts[0]); i++) {
+    if (0 != run(&support, &allocator, parameter_counts[i], false) ||
+      0 != run(&support, &allocator, parameter_counts[i], true))
+    {
+      return 1;
+    }
+  }
+
+  // clean up
+  RCCHECK(rclc_support_fini(&support));
+  return 0;
+}
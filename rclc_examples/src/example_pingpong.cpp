@@ -17,6 +17,7 @@
 #include <stdio.h>
 #include <std_msgs/msg/string.h>
 #include <rclc/executor.h>
+#include <rclc/executor.hpp>
 #include <rclc/rclc.h>
 // #include "example_pingpong_helper.h"
 
@@ -38,15 +39,10 @@ std_msgs__msg__String pongNode_pong_msg;
 
 class MySubscription {
 public: 
-  MySubscription(){};
-  static void on_update(const void * msgin) {
-    const std_msgs__msg__String * msg = (const std_msgs__msg__String *)msgin;
-    if (msg == NULL) {
-      printf("Callback: msg NULL\n");
-    } else {
-      printf("CLASS Callback: I heard: %s\n", msg->data.data);
-    }
-    // number++; not possible to use member variables
+  MySubscription() : number(0) {};
+  void on_update(const std_msgs__msg__String & msg) {
+    number++;
+    printf("CLASS Callback: I heard: %s (message %d)\n", msg.data.data, number);
   }
   private:
     int number;
@@ -362,33 +358,27 @@ int main(int argc, const char * argv[])
   } else {
     // use two executors
 
-    // executor for ping node 
-    rclc_executor_t ping_executor;
-    ping_executor = rclc_executor_get_zero_initialized_executor();
+    // executor for ping node: the C++ executor of rclc/executor.hpp allows member
+    // functions and lambdas with captures as callbacks.
     // total number of handles = #subscriptions + #timers + #Services (in below case services are 0)
     // Note:
     // If you need more than the default number of publisher/subscribers, etc., you
     // need to configure the micro-ROS middleware also!
     // See documentation in the executor.h at the function rclc_executor_init()
     // for more details.
-    unsigned int pingNode_num_handles = 1 + 1;
-    printf("Debug: number of DDS handles: %u\n", pingNode_num_handles);
-    rclc_executor_init(&ping_executor, &support.context, pingNode_num_handles, &allocator);
+    rclc::Executor<1 + 1> ping_executor;
+    ping_executor.init(&support.context, &allocator);
 
     //add publisher (timer) for ping_msg
-    rc= rclc_executor_add_timer(&ping_executor, &ping_timer);
+    rc= rclc_executor_add_timer(ping_executor.get(), &ping_timer);
     if (rc != RCL_RET_OK) {
       printf("Error in rclc_executor_add_timer.\n");
     }
  
     // add subscription for pong_msg
-    // rc = rclc_executor_add_subscription(
-    //   &ping_executor, &pong_subscription, &pingNode_pong_msg, &pong_subscription_callback,
-    //  ON_NEW_DATA);
-
-    rc = rclc_executor_add_subscription(
-      &ping_executor, &pong_subscription, &pingNode_pong_msg, &MySubscription::on_update,
-      ON_NEW_DATA);
+    MySubscription my_subscription;
+    rc = ping_executor.add_subscription(
+      &pong_subscription, &pingNode_pong_msg, &my_subscription, &MySubscription::on_update);
 
     if (rc != RCL_RET_OK) {
       printf("Error in rclc_executor_add_subscription. \n");
@@ -418,17 +408,17 @@ int main(int argc, const char * argv[])
     }
 
     // Optional: prepare for avoiding allocations during spin
-    rclc_executor_prepare(&ping_executor);
+    ping_executor.prepare();
     rclc_executor_prepare(&pong_executor);
 
     for (unsigned int i = 0; i < 10; i++) {
         // timeout specified in nanoseconds (here 1s)
-      rclc_executor_spin_some(&ping_executor, RCL_MS_TO_NS( 1000 ));
+      ping_executor.spin_some(RCL_MS_TO_NS( 1000 ));
       rclc_executor_spin_some(&pong_executor, RCL_MS_TO_NS( 1000 ));
     }
 
     // clean up
-    rc = rclc_executor_fini(&ping_executor);
+    rc = ping_executor.fini();
     rc = rclc_executor_fini(&pong_executor);
 
     rc += rcl_publisher_fini(&ping_publisher, &ping_node);
@@ -188,6 +188,14 @@ int main(int argc, const char * argv[])
   if (rc != RCL_RET_OK) {
     printf("Error in rclc_executor_add_timer.\n");
   }
+
+  // the short timer expires while the subscription callback sleeps. It is
+  // executed right after the callback instead of in the next spin.
+  rc = rclc_executor_set_timer_interleaving(&executor, true);
+  if (rc != RCL_RET_OK) {
+    printf("Error in rclc_executor_set_timer_interleaving.\n");
+  }
+
   // Start Executor
   rclc_executor_spin(&executor);
 
@@ -0,0 +1,136 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the dispatch overhead of rclc_executor_t and rclc::static_executor.
+// NUMBER_OF_SUBSCRIPTIONS subscriptions listen to the same topic; each round
+// publishes one message and spins until every subscription has received it.
+// The reported time per round includes rcl_wait and the middleware, so the
+// difference of both executors is the cost of the dynamic dispatch.
+
+#include <stdio.h>
+#include <std_msgs/msg/int32.h>
+#include <rclc/executor.h>
+#include <rclc/rclc.h>
+#include <rclc/static_executor.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <utility>
+
+#define RCCHECK(fn) { \
+    rcl_ret_t temp_rc = fn; \
+    if ((temp_rc != RCL_RET_OK)) { \
+      printf( \
+        "Failed status on line %d: %d. Aborting.\n", __LINE__, (int)temp_rc); \
+      return 1; \
+    } \
+}
+
+constexpr std::size_t NUMBER_OF_SUBSCRIPTIONS = 10;
+constexpr unsigned int NUMBER_OF_ROUNDS = 10000;
+
+rcl_subscription_t subscriptions[NUMBER_OF_SUBSCRIPTIONS];
+std_msgs__msg__Int32 messages[NUMBER_OF_SUBSCRIPTIONS];
+unsigned int received = 0;
+
+void subscription_callback(const void * msgin)
+{
+  RCLC_UNUSED(msgin);
+  received++;
+}
+
+template<std::size_t ... I>
+auto make_static_executor(std::index_sequence<I...>)
+{
+  auto callback = [](const std_msgs__msg__Int32 &) {received++;};
+  return rclc::static_executor(
+    rclc::static_subscription(&subscriptions[I], &messages[I], callback) ...);
+}
+
+// returns the mean time per round in microseconds
+template<typename Spin>
+double run_rounds(rcl_publisher_t * publisher, Spin spin)
+{
+  std_msgs__msg__Int32 msg;
+  msg.data = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < NUMBER_OF_ROUNDS; i++) {
+    received = 0;
+    if (RCL_RET_OK != rcl_publish(publisher, &msg, NULL)) {
+      return -1.0;
+    }
+    while (received < NUMBER_OF_SUBSCRIPTIONS) {
+      spin();
+    }
+  }
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / NUMBER_OF_ROUNDS;
+}
+
+int main(int argc, const char * argv[])
+{
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rclc_support_t support;
+
+  RCCHECK(rclc_support_init(&support, argc, argv, &allocator));
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  RCCHECK(rclc_node_init_default(&node, "static_executor_benchmark", "", &support));
+
+  const rosidl_message_type_support_t * type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  RCCHECK(rclc_publisher_init_default(&publisher, &node, type_support, "benchmark_topic"));
+  for (std::size_t i = 0; i < NUMBER_OF_SUBSCRIPTIONS; i++) {
+    subscriptions[i] = rcl_get_zero_initialized_subscription();
+    RCCHECK(
+      rclc_subscription_init_default(
+        &subscriptions[i], &node, type_support, "benchmark_topic"));
+  }
+
+  // dynamic executor
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  RCCHECK(rclc_executor_init(&executor, &support.context, NUMBER_OF_SUBSCRIPTIONS, &allocator));
+  for (std::size_t i = 0; i < NUMBER_OF_SUBSCRIPTIONS; i++) {
+    RCCHECK(
+      rclc_executor_add_subscription(
+        &executor, &subscriptions[i], &messages[i], &subscription_callback, ON_NEW_DATA));
+  }
+  double dynamic_us = run_rounds(
+    &publisher, [&executor]() {rclc_executor_spin_some(&executor, RCL_MS_TO_NS(100));});
+  RCCHECK(rclc_executor_fini(&executor));
+
+  // static executor
+  auto static_executor =
+    make_static_executor(std::make_index_sequence<NUMBER_OF_SUBSCRIPTIONS>{});
+  RCCHECK(static_executor.init(&support.context, allocator));
+  double static_us = run_rounds(
+    &publisher, [&static_executor]() {static_executor.spin_some(RCL_MS_TO_NS(100));});
+  RCCHECK(static_executor.fini());
+
+  printf(
+    "%zu subscriptions, %u rounds\n"
+    "rclc_executor_t:       %8.2f us/round\n"
+    "rclc::static_executor: %8.2f us/round\n",
+    NUMBER_OF_SUBSCRIPTIONS, NUMBER_OF_ROUNDS, dynamic_us, static_us);
+
+  // clean up
+  for (std::size_t i = 0; i < NUMBER_OF_SUBSCRIPTIONS; i++) {
+    RCCHECK(rcl_subscription_fini(&subscriptions[i], &node));
+  }
+  RCCHECK(rcl_publisher_fini(&publisher, &node));
+  RCCHECK(rcl_node_fini(&node));
+  RCCHECK(rclc_support_fini(&support));
+  return 0;
+}